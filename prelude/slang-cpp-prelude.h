@@ -297,4 +297,52 @@ struct ISlangUnknown
 #   define SLANG_UNROLL
 #endif
 
+// Used by SPMD code generation (`-emit-cpp-spmd`), where the threads of a thread group are executed
+// as the lanes of a loop that the C++ compiler is told it can vectorize.
+//
+// SLANG_PRELUDE_SIMD_WIDTH is the amount of 32 bit lanes available for the instruction set being compiled for.
+#ifndef SLANG_PRELUDE_SIMD_WIDTH
+#   if defined(__AVX512F__)
+#       define SLANG_PRELUDE_SIMD_WIDTH 16
+#   elif defined(__AVX2__) || defined(__AVX__)
+#       define SLANG_PRELUDE_SIMD_WIDTH 8
+#   elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__ARM_NEON)
+#       define SLANG_PRELUDE_SIMD_WIDTH 4
+#   else
+#       define SLANG_PRELUDE_SIMD_WIDTH 1
+#   endif
+#endif
+
+#define SLANG_PRELUDE_PRAGMA(x) _Pragma(#x)
+
+// SLANG_PRELUDE_SIMD_LOOP precedes a loop whose iterations are independent, and should be vectorized.
+//
+// For GCC `omp simd` is used, because `ivdep` only asserts the iterations are independent, and the loop may still
+// not be vectorized by the cost model. `omp simd` requires compiling with -fopenmp-simd (which Slang does for SPMD code),
+// else the pragma is ignored.
+#ifndef SLANG_PRELUDE_SIMD_LOOP
+#   if SLANG_CLANG
+#       define SLANG_PRELUDE_SIMD_LOOP_WIDTH(width) SLANG_PRELUDE_PRAGMA(clang loop vectorize(assume_safety) vectorize_width(width) interleave(enable))
+#       define SLANG_PRELUDE_SIMD_LOOP SLANG_PRELUDE_SIMD_LOOP_WIDTH(SLANG_PRELUDE_SIMD_WIDTH)
+#   elif SLANG_GCC
+#       define SLANG_PRELUDE_SIMD_LOOP SLANG_PRELUDE_PRAGMA(omp simd)
+#   elif SLANG_VC
+#       define SLANG_PRELUDE_SIMD_LOOP __pragma(loop(ivdep))
+#   else
+#       define SLANG_PRELUDE_SIMD_LOOP
+#   endif
+#endif
+
+// SLANG_PRELUDE_SIMD_INLINE marks a function called from a SLANG_PRELUDE_SIMD_LOOP. The loop can only be vectorized
+// if the call is inlined, which `inline` (and so SLANG_FORCE_INLINE in the prelude) doesn't guarantee for large functions.
+#ifndef SLANG_PRELUDE_SIMD_INLINE
+#   if SLANG_CLANG || SLANG_GCC
+#       define SLANG_PRELUDE_SIMD_INLINE inline __attribute__((always_inline))
+#   elif SLANG_VC
+#       define SLANG_PRELUDE_SIMD_INLINE __forceinline
+#   else
+#       define SLANG_PRELUDE_SIMD_INLINE inline
+#   endif
+#endif
+
 #endif
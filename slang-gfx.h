@@ -57,6 +57,7 @@ const uint64_t kTimeoutInfinite = 0xFFFFFFFFFFFFFFFF;
 enum class StructType
 {
     D3D12ExtendedDesc,
+    CPUExtendedDesc,
 };
 
 // TODO: Rename to Stage
@@ -129,6 +130,7 @@ enum class AccessFlag
 const GfxCount kMaxRenderTargetCount = 8;
 
 class ITransientResourceHeap;
+class IPipelineState;
 
 class IShaderProgram: public ISlangUnknown
 {
@@ -1035,6 +1037,21 @@ public:
         0x7fe1c283, 0xd3f4, 0x48ed, { 0xaa, 0xf3, 0x1, 0x51, 0x96, 0x4e, 0x7c, 0xb5 } \
     }
 
+// A handle to the building of a specialized pipeline, which may take place in the background.
+class IPipelineSpecializationTask : public ISlangUnknown
+{
+public:
+    /// Returns true if the specialized pipeline has been built, or building it failed.
+    virtual SLANG_NO_THROW bool SLANG_MCALL isComplete() = 0;
+
+    /// Blocks until the task is complete, and returns the result of building the specialized pipeline.
+    virtual SLANG_NO_THROW Result SLANG_MCALL wait() = 0;
+};
+#define SLANG_UUID_IPipelineSpecializationTask                                        \
+    {                                                                                 \
+        0x5d2f7c1e, 0x8a43, 0x4b6e, { 0x9c, 0x1d, 0x3e, 0x72, 0xa5, 0x0b, 0x46, 0xf8 } \
+    }
+
 struct ShaderOffset
 {
     SlangInt uniformOffset = 0; // TODO: Change to Offset?
@@ -1309,12 +1326,20 @@ struct GraphicsPipelineStateDesc
     DepthStencilDesc    depthStencil;
     RasterizerDesc      rasterizer;
     BlendDesc           blend;
+    // If `program` is specializable, and the device builds specialized pipelines in the background, the pipeline
+    // used in place of a specialization that is still being built. Must not be specializable itself. If null, draw
+    // calls are skipped until the specialization is ready.
+    IPipelineState*     specializationFallback = nullptr;
 };
 
 struct ComputePipelineStateDesc
 {
     IShaderProgram*  program = nullptr;
     void* d3d12RootSignatureOverride = nullptr;
+    // If `program` is specializable, and the device builds specialized pipelines in the background, the pipeline
+    // used in place of a specialization that is still being built. Must not be specializable itself. If null,
+    // dispatches are skipped until the specialization is ready.
+    IPipelineState*  specializationFallback = nullptr;
 };
 
 struct RayTracingPipelineFlags
@@ -2056,6 +2081,16 @@ public:
         handleMessage(DebugMessageType type, DebugMessageSource source, const char* message) = 0;
 };
 
+enum class PipelineSpecializationMode
+{
+    // A specialized pipeline is built when it is first used, in the dispatch or draw call that uses it.
+    Synchronous,
+    // A specialized pipeline is built on a background thread. Until it is ready, dispatch and draw calls use the
+    // `specializationFallback` of the pipeline, or are skipped if it doesn't have one.
+    // Devices that can't build pipelines off the thread that uses them (D3D11, OpenGL, CUDA) build them synchronously.
+    Background,
+};
+
 class IDevice: public ISlangUnknown
 {
 public:
@@ -2103,7 +2138,20 @@ public:
         GfxIndex nvapiExtnSlot = -1;
         // The file system for loading cached shader kernels. The layer does not maintain a strong reference to the object,
         // instead the user is responsible for holding the object alive during the lifetime of an `IDevice`.
+        // If the file system is an `ISlangMutableFileSystem`, kernels are saved to it as they are compiled, so that later
+        // devices using the same file system (for example in another run of the application) don't need to compile them.
+        // For the CPU device a kernel is a shared library that is loaded into the process, so the file system must only be
+        // writable by trusted users. A kernel that doesn't match the hash saved with it is compiled again rather than used.
         ISlangFileSystem* shaderCacheFileSystem = nullptr;
+        // The maximum total size in bytes of the kernels held in `shaderCacheFileSystem`. When a kernel is saved and the
+        // total is over the limit, the least recently used kernels are removed. 0 means there is no limit.
+        Size maxShaderCacheSize = 0;
+        // How specialized pipelines are built when a specializable pipeline is used with arguments it hasn't
+        // been specialized for.
+        PipelineSpecializationMode pipelineSpecializationMode = PipelineSpecializationMode::Synchronous;
+        // The amount of threads that build specialized pipelines when `pipelineSpecializationMode` is `Background`.
+        // 0 uses a single thread. -1 uses a thread per hardware thread.
+        GfxCount pipelineSpecializationThreadCount = 0;
         // Configurations for Slang compiler.
         SlangDesc slang = {};
 
@@ -2428,6 +2476,17 @@ public:
         const ITextureResource::Desc& desc, Size* outSize, Size* outAlignment) = 0;
 
     virtual SLANG_NO_THROW Result SLANG_MCALL getTextureRowAlignment(Size* outAlignment) = 0;
+
+        /// Start building the specialization of the specializable `pipeline` for the specialization arguments
+        /// `args`, such that it is ready when the pipeline is used with those arguments. The arguments must
+        /// be types, in the order of the specialization parameters of the pipeline's program.
+        /// With `PipelineSpecializationMode::Synchronous` the specialization is built before returning.
+        /// `outTask` is optional.
+    virtual SLANG_NO_THROW Result SLANG_MCALL prewarmSpecializedPipeline(
+        IPipelineState* pipeline,
+        const slang::SpecializationArg* args,
+        GfxCount argCount,
+        IPipelineSpecializationTask** outTask) = 0;
 };
 
 #define SLANG_UUID_IDevice                                                               \
@@ -2497,4 +2556,15 @@ struct D3D12DeviceExtendedDesc
     bool debugBreakOnD3D12Error = false;
 };
 
+struct CPUDeviceExtendedDesc
+{
+    StructType structType = StructType::CPUExtendedDesc;
+        /// The amount of worker threads used to execute `dispatchCompute`.
+        /// 0 executes the whole dispatch on the calling thread. -1 uses a thread per hardware thread.
+    GfxCount workerThreadCount = 0;
+        /// The amount of thread groups in each tile of work that is handed to a worker, in each dimension.
+        /// A value of 0 for a dimension means the tile size will be chosen automatically.
+    GfxCount tileSize[3] = { 0, 0, 0 };
+};
+
 }
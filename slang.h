@@ -605,6 +605,14 @@ extern "C"
     };
 
     /* Defines an archive type used to holds a 'file system' type structure. */
+    typedef int SlangPerformanceReportFormatIntegral;
+    enum SlangPerformanceReportFormat : SlangPerformanceReportFormatIntegral
+    {
+        SLANG_PERFORMANCE_REPORT_FORMAT_TEXT,       ///< Indented table of phases, followed by counters
+        SLANG_PERFORMANCE_REPORT_FORMAT_JSON,
+        SLANG_PERFORMANCE_REPORT_FORMAT_COUNT_OF,
+    };
+
     typedef int SlangArchiveTypeIntegral;
     enum SlangArchiveType : SlangArchiveTypeIntegral
     {
@@ -661,6 +669,11 @@ extern "C"
 
         /* When set, will generate SPIRV directly instead of going through glslang. */
         SLANG_TARGET_FLAG_GENERATE_SPIRV_DIRECTLY = 1 << 10,
+
+        /* When set, CPU targets execute the threads of a compute thread group as the SIMD lanes
+           of a single vectorizable loop (SPMD style), rather than calling the kernel for one
+           thread at a time. Threads within a group must not communicate through memory. */
+        SLANG_TARGET_FLAG_GENERATE_SPMD = 1 << 11,
     };
 
     /*!
@@ -1617,6 +1630,46 @@ extern "C"
     SLANG_API SlangResult spCompile(
         SlangCompileRequest*    request);
 
+    /*! @brief A permutation of a compilation, as compiled by `spCompilePermutations`. */
+    typedef struct SlangPermutationDesc
+    {
+        /** Command line arguments (such as `-D` defines) that are added to the base arguments for the permutation. */
+        char const* const*  args;
+        int                 argCount;
+
+        /** Type names for the global existential type parameters of the permutation, in order. */
+        char const* const*  typeArgs;
+        int                 typeArgCount;
+    } SlangPermutationDesc;
+
+    /*!
+    @brief Compile permutations of the same source, that differ in their arguments.
+
+    Each permutation is compiled as if by a compile request that processed the base arguments, followed by the
+    arguments of the permutation. The arguments must specify a single target, and at most one entry point, such that
+    each permutation has a single output.
+
+    Permutations are preprocessed first, and those that preprocess to the same tokens (and otherwise only differ
+    by defines) share a single compilation. The remaining compilations run in parallel. Permutations that produce
+    the same output share an artifact.
+
+    @param outArtifactIndices Receives for each permutation the index of its artifact in outArtifacts, or -1 if it failed.
+    @param outArtifacts Receives the distinct artifacts. Must have space for permutationCount entries.
+    @param outArtifactCount Receives the number of distinct artifacts.
+    @param outDiagnostics (optional) Receives the diagnostics of the compilations, prefixed by the permutation they are for.
+    @return SLANG_OK if all of the permutations compiled.
+    */
+    SLANG_API SlangResult spCompilePermutations(
+        SlangSession*                   session,
+        char const* const*              baseArgs,
+        int                             baseArgCount,
+        SlangPermutationDesc const*     permutations,
+        int                             permutationCount,
+        int*                            outArtifactIndices,
+        ISlangBlob**                    outArtifacts,
+        int*                            outArtifactCount,
+        ISlangBlob**                    outDiagnostics);
+
 
     /*! @see slang::ICompileRequest::getDiagnosticOutput */
     SLANG_API char const* spGetDiagnosticOutput(
@@ -1757,6 +1810,15 @@ extern "C"
     /*! @see slang::ICompileRequest::setDiagnosticFlags */
     SLANG_API void spSetDiagnosticFlags(SlangCompileRequest* request, SlangDiagnosticFlags flags);
 
+    /*! @see slang::ICompileRequest::setReportPerformance */
+    SLANG_API void spSetReportPerformance(SlangCompileRequest* request, bool enable);
+
+    /*! @see slang::ICompileRequest::getPerformanceReport */
+    SLANG_API SlangResult spGetPerformanceReport(SlangCompileRequest* request, SlangPerformanceReportFormat format, ISlangBlob** outBlob);
+
+    /*! @see slang::ICompileRequest::getPerformanceCounter */
+    SLANG_API SlangResult spGetPerformanceCounter(SlangCompileRequest* request, const char* name, int64_t* outValue);
+
     /*
     Forward declarations of types used in the reflection interface;
     */
@@ -3179,9 +3241,13 @@ namespace slang
         multiple sessions, in order to amortize startups costs (in current
         Slang this is mostly the cost of loading the Slang standard library).
 
-        The global session is currently *not* thread-safe and objects created from
-        a single global session should only be used from a single thread at
-        a time.
+        Once the standard library has been loaded, the builtin state held by the global
+        session is immutable. Sessions and compile requests created from a single global
+        session may then be used on different threads at the same time, as long as each
+        session (and the objects created from it) is only used from a single thread at a time.
+        Other methods of the global session (such as setting downstream compiler paths or
+        preludes, or `addBuiltins`) are *not* thread-safe, and should not be called whilst
+        sessions are compiling.
         */
     struct IGlobalSession : public ISlangUnknown
     {
@@ -3970,6 +4036,36 @@ namespace slang
             /** Sets the flags of the request's diagnostic sink.
                 The previously specified flags are discarded. */
         virtual SLANG_NO_THROW void SLANG_MCALL setDiagnosticFlags(SlangDiagnosticFlags flags) = 0;
+
+            /** Enable or disable collecting the time taken by each phase of compilation, and counts
+                of work performed (such as IR instructions created), for subsequent calls to `compile`.
+                When disabled (the default) collection has close to no cost.
+            */
+        virtual SLANG_NO_THROW void SLANG_MCALL setReportPerformance(bool enable) = 0;
+
+            /** Get the performance report collected by the last call to `compile`.
+
+            @param format               The format of the report.
+            @param outBlob              Receives the report text.
+            @returns SLANG_E_NOT_AVAILABLE if no report was collected.
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getPerformanceReport(
+            SlangPerformanceReportFormat format,
+            ISlangBlob** outBlob) = 0;
+
+            /** Get the value of a counter in the performance report collected by the last call to `compile`.
+
+            @param name                 The name of the counter, as used as a key in the JSON report (such as
+                                        "irInstsCreated"). The runs and skips of an IR pass (collected with
+                                        -ir-pass-timings) are named "irPass.<pass name>.runs" and
+                                        "irPass.<pass name>.skips".
+            @param outValue             Receives the value.
+            @returns SLANG_E_NOT_AVAILABLE if no report was collected, or SLANG_E_NOT_FOUND if there is no
+                                        counter called `name`.
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getPerformanceCounter(
+            const char* name,
+            int64_t* outValue) = 0;
     };
 
     #define SLANG_UUID_ICompileRequest ICompileRequest::getTypeGuid()
@@ -4060,6 +4156,33 @@ namespace slang
         SlangInt                        preprocessorMacroCount = 0;
 
         ISlangFileSystem* fileSystem = nullptr;
+
+            /** If set, the directory used to cache the output of compile requests created from
+            this session. A later request with identical source, options and compiler version
+            will use the cached output instead of running code generation.
+            */
+        char const* cacheDirectory = nullptr;
+
+            /** The approximate amount of memory, in bytes, that can be used to cache the component types
+            produced by `IComponentType::specialize` and `IComponentType::link`. If non zero, specializing
+            or linking a component in the same way as before returns the same component type as before,
+            along with any code already generated for it. The least recently used component types are
+            removed from the cache when it is over budget. 0 disables the cache.
+            */
+        size_t specializationCacheBudget = 0;
+    };
+
+        /** Statistics for the cache of specialized and linked component types held by a session.
+        See `SessionDesc::specializationCacheBudget`.
+        */
+    struct SpecializationCacheStats
+    {
+        uint64_t hitCount = 0;                  ///< Requests that returned a cached component type
+        uint64_t missCount = 0;                 ///< Requests that weren't in the cache
+        uint64_t evictionCount = 0;             ///< Component types removed to stay within the budget
+        SlangInt entryCount = 0;                ///< Component types currently in the cache
+        size_t approximateMemoryUsage = 0;      ///< Approximate memory used by the component types in the cache
+        size_t budget = 0;                      ///< The budget
     };
 
     enum class ContainerType
@@ -4234,6 +4357,12 @@ namespace slang
             ITypeConformance** outConformance,
             SlangInt conformanceIdOverride,
             ISlangBlob** outDiagnostics) = 0;
+
+            /** Get statistics for the cache of specialized and linked component types.
+            See `SessionDesc::specializationCacheBudget`.
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getSpecializationCacheStats(
+            SpecializationCacheStats* outStats) = 0;
     };
 
     #define SLANG_UUID_ISession ISession::getTypeGuid()
@@ -4413,6 +4542,26 @@ namespace slang
             */
         virtual SLANG_NO_THROW SlangResult SLANG_MCALL renameEntryPoint(
             const char* newName, IComponentType** outEntryPoint) = 0;
+
+            /** Get a key that identifies the code generated for an entry point on a target.
+
+            The key is text that covers everything that can change the code produced by `getEntryPointCode`
+            or `getEntryPointHostCallable` - the compiler version, the target and session options, the
+            structure of this component type along with its specialization arguments, and the contents of
+            the source it depends on. The key is the same in different processes, so it can be used to
+            look up previously generated code, for example in a cache held on disk.
+
+            Calculating the key doesn't generate any code.
+
+            @param entryPointIndex  The index of the entry point.
+            @param targetIndex      The index of the target.
+            @param outKey           The key text.
+            @returns                A `SlangResult` to indicate success or failure.
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCacheKey(
+            SlangInt                entryPointIndex,
+            SlangInt                targetIndex,
+            IBlob**                 outKey) = 0;
     };
     #define SLANG_UUID_IComponentType IComponentType::getTypeGuid()
 
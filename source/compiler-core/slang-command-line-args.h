@@ -146,6 +146,8 @@ struct DownstreamArgs
 
         /// Get the args at the nameIndex
     CommandLineArgs& getArgsAt(Index nameIndex) { return m_entries[nameIndex].args; }
+        /// Get all of the entries
+    const List<Entry>& getEntries() const { return m_entries; }
         /// Get args by name - will assert if name isn't found
     CommandLineArgs& getArgsByName(const char* name);
     const CommandLineArgs& getArgsByName(const char* name) const;
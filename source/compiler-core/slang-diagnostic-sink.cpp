@@ -352,14 +352,13 @@ static void _sourceLocationNoteDiagnostic(DiagnosticSink* sink, SourceView* sour
     sb << caretLine << "\n";
 }
 
-// Output the length of the token at `sourceLoc`. This is used by language server.
-static void _tokenLengthNoteDiagnostic(
-    DiagnosticSink* sink, SourceView* sourceView, SourceLoc sourceLoc, StringBuilder& sb)
+// Get the length of the token at `sourceLoc`, or 0 if it can't be determined.
+static Index _calcTokenLength(DiagnosticSink* sink, SourceView* sourceView, SourceLoc sourceLoc)
 {
     SourceFile* sourceFile = sourceView->getSourceFile();
     if (!sourceFile)
     {
-        return;
+        return 0;
     }
 
     UnownedStringSlice content = sourceFile->getContent();
@@ -371,7 +370,7 @@ static void _tokenLengthNoteDiagnostic(
     const int offset = sourceView->getRange().getOffset(sourceLoc);
     if (offset < 0 || offset >= content.getLength())
     {
-        return;
+        return 0;
     }
 
     // Work out the position of the SourceLoc in the source
@@ -383,14 +382,21 @@ static void _tokenLengthNoteDiagnostic(
     line = UnownedStringSlice(line.begin(), line.trim().end());
 
     auto lexer = sink->getSourceLocationLexer();
-    if (lexer)
+    if (!lexer)
     {
-        UnownedStringSlice token = lexer(UnownedStringSlice(pos, line.end()));
+        return 0;
+    }
+    return lexer(UnownedStringSlice(pos, line.end())).getLength();
+}
 
-        if (token.getLength() > 1)
-        {
-            sb << "^+" << token.getLength() << "\n";
-        }
+// Output the length of the token at `sourceLoc`. This is used by language server.
+static void _tokenLengthNoteDiagnostic(
+    DiagnosticSink* sink, SourceView* sourceView, SourceLoc sourceLoc, StringBuilder& sb)
+{
+    const Index tokenLength = _calcTokenLength(sink, sourceView, sourceLoc);
+    if (tokenLength > 1)
+    {
+        sb << "^+" << tokenLength << "\n";
     }
 }
 
@@ -605,24 +611,64 @@ void DiagnosticSink::diagnoseImpl(SourceLoc const& pos, DiagnosticInfo info, int
     if (info.severity == Severity::Disable)
         return;
 
-    StringBuilder messageBuilder;
-    {
-        StringBuilder sb;
-        formatDiagnosticMessage(sb, info.messageFormat, argCount, args);
+    StringBuilder sb;
+    formatDiagnosticMessage(sb, info.messageFormat, argCount, args);
 
-        Diagnostic diagnostic;
-        diagnostic.ErrorID = info.id;
-        diagnostic.Message = sb.ProduceString();
-        diagnostic.loc = pos;
-        diagnostic.severity = info.severity;
+    Diagnostic diagnostic;
+    diagnostic.ErrorID = info.id;
+    diagnostic.Message = sb.ProduceString();
+    diagnostic.loc = pos;
+    diagnostic.severity = info.severity;
 
-        // If so, pass the error string along to them
-        formatDiagnostic(this, diagnostic, messageBuilder);
+    if (m_listener)
+    {
+        // The listener gets the diagnostic as is, so there is no need to format it
+        if (SourceView* sourceView = m_sourceManager ? m_sourceManager->findSourceViewRecursively(pos) : nullptr)
+        {
+            diagnostic.endLoc = pos + _calcTokenLength(this, sourceView, pos);
+        }
+        m_listener->handleDiagnostic(diagnostic);
+
+        if (info.severity >= Severity::Error)
+        {
+            m_errorCount++;
+        }
+        if (info.severity >= Severity::Fatal)
+        {
+            SLANG_ABORT_COMPILATION("");
+        }
+        return;
     }
 
+    StringBuilder messageBuilder;
+    formatDiagnostic(this, diagnostic, messageBuilder);
+
     diagnoseImpl(info, messageBuilder.getUnownedSlice());
 }
 
+void DiagnosticSink::outputBufferedDiagnostics(DiagnosticSink* sink)
+{
+    m_errorCount += sink->m_errorCount;
+
+    const UnownedStringSlice text = sink->outputBuffer.getUnownedSlice();
+    if (text.getLength())
+    {
+        if (writer)
+        {
+            writer->write(text.begin(), text.getLength());
+        }
+        else
+        {
+            outputBuffer.append(text);
+        }
+    }
+
+    if (m_parentSink)
+    {
+        m_parentSink->outputBufferedDiagnostics(sink);
+    }
+}
+
 void DiagnosticSink::diagnoseRaw(
     Severity    severity,
     char const* message)
@@ -61,6 +61,7 @@ class Diagnostic
 public:
     String Message;
     SourceLoc loc;
+    SourceLoc endLoc;               ///< The end of the token at loc if known. Only set for a DiagnosticListener.
     int ErrorID;
     Severity severity;
 
@@ -81,6 +82,13 @@ public:
     }
 };
 
+    /// Receives the diagnostics reported to a DiagnosticSink as Diagnostic records, rather than as formatted text.
+class DiagnosticListener
+{
+public:
+    virtual void handleDiagnostic(Diagnostic const& diagnostic) = 0;
+};
+
 class Name;
 
 void printDiagnosticArg(StringBuilder& sb, char const* str);
@@ -202,6 +210,10 @@ public:
     void diagnoseRaw(Severity severity, char const* message);
     void diagnoseRaw(Severity severity, const UnownedStringSlice& message);
 
+        /// Output the diagnostics held in the outputBuffer of sink, and add its error count.
+        /// Used to add diagnostics that were buffered (for example on another thread) in a deterministic order.
+    void outputBufferedDiagnostics(DiagnosticSink* sink);
+
         /// During propagation of an exception for an internal
         /// error, note that this source location was involved
     void noteInternalErrorLoc(SourceLoc const& loc);
@@ -245,6 +257,11 @@ public:
     void setParentSink(DiagnosticSink* parentSink) { m_parentSink = parentSink; }
     DiagnosticSink* getParentSink() const { return m_parentSink; }
 
+        /// Set a listener for diagnostics. If set, diagnostics with a location are passed to the listener
+        /// instead of being formatted, and aren't passed to the parent sink. Raw diagnostics are unaffected.
+    void setListener(DiagnosticListener* listener) { m_listener = listener; }
+    DiagnosticListener* getListener() const { return m_listener; }
+
         /// Reset state.
         /// Resets error counts. Resets the output buffer.
     void reset();
@@ -277,6 +294,8 @@ protected:
         /// If set all diagnostics (as formatted by *this* sink, will be routed to the parent).
     DiagnosticSink* m_parentSink = nullptr;
 
+    DiagnosticListener* m_listener = nullptr;
+
     int m_errorCount = 0;
     int m_internalErrorLocsNoted = 0;
 
@@ -24,6 +24,8 @@
 #include "slang-glslang-compiler.h"
 #include "slang-llvm-compiler.h"
 
+#include "slang-downstream-product-cache.h"
+
 namespace Slang
 {
 
@@ -423,6 +425,70 @@ static bool _isContentsInFile(const DownstreamCompiler::CompileOptions& options)
     return false;
 }
 
+SlangResult CommandLineDownstreamCompiler::calcProductCacheKey(const CompileOptions& options, String& outKey)
+{
+    // Only products that are a single file can be cached. With debug information the product may
+    // refer to other files produced by the compilation (such as a .pdb).
+    switch (options.targetType)
+    {
+        case SLANG_SHADER_SHARED_LIBRARY:
+        case SLANG_SHADER_HOST_CALLABLE:
+        case SLANG_HOST_HOST_CALLABLE:
+        case SLANG_OBJECT_CODE:
+        {
+            break;
+        }
+        default: return SLANG_E_NOT_AVAILABLE;
+    }
+    if (options.debugInfoType != DebugInfoType::None)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    // The key covers the source contents, and the files it includes by path, so the source must not be
+    // able to include files through include paths.
+    if (options.sourceContents.getLength() == 0 ||
+        options.sourceFiles.getCount() ||
+        options.includePaths.getCount() ||
+        _isContentsInFile(options))
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    // The args contain the paths of the temporary files used for a compilation, so calculate them
+    // with fixed paths instead.
+    CompileOptions keyOptions(options);
+    keyOptions.modulePath = "slang-product";
+    keyOptions.sourceContents = String();
+    keyOptions.sourceContentsPath = String();
+    keyOptions.sourceFiles.add((options.sourceLanguage == SLANG_SOURCE_LANGUAGE_C) ? "slang-product-src.c" : "slang-product-src.cpp");
+
+    CommandLine cmdLine(m_cmdLine);
+    SLANG_RETURN_ON_FAIL(calcArgs(keyOptions, cmdLine));
+
+    StringBuilder key;
+    key << "version: " << DownstreamProductCache::kVersion << "\n";
+
+    key << "compiler: ";
+    m_desc.appendAsText(key);
+    key << "\n";
+
+    key << "command-line: ";
+    cmdLine.append(key);
+    key << "\n";
+
+    // The size and hash of the source identifies it, without the key having to contain it
+    key << "source: " << options.sourceContents.getLength() << " ";
+    key.append(uint64_t(getStableHashCode64(options.sourceContents.getBuffer(), size_t(options.sourceContents.getLength()))), 16);
+    key << "\n";
+
+    // The source typically includes the prelude by its path
+    DownstreamProductCache::appendIncludesToKey(options.sourceContents.getUnownedSlice(), key);
+
+    outKey = key.ProduceString();
+    return SLANG_OK;
+}
+
 SlangResult CommandLineDownstreamCompiler::compile(const CompileOptions& inOptions, RefPtr<DownstreamCompileResult>& out)
 {
     // Copy the command line options
@@ -432,8 +498,42 @@ SlangResult CommandLineDownstreamCompiler::compile(const CompileOptions& inOptio
 
     // Find all the files that will be produced
     RefPtr<TemporaryFileSet> productFileSet(new TemporaryFileSet);
-    
-    
+
+    // If the product of an identical compilation is cached, use it rather than invoking the compiler
+    auto productCache = DownstreamProductCache::getSingleton();
+    String productCacheKey;
+
+    // Code compiled for the host CPU (with -march=native) can use instructions that another CPU doesn't
+    // have, so is only held in memory, and isn't shared with other processes (possibly on another
+    // machine) through the directory.
+    const String productCacheDirectory = (options.flags & CompileOptions::Flag::TargetHostCPU) ? String() : options.cacheDirectory;
+
+    if (SLANG_SUCCEEDED(calcProductCacheKey(options, productCacheKey)))
+    {
+        List<uint8_t> product;
+        if (SLANG_SUCCEEDED(productCache->find(productCacheKey, productCacheDirectory, product)))
+        {
+            if (options.modulePath.getLength() == 0)
+            {
+                String temporaryLockPath;
+                SLANG_RETURN_ON_FAIL(File::generateTemporary(UnownedStringSlice::fromLiteral("slang-generated"), temporaryLockPath));
+                productFileSet->add(temporaryLockPath);
+
+                options.modulePath = temporaryLockPath;
+            }
+
+            StringBuilder moduleFilePath;
+            SLANG_RETURN_ON_FAIL(calcModuleFilePath(options, moduleFilePath));
+
+            productFileSet->add(moduleFilePath);
+            SLANG_RETURN_ON_FAIL(File::writeAllBytes(moduleFilePath, product.getBuffer(), size_t(product.getCount())));
+
+            // Only compilations without diagnostics are cached, so there are none to report
+            out = new CommandLineDownstreamCompileResult(DownstreamDiagnostics(), moduleFilePath, productFileSet);
+            return SLANG_OK;
+        }
+    }
+
     if (options.modulePath.getLength() == 0 || options.sourceContents.getLength() != 0)
     {
         String modulePath = options.modulePath;
@@ -525,6 +625,20 @@ SlangResult CommandLineDownstreamCompiler::compile(const CompileOptions& inOptio
     DownstreamDiagnostics diagnostics;
     SLANG_RETURN_ON_FAIL(parseOutput(exeRes, diagnostics));
 
+    // Cache the product, if the compilation succeeded without any diagnostics (the diagnostics aren't cached).
+    // Failing to add it doesn't fail the compilation.
+    if (productCacheKey.getLength() &&
+        exeRes.resultCode == 0 &&
+        SLANG_SUCCEEDED(diagnostics.result) &&
+        diagnostics.diagnostics.getCount() == 0)
+    {
+        List<uint8_t> product;
+        if (SLANG_SUCCEEDED(File::readAllBytes(moduleFilePath, product)) && product.getCount())
+        {
+            productCache->add(productCacheKey, productCacheDirectory, product.getBuffer(), size_t(product.getCount()));
+        }
+    }
+
     out = new CommandLineDownstreamCompileResult(diagnostics, moduleFilePath, productFileSet);
     
     return SLANG_OK;
@@ -294,6 +294,8 @@ public:
                 Verbose                 = 0x02,             ///< Give more verbose diagnostics
                 EnableSecurityChecks    = 0x04,             ///< Enable runtime security checks (such as for buffer overruns) - enabling typically decreases performance
                 EnableFloat16           = 0x08,             ///< If set compiles with support for float16/half
+                EnableVectorization     = 0x10,             ///< Auto vectorize loops, even if the optimization level would not typically do so
+                TargetHostCPU           = 0x20,             ///< The output will only run on the host, so can use all of the host CPUs instruction set
             };
         };
 
@@ -347,6 +349,10 @@ public:
             /// NOTE! Not all downstream compilers can use the fileSystemExt/sourceManager. This option will be ignored in those scenarios.
         ISlangFileSystemExt* fileSystemExt = nullptr;
         SourceManager* sourceManager = nullptr;
+
+            /// If set, a command line compiler stores its products in this directory, such that a later compilation
+            /// (in this or another process) of the same source with the same options can use them (see `DownstreamProductCache`)
+        String cacheDirectory;
     };
 
     typedef uint32_t ProductFlags;
@@ -447,6 +453,10 @@ public:
     virtual SlangResult calcArgs(const CompileOptions& options, CommandLine& cmdLine) = 0;
     virtual SlangResult parseOutput(const ExecuteResult& exeResult, DownstreamDiagnostics& output) = 0;
 
+        /// Calculates the key used to look up the product of compiling with options in the `DownstreamProductCache`.
+        /// Returns SLANG_E_NOT_AVAILABLE if the product cannot be cached.
+    SlangResult calcProductCacheKey(const CompileOptions& options, String& outKey);
+
     CommandLineDownstreamCompiler(const Desc& desc, const ExecutableLocation& exe) :
         Super(desc)
     {
@@ -0,0 +1,252 @@
+// slang-downstream-product-cache.cpp
+#include "slang-downstream-product-cache.h"
+
+#include "../core/slang-io.h"
+#include "../core/slang-process.h"
+#include "../core/slang-stream.h"
+#include "../core/slang-string-util.h"
+#include "../core/slang-hash.h"
+
+namespace Slang
+{
+
+/* static */String DownstreamProductCache::calcEntryPath(const String& directory, const String& key)
+{
+    StringBuilder fileName;
+    fileName.append(uint64_t(getStableHashCode64(key.getBuffer(), size_t(key.getLength()))), 16);
+    fileName << ".slang-product";
+    return Path::combine(directory, fileName);
+}
+
+// Append the files included by `contents` (of a file in `directory`, or empty for the source) to the key.
+static void _appendIncludesToKey(
+    const UnownedStringSlice& contents,
+    const String& directory,
+    HashSet<String>& ioVisitedPaths,
+    StringBuilder& ioKey)
+{
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(contents, lines);
+
+    for (auto line : lines)
+    {
+        // Find `#include "path"`. Includes inside conditionals are found too, which can only make
+        // the key cover more than it needs to.
+        line = line.trim();
+        if (!line.startsWith(UnownedStringSlice::fromLiteral("#")))
+        {
+            continue;
+        }
+        line = line.tail(1).trim();
+        if (!line.startsWith(UnownedStringSlice::fromLiteral("include")))
+        {
+            continue;
+        }
+        line = line.tail(7).trim();
+        if (!line.startsWith(UnownedStringSlice::fromLiteral("\"")))
+        {
+            continue;
+        }
+        line = line.tail(1);
+        const Index endIndex = line.indexOf('"');
+        if (endIndex < 0)
+        {
+            continue;
+        }
+        const UnownedStringSlice includePath = line.head(endIndex);
+
+        // The source is compiled from a temporary file, so a relative include in it can't be found
+        String path;
+        if (Path::isAbsolute(includePath))
+        {
+            path = includePath;
+        }
+        else if (directory.getLength())
+        {
+            path = Path::combine(directory, includePath);
+        }
+        else
+        {
+            ioKey << "include: " << includePath << " unresolved\n";
+            continue;
+        }
+
+        String canonicalPath;
+        if (SLANG_FAILED(Path::getCanonical(path, canonicalPath)))
+        {
+            canonicalPath = path;
+        }
+        if (!ioVisitedPaths.Add(canonicalPath))
+        {
+            continue;
+        }
+
+        ioKey << "include: " << canonicalPath << " ";
+        String includeContents;
+        if (SLANG_FAILED(File::readAllText(canonicalPath, includeContents)))
+        {
+            ioKey << "missing\n";
+            continue;
+        }
+        ioKey << includeContents.getLength() << " ";
+        ioKey.append(uint64_t(getStableHashCode64(includeContents.getBuffer(), size_t(includeContents.getLength()))), 16);
+        ioKey << "\n";
+
+        _appendIncludesToKey(includeContents.getUnownedSlice(), Path::getParentDirectory(canonicalPath), ioVisitedPaths, ioKey);
+    }
+}
+
+/* static */void DownstreamProductCache::appendIncludesToKey(const UnownedStringSlice& source, StringBuilder& ioKey)
+{
+    HashSet<String> visitedPaths;
+    _appendIncludesToKey(source, String(), visitedPaths, ioKey);
+}
+
+/* static */DownstreamProductCache* DownstreamProductCache::getSingleton()
+{
+    static DownstreamProductCache s_cache;
+    return &s_cache;
+}
+
+void DownstreamProductCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_products = Dictionary<String, List<uint8_t>>();
+    m_addedKeys.clear();
+    m_memorySize = 0;
+}
+
+void DownstreamProductCache::_addToMemory(const String& key, const void* product, size_t productSize)
+{
+    // A product that is larger than the whole cache isn't held
+    if (productSize > kMaxMemorySize || m_products.ContainsKey(key))
+    {
+        return;
+    }
+
+    // Remove the least recently added products, until there is space
+    Index removeCount = 0;
+    while (m_memorySize + productSize > kMaxMemorySize)
+    {
+        const String& removeKey = m_addedKeys[removeCount++];
+        m_memorySize -= size_t(m_products.TryGetValue(removeKey)->getCount());
+        m_products.Remove(removeKey);
+    }
+    m_addedKeys.removeRange(0, removeCount);
+
+    List<uint8_t> contents;
+    contents.addRange((const uint8_t*)product, Index(productSize));
+    m_products.Add(String(key), _Move(contents));
+    m_addedKeys.add(key);
+    m_memorySize += productSize;
+}
+
+SlangResult DownstreamProductCache::find(const String& key, const String& directory, List<uint8_t>& outProduct)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (auto product = m_products.TryGetValue(key))
+        {
+            outProduct = *product;
+            return SLANG_OK;
+        }
+    }
+
+    if (directory.getLength() == 0)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    const String path = calcEntryPath(directory, key);
+    if (!File::exists(path))
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    List<uint8_t> contents;
+    SLANG_RETURN_ON_FAIL(File::readAllBytes(path, contents));
+
+    MemoryStreamBase stream(FileAccess::Read, contents.getBuffer(), contents.getCount());
+
+    RiffContainer container;
+    SLANG_RETURN_ON_FAIL(RiffUtil::read(&stream, container));
+
+    RiffContainer::ListChunk* entryChunk = container.getRoot();
+    if (!entryChunk || entryChunk->m_fourCC != kEntryFourCC)
+    {
+        return SLANG_FAIL;
+    }
+
+    // The key must match exactly. If it doesn't it's a collision, or a stale entry.
+    auto keyData = entryChunk->findContainedData(kKeyFourCC);
+    if (!keyData || UnownedStringSlice((const char*)keyData->getPayload(), keyData->getSize()) != key.getUnownedSlice())
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    auto productData = entryChunk->findContainedData(kProductFourCC);
+    if (!productData)
+    {
+        return SLANG_FAIL;
+    }
+
+    outProduct.clear();
+    outProduct.addRange((const uint8_t*)productData->getPayload(), Index(productData->getSize()));
+
+    // Hold in memory, so later finds in this process don't need to read the entry
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        _addToMemory(key, outProduct.getBuffer(), size_t(outProduct.getCount()));
+    }
+    return SLANG_OK;
+}
+
+SlangResult DownstreamProductCache::add(const String& key, const String& directory, const void* product, size_t productSize)
+{
+    // The container doesn't allow zero sized writes
+    if (productSize == 0)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        _addToMemory(key, product, productSize);
+    }
+
+    if (directory.getLength() == 0)
+    {
+        return SLANG_OK;
+    }
+
+    RiffContainer container;
+    {
+        RiffContainer::ScopeChunk entryScope(&container, RiffContainer::Chunk::Kind::List, kEntryFourCC);
+        container.addDataChunk(kKeyFourCC, key.getBuffer(), size_t(key.getLength()));
+        container.addDataChunk(kProductFourCC, product, productSize);
+    }
+
+    OwnedMemoryStream stream(FileAccess::Write);
+    SLANG_RETURN_ON_FAIL(RiffUtil::write(&container, &stream));
+
+    const String path = calcEntryPath(directory, key);
+
+    // Other processes may be writing or reading the same entry concurrently, so write to a
+    // temporary file, and then replace the entry in a single operation.
+    StringBuilder tempPath;
+    tempPath << path << "." << uint64_t(Process::getClockTick()) << "." << uint64_t(size_t(product)) << ".tmp";
+
+    Path::createDirectory(directory);
+
+    auto streamContents = stream.getContents();
+    SLANG_RETURN_ON_FAIL(File::writeAllBytes(tempPath, streamContents.getBuffer(), size_t(streamContents.getCount())));
+
+    if (SLANG_FAILED(File::rename(tempPath, path)))
+    {
+        File::remove(tempPath);
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+} // namespace Slang
@@ -0,0 +1,73 @@
+// slang-downstream-product-cache.h
+#ifndef SLANG_DOWNSTREAM_PRODUCT_CACHE_H
+#define SLANG_DOWNSTREAM_PRODUCT_CACHE_H
+
+#include "../core/slang-riff.h"
+#include "../core/slang-dictionary.h"
+#include "../core/slang-string.h"
+
+#include <mutex>
+
+namespace Slang
+{
+
+/* A cache of the products (such as shared libraries) of compilations performed by command line downstream compilers.
+
+Invoking a C/C++ compiler as a process typically takes far longer than the rest of a compilation, so if the same
+source is compiled with the same options, the product of a previous compilation is used instead.
+
+A product is looked up via a 'key', which is text that identifies the compiler, the arguments passed to it and the source
+compiled. The cache is held in memory for the whole process, so is shared between all sessions. If a directory is
+specified, products are also stored in, and looked up from files in the directory, such that they can be reused by other
+processes.
+
+An entry in the directory is a RIFF file, named by a hash of the key. The entry holds the whole key, which must match
+for the entry to be used, and so a hash collision can only cause a cache miss. */
+class DownstreamProductCache
+{
+public:
+    static const FourCC kEntryFourCC = SLANG_FOUR_CC('S', 'd', 'p', 'c');       ///< A cache entry
+    static const FourCC kKeyFourCC = SLANG_FOUR_CC('S', 'd', 'k', 'y');         ///< The key text
+    static const FourCC kProductFourCC = SLANG_FOUR_CC('S', 'd', 'p', 'r');     ///< The contents of the product
+
+        /// Change if the format of the key or entries changes
+    static const uint32_t kVersion = 2;
+
+        /// The total size of products held in memory, before the least recently added are removed
+    static const size_t kMaxMemorySize = 64 * 1024 * 1024;
+
+        /// Find the product for the key. Looks in memory, and then in the directory (if not empty).
+        /// Returns SLANG_E_NOT_FOUND if there is no product for the key.
+    SlangResult find(const String& key, const String& directory, List<uint8_t>& outProduct);
+        /// Add the product for the key. It is held in memory, and written to the directory (if not empty).
+    SlangResult add(const String& key, const String& directory, const void* product, size_t productSize);
+
+        /// Remove all products held in memory
+    void clear();
+
+        /// Get the path of the entry for key in the directory
+    static String calcEntryPath(const String& directory, const String& key);
+
+        /// Append the path, size and hash of each file `source` includes with a quoted `#include` (such as a
+        /// prelude included by its path) to the key, and of the files they include in turn. The compiler's own
+        /// headers are included with <>, and so aren't part of the key.
+    static void appendIncludesToKey(const UnownedStringSlice& source, StringBuilder& ioKey);
+
+        /// Get the cache shared by the process
+    static DownstreamProductCache* getSingleton();
+
+protected:
+    void _addToMemory(const String& key, const void* product, size_t productSize);
+
+    std::mutex m_mutex;
+
+    Dictionary<String, List<uint8_t>> m_products;
+        /// The keys of m_products in the order they were added
+    List<String> m_addedKeys;
+        /// The total size of the products in m_products
+    size_t m_memorySize = 0;
+};
+
+} // namespace Slang
+
+#endif
@@ -499,7 +499,8 @@ static SlangResult _parseGCCFamilyLine(const UnownedStringSlice& line, LineParse
         }
         case OptimizationLevel::Default:
         {
-            cmdLine.addArg("-Os");
+            // -Os doesn't inline enough for vectorized loops to be of benefit
+            cmdLine.addArg((options.flags & CompileOptions::Flag::EnableVectorization) ? "-O2" : "-Os");
             break;
         }
         case OptimizationLevel::High:
@@ -515,6 +516,27 @@ static SlangResult _parseGCCFamilyLine(const UnownedStringSlice& line, LineParse
         default: break;
     }
 
+    if (options.flags & CompileOptions::Flag::EnableVectorization)
+    {
+        if (options.optimizationLevel != OptimizationLevel::None)
+        {
+            cmdLine.addArg("-ftree-vectorize");
+        }
+
+        // Vectorize loops marked `omp simd`, regardless of the cost model (without linking OpenMP)
+        cmdLine.addArg("-fopenmp-simd");
+
+        // Floating point operations can't trap in shader code, so both sides of a branch can be executed
+        // and the results selected, which is necessary to vectorize loops with divergent control flow
+        cmdLine.addArg("-fno-trapping-math");
+    }
+
+    if (options.flags & CompileOptions::Flag::TargetHostCPU)
+    {
+        // Allows use of the widest SIMD instructions the host supports
+        cmdLine.addArg("-march=native");
+    }
+
     if (options.debugInfoType != DebugInfoType::None)
     {
         cmdLine.addArg("-g");
@@ -560,6 +582,13 @@ static SlangResult _parseGCCFamilyLine(const UnownedStringSlice& line, LineParse
                 // Position independent
                 cmdLine.addArg("-fPIC");
             }
+            if (PlatformUtil::isFamily(PlatformFamily::Linux, platformKind))
+            {
+                // Calls within the library bind to its own functions. Libraries are loaded with RTLD_GLOBAL,
+                // so otherwise a call to an exported function (such as an entry point's `_Group` function) could
+                // resolve to a function of the same name in a library loaded before, and not be inlined.
+                cmdLine.addArg("-Wl,-Bsymbolic");
+            }
             break;
         }
         case SLANG_HOST_EXECUTABLE:
@@ -150,6 +150,9 @@ public:
 
     HTTPPacketConnection* getUnderlyingConnection() { return m_connection.Ptr(); }
 
+        /// Get the backing process (if there is one)
+    Process* getProcess() { return m_process.Ptr(); }
+
         /// Dtor
     ~JSONRPCConnection() { disconnect(); }
 
@@ -616,6 +616,76 @@ static const StructRttiInfo _makeRegistrationParamsRtti()
 }
 const StructRttiInfo RegistrationParams::g_rttiInfo = _makeRegistrationParamsRtti();
 
+static const StructRttiInfo _makeFileEventRtti()
+{
+    FileEvent obj;
+    StructRttiBuilder builder(&obj, "LanguageServerProtocol::FileEvent", nullptr);
+    builder.addField("uri", &obj.uri);
+    builder.addField("type", &obj.type);
+    builder.ignoreUnknownFields();
+    return builder.make();
+}
+const StructRttiInfo FileEvent::g_rttiInfo = _makeFileEventRtti();
+
+static const StructRttiInfo _makeDidChangeWatchedFilesParamsRtti()
+{
+    DidChangeWatchedFilesParams obj;
+    StructRttiBuilder builder(&obj, "LanguageServerProtocol::DidChangeWatchedFilesParams", nullptr);
+    builder.addField("changes", &obj.changes);
+    builder.ignoreUnknownFields();
+    return builder.make();
+}
+const StructRttiInfo DidChangeWatchedFilesParams::g_rttiInfo = _makeDidChangeWatchedFilesParamsRtti();
+const UnownedStringSlice DidChangeWatchedFilesParams::methodName =
+    UnownedStringSlice::fromLiteral("workspace/didChangeWatchedFiles");
+
+static const StructRttiInfo _makeFileSystemWatcherRtti()
+{
+    FileSystemWatcher obj;
+    StructRttiBuilder builder(&obj, "LanguageServerProtocol::FileSystemWatcher", nullptr);
+    builder.addField("globPattern", &obj.globPattern);
+    builder.ignoreUnknownFields();
+    return builder.make();
+}
+const StructRttiInfo FileSystemWatcher::g_rttiInfo = _makeFileSystemWatcherRtti();
+
+static const StructRttiInfo _makeDidChangeWatchedFilesRegistrationOptionsRtti()
+{
+    DidChangeWatchedFilesRegistrationOptions obj;
+    StructRttiBuilder builder(
+        &obj, "LanguageServerProtocol::DidChangeWatchedFilesRegistrationOptions", nullptr);
+    builder.addField("watchers", &obj.watchers);
+    builder.ignoreUnknownFields();
+    return builder.make();
+}
+const StructRttiInfo DidChangeWatchedFilesRegistrationOptions::g_rttiInfo =
+    _makeDidChangeWatchedFilesRegistrationOptionsRtti();
+
+static const StructRttiInfo _makeDidChangeWatchedFilesRegistrationRtti()
+{
+    DidChangeWatchedFilesRegistration obj;
+    StructRttiBuilder builder(&obj, "LanguageServerProtocol::DidChangeWatchedFilesRegistration", nullptr);
+    builder.addField("id", &obj.id);
+    builder.addField("method", &obj.method);
+    builder.addField("registerOptions", &obj.registerOptions);
+    builder.ignoreUnknownFields();
+    return builder.make();
+}
+const StructRttiInfo DidChangeWatchedFilesRegistration::g_rttiInfo =
+    _makeDidChangeWatchedFilesRegistrationRtti();
+
+static const StructRttiInfo _makeDidChangeWatchedFilesRegistrationParamsRtti()
+{
+    DidChangeWatchedFilesRegistrationParams obj;
+    StructRttiBuilder builder(
+        &obj, "LanguageServerProtocol::DidChangeWatchedFilesRegistrationParams", nullptr);
+    builder.addField("registrations", &obj.registrations);
+    builder.ignoreUnknownFields();
+    return builder.make();
+}
+const StructRttiInfo DidChangeWatchedFilesRegistrationParams::g_rttiInfo =
+    _makeDidChangeWatchedFilesRegistrationParamsRtti();
+
 static const StructRttiInfo _makeCancelParamsRtti()
 {
     CancelParams obj;
@@ -853,6 +853,82 @@ struct RegistrationParams
     static const StructRttiInfo g_rttiInfo;
 };
 
+/**
+ * The file event types.
+ */
+const int kFileChangeTypeCreated = 1;
+const int kFileChangeTypeChanged = 2;
+const int kFileChangeTypeDeleted = 3;
+
+/**
+ * An event describing a file change.
+ */
+struct FileEvent
+{
+    /**
+     * The file's URI.
+     */
+    String uri;
+
+    /**
+     * The change type. See kFileChangeType*.
+     */
+    int type = 0;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+struct DidChangeWatchedFilesParams
+{
+    /**
+     * The actual file events.
+     */
+    List<FileEvent> changes;
+
+    static const StructRttiInfo g_rttiInfo;
+
+    static const UnownedStringSlice methodName;
+};
+
+struct FileSystemWatcher
+{
+    /**
+     * The glob pattern to watch.
+     */
+    String globPattern;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+struct DidChangeWatchedFilesRegistrationOptions
+{
+    /**
+     * The watchers to register.
+     */
+    List<FileSystemWatcher> watchers;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+/**
+ * A `Registration` of `workspace/didChangeWatchedFiles`, which has options.
+ */
+struct DidChangeWatchedFilesRegistration
+{
+    String id;
+    String method;
+    DidChangeWatchedFilesRegistrationOptions registerOptions;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+struct DidChangeWatchedFilesRegistrationParams
+{
+    List<DidChangeWatchedFilesRegistration> registrations;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
 struct CancelParams
 {
     /**
@@ -680,6 +680,11 @@ void SourceManager::addSourceFile(const String& uniqueIdentity, SourceFile* sour
     m_sourceFileMap.Add(uniqueIdentity, sourceFile);
 }
 
+void SourceManager::removeSourceFile(const String& uniqueIdentity)
+{
+    m_sourceFileMap.Remove(uniqueIdentity);
+}
+
 HumaneSourceLoc SourceManager::getHumaneLoc(SourceLoc loc, SourceLocType type)
 {
     SourceView* sourceView = findSourceViewRecursively(loc);
@@ -426,6 +426,10 @@ struct SourceManager
 
         /// Add a source file, uniqueIdentity must be unique for this manager AND any parents
     void addSourceFile(const String& uniqueIdentity, SourceFile* sourceFile);
+        /// Remove the source file associated with uniqueIdentity on this manager, so the file will be loaded
+        /// again when it is next needed. The source file is still owned by (and its locations are still valid
+        /// in) the manager.
+    void removeSourceFile(const String& uniqueIdentity);
 
         /// Get the slice pool
     StringSlicePool& getStringSlicePool() { return m_slicePool; }
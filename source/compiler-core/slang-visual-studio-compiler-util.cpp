@@ -170,6 +170,9 @@ namespace Slang
         default: break;
     }
 
+    // NOTE! EnableVectorization is not handled, because VS auto vectorizes loops when optimizing.
+    // There is no equivalent of TargetHostCPU (/arch requires naming a specific instruction set), so it is ignored.
+
     switch (options.floatingPointMode)
     {
         case FloatingPointMode::Default: break;
@@ -0,0 +1,589 @@
+#ifndef SLANG_CORE_FLAT_DICTIONARY_H
+#define SLANG_CORE_FLAT_DICTIONARY_H
+
+#include "slang-common.h"
+#include "slang-hash.h"
+
+#include <new>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define SLANG_FLAT_DICTIONARY_USE_SSE2 1
+#   include <emmintrin.h>
+#else
+#   define SLANG_FLAT_DICTIONARY_USE_SSE2 0
+#endif
+
+#if SLANG_VC
+#   include <intrin.h>
+#endif
+
+namespace Slang
+{
+
+/* Control bytes and group operations used by FlatDictionary.
+
+Each slot in the table has a control byte. A full slot holds 7 bits of the hash of its key (so is 0-127),
+and empty and deleted slots have the top bit set. The slots are split into groups of kWidth, and
+the control bytes of a whole group are tested at once, producing a bit mask with a bit set for each slot
+in the group that matches. */
+struct FlatDictionaryGroup
+{
+    typedef uint32_t Mask;
+
+    static const Index kWidth = 16;
+
+    static const int8_t kEmpty = -128;
+    static const int8_t kDeleted = -2;
+
+        /// Get a mask of the slots in the group with the control byte `h2`
+    SLANG_FORCE_INLINE static Mask match(const int8_t* ctrl, int8_t h2)
+    {
+#if SLANG_FLAT_DICTIONARY_USE_SSE2
+        const __m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+        return Mask(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), group)));
+#else
+        Mask mask = 0;
+        for (Index i = 0; i < kWidth; ++i)
+        {
+            mask |= Mask(ctrl[i] == h2) << i;
+        }
+        return mask;
+#endif
+    }
+
+        /// Get a mask of the empty slots in the group
+    SLANG_FORCE_INLINE static Mask matchEmpty(const int8_t* ctrl) { return match(ctrl, kEmpty); }
+
+        /// Get a mask of the slots in the group that are empty or deleted
+    SLANG_FORCE_INLINE static Mask matchEmptyOrDeleted(const int8_t* ctrl)
+    {
+#if SLANG_FLAT_DICTIONARY_USE_SSE2
+        // Only the empty and deleted control bytes have the top bit set
+        return Mask(_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)ctrl)));
+#else
+        Mask mask = 0;
+        for (Index i = 0; i < kWidth; ++i)
+        {
+            mask |= Mask(ctrl[i] < 0) << i;
+        }
+        return mask;
+#endif
+    }
+
+        /// Get the index of the lowest set bit. `mask` must not be 0.
+    SLANG_FORCE_INLINE static Index getFirstIndex(Mask mask)
+    {
+        SLANG_ASSERT(mask);
+#if SLANG_VC
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return Index(index);
+#else
+        return Index(__builtin_ctz(mask));
+#endif
+    }
+};
+
+template <typename TKey, typename TValue>
+struct FlatDictionaryEntry
+{
+    template <typename K, typename... Args>
+    FlatDictionaryEntry(K&& key, Args&&... args):
+        Key(std::forward<K>(key)),
+        Value(std::forward<Args>(args)...)
+    {
+    }
+
+    TKey Key;
+    TValue Value;
+};
+
+/* A hash map that uses open addressing, with the slots split into groups that are probed together
+(a 'Swiss table').
+
+A lookup uses the hash to find the first group to probe, and to produce a 7 bit value that is compared with the
+control bytes of all of the slots in the group at once (with SSE2 where available). Keys are only compared
+for slots where the 7 bits match. If the group has an empty slot, the key can't be in a later group, otherwise the
+next group in the probe sequence is tested.
+
+The entries are held in a single allocation with the control bytes, and are only constructed for used slots.
+
+Lookups are templated on the key type, so can use any type that has a hash code consistent with `TKey`, and can
+be compared with `==`. For example a `String` key can be looked up with an `UnownedStringSlice`.
+
+The interface follows `Dictionary`, so it can be used in its place. The differences are that operator[] returns a
+reference to the value (adding a default constructed value if the key isn't found), the iteration order is
+different, and that values can be constructed in place with `TryEmplace` and `GetOrEmplace`.
+
+Adding entries can move the entries in memory, so invalidates pointers to values and iterators. */
+template <typename TKey, typename TValue>
+class FlatDictionary
+{
+public:
+    typedef FlatDictionary ThisType;
+    typedef TKey KeyType;
+    typedef TValue ValueType;
+    typedef FlatDictionaryEntry<TKey, TValue> Entry;
+    typedef FlatDictionaryGroup Group;
+
+    class Iterator
+    {
+    public:
+        Entry& operator*() const { return m_dict->m_entries[m_index]; }
+        Entry* operator->() const { return m_dict->m_entries + m_index; }
+        Iterator& operator++()
+        {
+            m_index = m_dict->_findUsedIndex(m_index + 1);
+            return *this;
+        }
+        Iterator operator++(int)
+        {
+            Iterator rs = *this;
+            operator++();
+            return rs;
+        }
+        bool operator==(const Iterator& rhs) const { return m_index == rhs.m_index && m_dict == rhs.m_dict; }
+        bool operator!=(const Iterator& rhs) const { return !(*this == rhs); }
+
+        Iterator(const ThisType* dict, Index index): m_dict(dict), m_index(index) {}
+        Iterator(): m_dict(nullptr), m_index(0) {}
+
+    protected:
+        const ThisType* m_dict;
+        Index m_index;
+    };
+
+    Iterator begin() const { return Iterator(this, _findUsedIndex(0)); }
+    Iterator end() const { return Iterator(this, m_capacity); }
+
+        /// Get the amount of entries
+    Index Count() const { return m_count; }
+    Index getCount() const { return m_count; }
+
+        /// Add the key and value. The key must not already be in the dictionary.
+    template <typename K, typename V>
+    void Add(K&& key, V&& value)
+    {
+        if (!TryEmplace(std::forward<K>(key), std::forward<V>(value)))
+        {
+            SLANG_ASSERT_FAILURE("The key already exists in Dictionary.");
+        }
+    }
+        /// Add the key and value if the key isn't already in the dictionary. Returns true if it was added.
+    template <typename K, typename V>
+    bool AddIfNotExists(K&& key, V&& value) { return TryEmplace(std::forward<K>(key), std::forward<V>(value)); }
+
+        /// If the key isn't in the dictionary, add it, with the value constructed in place from `args`.
+        /// Returns true if it was added.
+    template <typename K, typename... Args>
+    bool TryEmplace(K&& key, Args&&... args)
+    {
+        bool isNew;
+        const Index index = _findOrPrepareInsert(key, isNew);
+        if (isNew)
+        {
+            new (m_entries + index) Entry(std::forward<K>(key), std::forward<Args>(args)...);
+        }
+        return isNew;
+    }
+        /// Get the value for the key. If the key isn't in the dictionary, adds it with the value constructed in
+        /// place from `args`.
+    template <typename K, typename... Args>
+    TValue& GetOrEmplace(K&& key, Args&&... args)
+    {
+        bool isNew;
+        const Index index = _findOrPrepareInsert(key, isNew);
+        if (isNew)
+        {
+            new (m_entries + index) Entry(std::forward<K>(key), std::forward<Args>(args)...);
+        }
+        return m_entries[index].Value;
+    }
+
+        /// If the key is in the dictionary returns a pointer to its value, otherwise adds the key and value
+        /// and returns nullptr.
+    template <typename K>
+    TValue* TryGetValueOrAdd(K&& key, const TValue& value)
+    {
+        bool isNew;
+        const Index index = _findOrPrepareInsert(key, isNew);
+        if (isNew)
+        {
+            new (m_entries + index) Entry(std::forward<K>(key), value);
+            return nullptr;
+        }
+        return &m_entries[index].Value;
+    }
+        /// Get the value for the key, adding the key with `defaultValue` if it isn't in the dictionary.
+    template <typename K>
+    TValue& GetOrAddValue(K&& key, const TValue& defaultValue) { return GetOrEmplace(std::forward<K>(key), defaultValue); }
+
+        /// Set the value for the key, adding the key if it isn't in the dictionary.
+    template <typename K, typename V>
+    void Set(K&& key, V&& value)
+    {
+        bool isNew;
+        const Index index = _findOrPrepareInsert(key, isNew);
+        if (isNew)
+        {
+            new (m_entries + index) Entry(std::forward<K>(key), std::forward<V>(value));
+        }
+        else
+        {
+            m_entries[index].Value = std::forward<V>(value);
+        }
+    }
+
+        /// Get the value for the key, adding a default constructed value if it isn't in the dictionary.
+    TValue& operator[](const TKey& key) { return GetOrEmplace(key); }
+    TValue& operator[](TKey&& key) { return GetOrEmplace(_Move(key)); }
+
+    template <typename K>
+    bool ContainsKey(const K& key) const { return _findIndex(key) >= 0; }
+
+    template <typename K>
+    TValue* TryGetValue(const K& key) const
+    {
+        const Index index = _findIndex(key);
+        return (index >= 0) ? &m_entries[index].Value : nullptr;
+    }
+    template <typename K>
+    bool TryGetValue(const K& key, TValue& outValue) const
+    {
+        const Index index = _findIndex(key);
+        if (index >= 0)
+        {
+            outValue = m_entries[index].Value;
+            return true;
+        }
+        return false;
+    }
+
+        /// Remove the key (if it's in the dictionary)
+    template <typename K>
+    void Remove(const K& key)
+    {
+        const Index index = _findIndex(key);
+        if (index < 0)
+        {
+            return;
+        }
+
+        m_entries[index].~Entry();
+        m_count--;
+
+        // If the group has an empty slot, lookups stop at this group anyway, so the slot can be made empty.
+        // Otherwise it has to be marked as deleted, so lookups continue to probe past it.
+        const Index groupStart = index & ~(Group::kWidth - 1);
+        if (Group::matchEmpty(m_ctrl + groupStart))
+        {
+            m_ctrl[index] = Group::kEmpty;
+            m_growthLeft++;
+        }
+        else
+        {
+            m_ctrl[index] = Group::kDeleted;
+        }
+    }
+
+        /// Remove all of the entries. Keeps the allocated memory.
+    void Clear()
+    {
+        _destroyEntries();
+        _resetCtrl();
+    }
+
+        /// Make sure there is space for `count` entries without growing
+    void reserve(Index count)
+    {
+        if (count > m_count + m_growthLeft)
+        {
+            _rehash(_calcCapacity(count));
+        }
+    }
+
+    FlatDictionary() {}
+    FlatDictionary(const ThisType& rhs) { *this = rhs; }
+    FlatDictionary(ThisType&& rhs) { *this = _Move(rhs); }
+    ~FlatDictionary() { _free(); }
+
+    ThisType& operator=(const ThisType& rhs)
+    {
+        if (this != &rhs)
+        {
+            _free();
+            if (rhs.m_count)
+            {
+                _allocate(_calcCapacity(rhs.m_count));
+                for (const auto& entry : rhs)
+                {
+                    _addUnique(entry.Key, entry.Value);
+                }
+            }
+        }
+        return *this;
+    }
+    ThisType& operator=(ThisType&& rhs)
+    {
+        if (this != &rhs)
+        {
+            _free();
+            m_entries = rhs.m_entries;
+            m_ctrl = rhs.m_ctrl;
+            m_capacity = rhs.m_capacity;
+            m_count = rhs.m_count;
+            m_growthLeft = rhs.m_growthLeft;
+
+            rhs.m_entries = nullptr;
+            rhs.m_ctrl = nullptr;
+            rhs.m_capacity = 0;
+            rhs.m_count = 0;
+            rhs.m_growthLeft = 0;
+        }
+        return *this;
+    }
+
+protected:
+        /// Mix the hash code, as for example pointer hashes can have poor low bits
+    template <typename K>
+    SLANG_FORCE_INLINE static uint64_t _getHash(const K& key)
+    {
+        const uint64_t hash = uint64_t(uint32_t(getHashCode(const_cast<K&>(key)))) * 0x9E3779B97F4A7C15ull;
+        return hash ^ (hash >> 32);
+    }
+    SLANG_FORCE_INLINE static int8_t _getH2(uint64_t hash) { return int8_t(hash & 0x7f); }
+    SLANG_FORCE_INLINE Index _getGroupMask() const { return (m_capacity / Group::kWidth) - 1; }
+
+        /// The maximum amount of entries for a capacity (a load factor of 7/8)
+    static Index _getMaxCount(Index capacity) { return capacity - capacity / 8; }
+
+    static Index _calcCapacity(Index count)
+    {
+        Index capacity = Group::kWidth;
+        while (_getMaxCount(capacity) < count)
+        {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    Index _findUsedIndex(Index index) const
+    {
+        while (index < m_capacity && m_ctrl[index] < 0)
+        {
+            index++;
+        }
+        return index;
+    }
+
+    template <typename K>
+    Index _findIndex(const K& key) const
+    {
+        if (m_count == 0)
+        {
+            return -1;
+        }
+
+        const uint64_t hash = _getHash(key);
+        const int8_t h2 = _getH2(hash);
+        const Index groupMask = _getGroupMask();
+
+        // Probing by an increasing amount visits every group, as the amount of groups is a power of 2.
+        // The table always has an empty slot, so the loop terminates.
+        Index group = Index(hash >> 7) & groupMask;
+        for (Index probe = 1; ; ++probe)
+        {
+            const Index groupStart = group * Group::kWidth;
+            const int8_t* ctrl = m_ctrl + groupStart;
+
+            for (Group::Mask mask = Group::match(ctrl, h2); mask; mask &= mask - 1)
+            {
+                const Index index = groupStart + Group::getFirstIndex(mask);
+                if (m_entries[index].Key == key)
+                {
+                    return index;
+                }
+            }
+            if (Group::matchEmpty(ctrl))
+            {
+                return -1;
+            }
+            group = (group + probe) & groupMask;
+        }
+    }
+
+        /// Find the slot to insert an entry with the hash, and mark it as used. The entry must be constructed by the caller.
+    Index _prepareInsert(uint64_t hash)
+    {
+        const Index groupMask = _getGroupMask();
+        Index group = Index(hash >> 7) & groupMask;
+        for (Index probe = 1; ; ++probe)
+        {
+            const Index groupStart = group * Group::kWidth;
+            if (const Group::Mask mask = Group::matchEmptyOrDeleted(m_ctrl + groupStart))
+            {
+                const Index index = groupStart + Group::getFirstIndex(mask);
+                if (m_ctrl[index] == Group::kEmpty)
+                {
+                    m_growthLeft--;
+                }
+                m_ctrl[index] = _getH2(hash);
+                m_count++;
+                return index;
+            }
+            group = (group + probe) & groupMask;
+        }
+    }
+
+        /// Find the key, or if it isn't found, prepare a slot for it that the caller must construct the entry in
+    template <typename K>
+    Index _findOrPrepareInsert(const K& key, bool& outIsNew)
+    {
+        const Index index = _findIndex(key);
+        if (index >= 0)
+        {
+            outIsNew = false;
+            return index;
+        }
+
+        if (m_growthLeft == 0)
+        {
+            // If a lot of the slots are deleted, it's enough to rehash at the same size
+            _rehash((m_count * 2 <= _getMaxCount(m_capacity)) ? _calcCapacity(m_count + 1) : m_capacity * 2);
+        }
+
+        outIsNew = true;
+        return _prepareInsert(_getHash(key));
+    }
+
+    template <typename K, typename V>
+    void _addUnique(K&& key, V&& value)
+    {
+        const Index index = _prepareInsert(_getHash(key));
+        new (m_entries + index) Entry(std::forward<K>(key), std::forward<V>(value));
+    }
+
+    void _allocate(Index capacity)
+    {
+        SLANG_ASSERT(m_entries == nullptr && capacity % Group::kWidth == 0);
+
+        // The entries and then control bytes are held in a single allocation
+        void* memory = ::operator new(sizeof(Entry) * capacity + sizeof(int8_t) * capacity);
+        m_entries = (Entry*)memory;
+        m_ctrl = (int8_t*)(m_entries + capacity);
+        m_capacity = capacity;
+
+        _resetCtrl();
+    }
+
+    void _resetCtrl()
+    {
+        ::memset(m_ctrl, Group::kEmpty, size_t(m_capacity));
+        m_count = 0;
+        m_growthLeft = _getMaxCount(m_capacity);
+    }
+
+    void _rehash(Index capacity)
+    {
+        Entry* oldEntries = m_entries;
+        int8_t* oldCtrl = m_ctrl;
+        const Index oldCapacity = m_capacity;
+
+        m_entries = nullptr;
+        _allocate(capacity);
+
+        for (Index i = 0; i < oldCapacity; ++i)
+        {
+            if (oldCtrl[i] >= 0)
+            {
+                Entry& entry = oldEntries[i];
+                _addUnique(_Move(entry.Key), _Move(entry.Value));
+                entry.~Entry();
+            }
+        }
+
+        ::operator delete(oldEntries);
+    }
+
+    void _destroyEntries()
+    {
+        for (Index i = 0; i < m_capacity; ++i)
+        {
+            if (m_ctrl[i] >= 0)
+            {
+                m_entries[i].~Entry();
+            }
+        }
+    }
+
+    void _free()
+    {
+        if (m_entries)
+        {
+            _destroyEntries();
+            ::operator delete(m_entries);
+        }
+        m_entries = nullptr;
+        m_ctrl = nullptr;
+        m_capacity = 0;
+        m_count = 0;
+        m_growthLeft = 0;
+    }
+
+    Entry* m_entries = nullptr;
+    int8_t* m_ctrl = nullptr;
+    Index m_capacity = 0;               ///< Amount of slots. 0, or a power of 2 that is at least Group::kWidth
+    Index m_count = 0;                  ///< Amount of used slots
+    Index m_growthLeft = 0;             ///< Amount of empty slots that can be used before the table has to be rehashed
+};
+
+/* A set that uses a FlatDictionary. */
+template <typename T>
+class FlatHashSet
+{
+public:
+    typedef FlatHashSet ThisType;
+
+    struct Empty {};
+    typedef FlatDictionary<T, Empty> DictionaryType;
+
+    class Iterator
+    {
+    public:
+        const T& operator*() const { return m_iter->Key; }
+        const T* operator->() const { return &m_iter->Key; }
+        Iterator& operator++() { ++m_iter; return *this; }
+        bool operator==(const Iterator& rhs) const { return m_iter == rhs.m_iter; }
+        bool operator!=(const Iterator& rhs) const { return m_iter != rhs.m_iter; }
+
+        Iterator(const typename DictionaryType::Iterator& iter): m_iter(iter) {}
+
+    protected:
+        typename DictionaryType::Iterator m_iter;
+    };
+
+    Iterator begin() const { return Iterator(m_dict.begin()); }
+    Iterator end() const { return Iterator(m_dict.end()); }
+
+    Index Count() const { return m_dict.Count(); }
+    Index getCount() const { return m_dict.Count(); }
+
+        /// Add the value. Returns true if it was added, false if it was already in the set.
+    template <typename K>
+    bool Add(K&& value) { return m_dict.TryEmplace(std::forward<K>(value)); }
+    template <typename K>
+    void Remove(const K& value) { m_dict.Remove(value); }
+    template <typename K>
+    bool Contains(const K& value) const { return m_dict.ContainsKey(value); }
+
+    void Clear() { m_dict.Clear(); }
+    void reserve(Index count) { m_dict.reserve(count); }
+
+protected:
+    DictionaryType m_dict;
+};
+
+} // namespace Slang
+
+#endif
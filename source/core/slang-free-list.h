@@ -66,6 +66,9 @@ class FreeList
 		/// Deallocates all, and frees any backing memory (put in initial state)
 	void reset();
 
+		/// Swap the contents (including all allocations) with rhs
+	void swapWith(ThisType& rhs);
+
 		/// Initialize. If called on an already initialized heap, the heap will be deallocated.
 	void init(size_t elementSize, size_t alignment, size_t elemsPerBlock);
 	
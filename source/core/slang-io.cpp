@@ -60,6 +60,26 @@ namespace Slang
     }
 
 
+    /* static */SlangResult File::rename(const String& fromName, const String& toName)
+    {
+#ifdef _WIN32
+        // https://docs.microsoft.com/en-us/windows/win32/api/winbase/nf-winbase-movefileexa
+        if (MoveFileExA(fromName.getBuffer(), toName.getBuffer(), MOVEFILE_REPLACE_EXISTING))
+        {
+            return SLANG_OK;
+        }
+        return SLANG_FAIL;
+#else
+        // https://linux.die.net/man/3/rename
+        // Replacing toName is atomic
+        if (::rename(fromName.getBuffer(), toName.getBuffer()) == 0)
+        {
+            return SLANG_OK;
+        }
+        return SLANG_FAIL;
+#endif
+    }
+
 #ifdef _WIN32
     /* static */SlangResult File::generateTemporary(const UnownedStringSlice& inPrefix, Slang::String& outFileName)
     {
@@ -25,6 +25,9 @@ namespace Slang
         
         static SlangResult remove(const String& fileName);
 
+            /// Renames (moves) the file fromName to toName. If a file toName exists it is replaced.
+        static SlangResult rename(const String& fromName, const String& toName);
+
         static SlangResult makeExecutable(const String& fileName);
 
             /// Creates a temporary file typically in some way based on the prefix
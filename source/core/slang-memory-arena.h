@@ -126,6 +126,8 @@ public:
 
         /// Resets to the initial state when constructed (and all backing memory will be deallocated)  
     void reset();
+        /// Swap the contents (including all allocations) with rhs. Allocations remain valid, and are now owned by rhs.
+    void swapWith(ThisType& rhs);
         /// Adjusts such that the next allocate will be at least to the block alignment.
     void adjustToBlockAlignment();
  
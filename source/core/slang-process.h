@@ -71,6 +71,10 @@ public:
         /// Get the clock tick.
     static uint64_t getClockTick();
 
+        /// Get the peak amount of physical memory used by the current process in bytes (its peak 'resident set'
+        /// or 'working set'). Returns 0 if not available.
+    static uint64_t getPeakMemoryUsage();
+
 protected:
     int32_t m_returnValue = 0;                              ///< Value returned if process terminated
     RefPtr<Stream> m_streams[Index(StdStreamType::CountOf)];   ///< Streams to communicate with the process
@@ -7,13 +7,18 @@
 
 #include "../../slang.h"
 
+#include <atomic>
+
 namespace Slang
 {
     // Base class for all reference-counted objects
+    //
+    // The reference count is atomic, so that objects (such as the representation of a `String`)
+    // can be shared between threads that each hold references.
     class SLANG_RT_API RefObject
     {
     private:
-        UInt referenceCount;
+        std::atomic<UInt> referenceCount;
 
     public:
         RefObject()
@@ -0,0 +1,161 @@
+// slang-thread-pool.cpp
+#include "slang-thread-pool.h"
+
+namespace Slang {
+
+ThreadPool::ThreadPool(Index workerCount):
+    m_nextQueue(0),
+    m_pendingCount(0),
+    m_queuedCount(0)
+{
+    SLANG_ASSERT(workerCount >= 0);
+
+    // One queue per worker, and one extra that is used when there are no workers
+    for (Index i = 0; i < workerCount + 1; ++i)
+    {
+        m_queues.add(new TaskQueue);
+    }
+
+    for (Index i = 0; i < workerCount; ++i)
+    {
+        m_workers.add(std::thread(&ThreadPool::_workerThread, this, i));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+    m_workAvailable.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+
+    // Any work that remains (because there were no workers) is done now
+    waitAll();
+
+    for (auto queue : m_queues)
+    {
+        delete queue;
+    }
+}
+
+/* static */Index ThreadPool::getHardwareWorkerCount()
+{
+    const unsigned int count = std::thread::hardware_concurrency();
+    return count ? Index(count) : 1;
+}
+
+void ThreadPool::submit(const Task& task)
+{
+    ++m_pendingCount;
+
+    const Index workerCount = m_workers.getCount();
+    const Index queueIndex = workerCount ? (m_nextQueue++ % workerCount) : workerCount;
+
+    {
+        TaskQueue* queue = m_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->tasks.push_back(task);
+    }
+    ++m_queuedCount;
+
+    {
+        // Taking the lock makes sure a thread that is about to wait sees the change in m_queuedCount
+        std::lock_guard<std::mutex> lock(m_mutex);
+    }
+    m_workAvailable.notify_one();
+    m_allDone.notify_one();
+}
+
+bool ThreadPool::_tryTakeTask(Index queueIndex, Task& outTask)
+{
+    // Try our own queue first, taking from the front
+    {
+        TaskQueue* queue = m_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (queue->tasks.size())
+        {
+            outTask = _Move(queue->tasks.front());
+            queue->tasks.pop_front();
+            --m_queuedCount;
+            return true;
+        }
+    }
+
+    // Steal from the back of the other queues
+    const Index queueCount = m_queues.getCount();
+    for (Index i = 1; i < queueCount; ++i)
+    {
+        TaskQueue* queue = m_queues[(queueIndex + i) % queueCount];
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (queue->tasks.size())
+        {
+            outTask = _Move(queue->tasks.back());
+            queue->tasks.pop_back();
+            --m_queuedCount;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::_runTask(Task& task)
+{
+    task();
+
+    if (--m_pendingCount == 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+        }
+        m_allDone.notify_all();
+    }
+}
+
+void ThreadPool::_workerThread(Index workerIndex)
+{
+    for (;;)
+    {
+        Task task;
+        if (_tryTakeTask(workerIndex, task))
+        {
+            _runTask(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_workAvailable.wait(lock, [&]() { return m_isShuttingDown || m_queuedCount > 0; });
+        if (m_isShuttingDown && m_queuedCount == 0)
+        {
+            return;
+        }
+    }
+}
+
+void ThreadPool::waitAll()
+{
+    const Index waiterQueueIndex = m_queues.getCount() - 1;
+    for (;;)
+    {
+        Task task;
+        if (_tryTakeTask(waiterQueueIndex, task))
+        {
+            _runTask(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_allDone.wait(lock, [&]() { return m_pendingCount == 0 || m_queuedCount > 0; });
+        if (m_pendingCount == 0)
+        {
+            return;
+        }
+    }
+}
+
+} // namespace Slang
@@ -0,0 +1,79 @@
+// slang-thread-pool.h
+#ifndef SLANG_CORE_THREAD_POOL_H
+#define SLANG_CORE_THREAD_POOL_H
+
+#include "slang-smart-pointer.h"
+#include "slang-list.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Slang {
+
+/* A fixed size pool of worker threads that execute submitted tasks.
+
+Each worker owns a task queue. Submitted tasks are distributed over the queues round robin. A worker takes
+tasks from the front of its own queue, and when that is empty 'steals' from the back of another worker's queue,
+so uneven task costs are balanced across the pool without a single contended queue.
+
+A thread that calls `waitAll` also takes part in executing tasks until all submitted tasks have completed. That
+means a pool created with a worker count of 0 is valid - all work will be done on the waiting thread.
+
+The pool itself is not reentrant - tasks should not call `waitAll` on the pool that is executing them. */
+class ThreadPool : public RefObject
+{
+public:
+    typedef std::function<void()> Task;
+
+        /// Add a task to be executed by the pool
+    void submit(const Task& task);
+
+        /// Blocks until all submitted tasks have completed. The calling thread helps with execution.
+    void waitAll();
+
+        /// Get the amount of worker threads (not including any thread that is waiting)
+    Index getWorkerCount() const { return m_workers.getCount(); }
+
+        /// Returns a worker count suitable for the hardware (at least 1)
+    static Index getHardwareWorkerCount();
+
+        /// Ctor. workerCount is the amount of threads that will be created
+    ThreadPool(Index workerCount);
+    ~ThreadPool();
+
+protected:
+    struct TaskQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+        /// Try to pop a task from the queue at queueIndex, or steal one from another queue.
+    bool _tryTakeTask(Index queueIndex, Task& outTask);
+        /// Executes the task, and signals waiters if it was the last one outstanding
+    void _runTask(Task& task);
+
+    void _workerThread(Index workerIndex);
+
+    // There is one queue per worker, plus a queue that is used by a thread that calls `waitAll`
+    List<TaskQueue*> m_queues;
+    List<std::thread> m_workers;
+
+    std::atomic<Index> m_nextQueue;
+    std::atomic<Index> m_pendingCount;              ///< Tasks submitted but not yet completed
+    std::atomic<Index> m_queuedCount;               ///< Tasks submitted but not yet taken from a queue
+
+    // Used to wake up idle workers and waiters
+    std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_allDone;
+    bool m_isShuttingDown = false;
+};
+
+} // namespace Slang
+
+#endif
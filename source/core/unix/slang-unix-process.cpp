@@ -24,6 +24,7 @@
 #endif
 
 #include <time.h>
+#include <sys/resource.h>
 
 namespace Slang {
 
@@ -487,6 +488,22 @@ static const int kCannotExecute = 126;
     return uint64_t(now.tv_sec) * 1000000000 + now.tv_nsec;
 }
 
+/* static */uint64_t Process::getPeakMemoryUsage()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#if SLANG_APPLE_FAMILY
+    // Is in bytes on Apple platforms
+    return uint64_t(usage.ru_maxrss);
+#else
+    // Is in kilobytes
+    return uint64_t(usage.ru_maxrss) * 1024;
+#endif
+}
+
 /* static */void Process::sleepCurrentThread(Int timeInMs)
 {
     struct timespec timeSpec;
@@ -16,6 +16,7 @@
 #   define WIN32_LEAN_AND_MEAN
 #   define NOMINMAX
 #   include <Windows.h>
+#   include <psapi.h>
 #   undef WIN32_LEAN_AND_MEAN
 #   undef NOMINMAX
 #endif
@@ -561,4 +562,14 @@ static const uint64_t g_frequency = _getClockFrequency();
     return counter.QuadPart;
 }
 
+/* static */uint64_t Process::getPeakMemoryUsage()
+{
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return 0;
+    }
+    return uint64_t(counters.PeakWorkingSetSize);
+}
+
 } // namespace Slang
@@ -2,6 +2,7 @@
 
 #include "slang-compiler.h"
 
+#include "slang-permutation-compile.h"
 #include "slang-repro.h"
 
 #include "../core/slang-shared-library.h"
@@ -594,6 +595,68 @@ SLANG_API SlangResult spCompile(
     return request->compile();
 }
 
+SLANG_API SlangResult spCompilePermutations(
+    SlangSession*                   session,
+    char const* const*              baseArgs,
+    int                             baseArgCount,
+    SlangPermutationDesc const*     permutations,
+    int                             permutationCount,
+    int*                            outArtifactIndices,
+    ISlangBlob**                    outArtifacts,
+    int*                            outArtifactCount,
+    ISlangBlob**                    outDiagnostics)
+{
+    using namespace Slang;
+
+    SLANG_ASSERT(session);
+    if (!outArtifactIndices || !outArtifacts || !outArtifactCount)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    List<String> baseArgList;
+    for (int i = 0; i < baseArgCount; ++i)
+    {
+        baseArgList.add(baseArgs[i]);
+    }
+
+    List<PermutationCompileUtil::Permutation> permutationList;
+    for (int i = 0; i < permutationCount; ++i)
+    {
+        const auto& desc = permutations[i];
+
+        PermutationCompileUtil::Permutation permutation;
+        for (int j = 0; j < desc.argCount; ++j)
+        {
+            permutation.args.add(desc.args[j]);
+        }
+        for (int j = 0; j < desc.typeArgCount; ++j)
+        {
+            permutation.typeArgs.add(desc.typeArgs[j]);
+        }
+        permutationList.add(permutation);
+    }
+
+    PermutationCompileUtil::Result result;
+    const SlangResult res = PermutationCompileUtil::compile(asInternal(session), baseArgList, permutationList, result);
+
+    for (int i = 0; i < permutationCount; ++i)
+    {
+        outArtifactIndices[i] = int(result.artifactIndices[i]);
+    }
+    for (Index i = 0; i < result.artifacts.getCount(); ++i)
+    {
+        outArtifacts[i] = result.artifacts[i].detach();
+    }
+    *outArtifactCount = int(result.artifacts.getCount());
+
+    if (outDiagnostics)
+    {
+        *outDiagnostics = result.diagnostics.getLength() ? StringUtil::createStringBlob(result.diagnostics).detach() : nullptr;
+    }
+    return res;
+}
+
 SLANG_API int
 spGetDependencyFileCount(
     slang::ICompileRequest*    request)
@@ -864,3 +927,27 @@ SLANG_API void spSetDiagnosticFlags(slang::ICompileRequest* request, SlangDiagno
 
     request->setDiagnosticFlags(flags);
 }
+
+SLANG_API void spSetReportPerformance(slang::ICompileRequest* request, bool enable)
+{
+    if (!request)
+        return;
+
+    request->setReportPerformance(enable);
+}
+
+SLANG_API SlangResult spGetPerformanceReport(slang::ICompileRequest* request, SlangPerformanceReportFormat format, ISlangBlob** outBlob)
+{
+    if (!request)
+        return SLANG_E_INVALID_ARG;
+
+    return request->getPerformanceReport(format, outBlob);
+}
+
+SLANG_API SlangResult spGetPerformanceCounter(slang::ICompileRequest* request, const char* name, int64_t* outValue)
+{
+    if (!request || !name || !outValue)
+        return SLANG_E_INVALID_ARG;
+
+    return request->getPerformanceCounter(name, outValue);
+}
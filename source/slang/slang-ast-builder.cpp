@@ -141,6 +141,25 @@ Type* SharedASTBuilder::getNoneType()
     return m_noneType;
 }
 
+void SharedASTBuilder::freeze(const List<ASTBuilder*>& builders)
+{
+    // Create the lazily created types now, as they can't be created once frozen.
+    // Not all of the magic types are necessarily defined, so only create the ones that are.
+    if (m_magicDecls.ContainsKey("StringType")) getStringType();
+    if (m_magicDecls.ContainsKey("NativeStringType")) getNativeStringType();
+    if (m_magicDecls.ContainsKey("EnumTypeType")) getEnumTypeType();
+    if (m_magicDecls.ContainsKey("DynamicType")) getDynamicType();
+    if (m_magicDecls.ContainsKey("NullPtrType")) getNullPtrType();
+    if (m_magicDecls.ContainsKey("NoneType")) getNoneType();
+
+    m_astBuilder->m_isFrozen = true;
+    for (auto builder : builders)
+    {
+        SLANG_ASSERT(builder->m_sharedASTBuilder == this);
+        builder->m_isFrozen = true;
+    }
+}
+
 SharedASTBuilder::~SharedASTBuilder()
 {
     // Release built in types..
@@ -3,6 +3,9 @@
 #define SLANG_AST_BUILDER_H
 
 #include <type_traits>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 #include "slang-ast-support-types.h"
 #include "slang-ast-all.h"
@@ -13,6 +16,36 @@
 namespace Slang
 {
 
+/* A recursive mutex that knows which thread holds it, so that it can be asserted that it is held.
+Can be used with std::lock_guard and std::unique_lock. */
+class OwnedRecursiveMutex
+{
+public:
+    void lock()
+    {
+        m_mutex.lock();
+        if (m_lockCount++ == 0)
+        {
+            m_owner.store(std::this_thread::get_id());
+        }
+    }
+    void unlock()
+    {
+        if (--m_lockCount == 0)
+        {
+            m_owner.store(std::thread::id());
+        }
+        m_mutex.unlock();
+    }
+        /// True if the current thread holds the mutex
+    bool isHeldByCurrentThread() const { return m_owner.load() == std::this_thread::get_id(); }
+
+protected:
+    std::recursive_mutex m_mutex;
+    std::atomic<std::thread::id> m_owner;
+    Index m_lockCount = 0;          ///< Only accessed by the thread holding the mutex
+};
+
 class SharedASTBuilder : public RefObject
 {
     friend class ASTBuilder;
@@ -51,6 +84,13 @@ public:
         /// Must be called before used
     void init(Session* session);
 
+        /// Make the shared state, and the builtin ASTBuilders in builders, immutable.
+        /// Creates any types that are otherwise created lazily.
+    void freeze(const List<ASTBuilder*>& builders);
+
+        /// Mutex that must be held when a node is created by a frozen ASTBuilder
+    OwnedRecursiveMutex& getFrozenMutex() { return m_frozenMutex; }
+
     SharedASTBuilder();
 
     ~SharedASTBuilder();
@@ -91,7 +131,11 @@ protected:
     ASTBuilder* m_astBuilder = nullptr;
     Session* m_session = nullptr;
 
-    Index m_id = 1;
+    // ASTBuilders may be created on different threads
+    std::atomic<Index> m_id{1};
+
+    // Guards creation of nodes in frozen ASTBuilders, which are shared between threads
+    OwnedRecursiveMutex m_frozenMutex;
 };
 
 class ASTBuilder : public RefObject
@@ -202,6 +246,10 @@ public:
         /// Get the global session
     Session* getGlobalSession() { return m_sharedASTBuilder->m_session; }
 
+        /// True if the builder holds builtin nodes that are shared between threads. A node can only be created
+        /// by a frozen builder whilst holding the SharedASTBuilder frozen mutex.
+    bool isFrozen() const { return m_isFrozen; }
+
         /// Ctor
     ASTBuilder(SharedASTBuilder* sharedASTBuilder, const String& name);
 
@@ -217,6 +265,9 @@ protected:
     {
         SLANG_COMPILE_TIME_ASSERT(IsValidType<T>::Value);
 
+        // Nodes in a frozen builder can be seen by other threads, so can only be created with the frozen mutex held
+        SLANG_ASSERT(!m_isFrozen || m_sharedASTBuilder->getFrozenMutex().isHeldByCurrentThread());
+
         node->init(T::kType, this);
         // Only add it if it has a dtor that does some work
         if (!std::is_trivially_destructible<T>::value)
@@ -230,6 +281,8 @@ protected:
     String m_name;
     Index m_id;
 
+    bool m_isFrozen = false;
+
         /// List of all nodes that require being dtored when ASTBuilder is dtored
     List<NodeBase*> m_dtorNodes;
 
@@ -249,7 +302,7 @@ protected:
 
         /// A cache for AST nodes that are entirely defined by their node type, with
         /// no need for additional state.
-    Dictionary<NodeDesc, NodeBase*> m_cachedNodes;
+    FlatDictionary<NodeDesc, NodeBase*> m_cachedNodes;
 
 
     typedef NodeBase* (*NodeCreateFunc)(ASTBuilder* astBuilder, NodeDesc const& desc, void* userData);
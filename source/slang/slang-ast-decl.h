@@ -37,7 +37,7 @@ class ContainerDecl: public Decl
 
     bool isMemberDictionaryValid() const { return dictionaryLastCount == members.getCount(); }
 
-    void invalidateMemberDictionary() { dictionaryLastCount = -1; }
+    void invalidateMemberDictionary() { SLANG_ASSERT(!isMemberDictionaryFrozen); dictionaryLastCount = -1; }
 
     SLANG_UNREFLECTED   // We don't want to reflect the following fields
 
@@ -49,11 +49,15 @@ class ContainerDecl: public Decl
 
     // Dictionary for looking up members by name.
     // This is built on demand before performing lookup.
-    Dictionary<Name*, Decl*> memberDictionary;
+    FlatDictionary<Name*, Decl*> memberDictionary;
     
     // A list of transparent members, to be used in lookup
     // Note: this is only valid if `memberDictionaryIsValid` is true
     List<TransparentMemberInfo> transparentMembers;
+
+    // Set for builtin declarations, whose dictionary is built before they are shared between threads.
+    // After that the dictionary (and so the members) must not change.
+    bool isMemberDictionaryFrozen = false;
 };
 
 // Base class for all variable declarations
@@ -11,6 +11,7 @@
 #include "../../slang.h"
 
 #include "../core/slang-semantic-version.h"
+#include "../core/slang-flat-dictionary.h"
 
 #include "slang-generated-ast.h" 
 
@@ -66,9 +66,22 @@ Type* Type::getCanonicalType()
     Type* et = const_cast<Type*>(this);
     if (!et->canonicalType)
     {
-        // TODO(tfoley): worry about thread safety here?
-        auto canType = et->createCanonicalType();
-        et->canonicalType = canType;
+        ASTBuilder* astBuilder = getASTBuilder();
+        if (astBuilder->isFrozen())
+        {
+            // The type is builtin, and may be shared between threads, so the canonical type
+            // must be created whilst holding the lock. Check again as another thread may have set it.
+            std::lock_guard<OwnedRecursiveMutex> lock(astBuilder->getSharedASTBuilder()->getFrozenMutex());
+            if (!et->canonicalType)
+            {
+                et->canonicalType = et->createCanonicalType();
+            }
+        }
+        else
+        {
+            auto canType = et->createCanonicalType();
+            et->canonicalType = canType;
+        }
 
         SLANG_ASSERT(et->canonicalType);
     }
@@ -368,7 +381,19 @@ Type* MatrixExpressionType::getRowType()
 {
     if (!rowType)
     {
-        rowType = m_astBuilder->getVectorType(getElementType(), getColumnCount());
+        if (m_astBuilder->isFrozen())
+        {
+            // The matrix type is builtin, so the row type must be created whilst holding the lock
+            std::lock_guard<OwnedRecursiveMutex> lock(m_astBuilder->getSharedASTBuilder()->getFrozenMutex());
+            if (!rowType)
+            {
+                rowType = m_astBuilder->getVectorType(getElementType(), getColumnCount());
+            }
+        }
+        else
+        {
+            rowType = m_astBuilder->getVectorType(getElementType(), getColumnCount());
+        }
     }
     return rowType;
 }
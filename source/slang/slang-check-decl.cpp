@@ -5160,6 +5160,9 @@ namespace Slang
         importedModulesList.add(moduleDecl);
         importedModulesSet.Add(moduleDecl);
 
+        // Extensions in the module can add members to types that have already been looked up
+        getShared()->invalidateMemberLookupCache();
+
         // Create a new sub-scope to wire the module
         // into our lookup chain.
         auto subScope = getASTBuilder()->create<Scope>();
@@ -5395,6 +5398,9 @@ namespace Slang
         //
         m_candidateExtensionListsBuilt = false;
         m_mapTypeDeclToCandidateExtensions.Clear();
+
+        // Lookups on the type could now find more members
+        invalidateMemberLookupCache();
     }
 
     void SharedSemanticsContext::_addCandidateExtensionsFromModule(ModuleDecl* moduleDecl)
@@ -208,6 +208,25 @@ namespace Slang
         Dictionary<BasicTypeKeyPair, ConversionCost> conversionCostCache;
     };
 
+        /// Key for the result of looking up the members of a type by name (see `lookUpMember`)
+    struct MemberLookupCacheKey
+    {
+        Type* type = nullptr;               ///< The canonical type
+        Name* name = nullptr;
+        LookupMask mask = LookupMask::Default;
+        LookupOptions options = LookupOptions::None;
+
+        bool operator==(const MemberLookupCacheKey& rhs) const
+        {
+            return name == rhs.name && mask == rhs.mask && options == rhs.options &&
+                (type == rhs.type || type->equals(rhs.type));
+        }
+        HashCode getHashCode() const
+        {
+            return combineHash(type->getHashCode(), PointerHash<1>::getHashCode(name), HashCode(int(mask) << 8 | int(options)));
+        }
+    };
+
         /// Shared state for a semantics-checking session.
     struct SharedSemanticsContext
     {
@@ -275,7 +294,23 @@ namespace Slang
             /// Register a candidate extension `extDecl` for `typeDecl` encountered during checking.
         void registerCandidateExtension(AggTypeDecl* typeDecl, ExtensionDecl* extDecl);
 
+            /// Get the cached results of member lookups performed in this context (see `lookUpMember`)
+        Dictionary<MemberLookupCacheKey, LookupResult>& getMemberLookupCache() { return m_memberLookupCache; }
+            /// Get the generation of the member lookup cache, which changes each time it is invalidated
+        uint32_t getMemberLookupCacheGeneration() const { return m_memberLookupCacheGeneration; }
+            /// Invalidate the member lookup cache, because members could have become visible on types
+            /// (for example when extensions are imported)
+        void invalidateMemberLookupCache()
+        {
+            m_memberLookupCache.Clear();
+            m_memberLookupCacheGeneration++;
+        }
+
     private:
+            /// Results of member lookups, which depend on the extensions visible in this context
+        Dictionary<MemberLookupCacheKey, LookupResult> m_memberLookupCache;
+        uint32_t m_memberLookupCacheGeneration = 0;
+
             /// Mapping from type declarations to the known extensiosn that apply to them
         Dictionary<AggTypeDecl*, RefPtr<CandidateExtensionList>> m_mapTypeDeclToCandidateExtensions;
 
@@ -225,6 +225,9 @@ namespace Slang
         //
         attrDecl->parentDecl = parentDecl;
         parentDecl->members.add(attrDecl);
+
+        // The parent could be a type that members have already been looked up in
+        getShared()->invalidateMemberLookupCache();
         
         // Finally, we perform any required semantic checks on
         // the newly constructed attribute decl.
@@ -3,6 +3,7 @@
 
 #include "slang-lookup.h"
 #include "slang-ast-print.h"
+#include "slang-performance-report.h"
 
 // This file implements semantic checking logic related
 // to resolving overloading call operations, by checking
@@ -530,6 +531,8 @@ namespace Slang
         OverloadResolveContext&		context,
         OverloadCandidate&			candidate)
     {
+        PerformanceReport::addToCounter(PerformanceCounter::OverloadCandidatesChecked);
+
         if (!TryCheckOverloadCandidateArity(context, candidate))
             return;
 
@@ -6,6 +6,7 @@
 // specialized `slang-check-*` files.
 
 #include "slang-check-impl.h"
+#include "slang-performance-report.h"
 
 #include "../core/slang-type-text-util.h"
 
@@ -60,6 +61,8 @@ namespace Slang
 
     void Session::_setSharedLibraryLoader(ISlangSharedLibraryLoader* loader)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_downstreamCompilerMutex);
+
         if (m_sharedLibraryLoader != loader)
         {
             // Need to clear all of the libraries
@@ -78,6 +81,8 @@ namespace Slang
 
     void Session::resetDownstreamCompiler(PassThroughMode type)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_downstreamCompilerMutex);
+
         // Mark as initialized
         m_downstreamCompilerInitialized &= ~(1 << int(type));
         m_downstreamCompilers[int(type)].setNull();
@@ -85,6 +90,9 @@ namespace Slang
 
     DownstreamCompiler* Session::getOrLoadDownstreamCompiler(PassThroughMode type, DiagnosticSink* sink)
     {
+        // Sessions created from this global session may be compiling on other threads
+        std::lock_guard<std::recursive_mutex> lock(m_downstreamCompilerMutex);
+
         if (m_downstreamCompilerInitialized & (1 << int(type)))
         {
             return m_downstreamCompilers[int(type)];
@@ -164,6 +172,8 @@ namespace Slang
         TranslationUnitRequest* translationUnit,
         LoadedModuleDictionary& loadedModules)
     {
+        SLANG_PERFORMANCE_PHASE("check");
+
         SharedSemanticsContext sharedSemanticsContext(
             translationUnit->compileRequest->getLinkage(),
             translationUnit->getModule(),
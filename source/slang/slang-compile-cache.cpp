@@ -0,0 +1,639 @@
+// slang-compile-cache.cpp
+#include "slang-compile-cache.h"
+
+#include "../core/slang-io.h"
+#include "../core/slang-platform.h"
+#include "../core/slang-shared-library.h"
+#include "../core/slang-stream.h"
+
+#include "../compiler-core/slang-artifact-desc-util.h"
+#include "../compiler-core/slang-artifact-representation-impl.h"
+
+#include "slang-mangle.h"
+
+#include "../../slang-tag-version.h"
+
+namespace Slang {
+
+namespace { // anonymous
+
+// A place a result is held for a request. An entryPointIndex < 0 means the whole program result.
+struct ResultSlot
+{
+    TargetProgram* targetProgram;
+    Index entryPointIndex;
+};
+
+} // anonymous
+
+static void _getResultSlots(EndToEndCompileRequest* request, List<ResultSlot>& outSlots)
+{
+    auto program = request->getSpecializedGlobalAndEntryPointsComponentType();
+
+    for (auto targetReq : request->getLinkage()->targets)
+    {
+        auto targetProgram = program->getTargetProgram(targetReq);
+        if (targetReq->isWholeProgramRequest())
+        {
+            outSlots.add(ResultSlot{ targetProgram, -1 });
+        }
+        else
+        {
+            const Index entryPointCount = program->getEntryPointCount();
+            for (Index i = 0; i < entryPointCount; ++i)
+            {
+                outSlots.add(ResultSlot{ targetProgram, i });
+            }
+        }
+    }
+}
+
+static String _calcBuildIdentity()
+{
+    const UnownedStringSlice tag(SLANG_TAG_VERSION);
+    const uint64_t timestamp = SharedLibraryUtils::getSharedLibraryTimestamp((void*)slang_createGlobalSession);
+
+    // Without a tag, or a binary to check, there is nothing that changes when the compiler does
+    if (tag == UnownedStringSlice::fromLiteral("unknown") && timestamp == 0)
+    {
+        return String();
+    }
+
+    StringBuilder buf;
+    buf << tag << " " << timestamp;
+    return buf.ProduceString();
+}
+
+/* static */UnownedStringSlice CompileCacheUtil::getBuildIdentity()
+{
+    static const String buildIdentity = _calcBuildIdentity();
+    return buildIdentity.getUnownedSlice();
+}
+
+static CompileResult& _getExistingResult(const ResultSlot& slot)
+{
+    return (slot.entryPointIndex < 0) ?
+        slot.targetProgram->getExistingWholeProgramResult() :
+        slot.targetProgram->getExistingEntryPointResult(slot.entryPointIndex);
+}
+
+/* static */void CompileCacheUtil::appendContentHash(const UnownedStringSlice& content, StringBuilder& out)
+{
+    // The size and hash of the content identifies it, without the key having to contain it
+    out << uint64_t(content.getLength()) << " ";
+    out.append(uint64_t(getStableHashCode64(content.begin(), size_t(content.getLength()))), 16);
+}
+
+/* static */void CompileCacheUtil::appendContentHash(ISlangBlob* blob, StringBuilder& out)
+{
+    appendContentHash(UnownedStringSlice((const char*)blob->getBufferPointer(), blob->getBufferSize()), out);
+}
+
+/* static */void CompileCacheUtil::appendDefines(const Dictionary<String, String>& defines, StringBuilder& out)
+{
+    // Sort so the key doesn't depend on the order the defines were added
+    List<KeyValuePair<String, String>> pairs;
+    for (const auto& pair : defines)
+    {
+        pairs.add(pair);
+    }
+    pairs.sort([](const KeyValuePair<String, String>& a, const KeyValuePair<String, String>& b) -> bool { return a.Key < b.Key; });
+
+    for (const auto& pair : pairs)
+    {
+        out << "define: " << pair.Key << "=" << pair.Value << "\n";
+    }
+}
+
+/* static */void CompileCacheUtil::appendTarget(TargetRequest* targetReq, StringBuilder& out)
+{
+    const auto target = targetReq->getTarget();
+
+    out << "target: " << int(target) << " " << targetReq->getTargetProfile().raw << " " << uint32_t(targetReq->getTargetFlags()) << " ";
+    out << int(targetReq->getFloatingPointMode()) << " " << int(targetReq->getLineDirectiveMode()) << " ";
+    out << int(targetReq->getForceGLSLScalarBufferLayout()) << " " << int(targetReq->shouldTrackLiveness()) << "\n";
+
+    const CapabilitySet targetCaps = targetReq->getTargetCaps();
+    out << "capabilities:";
+    for (auto atom : targetCaps.getExpandedAtoms())
+    {
+        out << " " << int(atom);
+    }
+    out << "\n";
+
+    // The version of the downstream compiler can change the output
+    const auto passThrough = getDownstreamCompilerRequiredForTarget(target);
+    if (passThrough != PassThroughMode::None)
+    {
+        auto session = targetReq->getLinkage()->getSessionImpl();
+        if (auto downstreamCompiler = session->getOrLoadDownstreamCompiler(passThrough, nullptr))
+        {
+            out << "downstream: ";
+            downstreamCompiler->getDesc().appendAsText(out);
+            out << "\n";
+        }
+    }
+}
+
+/* static */SlangResult CompileCacheUtil::appendLinkage(Linkage* linkage, StringBuilder& out)
+{
+    auto session = linkage->getSessionImpl();
+
+    for (Index i = 0; i < Index(SourceLanguage::CountOf); ++i)
+    {
+        const String& prelude = session->getPreludeForLanguage(SourceLanguage(i));
+        if (prelude.getLength())
+        {
+            out << "prelude: " << i << " ";
+            appendContentHash(prelude.getUnownedSlice(), out);
+            out << "\n";
+        }
+    }
+
+    out << "options: " << int(linkage->defaultMatrixLayoutMode) << " " << int(linkage->debugInfoLevel) << " " << int(linkage->optimizationLevel) << " ";
+    out << uint32_t(linkage->m_flag) << " " << int(linkage->m_obfuscateCode) << " " << int(linkage->m_useFalcorCustomSharedKeywordSemantics) << "\n";
+
+    for (const auto& entry : linkage->m_downstreamArgs.getEntries())
+    {
+        out << "downstream-args: " << entry.name;
+        for (const auto& arg : entry.args)
+        {
+            out << " \"" << arg.value << "\"";
+        }
+        out << "\n";
+    }
+
+    for (const auto& searchDirectory : linkage->searchDirectories.searchDirectories)
+    {
+        out << "search: " << searchDirectory.path << "\n";
+    }
+
+    appendDefines(linkage->preprocessorDefinitions, out);
+
+    // Modules referenced as libraries
+    for (auto libModule : linkage->m_libModules)
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(libModule->loadBlob(ArtifactKeep::Yes, blob.writeRef()));
+
+        out << "library: ";
+        appendContentHash(blob, out);
+        out << "\n";
+    }
+    return SLANG_OK;
+}
+
+/* static */SlangResult CompileCacheUtil::appendFileDependencies(ComponentType* program, StringBuilder& out)
+{
+    // These are loaded via the linkage file system, which caches contents, so typically they will not be read again.
+    ISlangFileSystemExt* fileSystem = program->getLinkage()->getFileSystemExt();
+    for (const auto& path : program->getFilePathDependencies())
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(fileSystem->loadFile(path.getBuffer(), blob.writeRef()));
+
+        out << "file: " << path << " ";
+        appendContentHash(blob, out);
+        out << "\n";
+    }
+    return SLANG_OK;
+}
+
+/* static */SlangResult CompileCacheUtil::calcKey(EndToEndCompileRequest* request, String& outKey)
+{
+    auto linkage = request->getLinkage();
+    auto frontEndReq = request->getFrontEndReq();
+    auto program = request->getSpecializedGlobalAndEntryPointsComponentType();
+
+    // Pass through compilations don't track what the downstream compiler depends on.
+    // Debugging output is a side effect of code generation, so isn't skipped.
+    if (request->m_passThrough != PassThroughMode::None ||
+        request->shouldDumpIntermediates ||
+        frontEndReq->shouldDumpIR ||
+        program == nullptr)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    // Output from a build that cannot be identified could be used by a different build
+    const UnownedStringSlice buildIdentity = getBuildIdentity();
+    if (buildIdentity.getLength() == 0)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    StringBuilder key;
+
+    key << "slang-compile-cache: " << kVersion << "\n";
+    key << "compiler: " << buildIdentity << "\n";
+
+    // The targets
+    for (auto targetReq : linkage->targets)
+    {
+        // Host callable results are loaded shared libraries, which we cannot store
+        if (ArtifactDescUtil::makeDescFromCompileTarget(asExternal(targetReq->getTarget())).kind == ArtifactKind::HostCallable ||
+            targetReq->shouldDumpIntermediates())
+        {
+            return SLANG_E_NOT_AVAILABLE;
+        }
+        appendTarget(targetReq, key);
+    }
+
+    SLANG_RETURN_ON_FAIL(appendLinkage(linkage, key));
+
+    // Request options
+    key << "request: " << uint32_t(frontEndReq->compileFlags) << " " << int(request->useUnknownImageFormatAsDefault) << " ";
+    key << int(request->disableSpecialization) << " " << int(request->disableDynamicDispatch) << " " << uint32_t(request->getSink()->getFlags()) << "\n";
+
+    appendDefines(frontEndReq->preprocessorDefinitions, key);
+
+    // The translation units. We use the source held in the source files, as they
+    // may not have been loaded from a file.
+    for (auto translationUnit : frontEndReq->translationUnits)
+    {
+        key << "translation-unit: " << int(translationUnit->sourceLanguage) << " " << getText(translationUnit->moduleName) << "\n";
+        appendDefines(translationUnit->preprocessorDefinitions, key);
+
+        for (auto sourceFile : translationUnit->getSourceFiles())
+        {
+            key << "source: " << sourceFile->getPathInfo().foundPath << " ";
+            appendContentHash(sourceFile->getContent(), key);
+            key << "\n";
+        }
+    }
+
+    // The entry points (the mangled name identifies the entry point, and how it is specialized)
+    {
+        const Index entryPointCount = program->getEntryPointCount();
+        for (Index i = 0; i < entryPointCount; ++i)
+        {
+            auto entryPoint = program->getEntryPoint(i);
+            key << "entry-point: " << program->getEntryPointMangledName(i) << " " << program->getEntryPointNameOverride(i) << " ";
+            key << (entryPoint ? entryPoint->getProfile().raw : Profile::RawVal(0)) << "\n";
+        }
+    }
+    for (const auto& arg : request->m_globalSpecializationArgStrings)
+    {
+        key << "specialization-arg: " << arg << "\n";
+    }
+    for (const auto& entryPointInfo : request->m_entryPoints)
+    {
+        key << "entry-point-args:";
+        for (const auto& arg : entryPointInfo.specializationArgStrings)
+        {
+            key << " " << arg;
+        }
+        key << "\n";
+    }
+
+    // All of the files that were depended on
+    SLANG_RETURN_ON_FAIL(appendFileDependencies(program, key));
+
+    outKey = key.ProduceString();
+    return SLANG_OK;
+}
+
+namespace { // anonymous
+
+// Appends text that describes the structure of a component type, along with how it is specialized.
+// Modules are identified by the content they were parsed from, and everything else by mangled names,
+// which are the same between processes.
+struct ComponentTypeKeyVisitor : ComponentTypeVisitor
+{
+    ComponentTypeKeyVisitor(ASTBuilder* astBuilder, StringBuilder& out):
+        m_astBuilder(astBuilder),
+        m_out(out)
+    {}
+
+    void visitEntryPoint(EntryPoint* entryPoint, EntryPoint::EntryPointSpecializationInfo* specializationInfo) SLANG_OVERRIDE
+    {
+        m_out << "entry-point: " << getMangledName(m_astBuilder, entryPoint->getFuncDeclRef()) << " " << entryPoint->getProfile().raw << "\n";
+        if (specializationInfo)
+        {
+            m_out << "entry-point-specialization: " << getMangledName(m_astBuilder, specializationInfo->specializedFuncDeclRef);
+            for (const auto& arg : specializationInfo->existentialSpecializationArgs)
+            {
+                _appendVal(arg.val);
+            }
+            m_out << "\n";
+        }
+    }
+
+    void visitModule(Module* module, Module::ModuleSpecializationInfo* specializationInfo) SLANG_OVERRIDE
+    {
+        auto moduleDecl = module->getModuleDecl();
+        m_out << "module: " << (moduleDecl ? getText(moduleDecl->getName()) : String()) << "\n";
+        for (const auto& digest : module->getSourceContentDigests())
+        {
+            m_out << "module-source: " << digest << "\n";
+        }
+        if (specializationInfo)
+        {
+            m_out << "module-specialization:";
+            for (const auto& arg : specializationInfo->genericArgs)
+            {
+                _appendVal(arg.argVal);
+            }
+            for (const auto& arg : specializationInfo->existentialArgs)
+            {
+                _appendVal(arg.val);
+            }
+            m_out << "\n";
+        }
+    }
+
+    void visitComposite(CompositeComponentType* composite, CompositeComponentType::CompositeSpecializationInfo* specializationInfo) SLANG_OVERRIDE
+    {
+        m_out << "composite: " << composite->getChildComponentCount() << "\n";
+        visitChildren(composite, specializationInfo);
+    }
+
+    void visitSpecialized(SpecializedComponentType* specialized) SLANG_OVERRIDE
+    {
+        m_out << "specialized:\n";
+        visitChildren(specialized);
+    }
+
+    void visitTypeConformance(TypeConformance* conformance) SLANG_OVERRIDE
+    {
+        m_out << "conformance: " << conformance->getSubtypeWitness()->toString() << " " << conformance->getConformanceIdOverride() << "\n";
+    }
+
+    void visitRenamedEntryPoint(RenamedEntryPointComponentType* renamedEntryPoint, EntryPoint::EntryPointSpecializationInfo* specializationInfo) SLANG_OVERRIDE
+    {
+        m_out << "renamed-entry-point: " << renamedEntryPoint->getEntryPointNameOverride(0) << "\n";
+        renamedEntryPoint->getBase()->acceptVisitor(this, specializationInfo);
+    }
+
+    void _appendVal(Val* val)
+    {
+        m_out << " ";
+        if (auto type = as<Type>(val))
+        {
+            m_out << getMangledTypeName(m_astBuilder, type);
+        }
+        else if (val)
+        {
+            val->toText(m_out);
+        }
+    }
+
+    ASTBuilder* m_astBuilder;
+    StringBuilder& m_out;
+};
+
+} // anonymous
+
+/* static */SlangResult CompileCacheUtil::calcEntryPointKey(ComponentType* program, Index entryPointIndex, TargetRequest* targetReq, String& outKey)
+{
+    auto linkage = program->getLinkage();
+
+    if (entryPointIndex < 0 || entryPointIndex >= program->getEntryPointCount())
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    // Output from a build that cannot be identified could be used by a different build
+    const UnownedStringSlice buildIdentity = getBuildIdentity();
+    if (buildIdentity.getLength() == 0)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    StringBuilder key;
+
+    key << "slang-entry-point-cache: " << kVersion << "\n";
+    key << "compiler: " << buildIdentity << "\n";
+
+    appendTarget(targetReq, key);
+    SLANG_RETURN_ON_FAIL(appendLinkage(linkage, key));
+
+    key << "entry-point-index: " << entryPointIndex << " " << program->getEntryPointMangledName(entryPointIndex) << " ";
+    key << program->getEntryPointNameOverride(entryPointIndex) << "\n";
+
+    {
+        ComponentTypeKeyVisitor visitor(linkage->getASTBuilder(), key);
+        program->acceptVisitor(&visitor, nullptr);
+    }
+
+    SLANG_RETURN_ON_FAIL(appendFileDependencies(program, key));
+
+    outKey = key.ProduceString();
+    return SLANG_OK;
+}
+
+/* static */String CompileCacheUtil::calcEntryPath(const String& directory, const String& key)
+{
+    StringBuilder fileName;
+    fileName.append(uint64_t(getStableHashCode64(key.getBuffer(), size_t(key.getLength()))), 16);
+    fileName << ".slang-cache";
+    return Path::combine(directory, fileName);
+}
+
+/* static */void CompileCacheUtil::outputDiagnostics(DiagnosticSink* sink, const UnownedStringSlice& diagnostics)
+{
+    if (diagnostics.getLength() == 0)
+    {
+        return;
+    }
+
+    // Same logic as `DiagnosticSink::diagnoseRaw`, but doesn't change the error count
+    if (sink->writer)
+    {
+        sink->writer->write(diagnostics.begin(), size_t(diagnostics.getLength()));
+    }
+    else
+    {
+        sink->outputBuffer.append(diagnostics);
+    }
+}
+
+static UnownedStringSlice _getText(RiffContainer::Data* data)
+{
+    return data ? UnownedStringSlice((const char*)data->getPayload(), data->getSize()) : UnownedStringSlice();
+}
+
+/* static */SlangResult CompileCacheUtil::readEntry(const String& path, const String& key, EndToEndCompileRequest* request)
+{
+    if (!File::exists(path))
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    List<uint8_t> contents;
+    SLANG_RETURN_ON_FAIL(File::readAllBytes(path, contents));
+
+    MemoryStreamBase stream(FileAccess::Read, contents.getBuffer(), contents.getCount());
+
+    RiffContainer container;
+    SLANG_RETURN_ON_FAIL(RiffUtil::read(&stream, container));
+
+    RiffContainer::ListChunk* entryChunk = container.getRoot();
+    if (!entryChunk || entryChunk->m_fourCC != kEntryFourCC)
+    {
+        return SLANG_FAIL;
+    }
+
+    // The key must match exactly. If it doesn't it's a collision, or a stale entry.
+    if (_getText(entryChunk->findContainedData(kKeyFourCC)) != key.getUnownedSlice())
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    List<ResultSlot> slots;
+    _getResultSlots(request, slots);
+
+    List<RiffContainer::ListChunk*> resultChunks;
+    entryChunk->findContained(kResultFourCC, resultChunks);
+    if (resultChunks.getCount() != slots.getCount())
+    {
+        return SLANG_FAIL;
+    }
+
+    // Decode all of the results before setting any, so a bad entry doesn't leave the request partially set
+    List<CompileResult> results;
+    for (auto resultChunk : resultChunks)
+    {
+        auto header = resultChunk->findContainedData<ResultHeader>(kResultHeaderFourCC);
+        // An empty result is stored as no data
+        auto data = resultChunk->findContainedData(kResultDataFourCC);
+        if (!header)
+        {
+            return SLANG_FAIL;
+        }
+
+        RefPtr<PostEmitMetadata> metadata;
+        if (header->hasMetadata)
+        {
+            metadata = new PostEmitMetadata;
+            if (auto rangesData = resultChunk->findContainedData(kBindingRangesFourCC))
+            {
+                const auto ranges = (const BindingRange*)rangesData->getPayload();
+                const Index rangeCount = Index(rangesData->getSize() / sizeof(BindingRange));
+                for (Index i = 0; i < rangeCount; ++i)
+                {
+                    const auto& srcRange = ranges[i];
+
+                    ShaderBindingRange range;
+                    range.category = slang::ParameterCategory(srcRange.category);
+                    range.spaceIndex = UInt(srcRange.spaceIndex);
+                    range.registerIndex = UInt(srcRange.registerIndex);
+                    range.registerCount = UInt(srcRange.registerCount);
+                    metadata->usedBindings.add(range);
+                }
+            }
+        }
+
+        CompileResult result;
+        switch (ResultFormat(header->format))
+        {
+            case ResultFormat::Text:
+            {
+                result = CompileResult(String(_getText(data)), metadata);
+                break;
+            }
+            case ResultFormat::Binary:
+            {
+                const UnownedStringSlice bytes = _getText(data);
+                result = CompileResult(RawBlob::create(bytes.begin(), size_t(bytes.getLength())));
+                result.postEmitMetadata = metadata;
+                break;
+            }
+            default: return SLANG_FAIL;
+        }
+        results.add(result);
+    }
+
+    for (Index i = 0; i < slots.getCount(); ++i)
+    {
+        const auto& slot = slots[i];
+        if (slot.entryPointIndex < 0)
+        {
+            slot.targetProgram->setWholeProgramResult(results[i]);
+        }
+        else
+        {
+            slot.targetProgram->setEntryPointResult(slot.entryPointIndex, results[i]);
+        }
+    }
+
+    outputDiagnostics(request->getSink(), _getText(entryChunk->findContainedData(kDiagnosticsFourCC)));
+    return SLANG_OK;
+}
+
+static void _addDataChunk(RiffContainer& container, FourCC fourCC, const void* data, size_t size)
+{
+    // Empty data isn't written, as the container doesn't allow zero sized writes
+    if (size)
+    {
+        container.addDataChunk(fourCC, data, size);
+    }
+}
+
+/* static */SlangResult CompileCacheUtil::writeEntry(const String& path, const String& key, EndToEndCompileRequest* request, const UnownedStringSlice& diagnostics)
+{
+    List<ResultSlot> slots;
+    _getResultSlots(request, slots);
+
+    RiffContainer container;
+    {
+        RiffContainer::ScopeChunk entryScope(&container, RiffContainer::Chunk::Kind::List, kEntryFourCC);
+
+        container.addDataChunk(kKeyFourCC, key.getBuffer(), size_t(key.getLength()));
+        _addDataChunk(container, kDiagnosticsFourCC, diagnostics.begin(), size_t(diagnostics.getLength()));
+
+        for (const auto& slot : slots)
+        {
+            CompileResult& result = _getExistingResult(slot);
+
+            ComPtr<ISlangBlob> blob;
+            SLANG_RETURN_ON_FAIL(result.getBlob(blob));
+
+            RiffContainer::ScopeChunk resultScope(&container, RiffContainer::Chunk::Kind::List, kResultFourCC);
+
+            ResultHeader header;
+            header.format = uint32_t(result.format);
+            header.hasMetadata = result.postEmitMetadata ? 1 : 0;
+            container.addDataChunk(kResultHeaderFourCC, &header, sizeof(header));
+
+            _addDataChunk(container, kResultDataFourCC, blob->getBufferPointer(), blob->getBufferSize());
+
+            if (result.postEmitMetadata && result.postEmitMetadata->usedBindings.getCount())
+            {
+                List<BindingRange> ranges;
+                for (const auto& srcRange : result.postEmitMetadata->usedBindings)
+                {
+                    BindingRange range;
+                    range.category = uint32_t(srcRange.category);
+                    range.spaceIndex = srcRange.spaceIndex;
+                    range.registerIndex = srcRange.registerIndex;
+                    range.registerCount = srcRange.registerCount;
+                    ranges.add(range);
+                }
+                container.addDataChunk(kBindingRangesFourCC, ranges.getBuffer(), ranges.getCount() * sizeof(BindingRange));
+            }
+        }
+    }
+
+    OwnedMemoryStream stream(FileAccess::Write);
+    SLANG_RETURN_ON_FAIL(RiffUtil::write(&container, &stream));
+
+    // Other compilations may be writing or reading the same entry concurrently, so write to a
+    // temporary file, and then replace the entry in a single operation.
+    StringBuilder tempPath;
+    tempPath << path << "." << uint64_t(Process::getClockTick()) << "." << uint64_t(size_t(request)) << ".tmp";
+
+    Path::createDirectory(Path::getParentDirectory(path));
+
+    auto streamContents = stream.getContents();
+    SLANG_RETURN_ON_FAIL(File::writeAllBytes(tempPath, streamContents.getBuffer(), size_t(streamContents.getCount())));
+
+    if (SLANG_FAILED(File::rename(tempPath, path)))
+    {
+        File::remove(tempPath);
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+} // namespace Slang
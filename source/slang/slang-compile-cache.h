@@ -0,0 +1,104 @@
+// slang-compile-cache.h
+#ifndef SLANG_COMPILE_CACHE_H_INCLUDED
+#define SLANG_COMPILE_CACHE_H_INCLUDED
+
+#include "../core/slang-riff.h"
+#include "../core/slang-string.h"
+
+#include "slang-compiler.h"
+
+namespace Slang {
+
+/* Facilities to cache the output of an end-to-end compilation in a directory on disk, such that a later compilation
+with the same inputs can skip code generation (IR linking/optimization, emit and downstream compilation).
+
+A cache entry is looked up via a 'key'. The key is text that identifies everything that can change the output -
+the compiler build (see `getBuildIdentity`), the target and compilation options, the entry points and specialization arguments,
+and the contents of every file the front end depended on (as seen through the linkage file system). The key is
+computed after the front end has run, as it is only then that the full set of dependencies (such as files
+that were `#include`d or `import`ed) is known. Because the front end still runs, reflection is available
+when output comes from the cache.
+
+An entry is a RIFF file, named by a hash of the key. The entry holds the whole key, which must match for the
+entry to be used, and so a hash collision can only cause a cache miss. The entry holds the output for each
+target and entry point (or whole program), along with any binding usage information and the diagnostics
+produced during code generation.
+
+Entries are only written for compilations that produce no errors. If the build of the compiler cannot be identified,
+nothing is cached. */
+struct CompileCacheUtil
+{
+    static const FourCC kEntryFourCC = SLANG_FOUR_CC('S', 'c', 'c', 'h');           ///< A cache entry
+    static const FourCC kKeyFourCC = SLANG_FOUR_CC('S', 'c', 'k', 'y');             ///< The key text
+    static const FourCC kDiagnosticsFourCC = SLANG_FOUR_CC('S', 'c', 'd', 'g');     ///< Diagnostics from code generation
+    static const FourCC kResultFourCC = SLANG_FOUR_CC('S', 'c', 'r', 's');          ///< A list holding a result
+    static const FourCC kResultHeaderFourCC = SLANG_FOUR_CC('S', 'c', 'r', 'h');    ///< ResultHeader
+    static const FourCC kResultDataFourCC = SLANG_FOUR_CC('S', 'c', 'r', 'd');      ///< The text or binary output
+    static const FourCC kBindingRangesFourCC = SLANG_FOUR_CC('S', 'c', 'b', 'r');   ///< BindingRange array
+
+        /// Change if the format of the key or entries changes
+    static const uint32_t kVersion = 1;
+
+    struct ResultHeader
+    {
+        uint32_t format;                ///< The ResultFormat
+        uint32_t hasMetadata;           ///< Non zero if there is PostEmitMetadata (ie binding ranges)
+    };
+
+    struct BindingRange
+    {
+        uint32_t category;
+        uint32_t pad = 0;
+        uint64_t spaceIndex;
+        uint64_t registerIndex;
+        uint64_t registerCount;
+    };
+
+        /// Calculate the key for the request. The front end must have been run, and specialization performed.
+        /// Returns SLANG_E_NOT_AVAILABLE if the output of the request cannot be cached.
+    static SlangResult calcKey(EndToEndCompileRequest* request, String& outKey);
+
+        /// Calculate the key for the code generated for an entry point of program on a target.
+        /// Unlike `calcKey`, this is used for code produced through the component type API, and so also
+        /// covers host callable targets. The key is held by the caller rather than used for entries in the
+        /// cache directory.
+    static SlangResult calcEntryPointKey(ComponentType* program, Index entryPointIndex, TargetRequest* targetReq, String& outKey);
+
+        /// Get text that identifies the build of the compiler, such that output produced by a different build is not used.
+        /// This is the version tag, and the modification time of the binary holding the compiler, as a development build
+        /// without a tag can change between builds. Returns an empty slice if the build cannot be identified.
+    static UnownedStringSlice getBuildIdentity();
+
+        /// Append text that identifies the target and how code is generated for it to out
+    static void appendTarget(TargetRequest* targetReq, StringBuilder& out);
+
+        /// Append text that identifies the options held on the linkage to out
+    static SlangResult appendLinkage(Linkage* linkage, StringBuilder& out);
+
+        /// Append text that identifies the contents of each file program depends on to out
+    static SlangResult appendFileDependencies(ComponentType* program, StringBuilder& out);
+
+        /// Get the path of the entry for key in the directory
+    static String calcEntryPath(const String& directory, const String& key);
+
+        /// Read the entry at path, and if it matches key set the results on the request and
+        /// output the diagnostics that were stored with the entry.
+    static SlangResult readEntry(const String& path, const String& key, EndToEndCompileRequest* request);
+
+        /// Write the results of the request as an entry at path.
+    static SlangResult writeEntry(const String& path, const String& key, EndToEndCompileRequest* request, const UnownedStringSlice& diagnostics);
+
+        /// Output diagnostics text to the sink, without interpretation
+    static void outputDiagnostics(DiagnosticSink* sink, const UnownedStringSlice& diagnostics);
+
+        /// Append text that identifies content (its size and hash) to out
+    static void appendContentHash(const UnownedStringSlice& content, StringBuilder& out);
+    static void appendContentHash(ISlangBlob* blob, StringBuilder& out);
+
+        /// Append the defines to out, in a stable order
+    static void appendDefines(const Dictionary<String, String>& defines, StringBuilder& out);
+};
+
+} // namespace Slang
+
+#endif
@@ -8,9 +8,12 @@
 #include "../core/slang-riff.h"
 #include "../core/slang-type-text-util.h"
 #include "../core/slang-type-convert-util.h"
+#include "../core/slang-thread-pool.h"
 
 #include "slang-check.h"
 #include "slang-compiler.h"
+#include "slang-compile-cache.h"
+#include "slang-precompiled-module.h"
 
 #include "../compiler-core/slang-lexer.h"
 
@@ -1352,9 +1355,10 @@ namespace Slang
             options.profileName = GetHLSLProfileName(profile);
         }
 
+        const bool isHostCallable = ArtifactDescUtil::makeDescFromCompileTarget(asExternal(target)).kind == ArtifactKind::HostCallable;
+
         // If we aren't using LLVM 'host callable', we want downstream compile to produce a shared library
-        if (compilerType != PassThroughMode::LLVM && 
-            ArtifactDescUtil::makeDescFromCompileTarget(asExternal(target)).kind == ArtifactKind::HostCallable)
+        if (compilerType != PassThroughMode::LLVM && isHostCallable)
         {
             target = CodeGenTarget::ShaderSharedLibrary;
         }
@@ -1409,6 +1413,19 @@ namespace Slang
                 default: SLANG_ASSERT(!"Unhandled floating point mode");
             }
 
+            if (getTargetReq()->getTargetFlags() & SLANG_TARGET_FLAG_GENERATE_SPMD)
+            {
+                // The SPMD lane loops are only of benefit if the downstream compiler vectorizes them
+                options.flags |= CompileOptions::Flag::EnableVectorization;
+
+                // Host callable code is only ever run in the process that compiled it, so can use all the
+                // features of the host CPU
+                if (isHostCallable)
+                {
+                    options.flags |= CompileOptions::Flag::TargetHostCPU;
+                }
+            }
+
             {
                 // We need to look at the stage of the entry point(s) we are
                 // being asked to compile, since this will determine the
@@ -1475,12 +1492,18 @@ namespace Slang
 
             // Add all of the module libraries
             options.libraries.addRange(linkage->m_libModules.getBuffer(), linkage->m_libModules.getCount());
+
+            // Products of command line compilers are cached in the same directory as the output of compilations
+            options.cacheDirectory = linkage->m_cacheDirectory;
         }
 
         // Compile
         RefPtr<DownstreamCompileResult> downstreamCompileResult;
         auto downstreamStartTime = std::chrono::high_resolution_clock::now();
-        SLANG_RETURN_ON_FAIL(compiler->compile(options, downstreamCompileResult));
+        {
+            SLANG_PERFORMANCE_PHASE("downstreamCompile");
+            SLANG_RETURN_ON_FAIL(compiler->compile(options, downstreamCompileResult));
+        }
         auto downstreamElapsedTime =
             (std::chrono::high_resolution_clock::now() - downstreamStartTime).count() * 0.000000001;
         getSession()->addDownstreamCompileTime(downstreamElapsedTime);
@@ -2064,6 +2087,14 @@ namespace Slang
         return result;
     }
 
+    void TargetProgram::setEntryPointResult(Int entryPointIndex, CompileResult const& result)
+    {
+        if (entryPointIndex >= m_entryPointResults.getCount())
+            m_entryPointResults.setCount(entryPointIndex + 1);
+
+        m_entryPointResults[entryPointIndex] = result;
+    }
+
     CompileResult& TargetProgram::getOrCreateWholeProgramResult(
         DiagnosticSink* sink)
     {
@@ -2141,6 +2172,15 @@ namespace Slang
         // Set up options
         SerialContainerUtil::WriteOptions options;
 
+        // If the container holds a single module that was compiled in the same way as it would be for
+        // an `import`, it can be used as a precompiled module (see `PrecompiledModuleUtil`)
+        auto frontEndReq = getFrontEndReq();
+        const bool isImportable = !linkage->m_obfuscateCode &&
+            frontEndReq->translationUnits.getCount() == 1 &&
+            frontEndReq->preprocessorDefinitions.Count() == 0 &&
+            frontEndReq->translationUnits[0]->preprocessorDefinitions.Count() == 0 &&
+            frontEndReq->translationUnits[0]->sourceLanguage == SourceLanguage::Slang;
+
         options.compressionType = linkage->serialCompressionType;
         if (linkage->m_obfuscateCode)
         {
@@ -2149,8 +2189,9 @@ namespace Slang
             // Also currently only IR is needed.
             options.optionFlags &= ~SerialOptionFlag::ASTModule;
         }
-        else if (linkage->debugInfoLevel != DebugInfoLevel::None && linkage->getSourceManager())
+        else if ((isImportable || linkage->debugInfoLevel != DebugInfoLevel::None) && linkage->getSourceManager())
         {
+            // An imported module needs source locations, such that output is the same as when imported from source
             options.optionFlags |= SerialOptionFlag::SourceLocation;
             options.sourceManager = linkage->getSourceManager();
         }
@@ -2158,6 +2199,14 @@ namespace Slang
         {
             RiffContainer container;
             {
+                RiffContainer::ScopeChunk scopeModule(&container, RiffContainer::Chunk::Kind::List, PrecompiledModuleUtil::kPrecompiledModuleFourCC);
+
+                if (isImportable)
+                {
+                    // It's not an error if the info can't be written, the module just won't be usable via `import`
+                    PrecompiledModuleUtil::writeInfo(linkage, frontEndReq->translationUnits[0]->getModule(), &container);
+                }
+
                 SerialContainerData data;
                 SLANG_RETURN_ON_FAIL(SerialContainerUtil::addEndToEndRequestToData(this, options, data));
                 SLANG_RETURN_ON_FAIL(SerialContainerUtil::write(data, options, &container));
@@ -2313,6 +2362,8 @@ namespace Slang
     void EndToEndCompileRequest::generateOutput(
         ComponentType* program)
     {
+        SLANG_PERFORMANCE_PHASE("generateOutput");
+
         // When dynamic dispatch is disabled, the program must
         // be fully specialized by now. So we check if we still
         // have unspecialized generic/existential parameters,
@@ -2344,6 +2395,12 @@ namespace Slang
         }
 
 
+        if (_canGenerateOutputInParallel(program))
+        {
+            _generateOutputInParallel(program);
+            return;
+        }
+
         // Go through the code-generation targets that the user
         // has specified, and generate code for each of them.
         //
@@ -2355,9 +2412,235 @@ namespace Slang
         }
     }
 
+    bool EndToEndCompileRequest::_canGenerateOutputInParallel(ComponentType* program)
+    {
+        // Pass-through compilations and dumping are not performed in parallel, as they
+        // rely on state that is shared across code generation.
+        if (!m_parallelCodegen ||
+            m_passThrough != PassThroughMode::None ||
+            shouldDumpIntermediates ||
+            getFrontEndReq()->shouldDumpIR)
+        {
+            return false;
+        }
+
+        Index jobCount = 0;
+        for (auto targetReq : getLinkage()->targets)
+        {
+            if (targetReq->shouldDumpIntermediates() ||
+                (targetReq->getTargetFlags() & SLANG_TARGET_FLAG_DUMP_IR))
+            {
+                return false;
+            }
+            jobCount += targetReq->isWholeProgramRequest() ? 1 : program->getEntryPointCount();
+        }
+
+        return jobCount > 1;
+    }
+
+    void EndToEndCompileRequest::_generateOutputInParallel(ComponentType* program)
+    {
+        auto sink = getSink();
+        auto session = getSession();
+        auto linkage = getLinkage();
+
+        // A job generates the code for a single entry point (or the whole program) on a target.
+        //
+        // Each job links its own copy of the IR (with its own `SharedIRBuilder`), and reports
+        // diagnostics to its own sink. Other state is only read by jobs, or is made ready below.
+        struct Job
+        {
+            TargetProgram* targetProgram = nullptr;
+            Index entryPointIndex = -1;                 ///< -1 if it's for the whole program
+            DiagnosticSink sink;
+            std::exception_ptr exception;
+        };
+
+        List<Job> jobs;
+
+        auto addJob = [&](TargetProgram* targetProgram, Index entryPointIndex)
+        {
+            Job job;
+            job.targetProgram = targetProgram;
+            job.entryPointIndex = entryPointIndex;
+
+            // Use the same configuration as the request sink, but buffer the output
+            job.sink = *sink;
+            job.sink.setParentSink(nullptr);
+            job.sink.writer = nullptr;
+            job.sink.reset();
+
+            jobs.add(job);
+        };
+
+        for (auto targetReq : linkage->targets)
+        {
+            auto targetProgram = program->getTargetProgram(targetReq);
+
+            // Make sure state that is lazily evaluated is available before any job needs it
+            targetReq->getTargetCaps();
+            targetProgram->getOrCreateLayout(sink);
+            targetProgram->getOrCreateIRModuleForLayout(sink);
+
+            const Index firstJobIndex = jobs.getCount();
+            if (targetReq->isWholeProgramRequest())
+            {
+                addJob(targetProgram, -1);
+            }
+            else
+            {
+                const Index entryPointCount = program->getEntryPointCount();
+                for (Index ii = 0; ii < entryPointCount; ++ii)
+                {
+                    // Makes sure space for all of the results is allocated up front
+                    targetProgram->setEntryPointResult(ii, CompileResult());
+                    addJob(targetProgram, ii);
+                }
+            }
+
+            if (firstJobIndex == jobs.getCount())
+            {
+                continue;
+            }
+
+            // Loading downstream compilers modifies the session, so load any that might be used. Any
+            // diagnostics are reported by the first job for the target, as they would be if serial.
+            const auto target = targetReq->getTarget();
+            const auto sourceTarget = _getDefaultSourceForTarget(target);
+            const PassThroughMode compilerTypes[] =
+            {
+                (PassThroughMode)session->getDownstreamCompilerForTransition((SlangCompileTarget)sourceTarget, (SlangCompileTarget)target),
+                getDownstreamCompilerRequiredForTarget(target),
+            };
+            for (auto compilerType : compilerTypes)
+            {
+                if (compilerType != PassThroughMode::None)
+                {
+                    session->getOrLoadDownstreamCompiler(compilerType, &jobs[firstJobIndex].sink);
+                }
+            }
+        }
+
+        // Looking up the line for a location lazily calculates the line breaks for a file,
+        // so make sure they are available for all files that code generation could reference.
+        for (auto sourceManager = linkage->getSourceManager(); sourceManager; sourceManager = sourceManager->getParent())
+        {
+            for (auto sourceFile : sourceManager->getSourceFiles())
+            {
+                sourceFile->getLineBreakOffsets();
+            }
+        }
+
+        {
+            // The thread that waits also executes jobs
+            RefPtr<ThreadPool> threadPool = new ThreadPool(Math::Min(ThreadPool::getHardwareWorkerCount(), jobs.getCount()) - 1);
+
+            // Phases timed by a job are attributed to the phase that is active here
+            PerformanceReport* performanceReport = PerformanceReport::getCurrent();
+            const Index performancePhaseIndex = PerformanceReport::getCurrentPhaseIndex();
+
+            for (auto& job : jobs)
+            {
+                Job* jobPtr = &job;
+                threadPool->submit([this, jobPtr, performanceReport, performancePhaseIndex]()
+                {
+                    PerformanceReport::ThreadScope performanceReportScope(performanceReport, performancePhaseIndex);
+                    try
+                    {
+                        if (jobPtr->entryPointIndex < 0)
+                        {
+                            jobPtr->targetProgram->_createWholeProgramResult(&jobPtr->sink, this);
+                        }
+                        else
+                        {
+                            jobPtr->targetProgram->_createEntryPointResult(jobPtr->entryPointIndex, &jobPtr->sink, this);
+                        }
+                    }
+                    catch (...)
+                    {
+                        jobPtr->exception = std::current_exception();
+                    }
+                });
+            }
+
+            threadPool->waitAll();
+        }
+
+        // Output the diagnostics in the same order as they would be if generated serially. If a job
+        // failed with an exception, it is rethrown, and output of later jobs is discarded.
+        for (auto& job : jobs)
+        {
+            // If serial, code generation fails when there are any prior errors, so output isn't produced
+            if (sink->getErrorCount() != 0)
+            {
+                if (job.entryPointIndex < 0)
+                {
+                    job.targetProgram->setWholeProgramResult(CompileResult());
+                }
+                else
+                {
+                    job.targetProgram->setEntryPointResult(job.entryPointIndex, CompileResult());
+                }
+            }
+
+            sink->outputBufferedDiagnostics(&job.sink);
+            if (job.exception)
+            {
+                std::rethrow_exception(job.exception);
+            }
+        }
+    }
+
+    void EndToEndCompileRequest::_generateOutputWithCache()
+    {
+        auto program = getSpecializedGlobalAndEntryPointsComponentType();
+        const String& cacheDirectory = getLinkage()->m_cacheDirectory;
+
+        String key;
+        if (cacheDirectory.getLength() == 0 ||
+            SLANG_FAILED(CompileCacheUtil::calcKey(this, key)))
+        {
+            generateOutput(program);
+            return;
+        }
+
+        const String entryPath = CompileCacheUtil::calcEntryPath(cacheDirectory, key);
+        if (SLANG_SUCCEEDED(CompileCacheUtil::readEntry(entryPath, key, this)))
+        {
+            PerformanceReport::addToCounter(PerformanceCounter::CompileCacheHits, 1);
+            return;
+        }
+        PerformanceReport::addToCounter(PerformanceCounter::CompileCacheMisses, 1);
+
+        // Capture the diagnostics produced during code generation, so they can be stored
+        // with the entry, and replayed when it is used.
+        StringBuilder diagnostics;
+        {
+            struct ScopeWriter
+            {
+                ScopeWriter(DiagnosticSink* sink, ISlangWriter* writer) : m_sink(sink), m_writer(sink->writer) { sink->writer = writer; }
+                ~ScopeWriter() { m_sink->writer = m_writer; }
+                DiagnosticSink* m_sink;
+                ISlangWriter* m_writer;
+            };
+
+            ComPtr<ISlangWriter> captureWriter(new StringWriter(&diagnostics, 0));
+            ScopeWriter scopeWriter(getSink(), captureWriter);
+
+            generateOutput(program);
+        }
+        CompileCacheUtil::outputDiagnostics(getSink(), diagnostics.getUnownedSlice());
+
+        if (getSink()->getErrorCount() == 0)
+        {
+            // Failing to write to the cache doesn't fail the compilation
+            CompileCacheUtil::writeEntry(entryPath, key, this, diagnostics.getUnownedSlice());
+        }
+    }
+
     void EndToEndCompileRequest::generateOutput()
     {
-        generateOutput(getSpecializedGlobalAndEntryPointsComponentType());
+        _generateOutputWithCache();
 
         // If we are in command-line mode, we might be expected to actually
         // write output to one or more files here.
@@ -2636,4 +2919,40 @@ namespace Slang
         }
         return false;
     }
+
+    bool CodeGenContext::shouldReportIRPassTimings()
+    {
+        if (auto endToEndReq = isEndToEndCompile())
+        {
+            return endToEndReq->m_reportIRPassTimings;
+        }
+        return false;
+    }
+
+    bool CodeGenContext::isIRPassDisabled(const char* name)
+    {
+        if (auto endToEndReq = isEndToEndCompile())
+        {
+            return endToEndReq->m_disabledIRPasses.indexOf(UnownedStringSlice(name)) >= 0;
+        }
+        return false;
+    }
+
+    bool CodeGenContext::shouldVerifyIRSimplify()
+    {
+        if (auto endToEndReq = isEndToEndCompile())
+        {
+            return endToEndReq->m_verifyIRSimplify;
+        }
+        return false;
+    }
+
+    bool CodeGenContext::shouldVerifyIRCompaction()
+    {
+        if (auto endToEndReq = isEndToEndCompile())
+        {
+            return endToEndReq->m_verifyIRCompaction;
+        }
+        return false;
+    }
 }
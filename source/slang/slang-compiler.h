@@ -22,6 +22,9 @@
 #include "slang-profile.h"
 #include "slang-syntax.h"
 #include "slang-content-assist-info.h"
+#include "slang-performance-report.h"
+#include "slang-specialization-cache.h"
+#include "slang-lexed-file-cache.h"
 
 #include "slang-serialize-ir-types.h"
 
@@ -39,6 +42,7 @@ namespace Slang
     class TargetRequest;
     class TypeLayout;
     class Artifact;
+    class IRSerialDeferredModule;
 
     enum class CompilerMode
     {
@@ -333,6 +337,10 @@ namespace Slang
             int                     targetIndex,
             ISlangSharedLibrary**   outSharedLibrary,
             slang::IBlob**          outDiagnostics) SLANG_OVERRIDE;
+        SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCacheKey(
+            SlangInt        entryPointIndex,
+            SlangInt        targetIndex,
+            slang::IBlob**  outKey) SLANG_OVERRIDE;
 
             /// Get the linkage (aka "session" in the public API) for this component type.
         Linkage* getLinkage() { return m_linkage; }
@@ -342,6 +350,10 @@ namespace Slang
             /// The `target` must be a target on the `Linkage` that was used to create this program.
         TargetProgram* getTargetProgram(TargetRequest* target);
 
+            /// Calculate the approximate amount of memory used by this component type that isn't shared with
+            /// other component types (such as IR and generated code)
+        virtual size_t calcApproximateMemoryUsage();
+
             /// Get the number of entry points linked into this component type.
         virtual Index getEntryPointCount() = 0;
 
@@ -656,6 +668,8 @@ namespace Slang
 
         void acceptVisitor(ComponentTypeVisitor* visitor, SpecializationInfo* specializationInfo) SLANG_OVERRIDE;
 
+        size_t calcApproximateMemoryUsage() SLANG_OVERRIDE;
+
     protected:
 
         RefPtr<SpecializationInfo> _validateSpecializationArgsImpl(
@@ -736,6 +750,14 @@ namespace Slang
             return Super::renameEntryPoint(newName, outEntryPoint);
         }
 
+        SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCacheKey(
+            SlangInt        entryPointIndex,
+            SlangInt        targetIndex,
+            slang::IBlob**  outKey) SLANG_OVERRIDE
+        {
+            return Super::getEntryPointCacheKey(entryPointIndex, targetIndex, outKey);
+        }
+
         SLANG_NO_THROW SlangResult SLANG_MCALL link(
             slang::IComponentType** outLinkedComponentType,
             ISlangBlob** outDiagnostics) SLANG_OVERRIDE
@@ -872,6 +894,14 @@ namespace Slang
             return Super::renameEntryPoint(newName, outEntryPoint);
         }
 
+        SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCacheKey(
+            SlangInt        entryPointIndex,
+            SlangInt        targetIndex,
+            slang::IBlob**  outKey) SLANG_OVERRIDE
+        {
+            return Super::getEntryPointCacheKey(entryPointIndex, targetIndex, outKey);
+        }
+
         SLANG_NO_THROW SlangResult SLANG_MCALL link(
             slang::IComponentType**         outLinkedComponentType,
             ISlangBlob**                    outDiagnostics) SLANG_OVERRIDE
@@ -1078,6 +1108,14 @@ namespace Slang
             return Super::renameEntryPoint(newName, outEntryPoint);
         }
 
+        SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCacheKey(
+            SlangInt        entryPointIndex,
+            SlangInt        targetIndex,
+            slang::IBlob**  outKey) SLANG_OVERRIDE
+        {
+            return Super::getEntryPointCacheKey(entryPointIndex, targetIndex, outKey);
+        }
+
         SLANG_NO_THROW SlangResult SLANG_MCALL link(
             slang::IComponentType** outLinkedComponentType,
             ISlangBlob** outDiagnostics) SLANG_OVERRIDE
@@ -1126,6 +1164,7 @@ namespace Slang
         }
 
         SubtypeWitness* getSubtypeWitness() { return m_subtypeWitness; }
+        Int getConformanceIdOverride() { return m_conformanceIdOverride; }
         IRModule* getIRModule() { return m_irModule.Ptr(); }
     protected:
         void acceptVisitor(ComponentTypeVisitor* visitor, SpecializationInfo* specializationInfo)
@@ -1222,6 +1261,14 @@ namespace Slang
             return Super::renameEntryPoint(newName, outEntryPoint);
         }
 
+        SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCacheKey(
+            SlangInt        entryPointIndex,
+            SlangInt        targetIndex,
+            slang::IBlob**  outKey) SLANG_OVERRIDE
+        {
+            return Super::getEntryPointCacheKey(entryPointIndex, targetIndex, outKey);
+        }
+
         SLANG_NO_THROW SlangResult SLANG_MCALL link(
             slang::IComponentType**         outLinkedComponentType,
             ISlangBlob**                    outDiagnostics) SLANG_OVERRIDE
@@ -1261,7 +1308,17 @@ namespace Slang
         ModuleDecl* getModuleDecl() { return m_moduleDecl; }
 
             /// The the IR for the module (if it has been generated)
-        IRModule* getIRModule() { return m_irModule; }
+            ///
+            /// If the module has deferred IR, it is read on the first call.
+            ///
+        IRModule* getIRModule()
+        {
+            if (m_hasDeferredIRModule.load(std::memory_order_acquire))
+            {
+                _readDeferredIRModule();
+            }
+            return m_irModule;
+        }
 
             /// Get the list of other modules this module depends on
         List<Module*> const& getModuleDependencyList() { return m_moduleDependencyList.getModuleList(); }
@@ -1275,6 +1332,15 @@ namespace Slang
             /// Register a filesystem path that this module depends on
         void addFilePathDependency(String const& path);
 
+            /// Register a digest (such as a size and hash) of the content of a source file the module was parsed from.
+            ///
+            /// Unlike file path dependencies, these identify the source of the module when it wasn't loaded from a file.
+            ///
+        void addSourceContentDigest(String const& digest) { m_sourceContentDigests.add(digest); }
+
+            /// Get the digests of the content of the source files the module was parsed from
+        List<String> const& getSourceContentDigests() { return m_sourceContentDigests; }
+
             /// Set the AST for this module.
             ///
             /// This should only be called once, during creation of the module.
@@ -1287,6 +1353,12 @@ namespace Slang
             ///
         void setIRModule(IRModule* irModule) { m_irModule = irModule; }
 
+            /// Set the serialized IR for this module, which will be read when the IR is first needed.
+            ///
+            /// This should only be called once, during creation of the module, instead of `setIRModule`.
+            ///
+        void setDeferredIRModule(IRSerialDeferredModule* deferredIRModule);
+
         Index getEntryPointCount() SLANG_OVERRIDE { return 0; }
         RefPtr<EntryPoint> getEntryPoint(Index index) SLANG_OVERRIDE { SLANG_UNUSED(index); return nullptr; }
         String getEntryPointMangledName(Index index) SLANG_OVERRIDE { SLANG_UNUSED(index); return String(); }
@@ -1308,6 +1380,16 @@ namespace Slang
             /// If not found returns nullptr.
         NodeBase* findExportFromMangledName(const UnownedStringSlice& slice);
 
+            /// Get all of the exported symbols, and their mangled names
+        void getExportSymbols(List<UnownedStringSlice>& outMangledNames, List<NodeBase*>& outSymbols);
+
+            /// Set the exported symbols (for example as read from a serialized module), so they
+            /// don't have to be found by mangling every decl in the module.
+            ///
+            /// This should only be called once, during creation of the module.
+            ///
+        void setExportSymbols(const List<String>& mangledNames, const List<NodeBase*>& symbols);
+
             /// Get the ASTBuilder
         ASTBuilder* getASTBuilder() { return m_astBuilder; }
 
@@ -1341,6 +1423,8 @@ namespace Slang
         void _addEntryPoint(EntryPoint* entryPoint);
         void _processFindDeclsExportSymbolsRec(Decl* decl);
 
+        ~Module();
+
     protected:
         void acceptVisitor(ComponentTypeVisitor* visitor, SpecializationInfo* specializationInfo) SLANG_OVERRIDE;
 
@@ -1353,9 +1437,16 @@ namespace Slang
         // The AST for the module
         ModuleDecl*  m_moduleDecl = nullptr;
 
+        void _ensureExportSymbols();
+        void _readDeferredIRModule();
+
         // The IR for the module
         RefPtr<IRModule> m_irModule = nullptr;
 
+        // The serialized IR for the module, if it hasn't been read yet
+        RefPtr<IRSerialDeferredModule> m_deferredIRModule;
+        std::atomic<bool> m_hasDeferredIRModule{ false };
+
         List<ShaderParamInfo> m_shaderParams;
         SpecializationParams m_specializationParams;
 
@@ -1367,6 +1458,9 @@ namespace Slang
         // List of filesystem paths this module depends on
         FilePathDependencyList m_filePathDependencyList;
 
+        // Digests of the content of the source files the module was parsed from
+        List<String> m_sourceContentDigests;
+
         // Entry points that were defined in thsi module
         //
         // Note: the entry point defined in the module are *not*
@@ -1395,6 +1489,7 @@ namespace Slang
         // and m_mangledExportSymbols holds the NodeBase* values for each index. 
         StringSlicePool m_mangledExportPool;
         List<NodeBase*> m_mangledExportSymbols;
+        bool m_hasExportSymbols = false;
     };
     typedef Module LoadedModule;
 
@@ -1660,6 +1755,8 @@ namespace Slang
             ISlangBlob** outDiagnostics) override;
         SLANG_NO_THROW SlangResult SLANG_MCALL createCompileRequest(
             SlangCompileRequest**   outCompileRequest) override;
+        SLANG_NO_THROW SlangResult SLANG_MCALL getSpecializationCacheStats(
+            slang::SpecializationCacheStats* outStats) override;
 
         void addTarget(
             slang::TargetDesc const& desc);
@@ -1809,6 +1906,13 @@ namespace Slang
             DiagnosticSink*     sink,
             const LoadedModuleDictionary* loadedModules = nullptr);
 
+            /// Load a precompiled module (see `PrecompiledModuleUtil`) for the module source at filePathInfo, if
+            /// there is one that is valid. If found, the module is registered as loaded.
+        RefPtr<Module> _findPrecompiledModule(
+            Name*               name,
+            const PathInfo&     filePathInfo,
+            DiagnosticSink*     sink);
+
         SourceManager* getSourceManager()
         {
             return m_sourceManager;
@@ -1846,6 +1950,16 @@ namespace Slang
         bool m_requireCacheFileSystem = false;
         bool m_useFalcorCustomSharedKeywordSemantics = false;
 
+            /// If set, the output of end-to-end compile requests is cached in this directory (see `CompileCacheUtil`),
+            /// as are modules that are imported (see `PrecompiledModuleUtil`)
+        String m_cacheDirectory;
+
+            /// Cache of the component types produced by specializing and linking
+        SpecializationCache m_specializationCache;
+
+            /// Cache of the tokens lexed from `#include`d files
+        LexedFileCache m_lexedFileCache;
+
         // Modules that have been read in with the -r option
         List<ComPtr<IArtifact>> m_libModules;
 
@@ -2172,6 +2286,9 @@ namespace Slang
             /// code generation to the given `sink`.
             ///
         CompileResult& getOrCreateEntryPointResult(Int entryPointIndex, DiagnosticSink* sink);
+
+            /// Calculate the approximate amount of memory used by the layout IR and generated code
+        size_t calcApproximateMemoryUsage();
         CompileResult& getOrCreateWholeProgramResult(DiagnosticSink* sink);
 
 
@@ -2189,6 +2306,12 @@ namespace Slang
             return m_entryPointResults[entryPointIndex];
         }
 
+            /// Set the compiled code for an entry point on the target, for example
+            /// when it has been found in a cache.
+        void setEntryPointResult(Int entryPointIndex, CompileResult const& result);
+            /// Set the compiled code for the whole program on the target.
+        void setWholeProgramResult(CompileResult const& result) { m_wholeProgramResult = result; }
+
         CompileResult& _createWholeProgramResult(
             DiagnosticSink*         sink,
             EndToEndCompileRequest* endToEndReq = nullptr);
@@ -2414,6 +2537,15 @@ namespace Slang
 
         bool isSpecializationDisabled();
 
+            /// True if the time taken by each IR pass should be added to the performance report (see `IRPassManager`)
+        bool shouldReportIRPassTimings();
+            /// True if the IR pass called `name` has been disabled (with `-ir-disable-pass`)
+        bool isIRPassDisabled(const char* name);
+            /// True if simplifyIR should check the code it skips (with `-verify-ir-simplify`)
+        bool shouldVerifyIRSimplify();
+            /// True if the IR module should always be compacted, and validated afterwards (with `-verify-ir-compaction`)
+        bool shouldVerifyIRCompaction();
+
         //
 
         CompileResult emitEntryPoints();
@@ -2582,6 +2714,9 @@ namespace Slang
             SlangSeverity overrideSeverity) SLANG_OVERRIDE;
         virtual SLANG_NO_THROW SlangDiagnosticFlags SLANG_MCALL getDiagnosticFlags() SLANG_OVERRIDE;
         virtual SLANG_NO_THROW void SLANG_MCALL setDiagnosticFlags(SlangDiagnosticFlags flags) SLANG_OVERRIDE;
+        virtual SLANG_NO_THROW void SLANG_MCALL setReportPerformance(bool enable) SLANG_OVERRIDE;
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getPerformanceReport(SlangPerformanceReportFormat format, ISlangBlob** outBlob) SLANG_OVERRIDE;
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getPerformanceCounter(const char* name, int64_t* outValue) SLANG_OVERRIDE;
 
         EndToEndCompileRequest(
             Session* session);
@@ -2725,6 +2860,26 @@ namespace Slang
         // If true will disable generating dynamic dispatch code.
         bool disableDynamicDispatch = false;
 
+        // If true, code generation for each target and entry point can be performed in parallel.
+        bool m_parallelCodegen = false;
+
+            /// If true, a performance report is collected on compile
+        bool m_reportPerformance = false;
+            /// The format the performance report is written in, for command line compiles
+        SlangPerformanceReportFormat m_performanceReportFormat = SLANG_PERFORMANCE_REPORT_FORMAT_TEXT;
+            /// The report collected by the last compile, if enabled
+        RefPtr<PerformanceReport> m_performanceReport;
+
+            /// If true, the time taken by each IR pass is collected in the performance report, and for command
+            /// line compiles written on its own if a full report isn't requested
+        bool m_reportIRPassTimings = false;
+            /// The names of optimization IR passes that aren't run
+        List<String> m_disabledIRPasses;
+            /// If true, simplifyIR checks that the code it skips as unmodified is fully simplified
+        bool m_verifyIRSimplify = false;
+            /// If true, the IR module is compacted whether or not it is wasteful, and validated afterwards
+        bool m_verifyIRCompaction = false;
+
         // The default IR dumping options
 //        IRDumpOptions m_irDumpOptions;
 
@@ -2742,6 +2897,14 @@ namespace Slang
         void generateOutput(ComponentType* program);
         void generateOutput(TargetProgram* targetProgram);
 
+            /// Generates output for the program, using the cache directory of the linkage (if set)
+        void _generateOutputWithCache();
+
+            /// True if output for program can be generated with `_generateOutputInParallel`
+        bool _canGenerateOutputInParallel(ComponentType* program);
+            /// Generates output for each target and entry point of program on a thread pool
+        void _generateOutputInParallel(ComponentType* program);
+
         void init();
 
         Session*                        m_session = nullptr;
@@ -2873,6 +3036,7 @@ namespace Slang
         SLANG_NO_THROW SlangPassThrough SLANG_MCALL getDownstreamCompilerForTransition(SlangCompileTarget source, SlangCompileTarget target) override;
         SLANG_NO_THROW double SLANG_MCALL getDownstreamCompilerElapsedTime() override
         {
+            std::lock_guard<std::recursive_mutex> lock(m_downstreamCompilerMutex);
             return m_downstreamCompileTime;
         }
 
@@ -2951,7 +3115,15 @@ namespace Slang
             String const&           source);
         ~Session();
 
-        void addDownstreamCompileTime(double time) { m_downstreamCompileTime += time; }
+        void addDownstreamCompileTime(double time)
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_downstreamCompilerMutex);
+            m_downstreamCompileTime += time;
+        }
+
+            /// Make the builtin (stdlib) state immutable, so that it can be read by sessions compiling on
+            /// different threads. Called once the stdlib has been compiled or loaded.
+        void _freezeBuiltinState();
 
         ComPtr<ISlangSharedLibraryLoader> m_sharedLibraryLoader;                    ///< The shared library loader (never null)
 
@@ -2981,6 +3153,11 @@ namespace Slang
         CodeGenTransitionMap m_codeGenTransitionMap;
 
         double m_downstreamCompileTime = 0.0;
+
+            /// Guards loading of downstream compilers, and m_downstreamCompileTime, as sessions
+            /// created from this global session may compile on different threads.
+            /// Recursive because loading a generic C/C++ compiler loads the other C/C++ compilers.
+        std::recursive_mutex m_downstreamCompilerMutex;
     };
 
     void checkTranslationUnit(
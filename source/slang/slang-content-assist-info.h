@@ -3,6 +3,7 @@
 #pragma once
 
 #include "slang-syntax.h"
+#include "../compiler-core/slang-diagnostic-sink.h"
 #include "../../slang.h"
 
 namespace Slang
@@ -107,6 +108,10 @@ struct ContentAssistInfo
     // The preprocessors definitions and invocations found during preprocessing. Filled in during
     // preprocessing.
     PreprocessorContentAssistInfo preprocessorInfo;
+
+    // If set, receives the diagnostics reported when loading a module, instead of them being
+    // output as text. Provided by the language server.
+    DiagnosticListener* diagnosticListener = nullptr;
 };
 
 }
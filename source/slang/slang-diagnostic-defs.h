@@ -129,6 +129,8 @@ DIAGNOSTIC(    94, Error, unableToReadRiff, "unable to read as 'riff'/not a 'rif
 DIAGNOSTIC(    95, Error, unknownLibraryKind, "unknown library kind '$0'")
 DIAGNOSTIC(    96, Error, kindNotLinkable, "not a known linkable kind '$0'")
 DIAGNOSTIC(    97, Error, libraryDoesNotExist, "library '$0' does not exist")
+DIAGNOSTIC(    98, Error, permutationRequiresSingleOutput, "compiling permutations requires a single target, and at most one entry point")
+DIAGNOSTIC(    99, Warning, irPassCannotBeDisabled, "the IR pass '$0' is required for code generation, and can't be disabled")
 
 //
 // 001xx - Downstream Compilers
@@ -594,6 +596,9 @@ DIAGNOSTIC(52005, Error, unableToReadFile, "unable to read file '$0'")
 
 DIAGNOSTIC(52006, Error, compilerNotDefinedForTransition, "compiler not defined for transition '$0' to '$1'.")
 
+DIAGNOSTIC(52007, Error, spmdGroupSharedUnsupported, "groupshared variable '$0' can't be used with -emit-cpp-spmd, as each thread of a group has its own copy")
+DIAGNOSTIC(52008, Error, spmdBarrierUnsupported, "'$0' can't be used with -emit-cpp-spmd, as the threads of a group can't be synchronized")
+
 DIAGNOSTIC(53001,Error, invalidTypeMarshallingForImportedDLLSymbol, "invalid type marshalling in imported func $0.")
 
 //
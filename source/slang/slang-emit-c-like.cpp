@@ -1193,9 +1193,9 @@ bool CLikeSourceEmitter::shouldFoldInstIntoUseSites(IRInst* inst)
         return false;
 
     // Okay, at this point we know our instruction must have a single use.
-    auto use = inst->firstUse;
+    auto use = inst->getFirstUse();
     SLANG_ASSERT(use);
-    SLANG_ASSERT(!use->nextUse);
+    SLANG_ASSERT(!use->getNextUse());
 
     auto user = use->getUser();
 
@@ -3275,9 +3275,9 @@ static bool _shouldSkipFuncEmit(IRInst* func)
     // and this is handled by `emitComWitnessTable`.
 
     if (func->hasMoreThanOneUse()) return false;
-    if (func->firstUse)
+    if (func->getFirstUse())
     {
-        if (auto entry = as<IRWitnessTableEntry>(func->firstUse->getUser()))
+        if (auto entry = as<IRWitnessTableEntry>(func->getFirstUse()->getUser()))
         {
             if (auto table = as<IRWitnessTable>(entry->getParent()))
             {
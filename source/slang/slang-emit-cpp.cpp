@@ -2022,6 +2022,20 @@ void CPPSourceEmitter::emitSimpleFuncImpl(IRFunc* func)
         // Because the workhorse function doesn't have the right signature to service
         // general-purpose calls, it is being emitted with a `_` prefix.
         //
+        // When generating SPMD code the workhorse needs to be inlined into the loop over
+        // the group's threads for that loop to be vectorized, so it is made internal
+        // (so it can't be interposed) and is always inlined.
+        if (_isSPMD() && entryPointDecor->getProfile().getStage() == Stage::Compute)
+        {
+            bool isExternC = false;
+            bool isExported = false;
+            _getExportStyle(func, isExported, isExternC);
+            if (!isExported && !isExternC)
+            {
+                m_writer->emit("static SLANG_PRELUDE_SIMD_INLINE ");
+            }
+        }
+
         StringBuilder prefixName;
         prefixName << "_" << name;
         emitType(resultType, prefixName);
@@ -2857,6 +2871,90 @@ void CPPSourceEmitter::_emitEntryPointGroup(const Int sizeAlongAxis[kThreadGroup
     }
 }
 
+void CPPSourceEmitter::_emitEntryPointGroupSPMD(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName)
+{
+    // The threads of the group along x are executed by an inner loop, such that the C++
+    // compiler can map consecutive threads onto SIMD lanes (the lane width is determined
+    // by the instruction set the C++ compiler is targetting, see `SLANG_PRELUDE_SIMD_WIDTH`).
+    // Outer loops (if needed) execute the y and z axes.
+    //
+    // Each iteration has its own `threadInput`, so there is no dependency between
+    // iterations other than any introduced by the kernel itself. Divergent control flow within
+    // the kernel is handled by the C++ compiler through predication/masking of the lanes.
+    //
+    // Buffers are typically indexed by the dispatch thread ID, which is unsigned 32 bit, and so
+    // could wrap around. The C++ compiler can't vectorize accesses with an index that may wrap,
+    // so when the group's dispatch thread IDs along x fit in an int32_t, the lane loop iterates
+    // over them as an int32_t (which can't wrap). The kernel's calculation of the dispatch thread
+    // ID then folds to the loop variable. Otherwise the threads are executed by the same loops as
+    // `_emitEntryPointGroup`.
+
+    const Int sizeX = sizeAlongAxis[0];
+
+    StringBuilder builder;
+    builder << "if (groupID.x < 0x7fffffffU / " << sizeX << "U)\n{\n";
+    m_writer->emit(builder);
+    m_writer->indent();
+
+    builder.Clear();
+    builder << "const int32_t startX = int32_t(groupID.x * " << sizeX << "U);\n";
+    m_writer->emit(builder);
+
+    // Open the loops for the other axes
+    Index openCount = 0;
+    for (int i = kThreadGroupAxisCount - 1; i > 0; --i)
+    {
+        if (sizeAlongAxis[i] > 1)
+        {
+            const char elem[2] = { s_xyzwNames[i], 0 };
+            builder.Clear();
+            builder << "for (uint32_t " << elem << " = 0; " << elem << " < " << sizeAlongAxis[i] << "; ++" << elem << ")\n{\n";
+            m_writer->emit(builder);
+            m_writer->indent();
+            openCount++;
+        }
+    }
+
+    m_writer->emit("SLANG_PRELUDE_SIMD_LOOP\n");
+    builder.Clear();
+    builder << "for (int32_t x = startX; x < startX + " << sizeX << "; ++x)\n{\n";
+    m_writer->emit(builder);
+    m_writer->indent();
+
+    m_writer->emit("ComputeThreadVaryingInput threadInput;\n");
+    m_writer->emit("threadInput.groupID = groupID;\n");
+    m_writer->emit("threadInput.groupThreadID.x = uint32_t(x - startX);\n");
+    for (int i = 1; i < kThreadGroupAxisCount; ++i)
+    {
+        const char elem[2] = { s_xyzwNames[i], 0 };
+        builder.Clear();
+        builder << "threadInput.groupThreadID." << elem << " = " << ((sizeAlongAxis[i] > 1) ? elem : "0") << ";\n";
+        m_writer->emit(builder);
+    }
+
+    m_writer->emit("_");
+    m_writer->emit(funcName);
+    m_writer->emit("(&threadInput, entryPointParams, globalParams);\n");
+
+    // Close the lane loop, and the loops for the other axes
+    for (Index i = 0; i < openCount + 1; ++i)
+    {
+        m_writer->dedent();
+        m_writer->emit("}\n");
+    }
+
+    m_writer->dedent();
+    m_writer->emit("}\nelse\n{\n");
+    m_writer->indent();
+
+    m_writer->emit("ComputeThreadVaryingInput threadInput = {};\n");
+    m_writer->emit("threadInput.groupID = groupID;\n");
+    _emitEntryPointGroup(sizeAlongAxis, funcName);
+
+    m_writer->dedent();
+    m_writer->emit("}\n");
+}
+
 void CPPSourceEmitter::_emitEntryPointGroupRange(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName)
 {
     List<AxisWithSize> axes;
@@ -3043,10 +3141,18 @@ void CPPSourceEmitter::emitModuleImpl(IRModule* module, DiagnosticSink* sink)
 
                     _emitEntryPointDefinitionStart(func, groupFuncName, UnownedStringSlice::fromLiteral("ComputeVaryingInput"));
 
-                    m_writer->emit("ComputeThreadVaryingInput threadInput = {};\n");
-                    m_writer->emit("threadInput.groupID = varyingInput->startGroupID;\n");
+                    if (_isSPMD())
+                    {
+                        m_writer->emit("const uint3 groupID = varyingInput->startGroupID;\n");
+                        _emitEntryPointGroupSPMD(groupThreadSize, funcName);
+                    }
+                    else
+                    {
+                        m_writer->emit("ComputeThreadVaryingInput threadInput = {};\n");
+                        m_writer->emit("threadInput.groupID = varyingInput->startGroupID;\n");
 
-                    _emitEntryPointGroup(groupThreadSize, funcName);
+                        _emitEntryPointGroup(groupThreadSize, funcName);
+                    }
                     _emitEntryPointDefinitionEnd(func);
                 }
 
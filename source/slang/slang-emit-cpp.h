@@ -123,6 +123,11 @@ protected:
     void _emitEntryPointDefinitionEnd(IRFunc* func);
     void _emitEntryPointGroup(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName);
     void _emitEntryPointGroupRange(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName);
+        /// Emits the threads of a group such that those along x are executed by a loop that can be vectorized by the C++ compiler
+    void _emitEntryPointGroupSPMD(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName);
+
+        /// True if compute entry points should be emitted such that a group's threads execute as SIMD lanes
+    bool _isSPMD() { return (getTargetReq()->getTargetFlags() & SLANG_TARGET_FLAG_GENERATE_SPMD) != 0; }
 
     void _emitInitAxisValues(const Int sizeAlongAxis[kThreadGroupAxisCount], const UnownedStringSlice& mulName, const UnownedStringSlice& addName);
 
@@ -1543,7 +1543,7 @@ struct SPIRVEmitContext
         /// Check if a block is a loop's target block.
     bool isLoopTargetBlock(IRInst* block, IRInst*& loopInst)
     {
-        for (auto use = block->firstUse; use; use = use->nextUse)
+        for (auto use = block->getFirstUse(); use; use = use->getNextUse())
         {
             if (use->getUser()->getOp() == kIROp_loop &&
                 as<IRLoop>(use->getUser())->getTargetBlock() == block)
@@ -2141,7 +2141,7 @@ struct SPIRVEmitContext
             emitOperand(inst->getFullType());
             emitOperand(kResultID);
             // Find phi arguments from incoming branch instructions that target `block`.
-            for (auto use = block->firstUse; use; use = use->nextUse)
+            for (auto use = block->getFirstUse(); use; use = use->getNextUse())
             {
                 auto branchInst = use->getUser();
                 UInt argStartIndex = 0;
@@ -7,6 +7,7 @@
 
 #include "slang-ir-bind-existentials.h"
 #include "slang-ir-byte-address-legalize.h"
+#include "slang-ir-check-spmd.h"
 #include "slang-ir-collect-global-uniforms.h"
 #include "slang-ir-cleanup-void.h"
 #include "slang-ir-dce.h"
@@ -31,6 +32,7 @@
 #include "slang-ir-lower-reinterpret.h"
 #include "slang-ir-metadata.h"
 #include "slang-ir-optix-entry-point-uniforms.h"
+#include "slang-ir-pass-manager.h"
 #include "slang-ir-restructure.h"
 #include "slang-ir-restructure-scoping.h"
 #include "slang-ir-sccp.h"
@@ -52,6 +54,7 @@
 #include "slang-legalize-types.h"
 #include "slang-lower-to-ir.h"
 #include "slang-mangle.h"
+#include "slang-performance-report.h"
 
 #include "slang-syntax.h"
 #include "slang-type-layout.h"
@@ -167,6 +170,58 @@ static void dumpIRIfEnabled(
     }
 }
 
+    /// Compact the IR module if most of its memory is taken up by instructions that have been removed.
+    ///
+    /// Passes such as specialization, type legalization and SSA construction replace many instructions,
+    /// and the memory of replaced instructions is only partially reused by later passes.
+    ///
+    /// With `-verify-ir-compaction` the module is always compacted, and validated afterwards. Some code
+    /// already produces IR that doesn't validate before compaction, so the full validation is only
+    /// required to pass afterwards if it passed before.
+static void compactIRModuleIfWasteful(
+    CodeGenContext* codeGenContext,
+    IRModule*   irModule,
+    LinkedIR&   linkedIR,
+    List<IRFunc*>& irEntryPoints)
+{
+    const bool shouldVerify = codeGenContext->shouldVerifyIRCompaction();
+    const size_t usedBytes = irModule->getMemoryArena().calcTotalMemoryUsed();
+    if (!shouldVerify && irModule->calcInstBytesInUse() * 2 > usedBytes)
+    {
+        return;
+    }
+
+    const bool wasValid = shouldVerify && isIRModuleValid(irModule);
+
+    Dictionary<IRInst*, IRInst*> remap;
+    irModule->compact(&remap);
+
+    // Update the instructions we hold. Any that have been removed from the module (such as a layout
+    // that is no longer used) no longer exist.
+    auto remapInst = [&](IRInst* inst) -> IRInst*
+    {
+        IRInst** newInst = inst ? remap.TryGetValue(inst) : nullptr;
+        return newInst ? *newInst : nullptr;
+    };
+
+    for (auto& entryPoint : linkedIR.entryPoints)
+    {
+        entryPoint = as<IRFunc>(remapInst(entryPoint));
+    }
+    irEntryPoints = linkedIR.entryPoints;
+
+    linkedIR.globalScopeVarLayout = as<IRVarLayout>(remapInst(linkedIR.globalScopeVarLayout));
+
+    if (shouldVerify)
+    {
+        validateIRModuleMemory(irModule, codeGenContext->getSink());
+        if (wasValid)
+        {
+            validateIRModule(irModule, codeGenContext->getSink());
+        }
+    }
+}
+
 struct LinkingAndOptimizationOptions
 {
     bool shouldLegalizeExistentialAndResourceTypes = true;
@@ -178,6 +233,8 @@ Result linkAndOptimizeIR(
     LinkingAndOptimizationOptions const&    options,
     LinkedIR&                               outLinkedIR)
 {
+    SLANG_PERFORMANCE_PHASE("linkAndOptimizeIR");
+
     auto session = codeGenContext->getSession();
     auto sink = codeGenContext->getSink();
     auto target = codeGenContext->getTargetFormat();
@@ -209,25 +266,31 @@ Result linkAndOptimizeIR(
     // un-specialized IR.
     dumpIRIfEnabled(codeGenContext, irModule);
 
+    // The passes below are run through the pass manager, which names and times them,
+    // and skips those that don't need to run (see `IRPassManager`).
+    IRPassManager passManager(codeGenContext, irModule);
+
+    irModule->getSimplifiedEpochs().shouldVerify = codeGenContext->shouldVerifyIRSimplify();
+
     switch (target)
     {
         case CodeGenTarget::CPPSource:
         case CodeGenTarget::HostCPPSource:
         {
-            lowerComInterfaces(irModule, artifactDesc.style, sink);
-            generateDllImportFuncs(irModule, sink);
-            generateDllExportFuncs(irModule, sink);
+            passManager.run("lowerComInterfaces", [&]() { lowerComInterfaces(irModule, artifactDesc.style, sink); });
+            passManager.run("generateDllImportFuncs", [&]() { generateDllImportFuncs(irModule, sink); });
+            passManager.run("generateDllExportFuncs", [&]() { generateDllExportFuncs(irModule, sink); });
             break;
         }
         default: break;
     }
 
     // Lower `Result<T,E>` types into ordinary struct types.
-    lowerResultType(irModule, sink);
+    passManager.run("lowerResultType", [&]() { lowerResultType(irModule, sink); });
 
     // Replace any global constants with their values.
     //
-    replaceGlobalConstants(irModule);
+    passManager.run("replaceGlobalConstants", [&]() { replaceGlobalConstants(irModule); });
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "GLOBAL CONSTANTS REPLACED");
 #endif
@@ -241,7 +304,7 @@ Result linkAndOptimizeIR(
     // shader parameters for those slots, to be wired up to
     // use sites.
     //
-    bindExistentialSlots(irModule, sink);
+    passManager.run("bindExistentialSlots", [&]() { bindExistentialSlots(irModule, sink); });
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "EXISTENTIALS BOUND");
 #endif
@@ -265,7 +328,7 @@ Result linkAndOptimizeIR(
     // can assume that all ordinary/uniform data is strictly
     // passed using constant buffers.
     //
-    collectGlobalUniformParameters(irModule, outLinkedIR.globalScopeVarLayout);
+    passManager.run("collectGlobalUniformParameters", [&]() { collectGlobalUniformParameters(irModule, outLinkedIR.globalScopeVarLayout); });
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "GLOBAL UNIFORMS COLLECTED");
 #endif
@@ -286,7 +349,7 @@ Result linkAndOptimizeIR(
         case CodeGenTarget::HostCPPSource:
             break;
         case CodeGenTarget::CUDASource:
-            collectOptiXEntryPointUniformParams(irModule);
+            passManager.run("collectOptiXEntryPointUniformParams", [&]() { collectOptiXEntryPointUniformParams(irModule); });
             #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "OPTIX ENTRY POINT UNIFORMS COLLECTED");
             #endif
@@ -296,7 +359,7 @@ Result linkAndOptimizeIR(
         case CodeGenTarget::CPPSource:
             passOptions.alwaysCreateCollectedParam = true;
         default:
-            collectEntryPointUniformParams(irModule, passOptions);
+            passManager.run("collectEntryPointUniformParams", [&]() { collectEntryPointUniformParams(irModule, passOptions); });
         #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "ENTRY POINT UNIFORMS COLLECTED");
         #endif
@@ -308,7 +371,7 @@ Result linkAndOptimizeIR(
     switch( target )
     {
     default:
-        moveEntryPointUniformParamsToGlobalScope(irModule);
+        passManager.run("moveEntryPointUniformParamsToGlobalScope", [&]() { moveEntryPointUniformParamsToGlobalScope(irModule); });
     #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "ENTRY POINT UNIFORMS MOVED");
     #endif
@@ -324,7 +387,7 @@ Result linkAndOptimizeIR(
     // Desguar any union types, since these will be illegal on
     // various targets.
     //
-    desugarUnionTypes(irModule);
+    passManager.run("desugarUnionTypes", [&]() { desugarUnionTypes(irModule); });
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "UNIONS DESUGARED");
 #endif
@@ -351,21 +414,24 @@ Result linkAndOptimizeIR(
     //
     dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-SPECIALIZE");
     if (!codeGenContext->isSpecializationDisabled())
-        specializeModule(irModule);
+        passManager.run("specializeModule", [&]() { specializeModule(irModule); });
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER-SPECIALIZE");
 
-    applySparseConditionalConstantPropagation(irModule);
-    eliminateDeadCode(irModule);
+    passManager.run("applySparseConditionalConstantPropagation", IRPassFlag::SkipIfUnchanged, [&]() { applySparseConditionalConstantPropagation(irModule); });
+    passManager.run("eliminateDeadCode", IRPassFlag::SkipIfUnchanged, [&]() { eliminateDeadCode(irModule); });
 
-    lowerReinterpret(targetRequest, irModule, sink);
+    passManager.run("lowerReinterpret", [&]() { lowerReinterpret(targetRequest, irModule, sink); });
 
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
+    // Instructions removed by the passes so far can have their memory reused by later passes
+    irModule->recycleDeallocatedInsts();
+
     // For targets that supports dynamic dispatch, we need to lower the
     // generics / interface types to ordinary functions and types using
     // function pointers.
     dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-LOWER-GENERICS");
-    lowerGenerics(targetRequest, irModule, sink);
+    passManager.run("lowerGenerics", [&]() { lowerGenerics(targetRequest, irModule, sink); });
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER-LOWER-GENERICS");
 
     if (sink->getErrorCount() != 0)
@@ -382,15 +448,15 @@ Result linkAndOptimizeIR(
     // Inline calls to any functions marked with [__unsafeInlineEarly] again,
     // since we may be missing out cases prevented by the generic constructs
     // that we just lowered out.
-    performMandatoryEarlyInlining(irModule);
+    passManager.run("performMandatoryEarlyInlining", [&]() { performMandatoryEarlyInlining(irModule); });
 
     // Specialization can introduce dead code that could trip
     // up downstream passes like type legalization, so we
     // will run a DCE pass to clean up after the specialization.
     //
-    simplifyIR(irModule);
+    passManager.run("simplifyIR", IRPassFlag::SkipIfUnchanged, [&]() { simplifyIR(irModule); });
 
-    lowerOptionalType(irModule, sink);
+    passManager.run("lowerOptionalType", [&]() { lowerOptionalType(irModule, sink); });
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER DCE");
@@ -426,10 +492,8 @@ Result linkAndOptimizeIR(
         //  we need to replace it with just an `X`, after which we
         //  will have (more) legal shader code.
         //
-        legalizeExistentialTypeLayout(
-            irModule,
-            sink);
-        eliminateDeadCode(irModule);
+        passManager.run("legalizeExistentialTypeLayout", [&]() { legalizeExistentialTypeLayout(irModule, sink); });
+        passManager.run("eliminateDeadCode", IRPassFlag::SkipIfUnchanged, [&]() { eliminateDeadCode(irModule); });
 
 #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "EXISTENTIALS LEGALIZED");
@@ -447,16 +511,16 @@ Result linkAndOptimizeIR(
         // What used to be individual variables/parameters/arguments/etc.
         // then become multiple variables/parameters/arguments/etc.
         //
-        legalizeResourceTypes(
-            irModule,
-            sink);
-        eliminateDeadCode(irModule);
+        passManager.run("legalizeResourceTypes", [&]() { legalizeResourceTypes(irModule, sink); });
+        passManager.run("eliminateDeadCode", IRPassFlag::SkipIfUnchanged, [&]() { eliminateDeadCode(irModule); });
 
         //  Debugging output of legalization
     #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "LEGALIZED");
     #endif
         validateIRModuleIfEnabled(codeGenContext, irModule);
+
+        irModule->recycleDeallocatedInsts();
     }
 
     // Once specialization and type legalization have been performed,
@@ -464,13 +528,18 @@ Result linkAndOptimizeIR(
     // to see if we can clean up any temporaries created by legalization.
     // (e.g., things that used to be aggregated might now be split up,
     // so that we can work with the individual fields).
-    simplifyIR(irModule);
+    passManager.run("simplifyIR", IRPassFlag::SkipIfUnchanged, [&]() { simplifyIR(irModule); });
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER SSA");
 #endif
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
+    // Most of the instructions that will be replaced have been by now, so if they take up much of
+    // the memory of the module, it's worth compacting it for the passes that follow.
+    irModule->recycleDeallocatedInsts();
+    compactIRModuleIfWasteful(codeGenContext, irModule, outLinkedIR, irEntryPoints);
+
     // After type legalization and subsequent SSA cleanup we expect
     // that any resource types passed to functions are exposed
     // as their own top-level parameters (which might have
@@ -480,19 +549,19 @@ Result linkAndOptimizeIR(
     // resource types can be used, so that having them as
     // function parameters, reults, etc. is invalid.
     // We clean up the usages of resource values here.
-    specializeResourceUsage(codeGenContext, irModule);
-    specializeFuncsForBufferLoadArgs(codeGenContext, irModule);
+    passManager.run("specializeResourceUsage", [&]() { specializeResourceUsage(codeGenContext, irModule); });
+    passManager.run("specializeFuncsForBufferLoadArgs", IRPassFlag::Optimization, [&]() { specializeFuncsForBufferLoadArgs(codeGenContext, irModule); });
 
     //
-    simplifyIR(irModule);
+    passManager.run("simplifyIR", IRPassFlag::SkipIfUnchanged, [&]() { simplifyIR(irModule); });
 
     // For GLSL targets, we also want to specialize calls to functions that
     // takes array parameters if possible, to avoid performance issues on
     // those platforms.
     if (isKhronosTarget(targetRequest))
     {
-        specializeArrayParameters(codeGenContext, irModule);
-        simplifyIR(irModule);
+        passManager.run("specializeArrayParameters", IRPassFlag::Optimization, [&]() { specializeArrayParameters(codeGenContext, irModule); });
+        passManager.run("simplifyIR", IRPassFlag::SkipIfUnchanged, [&]() { simplifyIR(irModule); });
     }
 
 #if 0
@@ -512,7 +581,7 @@ Result linkAndOptimizeIR(
     {
     case CodeGenTarget::HLSL:
         {
-            wrapStructuredBuffersOfMatrices(irModule);
+            passManager.run("wrapStructuredBuffersOfMatrices", [&]() { wrapStructuredBuffersOfMatrices(irModule); });
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "STRUCTURED BUFFERS WRAPPED");
 #endif
@@ -609,7 +678,7 @@ Result linkAndOptimizeIR(
             break;
         }
 
-        legalizeByteAddressBufferOps(session, targetRequest, irModule, byteAddressBufferOptions);
+        passManager.run("legalizeByteAddressBufferOps", [&]() { legalizeByteAddressBufferOps(session, targetRequest, irModule, byteAddressBufferOptions); });
     }
 
     // For CUDA targets only, we will need to turn operations
@@ -621,9 +690,7 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CUDASource:
     case CodeGenTarget::PTX:
         {
-            synthesizeActiveMask(
-                irModule,
-                codeGenContext->getSink());
+            passManager.run("synthesizeActiveMask", [&]() { synthesizeActiveMask(irModule, codeGenContext->getSink()); });
 
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "AFTER synthesizeActiveMask");
@@ -650,12 +717,15 @@ Result linkAndOptimizeIR(
     {
         auto glslExtensionTracker = as<GLSLExtensionTracker>(options.sourceEmitter->getExtensionTracker());
 
-        legalizeEntryPointsForGLSL(
-            session,
-            irModule,
-            irEntryPoints,
-            codeGenContext->getSink(),
-            glslExtensionTracker);
+        passManager.run("legalizeEntryPointsForGLSL", [&]()
+        {
+            legalizeEntryPointsForGLSL(
+                session,
+                irModule,
+                irEntryPoints,
+                codeGenContext->getSink(),
+                glslExtensionTracker);
+        });
 
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "GLSL LEGALIZED");
@@ -667,13 +737,20 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CSource:
     case CodeGenTarget::CPPSource:
         {
-            legalizeEntryPointVaryingParamsForCPU(irModule, codeGenContext->getSink());
+            if (targetRequest->getTargetFlags() & SLANG_TARGET_FLAG_GENERATE_SPMD)
+            {
+                checkForSPMDUnsupportedFeatures(irModule, sink);
+                if (sink->getErrorCount() != 0)
+                    return SLANG_FAIL;
+            }
+
+            passManager.run("legalizeEntryPointVaryingParamsForCPU", [&]() { legalizeEntryPointVaryingParamsForCPU(irModule, codeGenContext->getSink()); });
         }
         break;
 
     case CodeGenTarget::CUDASource:
         {
-            legalizeEntryPointVaryingParamsForCUDA(irModule, codeGenContext->getSink());
+            passManager.run("legalizeEntryPointVaryingParamsForCUDA", [&]() { legalizeEntryPointVaryingParamsForCUDA(irModule, codeGenContext->getSink()); });
         }
         break;
 
@@ -686,7 +763,7 @@ Result linkAndOptimizeIR(
     {
     case CodeGenTarget::GLSL:
         {
-            legalizeImageSubscriptForGLSL(irModule);
+            passManager.run("legalizeImageSubscriptForGLSL", [&]() { legalizeImageSubscriptForGLSL(irModule); });
         }
         break;
     default:
@@ -700,11 +777,11 @@ Result linkAndOptimizeIR(
 
     case CodeGenTarget::CPPSource:
     case CodeGenTarget::CUDASource:
-        moveGlobalVarInitializationToEntryPoints(irModule);
-        introduceExplicitGlobalContext(irModule, target);
+        passManager.run("moveGlobalVarInitializationToEntryPoints", [&]() { moveGlobalVarInitializationToEntryPoints(irModule); });
+        passManager.run("introduceExplicitGlobalContext", [&]() { introduceExplicitGlobalContext(irModule, target); });
         if(target == CodeGenTarget::CPPSource)
         {
-            convertEntryPointPtrParamsToRawPtrs(irModule);
+            passManager.run("convertEntryPointPtrParamsToRawPtrs", [&]() { convertEntryPointPtrParamsToRawPtrs(irModule); });
         }
     #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "EXPLICIT GLOBAL CONTEXT INTRODUCED");
@@ -713,18 +790,20 @@ Result linkAndOptimizeIR(
         break;
     }
 
-    stripCachedDictionaries(irModule);
+    passManager.run("stripCachedDictionaries", [&]() { stripCachedDictionaries(irModule); });
 
     // TODO: our current dynamic dispatch pass will remove all uses of witness tables.
     // If we are going to support function-pointer based, "real" modular dynamic dispatch,
     // we will need to disable this pass.
-    stripWitnessTables(irModule);
+    passManager.run("stripWitnessTables", [&]() { stripWitnessTables(irModule); });
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER STRIP WITNESS TABLES");
 #endif
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
+    irModule->recycleDeallocatedInsts();
+
     // The resource-based specialization pass above
     // may create specialized versions of functions, but
     // it does not try to completely eliminate the original
@@ -733,25 +812,25 @@ Result linkAndOptimizeIR(
     //
     // We run IR simplification passes again to clean things up.
     //
-    simplifyIR(irModule);
+    passManager.run("simplifyIR", IRPassFlag::SkipIfUnchanged, [&]() { simplifyIR(irModule); });
 
     if (isKhronosTarget(targetRequest))
     {
         // As a fallback, if the above specialization steps failed to remove resource type parameters, we will
         // inline the functions in question to make sure we can produce valid GLSL.
-        performGLSLResourceReturnFunctionInlining(irModule);
+        passManager.run("performGLSLResourceReturnFunctionInlining", [&]() { performGLSLResourceReturnFunctionInlining(irModule); });
     }
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER DCE");
 #endif
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
-    cleanUpVoidType(irModule);
+    passManager.run("cleanUpVoidType", [&]() { cleanUpVoidType(irModule); });
 
     // Lower all bit_cast operations on complex types into leaf-level
     // bit_cast on basic types.
-    lowerBitCast(targetRequest, irModule);
-    simplifyIR(irModule);
+    passManager.run("lowerBitCast", [&]() { lowerBitCast(targetRequest, irModule); });
+    passManager.run("simplifyIR", IRPassFlag::SkipIfUnchanged, [&]() { simplifyIR(irModule); });
 
     {
         // Get the liveness mode.
@@ -769,7 +848,7 @@ Result linkAndOptimizeIR(
         //
         if (isEnabled(livenessMode))
         {
-            LivenessUtil::addVariableRangeStarts(irModule, livenessMode);
+            passManager.run("addVariableRangeStarts", [&]() { LivenessUtil::addVariableRangeStarts(irModule, livenessMode); });
         }
 
         // As a late step, we need to take the SSA-form IR and move things *out*
@@ -781,7 +860,7 @@ Result linkAndOptimizeIR(
 
         {
             // We only want to accumulate locations if liveness tracking is enabled.
-            eliminatePhis(codeGenContext, livenessMode, irModule);
+            passManager.run("eliminatePhis", [&]() { eliminatePhis(codeGenContext, livenessMode, irModule); });
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "PHIS ELIMINATED");
 #endif
@@ -791,7 +870,7 @@ Result linkAndOptimizeIR(
 
         if (isEnabled(livenessMode))
         {
-            LivenessUtil::addRangeEnds(irModule, livenessMode);
+            passManager.run("addRangeEnds", [&]() { LivenessUtil::addRangeEnds(irModule, livenessMode); });
 
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "LIVENESS");
@@ -821,7 +900,7 @@ Result linkAndOptimizeIR(
     {
         if (isKhronosTarget(targetRequest))
         {
-            applyGLSLLiveness(irModule);
+            passManager.run("applyGLSLLiveness", [&]() { applyGLSLLiveness(irModule); });
         }
     }
 
@@ -834,6 +913,17 @@ Result linkAndOptimizeIR(
 #endif
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
+    // Measure the memory the IR takes, and how much it would take with a compact encoding.
+    // Only done when a report is being collected, as it walks the whole module.
+    if (PerformanceReport::getCurrent())
+    {
+        const auto memoryStats = irModule->calcMemoryStats();
+        PerformanceReport::addToCounter(PerformanceCounter::LinkedIRInsts, memoryStats.instCount);
+        PerformanceReport::addToCounter(PerformanceCounter::LinkedIROperands, memoryStats.operandCount);
+        PerformanceReport::addToCounter(PerformanceCounter::LinkedIRInstBytes, int64_t(memoryStats.instBytes));
+        PerformanceReport::addToCounter(PerformanceCounter::LinkedIRCompactInstBytes, int64_t(memoryStats.compactInstBytes));
+    }
+
     outLinkedIR.metadata = new PostEmitMetadata();
     collectMetadata(irModule, *outLinkedIR.metadata);
 
@@ -844,6 +934,8 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(
     String&                 outSource,
     RefPtr<PostEmitMetadata>& outMetadata)
 {
+    SLANG_PERFORMANCE_PHASE("emitSource");
+
     outSource = String();
 
     auto session = getSession();
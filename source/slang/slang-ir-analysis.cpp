@@ -0,0 +1,109 @@
+// slang-ir-analysis.cpp
+#include "slang-ir-analysis.h"
+
+#include "slang-performance-report.h"
+
+namespace Slang {
+
+    /// Get the cached analysis of `kind` for `code`, if there is one that is still valid
+static RefObject* _findAnalysis(IRModule* module, IRGlobalValueWithCode* code, IRAnalysisKind kind)
+{
+    if (!module)
+    {
+        return nullptr;
+    }
+
+    auto codeEntries = module->getAnalysisCache().codeEntries.TryGetValue(code);
+    if (!codeEntries)
+    {
+        return nullptr;
+    }
+
+    const auto& entry = codeEntries->entries[Index(kind)];
+    if (!entry.analysis || entry.epoch != code->getModificationEpoch())
+    {
+        return nullptr;
+    }
+
+    PerformanceReport::addToCounter(PerformanceCounter::IRAnalysesReused);
+    return entry.analysis;
+}
+
+static void _addAnalysis(IRModule* module, IRGlobalValueWithCode* code, IRAnalysisKind kind, RefObject* analysis)
+{
+    PerformanceReport::addToCounter(PerformanceCounter::IRAnalysesComputed);
+
+    // Code that isn't in a module has no modification epoch, so can't be cached
+    if (!module)
+    {
+        return;
+    }
+
+    auto& codeEntries = module->getAnalysisCache().codeEntries;
+    if (!codeEntries.ContainsKey(code))
+    {
+        codeEntries.Add(code, IRAnalysisCache::CodeEntries());
+    }
+
+    auto& entry = codeEntries.TryGetValue(code)->entries[Index(kind)];
+    entry.analysis = analysis;
+    entry.epoch = code->getModificationEpoch();
+}
+
+/* static */RefPtr<IRBlockOrder> IRAnalysisManager::getPostorder(IRGlobalValueWithCode* code)
+{
+    auto module = code->getModule();
+    if (auto analysis = _findAnalysis(module, code, IRAnalysisKind::Postorder))
+    {
+        return static_cast<IRBlockOrder*>(analysis);
+    }
+
+    RefPtr<IRBlockOrder> postorder = new IRBlockOrder;
+    computePostorder(code, postorder->blocks);
+
+    _addAnalysis(module, code, IRAnalysisKind::Postorder, postorder);
+    return postorder;
+}
+
+/* static */RefPtr<IRDominatorTree> IRAnalysisManager::getDominatorTree(IRGlobalValueWithCode* code)
+{
+    auto module = code->getModule();
+    if (auto analysis = _findAnalysis(module, code, IRAnalysisKind::DominatorTree))
+    {
+        return static_cast<IRDominatorTree*>(analysis);
+    }
+
+    auto postorder = getPostorder(code);
+    auto dominatorTree = computeDominatorTree(code, postorder->blocks);
+
+    _addAnalysis(module, code, IRAnalysisKind::DominatorTree, dominatorTree);
+    return dominatorTree;
+}
+
+/* static */void IRAnalysisManager::preserveControlFlowAnalyses(IRGlobalValueWithCode* code, uint32_t startEpoch)
+{
+    auto module = code->getModule();
+    if (!module)
+    {
+        return;
+    }
+
+    auto codeEntries = module->getAnalysisCache().codeEntries.TryGetValue(code);
+    if (!codeEntries)
+    {
+        return;
+    }
+
+    // All of the analyses only depend on the control flow
+    const uint32_t epoch = code->getModificationEpoch();
+    for (auto& entry : codeEntries->entries)
+    {
+        // An analysis computed at an epoch before `startEpoch` was already invalid
+        if (entry.analysis && entry.epoch >= startEpoch)
+        {
+            entry.epoch = epoch;
+        }
+    }
+}
+
+} // namespace Slang
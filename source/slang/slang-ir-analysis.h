@@ -0,0 +1,44 @@
+// slang-ir-analysis.h
+#pragma once
+
+#include "slang-ir.h"
+#include "slang-ir-dominators.h"
+
+namespace Slang
+{
+    /// The blocks of code, in a particular order
+struct IRBlockOrder : public RefObject
+{
+    List<IRBlock*> blocks;
+};
+
+/* Provides analyses of code (functions and other `IRGlobalValueWithCode`), which are computed when first
+needed and then cached in the module the code is in.
+
+A cached analysis is used for as long as the modification epoch of its code (see
+`IRGlobalValueWithCode::getModificationEpoch`) is unchanged, so passes don't need to do anything to
+invalidate the analyses of code they modify.
+
+A pass that modifies code without changing its control flow (for example by only adding or removing
+instructions within blocks) can keep the analyses that only depend on the control flow with
+`preserveControlFlowAnalyses`, so that later passes don't have to compute them again.
+
+An analysis refers to the blocks of the code, so shouldn't be held once the code has been modified in a
+way that could change it. */
+struct IRAnalysisManager
+{
+        /// Get the blocks of `code` that are reachable from its first block, in postorder
+    static RefPtr<IRBlockOrder> getPostorder(IRGlobalValueWithCode* code);
+
+        /// Get the dominator tree of `code`
+    static RefPtr<IRDominatorTree> getDominatorTree(IRGlobalValueWithCode* code);
+
+        /// Keep the cached analyses of `code` that only depend on its control flow, after `code` has been
+        /// modified without changing its control flow.
+        ///
+        /// `startEpoch` is the modification epoch of `code` before it was modified. The analyses that were
+        /// valid at any point since then remain valid.
+    static void preserveControlFlowAnalyses(IRGlobalValueWithCode* code, uint32_t startEpoch);
+};
+
+} // namespace Slang
@@ -314,7 +314,7 @@ struct BindExistentialSlots
         // new ones we'll be making.
         //
         List<IRUse*> usesToReplace;
-        for( auto use = inst->firstUse; use; use = use->nextUse )
+        for( auto use = inst->getFirstUse(); use; use = use->getNextUse() )
         {
             auto user = use->getUser();
 
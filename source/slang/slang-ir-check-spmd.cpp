@@ -0,0 +1,63 @@
+// slang-ir-check-spmd.cpp
+#include "slang-ir-check-spmd.h"
+
+#include "slang-ir.h"
+#include "slang-ir-insts.h"
+
+namespace Slang {
+
+    /// Get the name of the stdlib function `callee` if it is a barrier that waits for all of the threads in a group
+    /// (such as `GroupMemoryBarrierWithGroupSync`), else an empty slice
+static UnownedStringSlice _getGroupSyncBarrierName(IRInst* callee)
+{
+    if (auto nameHint = getResolvedInstForDecorations(callee)->findDecoration<IRNameHintDecoration>())
+    {
+        const UnownedStringSlice name = nameHint->getName();
+        if (name.endsWith(UnownedStringSlice::fromLiteral("WithGroupSync")))
+        {
+            return name;
+        }
+    }
+    return UnownedStringSlice();
+}
+
+static void _checkForSPMDUnsupportedFeaturesRec(
+    IRInst*         inst,
+    DiagnosticSink* sink)
+{
+    if (inst->getOp() == kIROp_GroupMemoryBarrierWithGroupSync)
+    {
+        sink->diagnose(inst, Diagnostics::spmdBarrierUnsupported, "GroupMemoryBarrierWithGroupSync");
+    }
+    else if (auto call = as<IRCall>(inst))
+    {
+        const UnownedStringSlice barrierName = _getGroupSyncBarrierName(call->getCallee());
+        if (barrierName.getLength())
+        {
+            sink->diagnose(call, Diagnostics::spmdBarrierUnsupported, barrierName);
+        }
+    }
+    else if (auto globalVar = as<IRGlobalVar>(inst))
+    {
+        if (as<IRGroupSharedRate>(globalVar->getRate()))
+        {
+            auto nameHint = globalVar->findDecoration<IRNameHintDecoration>();
+            sink->diagnose(globalVar, Diagnostics::spmdGroupSharedUnsupported, nameHint ? nameHint->getName() : UnownedStringSlice());
+        }
+    }
+
+    for (auto childInst : inst->getDecorationsAndChildren())
+    {
+        _checkForSPMDUnsupportedFeaturesRec(childInst, sink);
+    }
+}
+
+void checkForSPMDUnsupportedFeatures(
+    IRModule*       module,
+    DiagnosticSink* sink)
+{
+    // The module has been linked for the target, so only holds code used by its entry points
+    _checkForSPMDUnsupportedFeaturesRec(module->getModuleInst(), sink);
+}
+
+}
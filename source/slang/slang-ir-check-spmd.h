@@ -0,0 +1,17 @@
+// slang-ir-check-spmd.h
+#pragma once
+
+namespace Slang
+{
+    class DiagnosticSink;
+    struct IRModule;
+
+        /// Diagnose uses of features that can't be supported when the threads of a compute thread group
+        /// are executed as the lanes of a single loop (`-emit-cpp-spmd`).
+        ///
+        /// Lanes are executed in an arbitrary interleaving, and each has its own copy of groupshared variables,
+        /// so threads can't communicate through groupshared memory, or synchronize with barriers.
+    void checkForSPMDUnsupportedFeatures(
+        IRModule*       module,
+        DiagnosticSink* sink);
+}
@@ -232,13 +232,13 @@ struct CollectGlobalUniformParametersContext
             // uses and work with that instead.
             //
             List<IRUse*> uses;
-            for(auto use = globalParam->firstUse; use; use = use->nextUse)
+            for(auto use = globalParam->getFirstUse(); use; use = use->getNextUse())
             {
                 uses.add(use);
             }
             for( auto use : uses )
             {
-                auto user = use->user;
+                auto user = use->getUser();
 
                 // There is an annoying gotcha here, in that we are using
                 // global shader parameters themselves (the `IRGlobalParam`s)
@@ -70,7 +70,7 @@ void lowerComInterfaces(IRModule* module, ArtifactStyle artifactStyle, Diagnosti
             // Find all of the uses *before* doing any replacement
             // Otherwise we end up replacing the replacement leading 
             // to it pointing to itself.
-            for (auto use = comIntf->firstUse; use; use = use->nextUse)
+            for (auto use = comIntf->getFirstUse(); use; use = use->getNextUse())
             {
                 // Only store off uses where replacement can be made
                 if (_canReplace(use))
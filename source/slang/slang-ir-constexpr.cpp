@@ -189,7 +189,7 @@ bool maybeMarkConstExpr(
     if(value->getOp() == kIROp_Param)
     {
         auto param = (IRParam*) value;
-        auto block = (IRBlock*) param->parent;
+        auto block = (IRBlock*) param->getParent();
         auto code = block->getParent();
 
         if(block == code->getFirstBlock())
@@ -199,7 +199,7 @@ bool maybeMarkConstExpr(
             // fact so taht we can mark callers of this
             // function as `constexpr` themselves.
 
-            for( auto u = code->firstUse; u; u = u->nextUse )
+            for( auto u = code->getFirstUse(); u; u = u->getNextUse() )
             {
                 auto user = u->getUser();
 
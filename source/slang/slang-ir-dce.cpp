@@ -3,6 +3,7 @@
 
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
+#include "slang-performance-report.h"
 
 namespace Slang
 {
@@ -403,6 +404,8 @@ bool eliminateDeadCode(
     IRModule*                           module,
     IRDeadCodeEliminationOptions const& options)
 {
+    SLANG_PERFORMANCE_PHASE("eliminateDeadCode");
+
     DeadCodeEliminationContext context;
     context.module = module;
     context.options = options;
@@ -51,6 +51,11 @@ namespace Slang
     {
         DeduplicateContext context;
         context.builder = this;
+
+        // Code using a duplicate only changes to use an equivalent global, so isn't modified (and
+        // doesn't need to be simplified again)
+        m_module->_setIsReplacingEquivalentGlobals(true);
+
         m_constantMap.Clear();
         m_globalValueNumberingMap.Clear();
         for (auto inst : m_module->getGlobalInsts())
@@ -75,12 +80,14 @@ namespace Slang
         }
         for (auto inst : instToRemove)
             inst->removeAndDeallocate();
+
+        m_module->_setIsReplacingEquivalentGlobals(false);
     }
 
     void SharedIRBuilder::replaceGlobalInst(IRInst* oldInst, IRInst* newInst)
     {
         List<IRUse*> uses;
-        for (auto use = oldInst->firstUse; use; use = use->nextUse)
+        for (auto use = oldInst->getFirstUse(); use; use = use->getNextUse())
         {
             uses.add(use);
         }
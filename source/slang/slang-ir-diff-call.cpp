@@ -65,7 +65,7 @@ struct DerivativeCallProcessContext
         
         // Substitute all uses of the 'derivativeOf' operation 
         // with the resolved derivative function.
-        while (auto use = derivOfInst->firstUse)
+        while (auto use = derivOfInst->getFirstUse())
         {
             use->set(jvpFunc);
         }
@@ -359,8 +359,8 @@ struct DominatorTreeComputationContext
     //
     void iterativelyComputeImmediateDominators(IRGlobalValueWithCode* code)
     {
-        // First we compute the postorder traversal order for the blocks in the CFG.
-        computePostorder(code, postorder);
+        // The postorder traversal order for the blocks in the CFG has already
+        // been set in `postorder`.
 
         // We will initialize our map from the block objects to their "name"
         // (index in the traversal order), before moving on.
@@ -565,8 +565,10 @@ struct DominatorTreeComputationContext
     };
     //
 
-    RefPtr<IRDominatorTree> createDominatorTree(IRGlobalValueWithCode* code)
+    RefPtr<IRDominatorTree> createDominatorTree(IRGlobalValueWithCode* code, const List<IRBlock*>& inPostorder)
     {
+        postorder = inPostorder;
+
         // We first run the Cooper et al. algorithm to compute the `doms` array
         // which encodes immediate dominators.
         //
@@ -764,7 +766,15 @@ struct DominatorTreeComputationContext
 RefPtr<IRDominatorTree> computeDominatorTree(IRGlobalValueWithCode* code)
 {
     DominatorTreeComputationContext context;
-    return context.createDominatorTree(code);
+    List<IRBlock*> postorder;
+    computePostorder(code, postorder);
+    return context.createDominatorTree(code, postorder);
+}
+
+RefPtr<IRDominatorTree> computeDominatorTree(IRGlobalValueWithCode* code, const List<IRBlock*>& postorder)
+{
+    DominatorTreeComputationContext context;
+    return context.createDominatorTree(code, postorder);
 }
 
 }
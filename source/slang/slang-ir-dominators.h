@@ -165,4 +165,10 @@ namespace Slang
     };
 
     RefPtr<IRDominatorTree> computeDominatorTree(IRGlobalValueWithCode* code);
+
+        /// Compute the dominator tree of `code`, where `postorder` is the postorder of its blocks (see `computePostorder`)
+    RefPtr<IRDominatorTree> computeDominatorTree(IRGlobalValueWithCode* code, const List<IRBlock*>& postorder);
+
+        /// Compute the blocks of `code` that are reachable from its first block, in postorder
+    void computePostorder(IRGlobalValueWithCode* code, List<IRBlock*>& outOrder);
 }
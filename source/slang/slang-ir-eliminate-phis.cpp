@@ -51,7 +51,7 @@
 
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
-#include "slang-ir-dominators.h"
+#include "slang-ir-analysis.h"
 
 namespace Slang {
 
@@ -111,6 +111,8 @@ struct PhiEliminationContext
     {
         initializePerFuncState(func);
 
+        const uint32_t startEpoch = func->getModificationEpoch();
+
         // The first block in a function is always the entry block,
         // and its parameters are different than those of the other blocks;
         // they represent the parameters of the *function*. We therefore
@@ -126,6 +128,9 @@ struct PhiEliminationContext
 
             eliminatePhisInBlock(block);
         }
+
+        // Eliminating phis replaces branches, but keeps their targets, so the control flow is unchanged
+        IRAnalysisManager::preserveControlFlowAnalyses(func, startEpoch);
     }
 
     // In order to facilitate breaking things down into subroutines, we use a
@@ -152,11 +157,15 @@ struct PhiEliminationContext
     // "straight-line" function taht doesn't involve control flow
     // will never have any phis, so we expect that case to be common.
     //
+    // The tree is held for the whole function, because the function
+    // is modified as phis are eliminated, and the modified function
+    // would otherwise need a new tree from the analysis manager.
+    //
     IRDominatorTree* getDominatorTree()
     {
         if (!m_dominatorTree)
         {
-            m_dominatorTree = computeDominatorTree(m_func);
+            m_dominatorTree = IRAnalysisManager::getDominatorTree(m_func);
         }
         return m_dominatorTree;
     }
@@ -353,7 +362,7 @@ struct PhiEliminationContext
             // problems that would arise from trying to traverse
             // the list of uses while also modifying it.
             //
-            while (auto use = param->firstUse)
+            while (auto use = param->getFirstUse())
             {
                 // We emit a distinct `load` from the temporary
                 // right before each instruction that uses the
@@ -85,7 +85,7 @@ struct ConvertEntryPointPtrParamsToRawPtrsPass
                 // the bit cast instruction.
                 //
                 List<IRUse*> uses;
-                for(auto use = param->firstUse; use; use = use->nextUse)
+                for(auto use = param->getFirstUse(); use; use = use->getNextUse())
                     uses.add(use);
 
                 // Now we emit a bit-cast operation into the first block
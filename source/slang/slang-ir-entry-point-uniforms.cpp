@@ -314,7 +314,7 @@ struct CollectEntryPointUniformParams : PerEntryPointPass
             //
             // We are therefore going to replace the uses one at a time.
             //
-            while(auto use = param->firstUse )
+            while(auto use = param->getFirstUse() )
             {
                 // Given a `use` of the paramter, we will insert
                 // the replacement code right before the instruction
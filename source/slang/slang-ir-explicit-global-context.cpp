@@ -361,9 +361,9 @@ struct IntroduceExplicitGlobalContextPass
         // being changed while we walk it.
         //
         IRUse* nextUse = nullptr;
-        for( IRUse* use = globalParam->firstUse; use; use = nextUse )
+        for( IRUse* use = globalParam->getFirstUse(); use; use = nextUse )
         {
-            nextUse = use->nextUse;
+            nextUse = use->getNextUse();
 
             // At each use site, we need to look up the context
             // pointer that is appropriate for that use.
@@ -398,9 +398,9 @@ struct IntroduceExplicitGlobalContextPass
         // being changed while we walk it.
         //
         IRUse* nextUse = nullptr;
-        for( IRUse* use = globalVar->firstUse; use; use = nextUse )
+        for( IRUse* use = globalVar->getFirstUse(); use; use = nextUse )
         {
-            nextUse = use->nextUse;
+            nextUse = use->getNextUse();
 
             // At each use site, we need to look up the context
             // pointer that is appropriate for that use.
@@ -493,7 +493,7 @@ struct IntroduceExplicitGlobalContextPass
         // using the linked list), because when a replacement is made the func usage
         // linked list will no longer hold all of the use sites.
         List<IRCall*> callUses;
-        for (auto use = func->firstUse; use; use = use->nextUse)
+        for (auto use = func->getFirstUse(); use; use = use->getNextUse())
         {
             // We will only fix up calls to `func`, and ignore
             // other operations that might refer to it.
@@ -79,7 +79,7 @@ namespace Slang
             return result;
         IRBuilder builderStorage(sharedBuilderStorage);
         auto builder = &builderStorage;
-        builder->setInsertBefore(typeInst->next);
+        builder->setInsertBefore(typeInst->getNextInst());
 
         result = builder->emitMakeRTTIObject(typeInst);
 
@@ -151,7 +151,7 @@ namespace Slang
 
             sharedContext->workList.removeLast();
 
-            sharedContext->addToWorkList(inst->parent);
+            sharedContext->addToWorkList(inst->getParent());
             sharedContext->addToWorkList(inst->getFullType());
 
             UInt operandCount = inst->getOperandCount();
@@ -1797,7 +1797,7 @@ void legalizeEntryPointForGLSL(
     // TODO: the right thing to do here is to split any
     // function that both gets called as an entry point
     // and as an ordinary function.
-    SLANG_ASSERT(!func->firstUse);
+    SLANG_ASSERT(!func->getFirstUse());
 
     // We create a dummy IR builder, since some of
     // the functions require it.
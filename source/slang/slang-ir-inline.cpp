@@ -19,6 +19,7 @@
 #include "slang-ir.h"
 #include "slang-ir-clone.h"
 #include "slang-ir-insts.h"
+#include "slang-performance-report.h"
 
 namespace Slang
 {
@@ -549,6 +550,8 @@ struct MandatoryEarlyInliningPass : InliningPassBase
 
 void performMandatoryEarlyInlining(IRModule* module)
 {
+    SLANG_PERFORMANCE_PHASE("performMandatoryEarlyInlining");
+
     MandatoryEarlyInliningPass pass(module);
     pass.considerAllCallSites();
 }
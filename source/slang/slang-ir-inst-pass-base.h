@@ -58,6 +58,13 @@ namespace Slang
 
         template <typename Func>
         void processAllInsts(const Func& f)
+        {
+            processAllInsts(nullptr, f);
+        }
+
+            /// Process all insts, except for those in code that isn't in `codeToProcess` (if set)
+        template <typename Func>
+        void processAllInsts(IRCodeSet const* codeToProcess, const Func& f)
         {
             workList.clear();
             workListSet.Clear();
@@ -72,6 +79,15 @@ namespace Slang
                 workListSet.Remove(inst);
                 f(inst);
 
+                if (codeToProcess)
+                {
+                    auto code = as<IRGlobalValueWithCode>(inst);
+                    if (code && !codeToProcess->Contains(code))
+                    {
+                        continue;
+                    }
+                }
+
                 for (auto child = inst->getLastChild(); child; child = child->getPrevInst())
                 {
                     addToWorkList(child);
@@ -2093,8 +2093,8 @@ public:
     // Replaces all uses of oldInst with newInst, and ensures the global numbering map is valid after the replacement.
     void replaceGlobalInst(IRInst* oldInst, IRInst* newInst);
 
-    typedef Dictionary<IRInstKey, IRInst*> GlobalValueNumberingMap;
-    typedef Dictionary<IRConstantKey, IRConstant*> ConstantMap;
+    typedef FlatDictionary<IRInstKey, IRInst*> GlobalValueNumberingMap;
+    typedef FlatDictionary<IRConstantKey, IRConstant*> ConstantMap;
 
     GlobalValueNumberingMap& getGlobalValueNumberingMap() { return m_globalValueNumberingMap; }
     ConstantMap& getConstantMap() { return m_constantMap; }
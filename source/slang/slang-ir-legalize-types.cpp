@@ -17,6 +17,7 @@
 #include "slang-ir-insts.h"
 #include "slang-legalize-types.h"
 #include "slang-mangle.h"
+#include "slang-performance-report.h"
 
 namespace Slang
 {
@@ -583,7 +584,7 @@ private:
                     auto p = m_returnInst->getParent();
                     while( p && !as<IRGlobalValueWithCode>(p) )
                     {
-                        p = p->parent;
+                        p = p->getParent();
                     }
 
                     // We expect that the parent is actually an IR function.
@@ -3317,7 +3318,7 @@ struct IRTypeLegalizationPass
         // * `i` is a user of `inst`, or
         // * `i` is a child of `inst`.
         // 
-        for( auto use = inst->firstUse; use; use = use->nextUse )
+        for( auto use = inst->getFirstUse(); use; use = use->getNextUse() )
         {
             auto user = use->getUser();
             maybeAddToWorkList(user);
@@ -3460,6 +3461,8 @@ void legalizeResourceTypes(
     IRModule*       module,
     DiagnosticSink* sink)
 {
+    SLANG_PERFORMANCE_PHASE("legalizeResourceTypes");
+
     SLANG_UNUSED(sink);
 
     IRResourceTypeLegalizationContext context(module);
@@ -3470,6 +3473,8 @@ void legalizeExistentialTypeLayout(
     IRModule*       module,
     DiagnosticSink* sink)
 {
+    SLANG_PERFORMANCE_PHASE("legalizeExistentialTypeLayout");
+
     SLANG_UNUSED(module);
     SLANG_UNUSED(sink);
 
@@ -5,6 +5,7 @@
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
 #include "slang-mangle.h"
+#include "slang-performance-report.h"
 #include "slang-ir-string-hash.h"
 
 #include "slang-module-library.h"
@@ -33,7 +34,7 @@ struct IRSpecEnv
     IRSpecEnv*  parent = nullptr;
 
     // A map from original values to their cloned equivalents.
-    typedef Dictionary<IRInst*, IRInst*> ClonedValueDictionary;
+    typedef FlatDictionary<IRInst*, IRInst*> ClonedValueDictionary;
     ClonedValueDictionary clonedValues;
 };
 
@@ -48,10 +49,18 @@ struct IRSharedSpecContext
     // The specialized module we are building
     RefPtr<IRModule>   module;
 
+    // The modules whose global values can be linked, in the
+    // order they are searched. The modules hold an index of
+    // their global values by mangled name, so we don't need
+    // to build one up for every link.
+    List<IRModule*> symbolModules;
+
     // A map from mangled symbol names to zero or
     // more global IR values that have that name,
-    // in the *original* module.
-    typedef Dictionary<String, RefPtr<IRSpecSymbol>> SymbolDictionary;
+    // in the *original* modules. Entries are only added
+    // for names that are looked up, and the key is a slice
+    // of the name held in an original module.
+    typedef FlatDictionary<UnownedStringSlice, RefPtr<IRSpecSymbol>> SymbolDictionary;
     SymbolDictionary symbols;
 
     SharedIRBuilder sharedBuilderStorage;
@@ -69,7 +78,7 @@ struct IRSpecContextBase
 
     IRModule* getModule() { return getShared()->module; }
 
-    IRSharedSpecContext::SymbolDictionary& getSymbols() { return getShared()->symbols; }
+    IRSpecSymbol* findSymbol(const UnownedStringSlice& mangledName);
 
     // The current specialization environment to use.
     IRSpecEnv* env = nullptr;
@@ -829,12 +838,13 @@ IRFunc* specializeIRForEntryPoint(
     // so that the mangled name of the decl-ref is
     // not the same as the mangled name of the decl.
     //
-    RefPtr<IRSpecSymbol> sym;
-    if (!context->getSymbols().TryGetValue(mangledName, sym))
+    IRSpecSymbol* sym = context->findSymbol(mangledName.getUnownedSlice());
+    if (!sym)
     {
         String hashedName = getHashedName(mangledName.getUnownedSlice());
 
-        if (!context->getSymbols().TryGetValue(hashedName, sym))
+        sym = context->findSymbol(hashedName.getUnownedSlice());
+        if (!sym)
         {
             SLANG_UNEXPECTED("no matching IR symbol");
             return nullptr;
@@ -1198,9 +1208,8 @@ IRInst* cloneGlobalValueWithLinkage(
     // with the same mangled name as `originalVal` and try
     // to pick the "best" one for our target.
 
-    auto mangledName = String(originalLinkage->getMangledName());
-    RefPtr<IRSpecSymbol> sym;
-    if( !context->getSymbols().TryGetValue(mangledName, sym) )
+    IRSpecSymbol* sym = context->findSymbol(originalLinkage->getMangledName());
+    if( !sym )
     {
         if(!originalVal)
             return nullptr;
@@ -1257,46 +1266,60 @@ IRInst* cloneGlobalValue(IRSpecContext* context, IRInst* originalVal)
         originalVal->findDecoration<IRLinkageDecoration>());
 }
 
-void insertGlobalValueSymbol(
-    IRSharedSpecContext*    sharedContext,
-    IRInst*                 gv)
+IRSpecSymbol* IRSpecContextBase::findSymbol(const UnownedStringSlice& mangledName)
 {
-    auto linkage = gv->findDecoration<IRLinkageDecoration>();
+    auto sharedContext = getShared();
 
-    // Don't try to register a symbol for global values
-    // that don't have linkage.
-    //
-    if (!linkage)
-        return;
-
-    auto mangledName = String(linkage->getMangledName());
+    RefPtr<IRSpecSymbol> sym;
+    if (sharedContext->symbols.TryGetValue(mangledName, sym))
+    {
+        return sym;
+    }
 
-    RefPtr<IRSpecSymbol> sym = new IRSpecSymbol();
-    sym->irGlobalValue = gv;
+    // Find all of the values with the name, in the order of the modules
+    List<IRInst*> globalValues;
+    for (auto symbolModule : sharedContext->symbolModules)
+    {
+        const IRModuleSymbolIndex& symbolIndex = symbolModule->getSymbolIndex();
+        for (Index i = symbolIndex.findFirst(mangledName); i >= 0; i = symbolIndex.getNext(i))
+        {
+            globalValues.add(symbolIndex.m_symbols[i]);
+        }
+    }
 
-    RefPtr<IRSpecSymbol> prev;
-    if (sharedContext->symbols.TryGetValue(mangledName, prev))
+    if (globalValues.getCount() == 0)
     {
-        sym->nextWithSameName = prev->nextWithSameName;
-        prev->nextWithSameName = sym;
+        return nullptr;
     }
-    else
+
+    // The symbols are chained with the first value at the head, followed by
+    // the others in reverse order. This is the order they were found in when
+    // each value was inserted into the dictionary, and which value is used can
+    // depend on it.
+    sym = new IRSpecSymbol();
+    sym->irGlobalValue = globalValues[0];
+    for (Index i = 1; i < globalValues.getCount(); ++i)
     {
-        sharedContext->symbols.Add(mangledName, sym);
+        RefPtr<IRSpecSymbol> nextSym = new IRSpecSymbol();
+        nextSym->irGlobalValue = globalValues[i];
+        nextSym->nextWithSameName = sym->nextWithSameName;
+        sym->nextWithSameName = nextSym;
     }
+
+    // The key must remain valid for the lifetime of the dictionary, so use the name held by the value
+    auto linkage = globalValues[0]->findDecoration<IRLinkageDecoration>();
+    sharedContext->symbols.Add(linkage->getMangledName(), sym);
+    return sym;
 }
 
-void insertGlobalValueSymbols(
+void addSymbolModule(
     IRSharedSpecContext*    sharedContext,
     IRModule*               originalModule)
 {
     if (!originalModule)
         return;
 
-    for(auto ii : originalModule->getGlobalInsts())
-    {
-        insertGlobalValueSymbol(sharedContext, ii);
-    }
+    sharedContext->symbolModules.add(originalModule);
 }
 
 void initializeSharedSpecContext(
@@ -1369,6 +1392,8 @@ static bool _isPublicOrHLSLExported(IRInst* inst)
 LinkedIR linkIR(
     CodeGenContext* codeGenContext)
 {
+    SLANG_PERFORMANCE_PHASE("linkIR");
+
     auto linkage = codeGenContext->getLinkage();
     auto program = codeGenContext->getProgram();
     auto session = codeGenContext->getSession();
@@ -1420,7 +1445,7 @@ LinkedIR linkIR(
     // Add any modules that were loaded as libraries
     for (IRModule* irModule : irModules)
     {
-        insertGlobalValueSymbols(sharedContext, irModule);
+        addSymbolModule(sharedContext, irModule);
     }
 
     // We will also insert the IR global symbols from the IR module
@@ -1429,7 +1454,7 @@ LinkedIR linkIR(
     // global symbols via decorations.
     //
     auto irModuleForLayout = targetProgram->getExistingIRModuleForLayout();
-    insertGlobalValueSymbols(sharedContext, irModuleForLayout);
+    addSymbolModule(sharedContext, irModuleForLayout);
 
     auto context = state->getContext();
 
@@ -3,7 +3,7 @@
 #include "slang-ir-insts.h"
 #include "slang-ir.h"
 
-#include "slang-ir-dominators.h"
+#include "slang-ir-analysis.h"
 
 namespace Slang
 {
@@ -813,7 +813,7 @@ void LivenessContext::_findAliasesAndAccesses(IRInst* root)
         IRInst* alias = m_aliases[i];
 
         // Find all the uses of this alias/root
-        for (IRUse* use = alias->firstUse; use; use = use->nextUse)
+        for (IRUse* use = alias->getFirstUse(); use; use = use->getNextUse())
         {
             IRInst* cur = use->getUser();
             IRInst* base = nullptr;
@@ -1153,7 +1153,7 @@ void LivenessContext::_processRoot(IRLiveRangeStart* const* rangeStarts, Count r
 
     // Set the root
     m_root = root;
-    m_rootBlock = as<IRBlock>(m_root->parent);
+    m_rootBlock = as<IRBlock>(m_root->getParent());
 
     // Add all the live starts
     for (Index i = 0; i < rangeStartsCount; ++i)
@@ -1276,8 +1276,10 @@ void LivenessContext::_processFunction(IRFunc* func)
 {
     SLANG_ASSERT(m_rangeStarts.getCount() > 0);
 
-    // Create the dominator tree, for the function
-    m_dominatorTree = computeDominatorTree(func);
+    const uint32_t startEpoch = func->getModificationEpoch();
+
+    // Get the dominator tree, for the function
+    m_dominatorTree = IRAnalysisManager::getDominatorTree(func);
 
     // We are going to precalculate a variety of things for blocks. 
     // Most processing is performed via BlockIndex, so we need to set up a map from the block pointer to the index
@@ -1371,6 +1373,9 @@ void LivenessContext::_processFunction(IRFunc* func)
 
     // Remove any end/start spands within a block, that aren't 'interesting.
     _tidyUninterestingSpans();
+
+    // Only range ends have been added, so the control flow is unchanged
+    IRAnalysisManager::preserveControlFlowAnalyses(func, startEpoch);
 }
 
 static bool _isRootTypeScalar(IRType* type)
@@ -14,6 +14,7 @@
 #include "slang-ir-specialize-dynamic-associatedtype-lookup.h"
 #include "slang-ir-witness-table-wrapper.h"
 #include "slang-ir-ssa-simplification.h"
+#include "slang-performance-report.h"
 
 
 namespace Slang
@@ -35,9 +36,9 @@ namespace Slang
                 builder.getIntValue(builder.getUIntType(), id),
                 builder.getIntValue(builder.getUIntType(), 0)};
             auto idOperand = builder.emitMakeVector(uint2Type, 2, uint2Args);
-            for (auto use = rtti.Value->firstUse; use; use = nextUse)
+            for (auto use = rtti.Value->getFirstUse(); use; use = nextUse)
             {
-                nextUse = use->nextUse;
+                nextUse = use->getNextUse();
                 if (use->getUser()->getOp() == kIROp_getAddr)
                 {
                     use->getUser()->replaceUsesWith(idOperand);
@@ -179,6 +180,8 @@ namespace Slang
         IRModule*               module,
         DiagnosticSink*         sink)
     {
+        SLANG_PERFORMANCE_PHASE("lowerGenerics");
+
         SharedGenericsLoweringContext sharedContext;
         sharedContext.targetReq = targetReq;
         sharedContext.module = module;
@@ -0,0 +1,101 @@
+// slang-ir-pass-manager.cpp
+#include "slang-ir-pass-manager.h"
+
+#include "../core/slang-process.h"
+
+#include "slang-compiler.h"
+#include "slang-ir.h"
+#include "slang-performance-report.h"
+
+namespace Slang {
+
+IRPassManager::IRPassManager(CodeGenContext* codeGenContext, IRModule* module):
+    m_codeGenContext(codeGenContext),
+    m_module(module)
+{
+    m_isOptimizing = codeGenContext->getLinkage()->optimizationLevel != OptimizationLevel::None;
+    // Timings are only recorded if there is a report to record them in
+    m_shouldTime = codeGenContext->shouldReportIRPassTimings() && PerformanceReport::getCurrent();
+}
+
+IRPassManager::PassState& IRPassManager::_getPassState(const char* name)
+{
+    // Names are typically literals, so the pointers are compared before the text
+    for (auto& state : m_passStates)
+    {
+        if (state.name == name || ::strcmp(state.name, name) == 0)
+        {
+            return state;
+        }
+    }
+
+    PassState state;
+    state.name = name;
+    m_passStates.add(state);
+    return m_passStates.getLast();
+}
+
+Index IRPassManager::_calcInstCount()
+{
+    return m_module->calcMemoryStats().instCount;
+}
+
+bool IRPassManager::_beginPass(const char* name, IRPassFlags flags)
+{
+    SLANG_ASSERT(m_passIndex < 0);
+
+    PassState& state = _getPassState(name);
+
+    bool shouldRun = true;
+    if (flags & IRPassFlag::Optimization)
+    {
+        shouldRun = m_isOptimizing && !m_codeGenContext->isIRPassDisabled(name);
+    }
+    else if (!state.hasDiagnosedDisabled && m_codeGenContext->isIRPassDisabled(name))
+    {
+        state.hasDiagnosedDisabled = true;
+        m_codeGenContext->getSink()->diagnose(SourceLoc(), Diagnostics::irPassCannotBeDisabled, name);
+    }
+
+    if (shouldRun && (flags & IRPassFlag::SkipIfUnchanged))
+    {
+        shouldRun = !state.hasRun || state.epochAfterRun != m_module->getModificationEpoch();
+    }
+
+    if (!shouldRun)
+    {
+        if (m_shouldTime)
+        {
+            PerformanceReport::getCurrent()->addIRPassSkip(name);
+        }
+        return false;
+    }
+
+    m_passIndex = Index(&state - m_passStates.getBuffer());
+    if (m_shouldTime)
+    {
+        m_startInstCount = _calcInstCount();
+        m_startTick = Process::getClockTick();
+    }
+    return true;
+}
+
+void IRPassManager::_endPass()
+{
+    SLANG_ASSERT(m_passIndex >= 0);
+
+    PassState& state = m_passStates[m_passIndex];
+    m_passIndex = -1;
+
+    state.hasRun = true;
+    state.epochAfterRun = m_module->getModificationEpoch();
+
+    if (m_shouldTime)
+    {
+        const uint64_t ticks = Process::getClockTick() - m_startTick;
+        const int64_t instDelta = int64_t(_calcInstCount()) - int64_t(m_startInstCount);
+        PerformanceReport::getCurrent()->addIRPassRun(state.name, ticks, instDelta);
+    }
+}
+
+} // namespace Slang
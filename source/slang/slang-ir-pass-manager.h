@@ -0,0 +1,86 @@
+// slang-ir-pass-manager.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+namespace Slang
+{
+    struct CodeGenContext;
+    struct IRModule;
+
+typedef uint32_t IRPassFlags;
+struct IRPassFlag
+{
+    enum Enum : IRPassFlags
+    {
+        None            = 0,
+        SkipIfUnchanged = 0x1,      ///< Running the pass again on a module it has been run on does nothing, so it's skipped if the module is unchanged since
+        Optimization    = 0x2,      ///< The pass only makes the output more efficient, so it isn't run at -O0, and can be disabled by name
+    };
+};
+
+/* Runs the passes that prepare a linked IR module for a target (see `linkAndOptimizeIR`).
+
+Each pass is run by name through `run`, which
+
+* Skips a pass flagged `SkipIfUnchanged` if the module hasn't been modified since the pass last ran on it
+(see `IRModule::getModificationEpoch`)
+* Skips a pass flagged `Optimization` when optimization is disabled (-O0), or if the pass is disabled by
+name (-ir-disable-pass)
+* Times the pass, and counts the change in the number of instructions in the module, when IR pass timings
+are requested (-ir-pass-timings). These are added to the performance report.
+
+The order of passes, and which passes apply to a target, is decided by the code that runs them.
+*/
+class IRPassManager
+{
+public:
+        /// Run the pass called `name`, by calling `func`, unless it should be skipped.
+        /// Returns true if the pass was run.
+    template <typename F>
+    bool run(const char* name, IRPassFlags flags, const F& func)
+    {
+        if (!_beginPass(name, flags))
+        {
+            return false;
+        }
+        func();
+        _endPass();
+        return true;
+    }
+    template <typename F>
+    bool run(const char* name, const F& func) { return run(name, IRPassFlag::None, func); }
+
+    IRPassManager(CodeGenContext* codeGenContext, IRModule* module);
+
+protected:
+    struct PassState
+    {
+        const char* name;
+        bool hasRun = false;
+        uint32_t epochAfterRun = 0;         ///< The modification epoch of the module after the pass last ran
+        bool hasDiagnosedDisabled = false;
+    };
+
+        /// Returns true if the pass should be run, in which case `_endPass` must be called after it has run
+    bool _beginPass(const char* name, IRPassFlags flags);
+    void _endPass();
+
+    PassState& _getPassState(const char* name);
+    Index _calcInstCount();
+
+    CodeGenContext* m_codeGenContext;
+    IRModule* m_module;
+
+    bool m_isOptimizing;
+    bool m_shouldTime;
+
+    List<PassState> m_passStates;
+
+    // The pass being run
+    Index m_passIndex = -1;
+    uint64_t m_startTick = 0;
+    Index m_startInstCount = 0;
+};
+
+}
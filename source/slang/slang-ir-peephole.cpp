@@ -182,22 +182,22 @@ struct PeepholeContext : InstPassBase
         }
     }
 
-    bool processModule()
+    bool processModule(IRCodeSet const* codeToProcess)
     {
         SharedIRBuilder* sharedBuilder = &sharedBuilderStorage;
         sharedBuilder->init(module);
         sharedBuilderStorage.deduplicateAndRebuildGlobalNumberingMap();
 
         changed = false;
-        processAllInsts([this](IRInst* inst) { processInst(inst); });
+        processAllInsts(codeToProcess, [this](IRInst* inst) { processInst(inst); });
         return changed;
     }
 };
 
-bool peepholeOptimize(IRModule* module)
+bool peepholeOptimize(IRModule* module, IRCodeSet const* codeToProcess)
 {
     PeepholeContext context = PeepholeContext(module);
-    return context.processModule();
+    return context.processModule(codeToProcess);
 }
 
 } // namespace Slang
@@ -5,7 +5,9 @@ namespace Slang
 {
     struct IRModule;
     struct IRCall;
+    struct IRCodeSet;
 
         /// Apply peephole optimizations.
-    bool peepholeOptimize(IRModule* module);
+        /// If `codeToProcess` is set, only insts that aren't in code, or are in code in the set, are processed.
+    bool peepholeOptimize(IRModule* module, IRCodeSet const* codeToProcess = nullptr);
 }
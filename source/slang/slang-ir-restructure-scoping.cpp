@@ -264,9 +264,9 @@ static void fixValueScopingForInst(
     // in the linked list *before* we operator on `u`.
     //
     IRUse* nextUse = nullptr;
-    for( auto u = def->firstUse; u; u = nextUse )
+    for( auto u = def->getFirstUse(); u; u = nextUse )
     {
-        nextUse = u->nextUse;
+        nextUse = u->getNextUse();
 
         // Looking at the use site `u`, we'd like to check if
         // it violates our scoping rules.
@@ -1043,7 +1043,7 @@ struct SCCPContext
                         // their estimates updated as well.
                         //
                         setLatticeVal(param, newVal);
-                        for( auto use = param->firstUse; use; use = use->nextUse )
+                        for( auto use = param->getFirstUse(); use; use = use->getNextUse() )
                         {
                             ssaWorkList.add(use->getUser());
                         }
@@ -1198,7 +1198,7 @@ struct SCCPContext
         // and add them to our work list so that we can update
         // their values based on the new information.
         //
-        for( auto use = inst->firstUse; use; use = use->nextUse )
+        for( auto use = inst->getFirstUse(); use; use = use->getNextUse() )
         {
             ssaWorkList.add(use->getUser());
         }
@@ -1609,11 +1609,17 @@ struct SCCPContext
 
 static bool applySparseConditionalConstantPropagationRec(
     const SCCPContext&  globalContext,
+    IRCodeSet const*    codeToProcess,
     IRInst*             inst)
 {
     bool changed = false;
     if( auto code = as<IRGlobalValueWithCode>(inst) )
     {
+        // Any code nested in `code` can only have been modified if `code` was,
+        // so the whole of it can be skipped.
+        if( codeToProcess && !codeToProcess->Contains(code) )
+            return false;
+
         if( code->getFirstBlock() )
         {
             SCCPContext context;
@@ -1626,13 +1632,14 @@ static bool applySparseConditionalConstantPropagationRec(
 
     for( auto childInst : inst->getDecorationsAndChildren() )
     {
-        changed |= applySparseConditionalConstantPropagationRec(globalContext, childInst);
+        changed |= applySparseConditionalConstantPropagationRec(globalContext, codeToProcess, childInst);
     }
     return changed;
 }
 
 bool applySparseConditionalConstantPropagation(
-    IRModule*       module)
+    IRModule*           module,
+    IRCodeSet const*    codeToProcess)
 {
     SharedSCCPContext shared;
     shared.module = module;
@@ -1646,7 +1653,7 @@ bool applySparseConditionalConstantPropagation(
     bool changed = globalContext.applyOnGlobalScope(module);
 
     // Now run recursive SCCP passes on each child code block.
-    changed |= applySparseConditionalConstantPropagationRec(globalContext, module->getModuleInst());
+    changed |= applySparseConditionalConstantPropagationRec(globalContext, codeToProcess, module->getModuleInst());
 
     return changed;
 }
@@ -4,6 +4,7 @@
 namespace Slang
 {
     struct IRModule;
+    struct IRCodeSet;
 
         /// Apply Sparse Conditional Constant Propagation (SCCP) to a module.
         ///
@@ -12,8 +13,10 @@ namespace Slang
         /// also eliminates conditional branches where the condition will
         /// always evaluate to a constant (which can lead to entire blocks
         /// becoming dead code)
+        /// If `codeToProcess` is set, only the code in it is processed (as well as the global scope).
         /// Returns true if IR is changed.
     bool applySparseConditionalConstantPropagation(
-        IRModule*       module);
+        IRModule*           module,
+        IRCodeSet const*    codeToProcess = nullptr);
 }
 
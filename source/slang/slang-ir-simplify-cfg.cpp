@@ -66,13 +66,16 @@ bool processFunc(IRFunc* func)
     return changed;
 }
 
-bool simplifyCFG(IRModule* module)
+bool simplifyCFG(IRModule* module, IRCodeSet const* codeToProcess)
 {
     bool changed = false;
     for (auto inst : module->getGlobalInsts())
     {
         if (auto func = as<IRFunc>(inst))
         {
+            if (codeToProcess && !codeToProcess->Contains(func))
+                continue;
+
             changed |= processFunc(func);
         }
     }
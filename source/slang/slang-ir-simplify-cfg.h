@@ -4,9 +4,11 @@
 namespace Slang
 {
     struct IRModule;
+    struct IRCodeSet;
 
         /// Simplifies control flow graph by merging basic blocks that
         /// forms a simple linear chain.
+        /// If `codeToProcess` is set, only functions in it are simplified.
         /// Returns true if changed.
-    bool simplifyCFG(IRModule* module);
+    bool simplifyCFG(IRModule* module, IRCodeSet const* codeToProcess = nullptr);
 }
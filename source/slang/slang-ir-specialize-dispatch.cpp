@@ -234,7 +234,7 @@ void ensureWitnessTableSequentialIDs(SharedGenericsLoweringContext* sharedContex
 void fixupDispatchFuncCall(SharedGenericsLoweringContext* sharedContext, IRFunc* newDispatchFunc)
 {
     List<IRInst*> users;
-    for (auto use = newDispatchFunc->firstUse; use; use = use->nextUse)
+    for (auto use = newDispatchFunc->getFirstUse(); use; use = use->getNextUse())
     {
         users.add(use->getUser());
     }
@@ -199,9 +199,9 @@ struct AssociatedTypeLookupSpecializationContext
                 SLANG_ASSERT(seqId);
                 // Insert code to pack sequential ID into an uint2 at all use sites.
                 IRUse* nextUse = nullptr;
-                for (auto use = inst->firstUse; use; use = nextUse)
+                for (auto use = inst->getFirstUse(); use; use = nextUse)
                 {
-                    nextUse = use->nextUse;
+                    nextUse = use->getNextUse();
                     if (as<IRCOMWitnessDecoration>(use->getUser()))
                         continue;
                     IRBuilder builder(sharedContext->sharedBuilderStorage);
@@ -228,9 +228,9 @@ struct AssociatedTypeLookupSpecializationContext
                 auto witnessTableIDType = builder.getWitnessTableIDType(
                     (IRType*)cast<IRWitnessTableType>(globalInst)->getConformanceType());
                 IRUse* nextUse = nullptr;
-                for (auto use = globalInst->firstUse; use; use = nextUse)
+                for (auto use = globalInst->getFirstUse(); use; use = nextUse)
                 {
-                    nextUse = use->nextUse;
+                    nextUse = use->getNextUse();
                     if (use->getUser()->getOp() == kIROp_WitnessTable)
                         continue;
                     use->set(witnessTableIDType);
@@ -256,7 +256,7 @@ struct ResourceOutputSpecializationPass
         // the aid of this pass.
         //
         List<IRCall*> calls;
-        for( auto use = oldFunc->firstUse; use; use = use->nextUse )
+        for( auto use = oldFunc->getFirstUse(); use; use = use->getNextUse() )
         {
             auto user = use->getUser();
             auto call = as<IRCall>(user);
@@ -832,7 +832,7 @@ struct ResourceOutputSpecializationPass
         // `out`/`inout` parameters that doesn't have as many "gotcha" cases.
         //
         List<IRStore*> stores;
-        for( auto use = param->firstUse; use; use = use->nextUse )
+        for( auto use = param->getFirstUse(); use; use = use->getNextUse() )
         {
             auto user = use->getUser();
             auto store = as<IRStore>(user);
@@ -1190,7 +1190,7 @@ bool specializeResourceUsage(
         // Inline unspecializable resource output functions and then continue trying.
         for (auto func : unspecializableFuncs)
         {
-            for (auto use = func->firstUse; use; use = use->nextUse)
+            for (auto use = func->getFirstUse(); use; use = use->getNextUse())
             {
                 auto user = use->getUser();
                 auto call = as<IRCall>(user);
@@ -4,6 +4,7 @@
 #include "slang-ir.h"
 #include "slang-ir-clone.h"
 #include "slang-ir-insts.h"
+#include "slang-performance-report.h"
 
 namespace Slang
 {
@@ -159,7 +160,7 @@ struct SpecializationContext
     void addUsersToWorkList(
         IRInst* inst)
     {
-        for( auto use = inst->firstUse; use; use = use->nextUse )
+        for( auto use = inst->getFirstUse(); use; use = use->getNextUse() )
         {
             auto user = use->getUser();
             
@@ -266,6 +267,7 @@ struct SpecializationContext
         // this generic again for the same arguments.
         //
         genericSpecializations.Add(key, specializedVal);
+        PerformanceReport::addToCounter(PerformanceCounter::IRSpecializations);
 
         return specializedVal;
     }
@@ -1106,6 +1108,7 @@ struct SpecializationContext
             //
             specializedCallee = createExistentialSpecializedFunc(inst, calleeFunc);
             existentialSpecializedFuncs.Add(key, specializedCallee);
+            PerformanceReport::addToCounter(PerformanceCounter::IRSpecializations);
         }
 
         // At this point we have found or generated a specialized version
@@ -2110,6 +2113,7 @@ struct SpecializationContext
                 }
 
                 existentialSpecializedStructs.Add(key, newStructType);
+                PerformanceReport::addToCounter(PerformanceCounter::IRSpecializations);
             }
 
             type->replaceUsesWith(newStructType);
@@ -2181,7 +2185,7 @@ struct SpecializationContext
                     // have no uses in the first place, and all the global
                     // generic parameters should have had their uses replaced.
                     //
-                    SLANG_ASSERT(!inst->firstUse);
+                    SLANG_ASSERT(!inst->getFirstUse());
                     inst->removeAndDeallocate();
                     break;
                 }
@@ -2193,6 +2197,8 @@ struct SpecializationContext
 void specializeModule(
     IRModule*   module)
 {
+    SLANG_PERFORMANCE_PHASE("specializeModule");
+
     SpecializationContext context;
     context.module = module;
     context.processModule();
@@ -36,7 +36,7 @@ struct SPIRVLegalizationContext : public SourceEmitterBase
 
     void addUsersToWorkList(IRInst* inst)
     {
-        for (auto use = inst->firstUse; use; use = use->nextUse)
+        for (auto use = inst->getFirstUse(); use; use = use->getNextUse())
         {
             auto user = use->getUser();
 
@@ -76,7 +76,7 @@ struct SPIRVLegalizationContext : public SourceEmitterBase
             inst->setFullType(ptrType);
             // Insert an explicit load at each use site.
             List<IRUse*> uses;
-            for (auto use = inst->firstUse; use; use = use->nextUse)
+            for (auto use = inst->getFirstUse(); use; use = use->getNextUse())
             {
                 uses.add(use);
             }
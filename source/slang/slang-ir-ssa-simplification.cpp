@@ -6,31 +6,141 @@
 #include "slang-ir-dce.h"
 #include "slang-ir-simplify-cfg.h"
 #include "slang-ir-peephole.h"
+#include "slang-performance-report.h"
 
 namespace Slang
 {
     struct IRModule;
 
+    namespace { // anonymous
+
+    struct SimplifyCodeInfo
+    {
+        IRGlobalValueWithCode* code;
+        uint32_t epoch;                 ///< The modification epoch of the code when the iteration started
+        bool isSimplified;              ///< True if the code would have been skipped, and is only processed to verify it
+    };
+
+    } // anonymous
+
+        // Add the code in `inst` (which can be nested) that has been modified since it was last
+        // found to be fully simplified to `outInfos` and `outCodeToProcess`. Returns the number of
+        // code values that were skipped because they are unmodified.
+    static Index _findCodeToSimplify(
+        IRInst*                     inst,
+        const IRSimplifiedEpochs&   simplifiedEpochs,
+        List<SimplifyCodeInfo>&     outInfos,
+        IRCodeSet&                  outCodeToProcess)
+    {
+        if (auto code = as<IRGlobalValueWithCode>(inst))
+        {
+            const uint32_t epoch = code->getModificationEpoch();
+            const uint32_t* simplifiedEpoch = simplifiedEpochs.codeEpochs.TryGetValue(code);
+
+            // If the code hasn't been modified, neither has any code nested within it
+            const bool isSimplified = simplifiedEpoch && *simplifiedEpoch == epoch;
+            if (isSimplified && !simplifiedEpochs.shouldVerify)
+            {
+                return 1;
+            }
+
+            SimplifyCodeInfo info;
+            info.code = code;
+            info.epoch = epoch;
+            info.isSimplified = isSimplified;
+            outInfos.add(info);
+            outCodeToProcess.Add(code);
+        }
+        else if (as<IRBlock>(inst) == nullptr && inst->getOp() != kIROp_Module)
+        {
+            // Code can only be in the module, or in the blocks of other code
+            return 0;
+        }
+
+        Index skippedCount = 0;
+        for (auto child : inst->getChildren())
+        {
+            skippedCount += _findCodeToSimplify(child, simplifiedEpochs, outInfos, outCodeToProcess);
+        }
+        return skippedCount;
+    }
+
     // Run a combination of SSA, SCCP, SimplifyCFG, and DeadCodeElimination pass
     // until no more changes are possible.
     void simplifyIR(IRModule* module)
     {
+        SLANG_PERFORMANCE_PHASE("simplifyIR");
+
+        // The passes are run only on code that has been modified since it was last found to
+        // be fully simplified (by this call or a previous one on the module). All of the passes
+        // only look at the code they are simplifying, and the operands of the globals it uses,
+        // so if none of these have been modified the passes can't find anything to do.
+        //
+        // A modification of the operands of a global that isn't in code is tracked by the
+        // module inst, and causes all of the code to be processed.
+        auto& simplifiedEpochs = module->getSimplifiedEpochs();
+        auto moduleInst = module->getModuleInst();
+        if (simplifiedEpochs.moduleInstEpoch != moduleInst->m_modificationEpoch)
+        {
+            simplifiedEpochs.codeEpochs.Clear();
+        }
+
+        List<SimplifyCodeInfo> infos;
+        IRCodeSet codeToProcess;
+
         bool changed = true;
         const int kMaxIterations = 8;
         int iterationCounter = 0;
         while (changed && iterationCounter < kMaxIterations)
         {
+            infos.clear();
+            codeToProcess.Clear();
+            const Index skippedCount = _findCodeToSimplify(moduleInst, simplifiedEpochs, infos, codeToProcess);
+
+            PerformanceReport::addToCounter(PerformanceCounter::SimplifyIRCodeProcessed, infos.getCount());
+            PerformanceReport::addToCounter(PerformanceCounter::SimplifyIRCodeSkipped, skippedCount);
+
+            const uint32_t startModuleEpoch = moduleInst->m_modificationEpoch;
+
             changed = false;
-            changed |= applySparseConditionalConstantPropagation(module);
-            changed |= peepholeOptimize(module);
-            changed |= simplifyCFG(module);
+            changed |= applySparseConditionalConstantPropagation(module, &codeToProcess);
+            changed |= peepholeOptimize(module, &codeToProcess);
+            changed |= simplifyCFG(module, &codeToProcess);
 
             // Note: we disregard the `changed` state from dead code elimination pass since
             // SCCP pass could be generating temporarily evaluated constant values and never actually use them.
             // DCE will always remove those nearly generated consts and always returns true here.
             eliminateDeadCode(module);
 
-            changed |= constructSSA(module);
+            changed |= constructSSA(module, &codeToProcess);
+
+            // Code that would have been skipped must still be simplified. Code removed from the module
+            // (by dead code elimination) is marked as modified, so isn't checked.
+            for (const auto& info : infos)
+            {
+                if (info.isSimplified && info.code->getParent() && info.code->getModificationEpoch() != info.epoch)
+                {
+                    SLANG_UNEXPECTED("simplifyIR skipped code that wasn't fully simplified");
+                }
+            }
+
+            // Code that made it through all of the passes without being modified is fully simplified.
+            // If a global was modified, the code that uses it might not be, so nothing is recorded.
+            if (moduleInst->m_modificationEpoch == startModuleEpoch)
+            {
+                for (const auto& info : infos)
+                {
+                    if (info.code->getModificationEpoch() == info.epoch)
+                    {
+                        simplifiedEpochs.codeEpochs.Set(info.code, info.epoch);
+                    }
+                }
+            }
+            else
+            {
+                simplifiedEpochs.codeEpochs.Clear();
+            }
+            simplifiedEpochs.moduleInstEpoch = moduleInst->m_modificationEpoch;
 
             iterationCounter++;
         }
@@ -109,7 +109,7 @@ struct ConstructSSAContext
 /// that also lead to loads.
 bool allUsesLeadToLoads(IRInst* inst)
 {
-    for (auto u = inst->firstUse; u; u = u->nextUse)
+    for (auto u = inst->getFirstUse(); u; u = u->getNextUse())
     {
         auto user = u->getUser();
         switch (user->getOp())
@@ -175,7 +175,7 @@ bool isPromotableVar(
     // so that we don't need to construct aggregate temps.
     //
 
-    for (auto u = var->firstUse; u; u = u->nextUse)
+    for (auto u = var->getFirstUse(); u; u = u->getNextUse())
     {
         auto user = u->getUser();
         switch (user->getOp())
@@ -470,9 +470,9 @@ IRInst* tryRemoveTrivialPhi(
     // become trivial. We will recognize such candidates
     // by looking for phi nodes that use this node.
     List<PhiInfo*> otherPhis;
-    for( auto u = phi->firstUse; u; u = u->nextUse )
+    for( auto u = phi->getFirstUse(); u; u = u->getNextUse() )
     {
-        auto user = u->user;
+        auto user = u->getUser();
         if(!user) continue;
         if(user == phi) continue;
 
@@ -776,7 +776,7 @@ IRInst* readVar(
         return val;
     }
 
-    if( blockInfo->block == var->parent )
+    if( blockInfo->block == var->getParent() )
     {
         // If this is the block that actually *introduces*
         // the variable, then there is no reason to keep
@@ -906,7 +906,7 @@ void processBlock(
 
 IRBlock* IREdge::getPredecessor() const
 {
-    return cast<IRBlock>(getUse()->getUser()->parent);
+    return cast<IRBlock>(getUse()->getUser()->getParent());
 }
 
 IRBlock* IREdge::getSuccessor() const
@@ -1160,7 +1160,7 @@ bool constructSSA(ConstructSSAContext* context)
 
         // A terminator better not have uses, so we shouldn't have
         // to replace them.
-        SLANG_ASSERT(!oldTerminator->firstUse);
+        SLANG_ASSERT(!oldTerminator->getFirstUse());
 
 
         // Okay, we should be clear to remove the old terminator
@@ -1219,11 +1219,17 @@ bool constructSSA(IRModule* module, IRInst* globalVal)
     return false;
 }
 
-bool constructSSA(IRModule* module)
+bool constructSSA(IRModule* module, IRCodeSet const* codeToProcess)
 {
     bool changed = false;
     for(auto ii : module->getGlobalInsts())
     {
+        if (codeToProcess)
+        {
+            auto code = as<IRGlobalValueWithCode>(ii);
+            if (code && !codeToProcess->Contains(code))
+                continue;
+        }
         changed |= constructSSA(module, ii);
     }
     return changed;
@@ -5,6 +5,9 @@ namespace Slang
 {
     struct IRModule;
     struct IRGlobalValueWithCode;
+    struct IRCodeSet;
     bool constructSSA(IRModule* module, IRGlobalValueWithCode* globalVal);
-    bool constructSSA(IRModule* module);
+        /// Construct SSA form for the global values with code in the module.
+        /// If `codeToProcess` is set, only the values in it are processed.
+    bool constructSSA(IRModule* module, IRCodeSet const* codeToProcess = nullptr);
 }
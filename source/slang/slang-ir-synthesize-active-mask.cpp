@@ -1,7 +1,7 @@
 // slang-ir-synthesize-active-mask.cpp
 #include "slang-ir-synthesize-active-mask.h"
 
-#include "slang-ir-dominators.h"
+#include "slang-ir-analysis.h"
 #include "slang-ir-insts.h"
 
 namespace Slang
@@ -288,7 +288,7 @@ struct SynthesizeActiveMaskForModuleContext
         // in this function.
 
         List<IRCall*> calls;
-        for( IRUse* use = callee->firstUse; use; use = use->nextUse )
+        for( IRUse* use = callee->getFirstUse(); use; use = use->getNextUse() )
         {
             // We are looking for instructions that use `callee`,
             // where the instruction is a call, and `callee` is used
@@ -557,7 +557,7 @@ struct SynthesizeActiveMaskForFunctionContext
         // To check if the successor is used as a merge
         // point, we must iterate over its uses.
         //
-        for( auto use = succ->firstUse; use; use = use->nextUse )
+        for( auto use = succ->getFirstUse(); use; use = use->getNextUse() )
         {
             // For each use, we need to consider if
             // the user represents a structured control-flow
@@ -971,7 +971,7 @@ struct SynthesizeActiveMaskForFunctionContext
         // the function, since that will help us
         // identify the regions.
         //
-        m_dominatorTree = computeDominatorTree(m_func);
+        m_dominatorTree = IRAnalysisManager::getDominatorTree(m_func);
 
         // Next we look up th active mask for the function's
         // entry region, which had better be set before
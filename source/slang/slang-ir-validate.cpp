@@ -11,9 +11,13 @@ namespace Slang
         // The IR module we are validating.
         IRModule*           module;
 
-        // A diagnostic sink to send errors to if anything is invalid.
+        // A diagnostic sink to send errors to if anything is invalid, or
+        // null if errors are only recorded in `isValid`.
         DiagnosticSink*     sink;
 
+        // Set to false when anything is invalid.
+        bool                isValid = true;
+
         DiagnosticSink* getSink() { return sink; }
 
         // A set of instructions we've seen, to help confirm that
@@ -29,7 +33,11 @@ namespace Slang
     {
         if (!condition)
         {
-            context->getSink()->diagnose(inst, Diagnostics::irValidationFailed, message);
+            context->isValid = false;
+            if (auto sink = context->getSink())
+            {
+                sink->diagnose(inst, Diagnostics::irValidationFailed, message);
+            }
         }
     }
 
@@ -59,8 +67,8 @@ namespace Slang
         {
             // We need to check the integrity of the parent/next/prev links of
             // all of our instructions
-            validate(context, child->parent == parent,  child, "parent link");
-            validate(context, child->prev == prevChild, child, "next/prev link");
+            validate(context, child->getParent() == parent,     child, "parent link");
+            validate(context, child->getPrevInst() == prevChild, child, "next/prev link");
 
             // Recursively validate the instruction itself.
             validateIRInst(context, child);
@@ -258,7 +266,7 @@ namespace Slang
         }
     }
 
-    void validateIRModule(IRModule* module, DiagnosticSink* sink)
+    static bool _validateIRModule(IRModule* module, DiagnosticSink* sink)
     {
         IRValidateContext contextStorage;
         IRValidateContext* context = &contextStorage;
@@ -268,11 +276,64 @@ namespace Slang
         auto moduleInst = module->getModuleInst();
 
         validate(context, moduleInst != nullptr,            moduleInst, "module instruction");
-        validate(context, moduleInst->parent == nullptr,    moduleInst, "module instruction parent");
-        validate(context, moduleInst->prev == nullptr,      moduleInst, "module instruction prev");
-        validate(context, moduleInst->next == nullptr,      moduleInst, "module instruction next");
+        validate(context, moduleInst->getParent() == nullptr,   moduleInst, "module instruction parent");
+        validate(context, moduleInst->getPrevInst() == nullptr, moduleInst, "module instruction prev");
+        validate(context, moduleInst->getNextInst() == nullptr, moduleInst, "module instruction next");
 
         validateIRInst(context, moduleInst);
+        return context->isValid;
+    }
+
+    void validateIRModule(IRModule* module, DiagnosticSink* sink)
+    {
+        _validateIRModule(module, sink);
+    }
+
+    bool isIRModuleValid(IRModule* module)
+    {
+        return _validateIRModule(module, nullptr);
+    }
+
+    static void _validateIRInstMemory(
+        IRValidateContext*  context,
+        IRInst*             inst)
+    {
+        MemoryArena& arena = context->module->getMemoryArena();
+        auto isInModuleMemory = [&](IRInst* value) { return !value || arena.isValid(value, sizeof(IRInst)); };
+
+        validate(context, isInModuleMemory(inst), inst, "instruction in module memory");
+        validate(context, isInModuleMemory(inst->getFullType()), inst, "type in module memory");
+
+        UInt operandCount = inst->getOperandCount();
+        for (UInt ii = 0; ii < operandCount; ++ii)
+        {
+            validate(context, isInModuleMemory(inst->getOperand(ii)), inst, "operand in module memory");
+        }
+
+        // Every use in the list of uses of the instruction must use it, and be in a user in the module's memory
+        IRLink<IRUse>* prevLink = &inst->firstUse;
+        for (IRUse* use = inst->getFirstUse(); use; use = use->getNextUse())
+        {
+            validate(context, use->get() == inst, inst, "use of instruction");
+            validate(context, use->prevLink.get() == prevLink, inst, "use prev link");
+            validate(context, isInModuleMemory(use->getUser()), inst, "user in module memory");
+            prevLink = &use->nextUse;
+        }
+
+        for (auto child : inst->getDecorationsAndChildren())
+        {
+            _validateIRInstMemory(context, child);
+        }
+    }
+
+    void validateIRModuleMemory(IRModule* module, DiagnosticSink* sink)
+    {
+        IRValidateContext contextStorage;
+        IRValidateContext* context = &contextStorage;
+        context->module = module;
+        context->sink = sink;
+
+        _validateIRInstMemory(context, module->getModuleInst());
     }
 
     void validateIRModuleIfEnabled(
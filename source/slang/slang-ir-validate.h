@@ -28,6 +28,15 @@ namespace Slang
     // * Confirm that all the parameters of a block come before any "ordinary" instructions.
     void validateIRModule(IRModule* module, DiagnosticSink* sink);
 
+    // Returns true if `validateIRModule` would find nothing invalid in the module,
+    // without reporting anything.
+    bool isIRModuleValid(IRModule* module);
+
+    // Validate that every instruction in the module, and every operand and user of one,
+    // is in the memory of the module, and that the lists of uses are intact. This is
+    // used to check the result of `IRModule::compact`.
+    void validateIRModuleMemory(IRModule* module, DiagnosticSink* sink);
+
     // A wrapper that calls `validateIRModule` only when IR validation is enabled
     // for the given compile request.
     void validateIRModuleIfEnabled(
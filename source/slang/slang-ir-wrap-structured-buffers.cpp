@@ -134,7 +134,7 @@ struct WrapStructuredBuffersContext
         // scanning through its IR uses, since values of that
         // type are using it as a (type) operand.
         //
-        for( auto typeUse = newStructuredBufferType->firstUse; typeUse; typeUse = typeUse->nextUse )
+        for( auto typeUse = newStructuredBufferType->getFirstUse(); typeUse; typeUse = typeUse->getNextUse() )
         {
             // There might be uses of `newStructuredBufferType` where
             // it isn't being used as the type of a value, so we
@@ -155,7 +155,7 @@ struct WrapStructuredBuffersContext
             // because these could be calls to intrinsic functions like
             // `RWStructuredBuffer.Load`
             //
-            for( auto valueUse = valueOfStructuredBufferType->firstUse; valueUse; valueUse = valueUse->nextUse )
+            for( auto valueUse = valueOfStructuredBufferType->getFirstUse(); valueUse; valueUse = valueUse->getNextUse() )
             {
                 // we are only interested in instructions that are calls,
                 // with at least one argument, where the first argument
@@ -5,6 +5,7 @@
 #include "../core/slang-basic.h"
 
 #include "slang-mangle.h"
+#include "slang-performance-report.h"
 
 namespace Slang
 {
@@ -119,45 +120,218 @@ namespace Slang
 
     //
 
+    namespace { // anonymous
+
+    // The code values that contain the children of a parent inst. Finding them means walking up to the
+    // module inst, and consecutive modifications are typically to insts in the same parent (such as
+    // a block being built, or the uses of an inst being replaced), so the result for the last parent
+    // is held.
+    struct ContainingCodeCache
+    {
+        enum { kMaxCodeCount = 8 };
+
+        void clear() { parent = nullptr; }
+
+        IRInst* parent = nullptr;               ///< The parent, or nullptr if nothing is held
+        uint32_t releaseCount = 0;              ///< The value of s_irMemoryReleaseCount when found
+        IRModuleInst* moduleInst = nullptr;     ///< The module inst containing the parent, or nullptr if not in a module
+        Index codeCount = 0;
+        IRInst* code[kMaxCodeCount];            ///< The code values containing the children of the parent, innermost first
+    };
+
+    } // anonymous
+
+    // Advanced whenever inst memory is freed or reused in a way that the cache can't track (a module
+    // being destroyed or compacted), possibly on another thread. A cached parent is only used if it
+    // hasn't changed since it was found.
+    static std::atomic<uint32_t> s_irMemoryReleaseCount{ 0 };
+
+    static thread_local ContainingCodeCache s_containingCodeCache;
+
+        // Find the code containing the children of `parent`, and the module inst it is in, and hold them in
+        // the cache. The parent is only recorded (so the result is used again) if all of the code could be held.
+    static void _findContainingCode(IRInst* parent, uint32_t releaseCount, ContainingCodeCache& ioCache)
+    {
+        bool isComplete = true;
+        Index codeCount = 0;
+        IRInst* root = parent;
+        for (;;)
+        {
+            if (as<IRGlobalValueWithCode>(root))
+            {
+                if (codeCount < ContainingCodeCache::kMaxCodeCount)
+                {
+                    ioCache.code[codeCount++] = root;
+                }
+                else
+                {
+                    isComplete = false;
+                }
+            }
+            IRInst* next = root->getParent();
+            if (!next)
+            {
+                break;
+            }
+            root = next;
+        }
+
+        ioCache.moduleInst = as<IRModuleInst>(root);
+        ioCache.codeCount = codeCount;
+        // Insts not in a module can be freed without being removed, so aren't held
+        ioCache.parent = (isComplete && ioCache.moduleInst) ? parent : nullptr;
+        ioCache.releaseCount = releaseCount;
+    }
+
+        // Record that `inst` has been modified, by advancing the modification epoch of the
+        // module, and stamping each code bearing value that contains it with the new epoch.
+        //
+        // If `inst` is a global that isn't in any code, and `isOperandChange` is set, the
+        // module inst is stamped instead. Insts being inserted into or removed from a global
+        // that isn't code (such as a decoration on a global variable) are also a change to
+        // the global. Code can depend on globals, but never on globals being inserted into
+        // or removed from the module itself.
+    static void _markContainingCodeModified(IRInst* inst, bool isOperandChange)
+    {
+        // Insts being constructed aren't in a module yet, and there is nothing to mark
+        IRInst* parent = inst ? inst->getParent() : nullptr;
+        if (!parent)
+        {
+            return;
+        }
+
+        ContainingCodeCache& cache = s_containingCodeCache;
+
+        // Moving an inst changes what contains it, and anything inside it
+        if (!isOperandChange && (inst == cache.parent || inst->getFirstDecorationOrChild()))
+        {
+            cache.clear();
+        }
+
+        const uint32_t releaseCount = s_irMemoryReleaseCount.load(std::memory_order_relaxed);
+        const bool isCached = cache.parent == parent && cache.releaseCount == releaseCount;
+        if (!isCached)
+        {
+            _findContainingCode(parent, releaseCount, cache);
+        }
+
+        auto moduleInst = cache.moduleInst;
+        if (!moduleInst || !moduleInst->module)
+        {
+            return;
+        }
+
+        const uint32_t epoch = moduleInst->module->_advanceModificationEpoch();
+        if (moduleInst->module->_isReplacingEquivalentGlobals())
+        {
+            return;
+        }
+
+        const bool isCode = as<IRGlobalValueWithCode>(inst) != nullptr;
+        if (isCode)
+        {
+            inst->m_modificationEpoch = epoch;
+        }
+        else if (cache.codeCount == 0)
+        {
+            // A global that isn't in code
+            if (isOperandChange || parent != moduleInst)
+            {
+                moduleInst->m_modificationEpoch = epoch;
+            }
+            return;
+        }
+
+        for (Index i = 0; i < cache.codeCount; ++i)
+        {
+            cache.code[i]->m_modificationEpoch = epoch;
+        }
+
+        // Code too deeply nested to be held is found by walking up from the outermost held
+        if (cache.codeCount == ContainingCodeCache::kMaxCodeCount && !cache.parent)
+        {
+            for (IRInst* cur = cache.code[cache.codeCount - 1]->getParent(); cur != moduleInst; cur = cur->getParent())
+            {
+                if (as<IRGlobalValueWithCode>(cur))
+                {
+                    cur->m_modificationEpoch = epoch;
+                }
+            }
+        }
+    }
+
     void IRUse::debugValidate()
     {
 #ifdef _DEBUG
-        auto uv = this->usedValue;
+        auto uv = get();
         if(!uv)
         {
-            assert(!nextUse);
-            assert(!prevLink);
+            assert(!nextUse.get());
+            assert(!prevLink.get());
             return;
         }
 
         auto pp = &uv->firstUse;
-        for(auto u = uv->firstUse; u;)
+        for(auto u = uv->getFirstUse(); u;)
         {
-            assert(u->prevLink == pp);
+            assert(u->prevLink.get() == pp);
 
             pp = &u->nextUse;
-            u = u->nextUse;
+            u = u->getNextUse();
         }
 #endif
     }
 
+        // Remove `use` from the list of uses of the value it uses
+    static void _removeFromUseList(IRUse* use)
+    {
+        use->debugValidate();
+
+        if (auto uv = use->get())
+        {
+            use->prevLink.get()->set(use->getNextUse());
+            if(auto nextUse = use->getNextUse())
+            {
+                nextUse->prevLink.set(use->prevLink.get());
+            }
+
+            use->user.set(nullptr);
+            use->usedValue.set(nullptr);
+            use->nextUse.set(nullptr);
+            use->prevLink.set(nullptr);
+
+            if(auto firstUse = uv->getFirstUse())
+                firstUse->debugValidate();
+        }
+    }
+
     void IRUse::init(IRInst* u, IRInst* v)
     {
-        clear();
+        // Setting a use to the value it already has isn't a modification
+        if (get() != v)
+        {
+            _markContainingCodeModified(u, true);
+        }
+        if (getUser() != u && get())
+        {
+            _markContainingCodeModified(getUser(), true);
+        }
 
-        user = u;
-        usedValue = v;
+        _removeFromUseList(this);
+
+        user.set(u);
+        usedValue.set(v);
         if(v)
         {
-            nextUse = v->firstUse;
-            prevLink = &v->firstUse;
+            nextUse.set(v->getFirstUse());
+            prevLink.set(&v->firstUse);
 
-            if(nextUse)
+            if(auto next = getNextUse())
             {
-                nextUse->prevLink = &this->nextUse;
+                next->prevLink.set(&this->nextUse);
             }
 
-            v->firstUse = this;
+            v->firstUse.set(this);
         }
 
         debugValidate();
@@ -165,34 +339,19 @@ namespace Slang
 
     void IRUse::set(IRInst* uv)
     {
-        init(user, uv);
+        init(getUser(), uv);
     }
 
     void IRUse::clear()
     {
         // This `IRUse` is part of the linked list
         // of uses for  `usedValue`.
-
-        debugValidate();
-
-        if (usedValue)
+        if (get())
         {
-            auto uv = usedValue;
-
-            *prevLink = nextUse;
-            if(nextUse)
-            {
-                nextUse->prevLink = prevLink;
-            }
-
-            user        = nullptr;
-            usedValue   = nullptr;
-            nextUse     = nullptr;
-            prevLink    = nullptr;
-
-            if(uv->firstUse)
-                uv->firstUse->debugValidate();
+            _markContainingCodeModified(getUser(), true);
         }
+
+        _removeFromUseList(this);
     }
 
     // IRInstListBase
@@ -201,12 +360,12 @@ namespace Slang
     {
         if (inst)
         {
-            inst = inst->next;
+            inst = inst->getNextInst();
         }
     }
 
     IRInstListBase::Iterator IRInstListBase::begin() { return Iterator(first); }
-    IRInstListBase::Iterator IRInstListBase::end() { return Iterator(last ? last->next : nullptr); }
+    IRInstListBase::Iterator IRInstListBase::end() { return Iterator(last ? last->getNextInst() : nullptr); }
 
     //
 
@@ -529,7 +688,7 @@ namespace Slang
     {
         // We will search until we either find a
         // suitable use, or run out of uses.
-        for (;use; use = use->nextUse)
+        for (;use; use = use->getNextUse())
         {
             // We only want to deal with uses that represent
             // a "sucessor" operand to some terminator instruction.
@@ -578,7 +737,7 @@ namespace Slang
         // used to search for a use that actually represents an edge.
 
         return PredecessorList(
-            adjustPredecessorUse(firstUse));
+            adjustPredecessorUse(getFirstUse()));
     }
 
     UInt IRBlock::PredecessorList::getCount()
@@ -601,13 +760,13 @@ namespace Slang
     void IRBlock::PredecessorList::Iterator::operator++()
     {
         if (!use) return;
-        use = adjustPredecessorUse(use->nextUse);
+        use = adjustPredecessorUse(use->getNextUse());
     }
 
     IRBlock* IRBlock::PredecessorList::Iterator::operator*()
     {
         if (!use) return nullptr;
-        return (IRBlock*)use->getUser()->parent;
+        return (IRBlock*)use->getUser()->getParent();
     }
 
     IRBlock::SuccessorList IRBlock::getSuccessors()
@@ -680,7 +839,7 @@ namespace Slang
 
     IRInst* IRUnconditionalBranch::getArg(UInt index)
     {
-        return getArgs()[index].usedValue;
+        return getArgs()[index].get();
     }
 
     IRParam* IRGlobalValueWithParams::getFirstParam()
@@ -1352,7 +1511,26 @@ namespace Slang
         size_t defaultSize = sizeof(IRInst) + (operandCount) * sizeof(IRUse);
         size_t totalSize = minSizeInBytes > defaultSize ? minSizeInBytes : defaultSize;
 
-        IRInst* inst = (IRInst*) m_memoryArena.allocateAndZero(totalSize);
+        IRInst* inst = nullptr;
+
+        // If the memory of an inst with the same number of operands is available, reuse it
+        FreeInst* freeInst = (totalSize == defaultSize && operandCount < kFreeListCount) ? m_freeInsts[operandCount] : nullptr;
+        if (freeInst)
+        {
+            m_freeInsts[operandCount] = freeInst->next;
+
+            inst = (IRInst*)freeInst;
+            ::memset(inst, 0, totalSize);
+
+            PerformanceReport::addToCounter(PerformanceCounter::IRInstsRecycled);
+        }
+        else
+        {
+            inst = (IRInst*) m_memoryArena.allocateAndZero(totalSize);
+            PerformanceReport::addToCounter(PerformanceCounter::IRInstBytesAllocated, int64_t(totalSize));
+        }
+
+        PerformanceReport::addToCounter(PerformanceCounter::IRInstsCreated);
 
         // TODO: Is it actually important to run a constructor here?
         new(inst) IRInst();
@@ -2116,7 +2294,7 @@ namespace Slang
         IRConstant keyInst;
         memset(&keyInst, 0, sizeof(keyInst));
         keyInst.m_op = kIROp_BoolLit;
-        keyInst.typeUse.usedValue = getBoolType();
+        keyInst.typeUse.usedValue.set(getBoolType());
         keyInst.value.intVal = IRIntegerValue(inValue);
         return _findOrEmitConstant(keyInst);
     }
@@ -2126,7 +2304,7 @@ namespace Slang
         IRConstant keyInst;
         memset(&keyInst, 0, sizeof(keyInst));
         keyInst.m_op = kIROp_IntLit;
-        keyInst.typeUse.usedValue = type;
+        keyInst.typeUse.usedValue.set(type);
         // Truncate the input value based on `type`.
         switch (type->getOp())
         {
@@ -2161,7 +2339,7 @@ namespace Slang
         IRConstant keyInst;
         memset(&keyInst, 0, sizeof(keyInst));
         keyInst.m_op = kIROp_FloatLit;
-        keyInst.typeUse.usedValue = type;
+        keyInst.typeUse.usedValue.set(type);
         // Truncate the input value based on `type`.
         switch (type->getOp())
         {
@@ -2191,7 +2369,7 @@ namespace Slang
         stackDecoration.insertAtEnd(&keyInst);
             
         keyInst.m_op = kIROp_StringLit;
-        keyInst.typeUse.usedValue = getStringType();
+        keyInst.typeUse.usedValue.set(getStringType());
         
         IRConstant::StringSliceValue& dstSlice = keyInst.value.transitoryStringVal;
         dstSlice.chars = const_cast<char*>(inSlice.begin());
@@ -2207,7 +2385,7 @@ namespace Slang
         IRConstant keyInst;
         memset(&keyInst, 0, sizeof(keyInst));
         keyInst.m_op = kIROp_PtrLit;
-        keyInst.typeUse.usedValue = type;
+        keyInst.typeUse.usedValue.set(type);
         keyInst.value.ptrVal = value;
         return (IRPtrLit*) _findOrEmitConstant(keyInst);
     }
@@ -2219,7 +2397,7 @@ namespace Slang
         IRConstant keyInst;
         memset(&keyInst, 0, sizeof(keyInst));
         keyInst.m_op = kIROp_VoidLit;
-        keyInst.typeUse.usedValue = type;
+        keyInst.typeUse.usedValue.set(type);
         keyInst.value.intVal= 0;
         return (IRVoidLit*)_findOrEmitConstant(keyInst);
     }
@@ -2286,7 +2464,7 @@ namespace Slang
         inst->_debugUID = _debugGetAndIncreaseInstCounter();
 #endif
         inst->m_op = op;
-        inst->typeUse.usedValue = type;
+        inst->typeUse.usedValue.set(type);
         inst->operandCount = (uint32_t) operandCount;
 
         // Don't link up as we may free (if we already have this key)
@@ -2297,7 +2475,7 @@ namespace Slang
                 UInt listOperandCount = listOperandCounts[ii];
                 for (UInt jj = 0; jj < listOperandCount; ++jj)
                 {
-                    operand->usedValue = listOperands[ii][jj];
+                    operand->usedValue.set(listOperands[ii][jj]);
                     operand++;
                 }
             }
@@ -2323,7 +2501,7 @@ namespace Slang
         {
             if (type)
             {
-                inst->typeUse.usedValue = nullptr;
+                inst->typeUse.usedValue.set(nullptr);
                 inst->typeUse.init(inst, type);
             }
 
@@ -2333,9 +2511,9 @@ namespace Slang
             for (UInt i = 0; i < operandCount; ++i)
             {
                 IRUse& operand = operands[i];
-                auto value = operand.usedValue;
+                auto value = operand.get();
 
-                operand.usedValue = nullptr;
+                operand.usedValue.set(nullptr);
                 operand.init(inst, value);
             }
         }
@@ -2376,7 +2554,7 @@ namespace Slang
         inst->_debugUID = _debugGetAndIncreaseInstCounter();
 #endif
         inst->m_op = op;
-        inst->typeUse.usedValue = type;
+        inst->typeUse.usedValue.set(type);
         inst->operandCount = (uint32_t)operandCount;
 
         // Don't link up as we may free (if we already have this key)
@@ -2387,7 +2565,7 @@ namespace Slang
                 UInt listOperandCount = listOperandCounts[ii];
                 for (UInt jj = 0; jj < listOperandCount; ++jj)
                 {
-                    operand->usedValue = listOperands[ii][jj];
+                    operand->usedValue.set(listOperands[ii][jj]);
                     operand++;
                 }
             }
@@ -2413,7 +2591,7 @@ namespace Slang
         {
             if (type)
             {
-                inst->typeUse.usedValue = nullptr;
+                inst->typeUse.usedValue.set(nullptr);
                 inst->typeUse.init(inst, type);
             }
 
@@ -2423,9 +2601,9 @@ namespace Slang
             for (UInt i = 0; i < operandCount; ++i)
             {
                 IRUse& operand = operands[i];
-                auto value = operand.usedValue;
+                auto value = operand.get();
 
-                operand.usedValue = nullptr;
+                operand.usedValue.set(nullptr);
                 operand.init(inst, value);
             }
         }
@@ -3479,6 +3657,357 @@ namespace Slang
         return module;
     }
 
+        /// True if the memory of `inst` can be reused once it is deallocated.
+        ///
+        /// Hoistable insts (types, attributes, layouts and constants) are excluded, as a `SharedIRBuilder` may
+        /// still hold them as keys for deduplication after they are removed. They are also not allocated through
+        /// `_allocateInst`, so may not be of the size expected for their operand count.
+    static bool _canRecycleInst(IRInst* inst)
+    {
+        return inst->getOperandCount() < IRModule::kFreeListCount &&
+            !as<IRType>(inst) &&
+            !as<IRAttr>(inst) &&
+            !as<IRLayout>(inst) &&
+            !as<IRConstant>(inst) &&
+            inst->getOp() != kIROp_CapabilitySet &&
+            inst->getOp() != kIROp_Module;
+    }
+
+    void IRModule::_deallocateInst(IRInst* inst)
+    {
+        if (!_canRecycleInst(inst))
+        {
+            return;
+        }
+
+        // A later inst at the same address mustn't be taken to be simplified, or to have been analyzed
+        if (auto code = as<IRGlobalValueWithCode>(inst))
+        {
+            m_simplifiedEpochs.codeEpochs.Remove(code);
+            m_analysisCache.codeEntries.Remove(code);
+        }
+
+        m_deallocatedInsts[inst->getOperandCount()].add(inst);
+    }
+
+    void IRModule::recycleDeallocatedInsts()
+    {
+        // Reused memory can hold an inst in a different parent
+        s_irMemoryReleaseCount++;
+
+        for (Index i = 0; i < kFreeListCount; ++i)
+        {
+            for (IRInst* inst : m_deallocatedInsts[i])
+            {
+                // An inst that is still used (a pass removed it without replacing its uses) can't be reused
+                if (inst->hasUses())
+                {
+                    continue;
+                }
+                FreeInst* freeInst = (FreeInst*)inst;
+                freeInst->next = m_freeInsts[i];
+                m_freeInsts[i] = freeInst;
+            }
+            m_deallocatedInsts[i].clear();
+        }
+    }
+
+        /// Get the size in bytes needed to hold `inst`
+    static size_t _calcInstSize(IRInst* inst)
+    {
+        size_t size = sizeof(IRInst) + inst->getOperandCount() * sizeof(IRUse);
+
+        if (auto constant = as<IRConstant>(inst))
+        {
+            // The value of a constant is held after the fields of IRInst
+            const size_t prefixSize = SLANG_OFFSET_OF(IRConstant, value);
+            size_t constantSize = prefixSize;
+            switch (inst->getOp())
+            {
+                case kIROp_BoolLit:
+                case kIROp_IntLit:      constantSize += sizeof(IRIntegerValue); break;
+                case kIROp_FloatLit:    constantSize += sizeof(IRFloatingPointValue); break;
+                case kIROp_PtrLit:      constantSize += sizeof(void*); break;
+                case kIROp_StringLit:
+                {
+                    constantSize += offsetof(IRConstant::StringValue, chars) + constant->value.stringVal.numChars;
+                    break;
+                }
+                default: break;
+            }
+            size = Math::Max(size, constantSize);
+        }
+        else if (as<IRModuleInst>(inst))
+        {
+            size = Math::Max(size, sizeof(IRModuleInst));
+        }
+        return size;
+    }
+
+        /// Add `root` and all of its decorations and children (recursively) to `outInsts`, in the order they appear
+    static void _addInstsInOrder(IRInst* root, List<IRInst*>& outInsts)
+    {
+        IRInst* inst = root;
+        for (;;)
+        {
+            outInsts.add(inst);
+
+            if (auto child = inst->getFirstDecorationOrChild())
+            {
+                inst = child;
+                continue;
+            }
+
+            while (inst != root && !inst->getNextInst())
+            {
+                inst = inst->getParent();
+            }
+            if (inst == root)
+            {
+                break;
+            }
+            inst = inst->getNextInst();
+        }
+    }
+
+    IRModule::MemoryStats IRModule::calcMemoryStats()
+    {
+        // The sizes of an inst's header, and of an operand, if the pointers they hold were
+        // replaced with 32-bit handles, and the modification epoch was moved to a side table.
+        const size_t compactHeaderSize = 52;
+        const size_t compactOperandSize = 16;
+
+        List<IRInst*> insts;
+        _addInstsInOrder(m_moduleInst, insts);
+
+        MemoryStats stats;
+        stats.instCount = insts.getCount();
+        for (auto inst : insts)
+        {
+            const size_t operandCount = inst->getOperandCount();
+            const size_t size = _calcInstSize(inst);
+
+            // Any payload (such as the value of a constant) is unchanged
+            const size_t payloadSize = size - (sizeof(IRInst) + operandCount * sizeof(IRUse));
+
+            stats.operandCount += Count(operandCount);
+            stats.instBytes += size;
+            stats.compactInstBytes += compactHeaderSize + operandCount * compactOperandSize + payloadSize;
+        }
+        return stats;
+    }
+
+    IRModule::~IRModule()
+    {
+        // The memory of the insts can be reused by other modules
+        s_irMemoryReleaseCount++;
+    }
+
+    void IRModule::compact(Dictionary<IRInst*, IRInst*>* outRemap)
+    {
+        // All of the insts move, and the memory they were in is freed
+        s_irMemoryReleaseCount++;
+
+        MemoryArena arena(kMemoryArenaBlockSize);
+        Dictionary<IRInst*, IRInst*> remap;
+
+        // Copy the insts in the module into the new arena
+        List<IRInst*> insts;
+        _addInstsInOrder(m_moduleInst, insts);
+
+        auto copyInsts = [&](Index startIndex)
+        {
+            for (Index i = startIndex; i < insts.getCount(); ++i)
+            {
+                IRInst* inst = insts[i];
+                const size_t size = _calcInstSize(inst);
+                IRInst* newInst = (IRInst*)arena.allocate(size);
+                ::memcpy(newInst, inst, size);
+                remap.Add(inst, newInst);
+            }
+        };
+        copyInsts(0);
+
+        // Insts that aren't in the module can still be used by, or use, insts in the module (for example if a pass
+        // removed an inst from its parent, but didn't deallocate it). They must be copied too, along with any insts
+        // they contain.
+        auto addInstsNotInModule = [&](IRInst* inst)
+        {
+            if (!inst || remap.ContainsKey(inst))
+            {
+                return;
+            }
+            IRInst* root = inst;
+            while (root->getParent())
+            {
+                root = root->getParent();
+            }
+            SLANG_ASSERT(root->getOp() != kIROp_Module);
+
+            const Index startIndex = insts.getCount();
+            _addInstsInOrder(root, insts);
+            copyInsts(startIndex);
+
+            PerformanceReport::addToCounter(PerformanceCounter::IRDetachedInstsCompacted, int64_t(insts.getCount() - startIndex));
+        };
+        for (Index i = 0; i < insts.getCount(); ++i)
+        {
+            IRInst* inst = insts[i];
+            addInstsNotInModule(inst->getFullType());
+            for (UInt j = 0; j < inst->getOperandCount(); ++j)
+            {
+                addInstsNotInModule(inst->getOperand(j));
+            }
+            for (IRUse* use = inst->getFirstUse(); use; use = use->getNextUse())
+            {
+                addInstsNotInModule(use->getUser());
+            }
+        }
+
+        // Update all of the pointers between insts (which currently point to the previous insts)
+        auto remapInst = [&](IRInst* inst) -> IRInst*
+        {
+            return inst ? *remap.TryGetValue(inst) : nullptr;
+        };
+        // A use is at the same offset in the new copy of its user
+        auto remapUse = [&](IRUse* use) -> IRUse*
+        {
+            if (!use)
+            {
+                return nullptr;
+            }
+            IRInst* user = use->getUser();
+            return (IRUse*)((char*)remapInst(user) + ((char*)use - (char*)user));
+        };
+
+        for (auto inst : insts)
+        {
+            IRInst* newInst = remapInst(inst);
+
+            newInst->parent.set(remapInst(inst->getParent()));
+            newInst->next.set(remapInst(inst->getNextInst()));
+            newInst->prev.set(remapInst(inst->getPrevInst()));
+            newInst->m_decorationsAndChildren.first.set(remapInst(inst->getFirstDecorationOrChild()));
+            newInst->m_decorationsAndChildren.last.set(remapInst(inst->getLastDecorationOrChild()));
+            newInst->firstUse.set(remapUse(inst->getFirstUse()));
+
+            // The type is the use before the operands
+            const Index useCount = Index(inst->getOperandCount()) + 1;
+            IRUse* uses = &inst->typeUse;
+            IRUse* newUses = &newInst->typeUse;
+            for (Index i = 0; i < useCount; ++i)
+            {
+                const IRUse& use = uses[i];
+                IRUse& newUse = newUses[i];
+
+                newUse.usedValue.set(remapInst(use.get()));
+                newUse.user.set(use.getUser() ? newInst : nullptr);
+                newUse.nextUse.set(remapUse(use.getNextUse()));
+
+                // The link is either to the first use of the used value, or the next use of the previous use
+                IRLink<IRUse>* prevLink = use.prevLink.get();
+                if (!prevLink)
+                {
+                    newUse.prevLink.set(nullptr);
+                }
+                else if (prevLink == &use.get()->firstUse)
+                {
+                    newUse.prevLink.set(&newUse.get()->firstUse);
+                }
+                else
+                {
+                    IRUse* prevUse = (IRUse*)((char*)prevLink - SLANG_OFFSET_OF(IRUse, nextUse));
+                    newUse.prevLink.set(&remapUse(prevUse)->nextUse);
+                }
+            }
+        }
+
+        m_moduleInst = as<IRModuleInst>(remapInst(m_moduleInst));
+
+        {
+            IRSimplifiedEpochs simplifiedEpochs;
+            simplifiedEpochs.moduleInstEpoch = m_simplifiedEpochs.moduleInstEpoch;
+            for (const auto& entry : m_simplifiedEpochs.codeEpochs)
+            {
+                // Code that has been removed from the module isn't copied
+                if (IRInst** newCode = remap.TryGetValue(entry.Key))
+                {
+                    simplifiedEpochs.codeEpochs.Add(as<IRGlobalValueWithCode>(*newCode), entry.Value);
+                }
+            }
+            m_simplifiedEpochs = _Move(simplifiedEpochs);
+        }
+
+        // Analyses refer to the previous insts
+        m_analysisCache = IRAnalysisCache();
+
+        // The index holds slices of string literals, so is rebuilt if needed
+        m_symbolIndex = IRModuleSymbolIndex();
+        m_hasSymbolIndex = false;
+
+        // Deallocated insts are in the previous memory
+        for (Index i = 0; i < kFreeListCount; ++i)
+        {
+            m_deallocatedInsts[i].clear();
+            m_freeInsts[i] = nullptr;
+        }
+
+        const size_t previousSize = m_memoryArena.calcTotalMemoryUsed();
+        m_memoryArena.swapWith(arena);
+
+        PerformanceReport::addToCounter(PerformanceCounter::IRModuleCompactions);
+        PerformanceReport::addToCounter(PerformanceCounter::IRBytesReclaimedByCompaction, int64_t(previousSize) - int64_t(m_memoryArena.calcTotalMemoryUsed()));
+
+        if (outRemap)
+        {
+            *outRemap = _Move(remap);
+        }
+    }
+
+    void IRModuleSymbolIndex::addGlobalValues(IRModule* module)
+    {
+        // The last value added with each name, so the next one can be chained onto it
+        FlatDictionary<UnownedStringSlice, Index> lastIndexByName;
+
+        for (auto inst : module->getGlobalInsts())
+        {
+            auto linkage = inst->findDecoration<IRLinkageDecoration>();
+            if (!linkage)
+                continue;
+
+            const UnownedStringSlice mangledName = linkage->getMangledName();
+            const Index index = m_symbols.getCount();
+
+            m_symbols.add(inst);
+            m_nextWithSameName.add(-1);
+
+            if (Index* lastIndexPtr = lastIndexByName.TryGetValue(mangledName))
+            {
+                m_nextWithSameName[*lastIndexPtr] = index;
+                *lastIndexPtr = index;
+            }
+            else
+            {
+                m_firstIndexByName.Add(mangledName, index);
+                lastIndexByName.Add(mangledName, index);
+            }
+        }
+    }
+
+    const IRModuleSymbolIndex& IRModule::getSymbolIndex()
+    {
+        if (!m_hasSymbolIndex.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(m_symbolIndexMutex);
+            if (!m_hasSymbolIndex.load(std::memory_order_relaxed))
+            {
+                m_symbolIndex.addGlobalValues(this);
+                m_hasSymbolIndex.store(true, std::memory_order_release);
+            }
+        }
+        return m_symbolIndex;
+    }
+
     void addGlobalValue(
         IRBuilder*  builder,
         IRInst*     value)
@@ -3504,12 +4033,12 @@ namespace Slang
             // a generic? That is okay too.
             if (auto block = as<IRBlock>(parent))
             {
-                if (as<IRGeneric>(block->parent))
+                if (as<IRGeneric>(block->getParent()))
                     break;
             }
 
             // Otherwise, move up the chain.
-            parent = parent->parent;
+            parent = parent->getParent();
         }
 
         // If we somehow ran out of parents (possibly
@@ -4875,7 +5404,7 @@ namespace Slang
 
     bool instHasUses(IRInst* inst)
     {
-        return inst->firstUse != nullptr;
+        return inst->hasUses();
     }
 
     static void scrubName(
@@ -5801,7 +6330,7 @@ namespace Slang
 
         // We will walk through the list of uses for the current
         // instruction, and make them point to the other inst.
-        IRUse* ff = firstUse;
+        IRUse* ff = getFirstUse();
 
         // No uses? Nothing to do.
         if(!ff)
@@ -5817,11 +6346,12 @@ namespace Slang
             SLANG_ASSERT(uu->get() == this);
 
             // Swap this use over to use the other value.
-            uu->usedValue = other;
+            uu->usedValue.set(other);
+            _markContainingCodeModified(uu->getUser(), true);
 
             // Try to move to the next use, but bail
             // out if we are at the last one.
-            IRUse* nn = uu->nextUse;
+            IRUse* nn = uu->getNextUse();
             if( !nn )
                 break;
 
@@ -5840,21 +6370,21 @@ namespace Slang
         // If the value already had uses, then
         // we need to patch our new list onto
         // the front.
-        if( auto nn = other->firstUse )
+        if( auto nn = other->getFirstUse() )
         {
-            uu->nextUse = nn;
-            nn->prevLink = &uu->nextUse;
+            uu->nextUse.set(nn);
+            nn->prevLink.set(&uu->nextUse);
         }
 
         // No matter what, our list of
         // uses will become the start
         // of the list of uses for
         // `other`
-        other->firstUse = ff;
-        ff->prevLink = &other->firstUse;
+        other->firstUse.set(ff);
+        ff->prevLink.set(&other->firstUse);
 
         // And `this` will have no uses any more.
-        this->firstUse = nullptr;
+        this->firstUse.set(nullptr);
 
         ff->debugValidate();
     }
@@ -5875,7 +6405,7 @@ namespace Slang
 
     void IRInst::moveToStart()
     {
-        auto p = parent;
+        auto p = getParent();
         removeFromParent();
         insertAtStart(p);
     }
@@ -5891,25 +6421,27 @@ namespace Slang
 
         if( inPrev )
         {
-            inPrev->next = this;
+            inPrev->next.set(this);
         }
         else
         {
-            inParent->m_decorationsAndChildren.first = this;
+            inParent->m_decorationsAndChildren.first.set(this);
         }
 
         if (inNext)
         {
-            inNext->prev = this;
+            inNext->prev.set(this);
         }
         else
         {
-            inParent->m_decorationsAndChildren.last = this;
+            inParent->m_decorationsAndChildren.last.set(this);
         }
 
-        this->prev = inPrev;
-        this->next = inNext;
-        this->parent = inParent;
+        this->prev.set(inPrev);
+        this->next.set(inNext);
+        this->parent.set(inParent);
+
+        _markContainingCodeModified(this, false);
     }
 
     void IRInst::insertAfter(IRInst* other)
@@ -5928,7 +6460,7 @@ namespace Slang
 
     void IRInst::moveToEnd()
     {
-        auto p = parent;
+        auto p = getParent();
         removeFromParent();
         insertAtEnd(p);
     }
@@ -5967,32 +6499,34 @@ namespace Slang
         if(!oldParent)
             return;
 
+        _markContainingCodeModified(this, false);
+
         auto pp = getPrevInst();
         auto nn = getNextInst();
 
         if(pp)
         {
             SLANG_ASSERT(pp->getParent() == oldParent);
-            pp->next = nn;
+            pp->next.set(nn);
         }
         else
         {
-            oldParent->m_decorationsAndChildren.first = nn;
+            oldParent->m_decorationsAndChildren.first.set(nn);
         }
 
         if(nn)
         {
             SLANG_ASSERT(nn->getParent() == oldParent);
-            nn->prev = pp;
+            nn->prev.set(pp);
         }
         else
         {
-            oldParent->m_decorationsAndChildren.last = pp;
+            oldParent->m_decorationsAndChildren.last.set(pp);
         }
 
-        prev = nullptr;
-        next = nullptr;
-        parent = nullptr;
+        prev.set(nullptr);
+        next.set(nullptr);
+        parent.set(nullptr);
     }
 
     void IRInst::removeArguments()
@@ -6008,22 +6542,39 @@ namespace Slang
     // Remove this instruction from its parent block,
     // and then destroy it (it had better have no uses!)
     void IRInst::removeAndDeallocate()
+    {
+        // The module can't be found once the inst has been removed from its parent
+        _removeAndDeallocate(getModule());
+    }
+
+    void IRInst::removeAndDeallocateAllDecorationsAndChildren()
+    {
+        _removeAndDeallocateAllDecorationsAndChildren(getModule());
+    }
+
+    void IRInst::_removeAndDeallocate(IRModule* module)
     {
         removeFromParent();
         removeArguments();
-        removeAndDeallocateAllDecorationsAndChildren();
+        _removeAndDeallocateAllDecorationsAndChildren(module);
+
+        // Insts that weren't in a module (and so can't be found) are never reused
+        if (module)
+        {
+            module->_deallocateInst(this);
+        }
 
         // Run destructor to be sure...
         this->~IRInst();
     }
 
-    void IRInst::removeAndDeallocateAllDecorationsAndChildren()
+    void IRInst::_removeAndDeallocateAllDecorationsAndChildren(IRModule* module)
     {
         IRInst* nextChild = nullptr;
         for( IRInst* child = getFirstDecorationOrChild(); child; child = nextChild )
         {
             nextChild = child->getNextInst();
-            child->removeAndDeallocate();
+            child->_removeAndDeallocate(module);
         }
     }
 
@@ -9,6 +9,10 @@
 
 #include "../core/slang-basic.h"
 #include "../core/slang-memory-arena.h"
+#include "../core/slang-flat-dictionary.h"
+
+#include <atomic>
+#include <mutex>
 
 #include "../compiler-core/slang-source-loc.h"
 
@@ -95,28 +99,42 @@ struct IROpInfo
 // Look up the info for an op
 IROpInfo getIROpInfo(IROp op);
 
+    /// A link from one part of the IR to another, such as from an instruction to its parent.
+    ///
+    /// The links between instructions (and their uses) are only accessed through `get` and `set`,
+    /// so that how they are held can change (see docs/design/ir-compact-encoding.md).
+template <typename T>
+struct IRLink
+{
+    T* get() const { return m_ptr; }
+    void set(T* value) { m_ptr = value; }
+
+    T* m_ptr = nullptr;
+};
+
 // A use of another value/inst within an IR operation
 struct IRUse
 {
-    IRInst* get() const { return usedValue; }
-    IRInst* getUser() const { return user; }
+    IRInst* get() const { return usedValue.get(); }
+    IRInst* getUser() const { return user.get(); }
+    IRUse* getNextUse() const { return nextUse.get(); }
 
     void init(IRInst* user, IRInst* usedValue);
     void set(IRInst* usedValue);
     void clear();
 
     // The instruction that is being used
-    IRInst* usedValue = nullptr;
+    IRLink<IRInst> usedValue;
 
     // The instruction that is doing the using.
-    IRInst* user = nullptr;
+    IRLink<IRInst> user;
 
     // The next use of the same value
-    IRUse*  nextUse = nullptr;
+    IRLink<IRUse> nextUse;
 
     // A "link" back to where this use is referenced,
     // so that we can simplify updates.
-    IRUse** prevLink = nullptr;
+    IRLink<IRLink<IRUse>> prevLink;
 
     void debugValidate();
 };
@@ -478,6 +496,11 @@ struct IRInst
     // Source location information for this value, if any
     SourceLoc sourceLoc;
 
+    // For an `IRGlobalValueWithCode`, the modification epoch of its module when the code
+    // was last modified (see `IRGlobalValueWithCode::getModificationEpoch`). It is held
+    // here because on 64 bit targets it fits in what would otherwise be padding.
+    uint32_t m_modificationEpoch = 0;
+
     // Each instruction can have zero or more "decorations"
     // attached to it. A decoration is a specialized kind
     // of instruction that either attaches metadata to,
@@ -527,20 +550,21 @@ struct IRInst
     }
 
     // The first use of this value (start of a linked list)
-    IRUse*      firstUse = nullptr;
+    IRLink<IRUse> firstUse;
 
+    IRUse* getFirstUse() const { return firstUse.get(); }
 
     // The parent of this instruction.
-    IRInst*   parent;
+    IRLink<IRInst> parent;
 
-    IRInst* getParent() { return parent; }
+    IRInst* getParent() { return parent.get(); }
 
     // The next and previous instructions with the same parent
-    IRInst*         next;
-    IRInst*         prev;
+    IRLink<IRInst> next;
+    IRLink<IRInst> prev;
 
-    IRInst* getNextInst() { return next; }
-    IRInst* getPrevInst() { return prev; }
+    IRInst* getNextInst() { return next.get(); }
+    IRInst* getPrevInst() { return prev.get(); }
 
     // An instruction can have zero or more children, although
     // only certain instruction opcodes are allowed to have
@@ -570,14 +594,23 @@ struct IRInst
         // to be the last field in `IRInst` and to come right before any additional
         // `IRUse` values that represent operands.
         //
-    IRInstListBase m_decorationsAndChildren;
+    struct DecorationsAndChildren
+    {
+        IRLink<IRInst> first;
+        IRLink<IRInst> last;
+    };
+    DecorationsAndChildren m_decorationsAndChildren;
 
-    IRInst* getFirstDecorationOrChild() { return m_decorationsAndChildren.first; }
-    IRInst* getLastDecorationOrChild()  { return m_decorationsAndChildren.last;  }
-    IRInstListBase getDecorationsAndChildren() { return m_decorationsAndChildren; }
+    IRInst* getFirstDecorationOrChild() { return m_decorationsAndChildren.first.get(); }
+    IRInst* getLastDecorationOrChild()  { return m_decorationsAndChildren.last.get();  }
+    IRInstListBase getDecorationsAndChildren() { return IRInstListBase(getFirstDecorationOrChild(), getLastDecorationOrChild()); }
 
     void removeAndDeallocateAllDecorationsAndChildren();
 
+        /// Implementation of `removeAndDeallocate`, where `module` is the module the inst was in (if any).
+    void _removeAndDeallocate(IRModule* module);
+    void _removeAndDeallocateAllDecorationsAndChildren(IRModule* module);
+
 #ifdef SLANG_ENABLE_IR_BREAK_ALLOC
     // Unique allocation ID for this instruction since start of current process.
     // Used to aid debugging only.
@@ -610,7 +643,7 @@ struct IRInst
 
     void setOperand(UInt index, IRInst* value)
     {
-        SLANG_ASSERT(getOperands()[index].user != nullptr);
+        SLANG_ASSERT(getOperands()[index].getUser() != nullptr);
         getOperands()[index].set(value);
     }
 
@@ -653,10 +686,10 @@ struct IRInst
     void transferDecorationsTo(IRInst* target);
 
     /// Does this instruction have any uses?
-    bool hasUses() const { return firstUse != nullptr; }
+    bool hasUses() const { return getFirstUse() != nullptr; }
 
     /// Does this instructiomn have more than one use?
-    bool hasMoreThanOneUse() const { return firstUse != nullptr && firstUse->nextUse != nullptr; }
+    bool hasMoreThanOneUse() const { return hasUses() && getFirstUse()->getNextUse() != nullptr; }
 
     /// It is possible that this instruction has side effects?
     ///
@@ -738,7 +771,7 @@ T* IRInst::findDecoration()
 template<typename T>
 typename IRInstList<T>::Iterator IRInstList<T>::end()
 {
-    return Iterator(last ? last->next : nullptr);
+    return Iterator(last ? last->getNextInst() : nullptr);
 }
 
 
@@ -1581,9 +1614,57 @@ struct IRGlobalValueWithCode : IRInst
     // Add a block to the end of this function.
     void addBlock(IRBlock* block);
 
+        /// Get the modification epoch of the module when anything in this value's code was
+        /// last inserted, removed or had its operands changed (including in any nested code).
+        ///
+        /// Passes can record the epoch when they process code, and skip the code later
+        /// if the epoch is unchanged.
+    uint32_t getModificationEpoch() const { return m_modificationEpoch; }
+
     IR_PARENT_ISA(GlobalValueWithCode)
 };
 
+    /// A set of code bearing values, used to restrict the code a pass processes
+struct IRCodeSet : FlatHashSet<IRGlobalValueWithCode*>
+{
+};
+
+    /// The modification epochs at which code was last found to be fully simplified by `simplifyIR`
+struct IRSimplifiedEpochs
+{
+        /// Epoch of the code
+    FlatDictionary<IRGlobalValueWithCode*, uint32_t> codeEpochs;
+        /// Epoch of the module inst, which changes when the operands of globals not in code are modified
+    uint32_t moduleInstEpoch = 0;
+        /// If set, code that is unmodified since it was simplified is processed anyway, and it is an
+        /// internal error if that modifies it (see `-verify-ir-simplify`)
+    bool shouldVerify = false;
+};
+
+    /// Kinds of analysis of code that are cached in a module (see `IRAnalysisManager`)
+enum class IRAnalysisKind
+{
+    Postorder,              ///< The blocks of the code in postorder
+    DominatorTree,          ///< The dominator tree of the code
+    CountOf,
+};
+
+    /// Analyses of code in a module, each held with the modification epoch of the code it was computed for
+struct IRAnalysisCache
+{
+    struct Entry
+    {
+        RefPtr<RefObject> analysis;
+        uint32_t epoch = 0;
+    };
+    struct CodeEntries
+    {
+        Entry entries[Index(IRAnalysisKind::CountOf)];
+    };
+
+    Dictionary<IRGlobalValueWithCode*, CodeEntries> codeEntries;
+};
+
 // A value that has parameters so that it can conceptually be called.
 struct IRGlobalValueWithParams : IRGlobalValueWithCode
 {
@@ -1675,12 +1756,41 @@ struct IRModuleInst : IRInst
     IR_LEAF_ISA(Module)
 };
 
+    /// An index from mangled names to the global values in a module that have that name
+    /// (through an `IRLinkageDecoration`).
+    ///
+    /// The names are slices of the string literals in the module, so the index can only be
+    /// used while the module is alive.
+struct IRModuleSymbolIndex
+{
+        /// Get the index in `m_symbols` of the first global value with the name, or -1 if there isn't one
+    Index findFirst(const UnownedStringSlice& mangledName) const
+    {
+        const Index* indexPtr = m_firstIndexByName.TryGetValue(mangledName);
+        return indexPtr ? *indexPtr : -1;
+    }
+        /// Get the index of the next global value with the same name as the one at `index`, or -1 if there isn't one
+    Index getNext(Index index) const { return m_nextWithSameName[index]; }
+
+        /// Add all of the global values with mangled names in the module
+    void addGlobalValues(IRModule* module);
+
+        /// Global values with a mangled name, in the order they appear in the module
+    List<IRInst*> m_symbols;
+        /// For each value in `m_symbols`, the index of the next value with the same name (or -1)
+    List<Index> m_nextWithSameName;
+
+protected:
+    FlatDictionary<UnownedStringSlice, Index> m_firstIndexByName;
+};
+
 struct IRModule : RefObject
 {
 public:
     enum 
     {
         kMemoryArenaBlockSize = 16 * 1024,           ///< Use 16k block size for memory arena
+        kFreeListCount = 8,                         ///< Insts with fewer operands than this have their memory recycled
     };
 
     static RefPtr<IRModule> create(Session* session);
@@ -1691,6 +1801,29 @@ public:
 
     IRInstListBase getGlobalInsts() const { return getModuleInst()->getChildren(); }
 
+        /// Get the index of the global values in this module by mangled name.
+        ///
+        /// The index is built on first use, and then kept, so should only be used once the module
+        /// is complete (for example when it is being linked). It's safe to call from multiple threads.
+    const IRModuleSymbolIndex& getSymbolIndex();
+
+        /// Get the modification epoch, which is advanced each time the module is modified
+    uint32_t getModificationEpoch() const { return m_modificationEpoch; }
+        /// Advance the modification epoch, returning the new epoch
+    uint32_t _advanceModificationEpoch() { return ++m_modificationEpoch; }
+
+        /// Set while globals are replaced by equivalent ones (see `deduplicateAndRebuildGlobalNumberingMap`).
+        /// That doesn't change the meaning of the insts using them, so only advances the module's epoch, and
+        /// isn't a modification of the code they are in.
+    void _setIsReplacingEquivalentGlobals(bool value) { m_isReplacingEquivalentGlobals = value; }
+    bool _isReplacingEquivalentGlobals() const { return m_isReplacingEquivalentGlobals; }
+
+        /// The modification epochs of code when `simplifyIR` last found it couldn't be simplified further
+    IRSimplifiedEpochs& getSimplifiedEpochs() { return m_simplifiedEpochs; }
+
+        /// The analyses of code in the module that have been computed (see `IRAnalysisManager`)
+    IRAnalysisCache& getAnalysisCache() { return m_analysisCache; }
+
         /// Create an empty instruction with the `op` opcode and space for
         /// a number of operands given by `operandCount`.
         ///
@@ -1725,6 +1858,45 @@ public:
         return (T*) _allocateInst(op, operandCount, sizeof(T));
     }
 
+        /// Note that `inst` (which was in this module) has been removed and deallocated.
+        ///
+        /// The memory of the inst isn't reused straight away, as passes may still be holding (and reading
+        /// through) pointers to the insts they removed. It is only reused after `recycleDeallocatedInsts`.
+    void _deallocateInst(IRInst* inst);
+
+        /// Make the memory of insts deallocated so far available to be reused by new insts.
+        ///
+        /// Must only be called when nothing holds pointers to deallocated insts - typically between passes.
+        /// Deallocated insts that still have uses are never reused.
+    void recycleDeallocatedInsts();
+
+        /// Get the bytes used by all of the insts in the module
+    size_t calcInstBytesInUse() { return calcMemoryStats().instBytes; }
+
+        /// Statistics on the memory used by the insts in a module
+    struct MemoryStats
+    {
+        Count instCount = 0;                ///< The insts in the module
+        Count operandCount = 0;             ///< Operands of the insts, not including their types
+        size_t instBytes = 0;               ///< Bytes used by the insts
+        size_t compactInstBytes = 0;        ///< Estimate of the bytes the insts would use with 32-bit handles (see docs/design/ir-compact-encoding.md)
+    };
+
+        /// Calculate statistics on the memory used by the insts in the module
+    MemoryStats calcMemoryStats();
+
+        /// Copy the insts of the module into new memory, and free the memory previously used.
+        ///
+        /// Removed insts (and insts created for lookups) still take up memory in the module until it is compacted.
+        /// The insts are copied in the order they appear in the module, so the insts of a function are adjacent.
+        ///
+        /// All pointers to insts held outside of the module (such as by passes, or a `SharedIRBuilder`) are
+        /// invalidated, so this must only be called between passes. If `outRemap` is set, it receives the new
+        /// inst for each previous one, so such pointers can be updated.
+    void compact(Dictionary<IRInst*, IRInst*>* outRemap = nullptr);
+
+    ~IRModule();
+
 private:
     IRModule() = delete;
 
@@ -1749,6 +1921,28 @@ private:
 
         /// The memory arena from which all IR instructions (and any associated state) in this module are allocated.
     MemoryArena m_memoryArena;
+
+        /// Index of global values by mangled name, built when first needed
+    IRModuleSymbolIndex m_symbolIndex;
+    std::atomic<bool> m_hasSymbolIndex{ false };
+    std::mutex m_symbolIndexMutex;
+
+        /// Advanced each time code in the module is modified
+    uint32_t m_modificationEpoch = 0;
+    bool m_isReplacingEquivalentGlobals = false;
+    IRSimplifiedEpochs m_simplifiedEpochs;
+    IRAnalysisCache m_analysisCache;
+
+        /// The memory of a deallocated inst, when in a free list
+    struct FreeInst
+    {
+        FreeInst* next;
+    };
+
+        /// Deallocated insts that can't be reused yet, indexed by operand count
+    List<IRInst*> m_deallocatedInsts[kFreeListCount];
+        /// Memory available for new insts, indexed by operand count
+    FreeInst* m_freeInsts[kFreeListCount] = {};
 };
 
 struct IRSpecializationDictionaryItem : public IRInst
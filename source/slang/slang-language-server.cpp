@@ -140,6 +140,7 @@ SlangResult LanguageServer::parseNextMessage()
             else if (call.method == "initialized")
             {
                 registerCapability("workspace/didChangeConfiguration");
+                registerWatchedFiles();
                 sendConfigRequest();
                 m_initialized = true;
                 return SLANG_OK;
@@ -390,7 +391,7 @@ SlangResult LanguageServer::hover(
     Index line, col;
     doc->zeroBasedUTF16LocToOneBasedUTF8Loc(args.position.line, args.position.character, line, col);
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = m_workspace->getVersionForDocument(canonicalPath);
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -511,7 +512,7 @@ SlangResult LanguageServer::gotoDefinition(
     Index line, col;
     doc->zeroBasedUTF16LocToOneBasedUTF8Loc(args.position.line, args.position.character, line, col);
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = m_workspace->getVersionForDocument(canonicalPath);
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -613,16 +614,6 @@ SlangResult LanguageServer::gotoDefinition(
     }
 }
 
-template <typename Func> struct Deferred
-{
-    Func f;
-    Deferred(const Func& func)
-        : f(func)
-    {}
-    ~Deferred() { f(); }
-};
-template <typename Func> Deferred<Func> makeDeferred(const Func& f) { return Deferred<Func>(f); }
-
 SlangResult LanguageServer::completion(
     const LanguageServerProtocol::CompletionParams& args, const JSONValue& responseId)
 {
@@ -709,13 +700,20 @@ SlangResult LanguageServer::completion(
     }
 
 
-    // Insert a completion request token at cursor position.
+    // Insert a completion request token at cursor position. The version holds its own copy of the
+    // document, so the opened document is unaffected.
+    RefPtr<DocumentVersion> completionDoc;
+    if (!version->documents.TryGetValue(canonicalPath, completionDoc))
+    {
+        m_connection->sendResult(NullResponse::get(), responseId);
+        return SLANG_OK;
+    }
     auto originalText = doc->getText();
     StringBuilder newText;
     newText << originalText.getUnownedSlice().head(cursorOffset + 1) << "#?"
         << originalText.getUnownedSlice().tail(cursorOffset + 1);
-    doc->setText(newText.ProduceString());
-    auto restoreDocText = makeDeferred([&]() { doc->setText(originalText); });
+    completionDoc->setText(newText.ProduceString());
+    context.doc = completionDoc.Ptr();
 
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
@@ -799,7 +797,7 @@ SlangResult LanguageServer::semanticTokens(
         return SLANG_OK;
     }
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = m_workspace->getVersionForDocument(canonicalPath);
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -839,7 +837,7 @@ SlangResult LanguageServer::signatureHelp(
     Index line, col;
     doc->zeroBasedUTF16LocToOneBasedUTF8Loc(args.position.line, args.position.character, line, col);
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = m_workspace->getVersionForDocument(canonicalPath);
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -1032,7 +1030,7 @@ SlangResult LanguageServer::documentSymbol(
         m_connection->sendResult(NullResponse::get(), responseId);
         return SLANG_OK;
     }
-    auto version = m_workspace->getCurrentVersion();
+    auto version = m_workspace->getVersionForDocument(canonicalPath);
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -1053,7 +1051,7 @@ SlangResult LanguageServer::inlayHint(const LanguageServerProtocol::InlayHintPar
         m_connection->sendResult(NullResponse::get(), responseId);
         return SLANG_OK;
     }
-    auto version = m_workspace->getCurrentVersion();
+    auto version = m_workspace->getVersionForDocument(canonicalPath);
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -1161,6 +1159,24 @@ SlangResult LanguageServer::onTypeFormatting(const LanguageServerProtocol::Docum
     return SLANG_OK;
 }
 
+static bool _isSameDiagnostics(
+    const List<LanguageServerProtocol::Diagnostic>& lastPublished, const DocumentDiagnostics& diagnostics)
+{
+    if (lastPublished.getCount() != diagnostics.messages.Count())
+        return false;
+    Index index = 0;
+    for (auto& d : diagnostics.messages)
+    {
+        auto& other = lastPublished[index++];
+        if (!(d == other) || d.severity != other.severity ||
+            d.range.start.character != other.range.start.character ||
+            d.range.end.line != other.range.end.line ||
+            d.range.end.character != other.range.end.character)
+            return false;
+    }
+    return true;
+}
+
 void LanguageServer::publishDiagnostics()
 {
 
@@ -1168,9 +1184,14 @@ void LanguageServer::publishDiagnostics()
     {
         return;
     }
+
+    // Publish the diagnostics of the latest version that has been checked in the background, rather
+    // than waiting for a version of the latest changes.
+    auto version = m_workspace->getLastCheckedVersion();
+    if (!version)
+        return;
     m_lastDiagnosticUpdateTime = std::chrono::system_clock::now();
 
-    auto version = m_workspace->getCurrentVersion();
     // Send updates to clear diagnostics for files that no longer have any messages.
     List<String> filesToRemove;
     for (auto& file : m_lastPublishedDiagnostics)
@@ -1191,14 +1212,14 @@ void LanguageServer::publishDiagnostics()
     for (auto& list : version->diagnostics)
     {
         auto lastPublished = m_lastPublishedDiagnostics.TryGetValue(list.Key);
-        if (!lastPublished || *lastPublished != list.Value.originalOutput)
+        if (!lastPublished || !_isSameDiagnostics(*lastPublished, list.Value))
         {
             PublishDiagnosticsParams args;
             args.uri = URI::fromLocalFilePath(list.Key.getUnownedSlice()).uri;
             for (auto& d : list.Value.messages)
                 args.diagnostics.add(d);
             m_connection->sendCall(UnownedStringSlice("textDocument/publishDiagnostics"), &args);
-            m_lastPublishedDiagnostics[list.Key] = list.Value.originalOutput;
+            m_lastPublishedDiagnostics[list.Key] = _Move(args.diagnostics);
         }
     }
 }
@@ -1378,6 +1399,25 @@ void LanguageServer::registerCapability(const char* methodName)
         UnownedStringSlice("client/registerCapability"), &args, JSONValue::makeInt(999));
 }
 
+void LanguageServer::registerWatchedFiles()
+{
+    // Files that aren't opened are loaded from disk, so the server needs to know when they change
+    DidChangeWatchedFilesRegistrationParams args;
+    DidChangeWatchedFilesRegistration reg;
+    reg.method = DidChangeWatchedFilesParams::methodName;
+    reg.id = reg.method;
+    const char* const globPatterns[] = { "**/*.slang", "**/*.slangh", "**/*.hlsl", "**/*.h" };
+    for (auto globPattern : globPatterns)
+    {
+        FileSystemWatcher watcher;
+        watcher.globPattern = globPattern;
+        reg.registerOptions.watchers.add(watcher);
+    }
+    args.registrations.add(reg);
+    m_connection->sendCall(
+        UnownedStringSlice("client/registerCapability"), &args, JSONValue::makeInt(999));
+}
+
 void LanguageServer::logMessage(int type, String message)
 {
     LanguageServerProtocol::LogMessageParams args;
@@ -1509,6 +1549,12 @@ SlangResult LanguageServer::queueJSONCall(JSONRPCCall call)
         SLANG_RETURN_ON_FAIL(m_connection->toNativeArgsOrSendError(call.params, &args, call.id));
         cmd.changeDocArgs = args;
     }
+    else if (call.method == DidChangeWatchedFilesParams::methodName)
+    {
+        DidChangeWatchedFilesParams args;
+        SLANG_RETURN_ON_FAIL(m_connection->toNativeArgsOrSendError(call.params, &args, call.id));
+        cmd.changeWatchedFilesArgs = args;
+    }
     else if (call.method == HoverParams::methodName)
     {
         HoverParams args;
@@ -1611,6 +1657,10 @@ SlangResult LanguageServer::runCommand(Command& call)
     {
         return didChangeTextDocument(call.changeDocArgs.get());
     }
+    else if (call.method == DidChangeWatchedFilesParams::methodName)
+    {
+        return didChangeWatchedFiles(call.changeWatchedFilesArgs.get());
+    }
     else if (call.method == HoverParams::methodName)
     {
         return hover(call.hoverArgs.get(), call.id);
@@ -1670,11 +1720,41 @@ SlangResult LanguageServer::runCommand(Command& call)
     }
 }
 
+// Get the URI of the document a request is about, or nullptr if the command isn't a request about the
+// content of a document.
+static const String* _getRequestDocumentURI(Command& cmd)
+{
+    if (cmd.hoverArgs.isValid())
+        return &cmd.hoverArgs.get().textDocument.uri;
+    if (cmd.definitionArgs.isValid())
+        return &cmd.definitionArgs.get().textDocument.uri;
+    if (cmd.completionArgs.isValid())
+        return &cmd.completionArgs.get().textDocument.uri;
+    if (cmd.semanticTokenArgs.isValid())
+        return &cmd.semanticTokenArgs.get().textDocument.uri;
+    if (cmd.signatureHelpArgs.isValid())
+        return &cmd.signatureHelpArgs.get().textDocument.uri;
+    if (cmd.documentSymbolArgs.isValid())
+        return &cmd.documentSymbolArgs.get().textDocument.uri;
+    if (cmd.inlayHintArgs.isValid())
+        return &cmd.inlayHintArgs.get().textDocument.uri;
+    if (cmd.formattingArgs.isValid())
+        return &cmd.formattingArgs.get().textDocument.uri;
+    if (cmd.rangeFormattingArgs.isValid())
+        return &cmd.rangeFormattingArgs.get().textDocument.uri;
+    if (cmd.onTypeFormattingArgs.isValid())
+        return &cmd.onTypeFormattingArgs.get().textDocument.uri;
+    return nullptr;
+}
+
 void LanguageServer::processCommands()
 {
     HashSet<int64_t> canceledIDs;
-    for (auto& cmd : commands)
+    // The index of the last command that changes or closes each document
+    Dictionary<String, Index> lastDocumentChanges;
+    for (Index i = 0; i < commands.getCount(); i++)
     {
+        auto& cmd = commands[i];
         if (cmd.method == "$/cancelRequest")
         {
             auto id = cmd.cancelArgs.get().id;
@@ -1683,18 +1763,38 @@ void LanguageServer::processCommands()
                 canceledIDs.Add(id);
             }
         }
+        else if (cmd.changeDocArgs.isValid())
+        {
+            lastDocumentChanges[cmd.changeDocArgs.get().textDocument.uri] = i;
+        }
+        else if (cmd.closeDocArgs.isValid())
+        {
+            lastDocumentChanges[cmd.closeDocArgs.get().textDocument.uri] = i;
+        }
     }
     const int kErrorRequestCanceled = -32800;
-    for (auto& cmd : commands)
+    const int kErrorContentModified = -32801;
+    for (Index i = 0; i < commands.getCount(); i++)
     {
+        auto& cmd = commands[i];
         if (cmd.id.getKind() == JSONValue::Kind::Integer && canceledIDs.Contains(cmd.id.asInteger()))
         {
             m_connection->sendError((JSONRPC::ErrorCode)kErrorRequestCanceled, cmd.id);
+            continue;
         }
-        else
+
+        // A request about a document that is changed by a later command has a stale result, so drop
+        // it instead of making it wait for the document to be checked.
+        if (auto uri = _getRequestDocumentURI(cmd))
         {
-            runCommand(cmd);
+            Index changeIndex = -1;
+            if (lastDocumentChanges.TryGetValue(*uri, changeIndex) && changeIndex > i)
+            {
+                m_connection->sendError((JSONRPC::ErrorCode)kErrorContentModified, cmd.id);
+                continue;
+            }
         }
+        runCommand(cmd);
     }
 }
 
@@ -1714,6 +1814,23 @@ SlangResult LanguageServer::didChangeTextDocument(const DidChangeTextDocumentPar
     return SLANG_OK;
 }
 
+SlangResult LanguageServer::didChangeWatchedFiles(const DidChangeWatchedFilesParams& args)
+{
+    for (auto& change : args.changes)
+    {
+        // A deleted file has no canonical path, but the client's path is typically the same
+        String canonicalPath = uriToCanonicalPath(change.uri);
+        if (canonicalPath.getLength() == 0)
+            canonicalPath = URI::fromString(change.uri.getUnownedSlice()).getPath();
+        if (change.type == kFileChangeTypeCreated)
+            m_workspace->addFile(canonicalPath);
+        else
+            m_workspace->changeFile(canonicalPath);
+    }
+    resetDiagnosticUpdateTime();
+    return SLANG_OK;
+}
+
 SlangResult LanguageServer::didChangeConfiguration(
     const LanguageServerProtocol::DidChangeConfigurationParams& args)
 {
@@ -1726,6 +1843,9 @@ void LanguageServer::update()
 {
     if (!m_workspace)
         return;
+    // Start checking the changes made by the commands, so the result is ready by the time it is
+    // needed by a request.
+    m_workspace->checkVersionInBackground();
     publishDiagnostics();
 }
 
@@ -1762,7 +1882,10 @@ SlangResult LanguageServer::execute()
             logMessage(3, msgBuilder.ProduceString());
         }
 
-        m_connection->getUnderlyingConnection()->waitForResult(1000);
+        // Whilst a version is being checked, wake up more often so its diagnostics are published soon
+        // after it completes.
+        const Int waitTime = (m_workspace && m_workspace->hasPendingVersion()) ? 50 : 1000;
+        m_connection->getUnderlyingConnection()->waitForResult(waitTime);
     }
 
     return SLANG_OK;
@@ -28,12 +28,17 @@ struct Command
             value = new T(val);
             return *value;
         }
-        T& operator=(Optional&& other)
+        // Commands are move assigned over the commands of an earlier batch, so an invalid value
+        // must clear the value held.
+        Optional& operator=(Optional&& other)
         {
-            if (other.isValid())
-                *this = (other.get());
-            other.value = nullptr;
-            return *value;
+            if (this != &other)
+            {
+                delete value;
+                value = other.value;
+                other.value = nullptr;
+            }
+            return *this;
         }
         T& get()
         {
@@ -72,6 +77,7 @@ struct Command
     Optional<LanguageServerProtocol::DidOpenTextDocumentParams> openDocArgs;
     Optional<LanguageServerProtocol::DidChangeTextDocumentParams> changeDocArgs;
     Optional<LanguageServerProtocol::DidCloseTextDocumentParams> closeDocArgs;
+    Optional<LanguageServerProtocol::DidChangeWatchedFilesParams> changeWatchedFilesArgs;
     Optional<LanguageServerProtocol::CancelParams> cancelArgs;
 };
 
@@ -93,7 +99,7 @@ public:
     RefPtr<JSONRPCConnection> m_connection;
     ComPtr<slang::IGlobalSession> m_session;
     RefPtr<Workspace> m_workspace;
-    Dictionary<String, String> m_lastPublishedDiagnostics;
+    Dictionary<String, List<LanguageServerProtocol::Diagnostic>> m_lastPublishedDiagnostics;
     std::chrono::time_point<std::chrono::system_clock> m_lastDiagnosticUpdateTime;
     FormatOptions m_formatOptions;
     Slang::InlayHintOptions m_inlayHintOptions;
@@ -110,6 +116,8 @@ public:
         const LanguageServerProtocol::DidChangeTextDocumentParams& args);
     SlangResult didChangeConfiguration(
         const LanguageServerProtocol::DidChangeConfigurationParams& args);
+    SlangResult didChangeWatchedFiles(
+        const LanguageServerProtocol::DidChangeWatchedFilesParams& args);
     SlangResult hover(const LanguageServerProtocol::HoverParams& args, const JSONValue& responseId);
     SlangResult gotoDefinition(
         const LanguageServerProtocol::DefinitionParams& args, const JSONValue& responseId);
@@ -147,6 +155,7 @@ private:
 
     void sendConfigRequest();
     void registerCapability(const char* methodName);
+    void registerWatchedFiles();
     void logMessage(int type, String message);
 
     SlangResult tryGetMacroHoverInfo(
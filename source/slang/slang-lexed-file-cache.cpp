@@ -0,0 +1,200 @@
+// slang-lexed-file-cache.cpp
+#include "slang-lexed-file-cache.h"
+
+#include "../compiler-core/slang-source-loc.h"
+
+#include "slang-performance-report.h"
+
+namespace Slang {
+
+LexedFileCache::LexedFileCache():
+    m_memoryArena(4096)
+{
+}
+
+/* static */Name* LexedFileCache::_findIncludeGuard(const List<Token>& tokens)
+{
+    // The tokens must be of the form
+    //
+    // ```
+    // #ifndef X
+    // ...
+    // #endif
+    // ```
+    //
+    // where the `#endif` matches the `#ifndef`, and is only followed by new lines. Including the file
+    // whilst `X` is defined then has no effect, as long as the preprocessor doesn't diagnose anything
+    // in the disabled code. So the directives that are still processed in disabled code are checked to
+    // be well formed, and there can't be an `#else` or `#elif` for the `#ifndef`.
+
+    auto isEndOfLine = [&](Index index)
+    {
+        const TokenType type = tokens[index].type;
+        return type == TokenType::NewLine || type == TokenType::EndOfFile;
+    };
+    auto skipNewLines = [&](Index index)
+    {
+        while (tokens[index].type == TokenType::NewLine)
+        {
+            index++;
+        }
+        return index;
+    };
+
+    // Note that the last token is always the end of file token, so we can look at the token after any other
+    Index index = skipNewLines(0);
+    if (tokens[index].type != TokenType::Pound ||
+        tokens[index + 1].type != TokenType::Identifier ||
+        tokens[index + 1].getContent() != UnownedStringSlice::fromLiteral("ifndef") ||
+        tokens[index + 2].type != TokenType::Identifier ||
+        !isEndOfLine(index + 3))
+    {
+        return nullptr;
+    }
+    Name* includeGuard = tokens[index + 2].getName();
+
+    // For each conditional that is open, if an `#else` has been seen for it
+    List<bool> conditionalHasElse;
+    conditionalHasElse.add(false);
+
+    for (index += 3; tokens[index].type != TokenType::EndOfFile; ++index)
+    {
+        const Token& token = tokens[index];
+        if (token.type != TokenType::Pound || (token.flags & TokenFlag::AtStartOfLine) == 0)
+        {
+            continue;
+        }
+
+        // An empty directive is ignored, and any other directive needs a name
+        if (isEndOfLine(index + 1))
+        {
+            continue;
+        }
+        if (tokens[index + 1].type != TokenType::Identifier)
+        {
+            return nullptr;
+        }
+
+        const UnownedStringSlice directiveName = tokens[index + 1].getContent();
+        if (directiveName == UnownedStringSlice::fromLiteral("if"))
+        {
+            conditionalHasElse.add(false);
+        }
+        else if (directiveName == UnownedStringSlice::fromLiteral("ifdef") ||
+            directiveName == UnownedStringSlice::fromLiteral("ifndef"))
+        {
+            if (tokens[index + 2].type != TokenType::Identifier || !isEndOfLine(index + 3))
+            {
+                return nullptr;
+            }
+            conditionalHasElse.add(false);
+        }
+        else if (directiveName == UnownedStringSlice::fromLiteral("elif"))
+        {
+            if (conditionalHasElse.getCount() == 1 || conditionalHasElse.getLast())
+            {
+                return nullptr;
+            }
+        }
+        else if (directiveName == UnownedStringSlice::fromLiteral("else"))
+        {
+            if (conditionalHasElse.getCount() == 1 || conditionalHasElse.getLast() || !isEndOfLine(index + 2))
+            {
+                return nullptr;
+            }
+            conditionalHasElse.getLast() = true;
+        }
+        else if (directiveName == UnownedStringSlice::fromLiteral("endif"))
+        {
+            if (!isEndOfLine(index + 2))
+            {
+                return nullptr;
+            }
+            conditionalHasElse.removeLast();
+            if (conditionalHasElse.getCount() == 0)
+            {
+                return (tokens[skipNewLines(index + 2)].type == TokenType::EndOfFile) ? includeGuard : nullptr;
+            }
+        }
+    }
+    return nullptr;
+}
+
+LexedFileCache::Entry* LexedFileCache::findOrLex(SourceView* sourceView, NamePool* namePool)
+{
+    SourceFile* sourceFile = sourceView->getSourceFile();
+    if (!sourceFile->hasContent())
+    {
+        return nullptr;
+    }
+
+    const UnownedStringSlice content = sourceFile->getContent();
+    const HashCode64 hash = getStableHashCode64(content.begin(), content.getLength());
+
+    if (RefPtr<Entry>* foundEntry = m_entries.TryGetValue(hash))
+    {
+        // If the hash collides with different content, the content is just lexed without the cache
+        Entry* entry = *foundEntry;
+        if (entry && entry->m_content == content)
+        {
+            PerformanceReport::addToCounter(PerformanceCounter::LexedFileCacheHits, 1);
+            return entry;
+        }
+        PerformanceReport::addToCounter(PerformanceCounter::LexedFileCacheMisses, 1);
+        return nullptr;
+    }
+
+    PerformanceReport::addToCounter(PerformanceCounter::LexedFileCacheMisses, 1);
+
+    // Lex with a sink of our own, so we can tell if there are any diagnostics. If there are the file
+    // will be lexed again by the preprocessor, so they are reported with the right suppression.
+    DiagnosticSink sink(sourceView->getSourceManager(), Lexer::sourceLocationLexer);
+
+    Lexer lexer;
+    lexer.initialize(sourceView, &sink, namePool, &m_memoryArena);
+
+    RefPtr<Entry> entry = new Entry;
+    const SourceLoc::RawValue startLoc = sourceView->getRange().begin.getRaw();
+    for (;;)
+    {
+        Token token = lexer.lexToken();
+        switch (token.type)
+        {
+        case TokenType::WhiteSpace:
+        case TokenType::BlockComment:
+        case TokenType::LineComment:
+            continue;
+        default:
+            break;
+        }
+
+        token.loc = SourceLoc::fromRaw(token.loc.getRaw() - startLoc);
+        entry->m_tokens.add(token);
+
+        if (token.type == TokenType::EndOfFile)
+        {
+            break;
+        }
+    }
+
+    if (sink.getErrorCount() > 0 || sink.outputBuffer.getLength() > 0)
+    {
+        m_entries.Set(hash, RefPtr<Entry>());
+        return nullptr;
+    }
+
+    entry->m_contentBlob = sourceFile->getContentBlob();
+    entry->m_content = content;
+    entry->m_includeGuard = _findIncludeGuard(entry->m_tokens);
+
+    m_entries.Set(hash, entry);
+    return entry;
+}
+
+void LexedFileCache::clear()
+{
+    m_entries.Clear();
+    m_memoryArena.deallocateAll();
+}
+
+} // namespace Slang
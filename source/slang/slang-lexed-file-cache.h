@@ -0,0 +1,81 @@
+// slang-lexed-file-cache.h
+#ifndef SLANG_LEXED_FILE_CACHE_H_INCLUDED
+#define SLANG_LEXED_FILE_CACHE_H_INCLUDED
+
+#include "../core/slang-basic.h"
+#include "../core/slang-flat-dictionary.h"
+#include "../core/slang-memory-arena.h"
+
+#include "../compiler-core/slang-lexer.h"
+
+namespace Slang {
+
+class SourceView;
+
+/* A cache of the tokens lexed from files that are `#include`d by the preprocessor, held by a linkage.
+
+The same headers are typically included by many of the translation units compiled with a linkage. The
+tokens lexed from a file only depend on its content, so the preprocessor can play back the tokens held
+here instead of lexing the file again. Macro expansion and the handling of directives are still performed
+every time the file is included.
+
+An entry is looked up by a hash of the content of the file, and the content is compared to confirm the
+match, so it doesn't matter which path the file was found through, or if it was modified.
+
+Only files that can be lexed without any diagnostics are cached, as diagnostics from the lexer depend on
+whether they are in code disabled by a preprocessor conditional. When a file has been lexed it is also
+checked for an include guard (all of its contents being inside `#ifndef X` ... `#endif`), which allows the
+preprocessor to skip including the file again while `X` is defined.
+
+The `Name`s held in tokens are from the name pool of the linkage. */
+class LexedFileCache
+{
+public:
+    class Entry : public RefObject
+    {
+    public:
+            /// Get the tokens. The last token is the end of file token.
+            ///
+            /// The location of each token is its offset from the start of the content, and the
+            /// characters of a token are either in the `Name` or `m_content` (or in the memory
+            /// arena of the cache, if the token needed scrubbing).
+        const List<Token>& getTokens() const { return m_tokens; }
+
+            /// Get the content the tokens were lexed from
+        const UnownedStringSlice& getContent() const { return m_content; }
+
+            /// Get the macro used as an include guard, or nullptr if the file doesn't have one
+        Name* getIncludeGuard() const { return m_includeGuard; }
+
+    protected:
+        friend class LexedFileCache;
+
+        ComPtr<ISlangBlob> m_contentBlob;   ///< Owns the content
+        UnownedStringSlice m_content;
+        List<Token> m_tokens;               ///< All tokens other than whitespace and comments
+        Name* m_includeGuard = nullptr;
+    };
+
+        /// Get the entry for the content of `sourceView`, lexing it if it isn't in the cache.
+        /// Returns nullptr if the content can't be cached, in which case it should just be lexed.
+    Entry* findOrLex(SourceView* sourceView, NamePool* namePool);
+
+        /// Remove all entries
+    void clear();
+
+    LexedFileCache();
+
+protected:
+        /// Find the include guard in `tokens`, or return nullptr if the tokens aren't all inside one
+    static Name* _findIncludeGuard(const List<Token>& tokens);
+
+        /// Entries by hash of their content. Null if the content could not be cached.
+    FlatDictionary<HashCode64, RefPtr<Entry>> m_entries;
+
+        /// Holds the characters of tokens that needed scrubbing
+    MemoryArena m_memoryArena;
+};
+
+} // namespace Slang
+
+#endif
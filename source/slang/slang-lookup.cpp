@@ -3,6 +3,7 @@
 
 #include "../compiler-core/slang-name.h"
 #include "slang-check-impl.h"
+#include "slang-performance-report.h"
 
 namespace Slang {
 
@@ -36,6 +37,9 @@ void buildMemberDictionary(ContainerDecl* decl)
     if (decl->isMemberDictionaryValid())
         return;
 
+    // A frozen dictionary is read by other threads without synchronization
+    SLANG_ASSERT(!decl->isMemberDictionaryFrozen);
+
     // If it's < 0 it means that the dictionaries are entirely invalid
     if (decl->dictionaryLastCount < 0)
     {
@@ -73,13 +77,10 @@ void buildMemberDictionary(ContainerDecl* decl)
         if (genericDecl && m == genericDecl->inner)
             continue;
 
-        m->nextInContainerWithSameName = nullptr;
-
-        Decl* next = nullptr;
-        if (decl->memberDictionary.TryGetValue(name, next))
-            m->nextInContainerWithSameName = next;
-
-        decl->memberDictionary[name] = m;
+        // The member becomes the first with the name, followed by any previous ones
+        Decl*& firstWithName = decl->memberDictionary.GetOrEmplace(name, nullptr);
+        m->nextInContainerWithSameName = firstWithName;
+        firstWithName = m;
     }
 
     decl->dictionaryLastCount = membersCount;
@@ -1008,6 +1009,28 @@ LookupResult lookUp(
     return result;
 }
 
+    /// True if the result of looking up members of the canonical type `type` can be cached.
+    ///
+    /// Equality of types with a this-type substitution ignores the witnesses, which lookup results
+    /// depend on, and other kinds of types are only equal to themselves - so only other decl-ref types
+    /// are cached.
+static bool _canCacheMemberLookup(Type* type)
+{
+    auto declRefType = as<DeclRefType>(type);
+    if (!declRefType)
+    {
+        return false;
+    }
+    for (auto subst = declRefType->declRef.substitutions.substitutions; subst; subst = subst->outer)
+    {
+        if (as<ThisTypeSubstitution>(subst))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 LookupResult lookUpMember(
     ASTBuilder*         astBuilder, 
     SemanticsVisitor*   semantics,
@@ -1017,8 +1040,50 @@ LookupResult lookUpMember(
     LookupOptions       options)
 {
     LookupRequest request = initLookupRequest(semantics, name, mask, options, nullptr);
+
+    // Results are cached in the shared semantics context, as the same members of the same types
+    // are looked up many times. Lookup without a semantics context can find fewer members, so
+    // isn't cached.
+    SharedSemanticsContext* shared = nullptr;
+    MemberLookupCacheKey key;
+    if (semantics && type && !request.isCompletionRequest())
+    {
+        key.type = type->getCanonicalType();
+        key.name = name;
+        key.mask = mask;
+        key.options = options;
+
+        if (_canCacheMemberLookup(key.type))
+        {
+            shared = semantics->getShared();
+        }
+    }
+
+    if (shared)
+    {
+        if (auto cachedResult = shared->getMemberLookupCache().TryGetValue(key))
+        {
+            PerformanceReport::addToCounter(PerformanceCounter::MemberLookupCacheHits);
+            return *cachedResult;
+        }
+        PerformanceReport::addToCounter(PerformanceCounter::MemberLookupCacheMisses);
+    }
+
+    const uint32_t cacheGeneration = shared ? shared->getMemberLookupCacheGeneration() : 0;
+    const int errorCount = shared ? semantics->getSink()->getErrorCount() : 0;
+
     LookupResult result;
     _lookUpMembersInType(astBuilder, name, type, request, result, nullptr);
+
+    // Lookup can check declarations, which can make more extensions visible (invalidating the cache),
+    // or report errors that should be reported again if the same lookup is performed
+    if (shared &&
+        shared->getMemberLookupCacheGeneration() == cacheGeneration &&
+        semantics->getSink()->getErrorCount() == errorCount)
+    {
+        shared->getMemberLookupCache()[key] = result;
+    }
+
     return result;
 }
 
@@ -21,6 +21,7 @@
 #include "slang-ir-lower-error-handling.h"
 
 #include "slang-mangle.h"
+#include "slang-performance-report.h"
 #include "slang-type-layout.h"
 #include "slang-visitor.h"
 
@@ -8561,6 +8562,8 @@ RefPtr<IRModule> generateIRForTranslationUnit(
     ASTBuilder* astBuilder,
     TranslationUnitRequest* translationUnit)
 {
+    SLANG_PERFORMANCE_PHASE("lowerToIR");
+
     auto session = translationUnit->getSession();
     auto compileRequest = translationUnit->compileRequest;
 
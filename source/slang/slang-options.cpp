@@ -507,6 +507,8 @@ struct OptionsParser
             "\n"
             "General options:\n"
             "\n"
+            "  -cache-dir <path>: Reuse the output of previous identical compilations, held\n"
+            "    in the directory at <path>. Output is stored in the directory when not found.\n"
             "  -D<name>[=<value>], -D <name>[=<value>]: Insert a preprocessor macro.\n"
             "  -depfile <path>: Save the source file dependency list in a file.\n"
             "  -entry <name>: Specify the name of an entry-point function.\n"
@@ -578,6 +580,11 @@ struct OptionsParser
             "        by the target.\n"
             "  -g, -g<N>: Include debug information in the generated code, where possible.\n"
             "    N is the amount of information, 0..3, unspecified means 2\n"
+            "  -ir-disable-pass <name>: Don't run the optimization IR pass <name>. Passes are\n"
+            "    named as in the output of -ir-pass-timings.\n"
+            "  -ir-pass-timings: Output the time taken by each IR pass, the number of times\n"
+            "    it was run and skipped, and the change in the number of IR instructions,\n"
+            "    to stderr.\n"
             "  -line-directive-mode <mode>: Sets how the `#line` directives should be\n"
             "      produced. Available options are:\n"
             "        none : Don't emit `#line` directives at all\n"
@@ -585,8 +592,13 @@ struct OptionsParser
             "      for HLSL and C/C++ output, and traditional GLSL-style `#line` directives\n"
             "      for GLSL output.\n"
             "  -O<N>: Set the optimization level.\n"
-            "    N is the amount of optimization, 0..3, default is 1\n"
+            "    N is the amount of optimization, 0..3, default is 1. With -O0 optimization\n"
+            "    IR passes are not run.\n"
             "  -obfuscate: Remove all source file information from outputs.\n"
+            "  -parallel-codegen: Generate code for each target and entry point in parallel.\n"
+            "  -report-perf: Output the time taken by each phase of compilation, and counts\n"
+            "    of work performed, to stderr.\n"
+            "  -report-perf-json: As -report-perf, but output the report as JSON.\n"
             "\n"
             "Downstream compiler options:\n"
             "\n"
@@ -632,9 +644,15 @@ struct OptionsParser
             "  -validate-ir: Validate the IR between the phases.\n"
             "  -verbose-paths: Display more detailed paths in diagnostic output.\n"
             "  -verify-debug-serial-ir: Verify IR in the front-end.\n"
+            "  -verify-ir-simplify: Check that code skipped by simplifyIR as unmodified can't\n"
+            "      be simplified further.\n"
+            "  -verify-ir-compaction: Always compact the IR module during code generation, and\n"
+            "      validate it afterwards.\n"
             "\n"
             "Experimental options (use at your own risk):\n"
             "\n"
+            "  -emit-cpp-spmd: For CPU targets execute the threads of a compute thread group\n"
+            "      as SIMD lanes of a vectorizable loop. Threads in a group must be independent.\n"
             "  -emit-spirv-directly: Generate SPIR-V output directly (otherwise through \n"
             "      GLSL and using the glslang compiler)\n"
             "  -file-system <fs>: Set the filesystem hook to use for a compile request.\n"
@@ -1027,6 +1045,26 @@ struct OptionsParser
                 {
                     requestImpl->disableDynamicDispatch = true;
                 }
+                else if (argValue == "-parallel-codegen")
+                {
+                    requestImpl->m_parallelCodegen = true;
+                }
+                else if (argValue == "-report-perf" || argValue == "-report-perf-json")
+                {
+                    requestImpl->m_reportPerformance = true;
+                    requestImpl->m_performanceReportFormat = (argValue == "-report-perf-json") ? SLANG_PERFORMANCE_REPORT_FORMAT_JSON : SLANG_PERFORMANCE_REPORT_FORMAT_TEXT;
+                }
+                else if (argValue == "-ir-pass-timings")
+                {
+                    requestImpl->m_reportIRPassTimings = true;
+                }
+                else if (argValue == "-ir-disable-pass")
+                {
+                    CommandLineArg passName;
+                    SLANG_RETURN_ON_FAIL(reader.expectArg(passName));
+
+                    requestImpl->m_disabledIRPasses.add(passName.value);
+                }
                 else if (argValue == "-track-liveness")
                 {
                     requestImpl->setTrackLiveness(true);
@@ -1066,6 +1104,14 @@ struct OptionsParser
                 {
                     requestImpl->getFrontEndReq()->verifyDebugSerialization = true;
                 }
+                else if (argValue == "-verify-ir-simplify")
+                {
+                    requestImpl->m_verifyIRSimplify = true;
+                }
+                else if (argValue == "-verify-ir-compaction")
+                {
+                    requestImpl->m_verifyIRCompaction = true;
+                }
                 else if(argValue == "-validate-ir" )
                 {
                     requestImpl->getFrontEndReq()->shouldValidateIR = true;
@@ -1330,6 +1376,13 @@ struct OptionsParser
                         return SLANG_FAIL;
                     }
                 }
+                else if (argValue == "-cache-dir")
+                {
+                    CommandLineArg cacheDirectory;
+                    SLANG_RETURN_ON_FAIL(reader.expectArg(cacheDirectory));
+
+                    requestImpl->getLinkage()->m_cacheDirectory = cacheDirectory.value;
+                }
                 else if(argValue == "-matrix-layout-row-major")
                 {
                     defaultMatrixLayoutMode = kMatrixLayoutMode_RowMajor;
@@ -1523,6 +1576,10 @@ struct OptionsParser
                 {
                     getCurrentTarget()->targetFlags |= SLANG_TARGET_FLAG_GENERATE_SPIRV_DIRECTLY;
                 }
+                else if (argValue == "-emit-cpp-spmd")
+                {
+                    getCurrentTarget()->targetFlags |= SLANG_TARGET_FLAG_GENERATE_SPMD;
+                }
                 else if (argValue == "-default-downstream-compiler")
                 {
                     CommandLineArg sourceLanguageArg, compilerArg;
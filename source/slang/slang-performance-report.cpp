@@ -0,0 +1,395 @@
+// slang-performance-report.cpp
+#include "slang-performance-report.h"
+
+#include "../core/slang-process.h"
+
+#include "../compiler-core/slang-json-parser.h"
+
+namespace Slang {
+
+namespace { // anonymous
+
+struct CounterInfo
+{
+    const char* name;               ///< Name for display
+    const char* key;                ///< Key used in JSON output
+};
+
+} // anonymous
+
+static const CounterInfo kCounterInfos[] =
+{
+    { "IR insts created",               "irInstsCreated" },
+    { "IR inst bytes allocated",        "irInstBytesAllocated" },
+    { "IR insts recycled",              "irInstsRecycled" },
+    { "IR module compactions",          "irModuleCompactions" },
+    { "IR bytes reclaimed by compaction", "irBytesReclaimedByCompaction" },
+    { "IR detached insts compacted",    "irDetachedInstsCompacted" },
+    { "linked IR insts",                "linkedIRInsts" },
+    { "linked IR operands",             "linkedIROperands" },
+    { "linked IR inst bytes",           "linkedIRInstBytes" },
+    { "linked IR compact inst bytes",   "linkedIRCompactInstBytes" },
+    { "IR specializations",             "irSpecializations" },
+    { "overload candidates checked",    "overloadCandidatesChecked" },
+    { "member lookup cache hits",       "memberLookupCacheHits" },
+    { "member lookup cache misses",     "memberLookupCacheMisses" },
+    { "simplifyIR code processed",      "simplifyIRCodeProcessed" },
+    { "simplifyIR code skipped",        "simplifyIRCodeSkipped" },
+    { "IR analyses computed",           "irAnalysesComputed" },
+    { "IR analyses reused",             "irAnalysesReused" },
+    { "lexed file cache hits",          "lexedFileCacheHits" },
+    { "lexed file cache misses",        "lexedFileCacheMisses" },
+    { "includes skipped by guard",      "includesSkippedByGuard" },
+    { "compile cache hits",             "compileCacheHits" },
+    { "compile cache misses",           "compileCacheMisses" },
+};
+
+SLANG_COMPILE_TIME_ASSERT(SLANG_COUNT_OF(kCounterInfos) == Index(PerformanceCounter::CountOf));
+
+/* static */thread_local PerformanceReport* PerformanceReport::s_threadReport = nullptr;
+/* static */thread_local Index PerformanceReport::s_threadPhaseIndex = PerformanceReport::kRootPhaseIndex;
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! PerformanceReport::PhaseScope !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+void PerformanceReport::PhaseScope::_begin(const char* name)
+{
+    m_parentPhaseIndex = s_threadPhaseIndex;
+
+    {
+        std::lock_guard<std::mutex> lock(m_report->m_mutex);
+
+        auto& phases = m_report->m_phases;
+
+        // Find the child of the parent with the same name. Names are typically literals,
+        // so the pointers are compared before the text.
+        Index phaseIndex = phases[m_parentPhaseIndex].firstChildIndex;
+        Index lastChildIndex = -1;
+        for (; phaseIndex >= 0; phaseIndex = phases[phaseIndex].nextSiblingIndex)
+        {
+            const char* phaseName = phases[phaseIndex].name;
+            if (phaseName == name || ::strcmp(phaseName, name) == 0)
+            {
+                break;
+            }
+            lastChildIndex = phaseIndex;
+        }
+
+        if (phaseIndex < 0)
+        {
+            // Add to the end of the children, so they are in the order first entered
+            phaseIndex = phases.getCount();
+
+            Phase phase;
+            phase.name = name;
+            phase.parentIndex = m_parentPhaseIndex;
+            phases.add(phase);
+
+            if (lastChildIndex >= 0)
+            {
+                phases[lastChildIndex].nextSiblingIndex = phaseIndex;
+            }
+            else
+            {
+                phases[m_parentPhaseIndex].firstChildIndex = phaseIndex;
+            }
+        }
+
+        m_phaseIndex = phaseIndex;
+    }
+
+    s_threadPhaseIndex = m_phaseIndex;
+    m_startTick = Process::getClockTick();
+}
+
+void PerformanceReport::PhaseScope::_end()
+{
+    const uint64_t ticks = Process::getClockTick() - m_startTick;
+
+    s_threadPhaseIndex = m_parentPhaseIndex;
+
+    std::lock_guard<std::mutex> lock(m_report->m_mutex);
+    Phase& phase = m_report->m_phases[m_phaseIndex];
+    phase.count++;
+    phase.totalTicks += ticks;
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! PerformanceReport::ThreadScope !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+PerformanceReport::ThreadScope::ThreadScope(PerformanceReport* report, Index parentPhaseIndex)
+{
+    m_previousReport = s_threadReport;
+    m_previousPhaseIndex = s_threadPhaseIndex;
+
+    s_threadReport = report;
+    s_threadPhaseIndex = parentPhaseIndex;
+}
+
+PerformanceReport::ThreadScope::~ThreadScope()
+{
+    s_threadReport = m_previousReport;
+    s_threadPhaseIndex = m_previousPhaseIndex;
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! PerformanceReport !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+PerformanceReport::PerformanceReport()
+{
+    for (auto& counter : m_counters)
+    {
+        counter.store(0, std::memory_order_relaxed);
+    }
+
+    Phase root;
+    root.name = "";
+    root.parentIndex = -1;
+    m_phases.add(root);
+}
+
+/* static */const char* PerformanceReport::getCounterName(PerformanceCounter counter)
+{
+    return kCounterInfos[Index(counter)].name;
+}
+
+List<PerformanceReport::Phase> PerformanceReport::getPhases() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_phases;
+}
+
+PerformanceReport::IRPass& PerformanceReport::_getIRPass(const char* name)
+{
+    // There are few passes, so a linear search is fine. Names are typically literals, so the
+    // pointers are compared before the text.
+    for (auto& pass : m_irPasses)
+    {
+        if (pass.name == name || ::strcmp(pass.name, name) == 0)
+        {
+            return pass;
+        }
+    }
+
+    IRPass pass;
+    pass.name = name;
+    m_irPasses.add(pass);
+    return m_irPasses.getLast();
+}
+
+void PerformanceReport::addIRPassRun(const char* name, uint64_t ticks, int64_t instDelta)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    IRPass& pass = _getIRPass(name);
+    pass.runCount++;
+    pass.totalTicks += ticks;
+    pass.instDelta += instDelta;
+}
+
+void PerformanceReport::addIRPassSkip(const char* name)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    _getIRPass(name).skipCount++;
+}
+
+SlangResult PerformanceReport::findCounterValue(const UnownedStringSlice& name, int64_t& outValue) const
+{
+    for (Index i = 0; i < Index(PerformanceCounter::CountOf); ++i)
+    {
+        if (name == UnownedStringSlice(kCounterInfos[i].key))
+        {
+            outValue = getCounter(PerformanceCounter(i));
+            return SLANG_OK;
+        }
+    }
+
+    const UnownedStringSlice passPrefix = UnownedStringSlice::fromLiteral("irPass.");
+    if (name.startsWith(passPrefix))
+    {
+        const UnownedStringSlice runsSuffix = UnownedStringSlice::fromLiteral(".runs");
+        const UnownedStringSlice skipsSuffix = UnownedStringSlice::fromLiteral(".skips");
+
+        const bool isRuns = name.endsWith(runsSuffix);
+        if (isRuns || name.endsWith(skipsSuffix))
+        {
+            const Index suffixLength = isRuns ? runsSuffix.getLength() : skipsSuffix.getLength();
+            const UnownedStringSlice passName(name.begin() + passPrefix.getLength(), name.end() - suffixLength);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const auto& pass : m_irPasses)
+            {
+                if (passName == UnownedStringSlice(pass.name))
+                {
+                    outValue = int64_t(isRuns ? pass.runCount : pass.skipCount);
+                    return SLANG_OK;
+                }
+            }
+        }
+    }
+    return SLANG_E_NOT_FOUND;
+}
+
+List<PerformanceReport::IRPass> PerformanceReport::getIRPasses() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_irPasses;
+}
+
+void PerformanceReport::writeIRPassesText(StringBuilder& out) const
+{
+    const List<IRPass> passes = getIRPasses();
+    const double msPerTick = 1000.0 / double(Process::getClockFrequency());
+
+    char line[128];
+    sprintf_s(line, SLANG_COUNT_OF(line), "%-48s %8s %8s %12s %12s\n", "IR pass", "runs", "skips", "time (ms)", "inst delta");
+    out << line;
+
+    for (const auto& pass : passes)
+    {
+        sprintf_s(line, SLANG_COUNT_OF(line), "%-48s %8d %8d %12.3f %12lld\n", pass.name, int(pass.runCount), int(pass.skipCount),
+            double(pass.totalTicks) * msPerTick, (long long)pass.instDelta);
+        out << line;
+    }
+}
+
+void PerformanceReport::_writeTextPhase(const List<Phase>& phases, Index phaseIndex, Index depth, double msPerTick, StringBuilder& out) const
+{
+    const Phase& phase = phases[phaseIndex];
+
+    StringBuilder name;
+    for (Index i = 0; i < depth; ++i)
+    {
+        name << "  ";
+    }
+    name << phase.name;
+
+    char line[128];
+    sprintf_s(line, SLANG_COUNT_OF(line), "%-48s %8d %12.3f\n", name.getBuffer(), int(phase.count), double(phase.totalTicks) * msPerTick);
+    out << line;
+
+    for (Index childIndex = phase.firstChildIndex; childIndex >= 0; childIndex = phases[childIndex].nextSiblingIndex)
+    {
+        _writeTextPhase(phases, childIndex, depth + 1, msPerTick, out);
+    }
+}
+
+void PerformanceReport::writeText(StringBuilder& out) const
+{
+    const List<Phase> phases = getPhases();
+    const double msPerTick = 1000.0 / double(Process::getClockFrequency());
+
+    char line[128];
+    sprintf_s(line, SLANG_COUNT_OF(line), "%-48s %8s %12s\n", "phase", "count", "time (ms)");
+    out << line;
+
+    for (Index childIndex = phases[kRootPhaseIndex].firstChildIndex; childIndex >= 0; childIndex = phases[childIndex].nextSiblingIndex)
+    {
+        _writeTextPhase(phases, childIndex, 0, msPerTick, out);
+    }
+
+    out << "\n";
+    sprintf_s(line, SLANG_COUNT_OF(line), "%-48s %21s\n", "counter", "value");
+    out << line;
+
+    for (Index i = 0; i < Index(PerformanceCounter::CountOf); ++i)
+    {
+        sprintf_s(line, SLANG_COUNT_OF(line), "%-48s %21lld\n", kCounterInfos[i].name, (long long)getCounter(PerformanceCounter(i)));
+        out << line;
+    }
+
+    // The peak for the whole process up to when the report is written
+    sprintf_s(line, SLANG_COUNT_OF(line), "%-48s %21lld\n", "process peak memory bytes", (long long)Process::getPeakMemoryUsage());
+    out << line;
+
+    if (getIRPasses().getCount())
+    {
+        out << "\n";
+        writeIRPassesText(out);
+    }
+}
+
+static void _writeJSONPhases(const List<PerformanceReport::Phase>& phases, Index firstChildIndex, double msPerTick, JSONWriter& writer)
+{
+    writer.startArray(SourceLoc());
+    for (Index phaseIndex = firstChildIndex; phaseIndex >= 0; phaseIndex = phases[phaseIndex].nextSiblingIndex)
+    {
+        const auto& phase = phases[phaseIndex];
+
+        writer.startObject(SourceLoc());
+
+        writer.addUnquotedKey(UnownedStringSlice::fromLiteral("name"), SourceLoc());
+        writer.addStringValue(UnownedStringSlice(phase.name), SourceLoc());
+
+        writer.addUnquotedKey(UnownedStringSlice::fromLiteral("count"), SourceLoc());
+        writer.addIntegerValue(int64_t(phase.count), SourceLoc());
+
+        writer.addUnquotedKey(UnownedStringSlice::fromLiteral("timeMs"), SourceLoc());
+        writer.addFloatValue(double(phase.totalTicks) * msPerTick, SourceLoc());
+
+        if (phase.firstChildIndex >= 0)
+        {
+            writer.addUnquotedKey(UnownedStringSlice::fromLiteral("phases"), SourceLoc());
+            _writeJSONPhases(phases, phase.firstChildIndex, msPerTick, writer);
+        }
+
+        writer.endObject(SourceLoc());
+    }
+    writer.endArray(SourceLoc());
+}
+
+void PerformanceReport::writeJSON(StringBuilder& out) const
+{
+    const List<Phase> phases = getPhases();
+    const double msPerTick = 1000.0 / double(Process::getClockFrequency());
+
+    JSONWriter writer(JSONWriter::IndentationStyle::Allman);
+
+    writer.startObject(SourceLoc());
+
+    writer.addUnquotedKey(UnownedStringSlice::fromLiteral("phases"), SourceLoc());
+    _writeJSONPhases(phases, phases[kRootPhaseIndex].firstChildIndex, msPerTick, writer);
+
+    writer.addUnquotedKey(UnownedStringSlice::fromLiteral("counters"), SourceLoc());
+    writer.startObject(SourceLoc());
+    for (Index i = 0; i < Index(PerformanceCounter::CountOf); ++i)
+    {
+        writer.addUnquotedKey(UnownedStringSlice(kCounterInfos[i].key), SourceLoc());
+        writer.addIntegerValue(getCounter(PerformanceCounter(i)), SourceLoc());
+    }
+    writer.endObject(SourceLoc());
+
+    writer.addUnquotedKey(UnownedStringSlice::fromLiteral("processPeakMemoryBytes"), SourceLoc());
+    writer.addIntegerValue(int64_t(Process::getPeakMemoryUsage()), SourceLoc());
+
+    const List<IRPass> irPasses = getIRPasses();
+    if (irPasses.getCount())
+    {
+        writer.addUnquotedKey(UnownedStringSlice::fromLiteral("irPasses"), SourceLoc());
+        writer.startArray(SourceLoc());
+        for (const auto& pass : irPasses)
+        {
+            writer.startObject(SourceLoc());
+
+            writer.addUnquotedKey(UnownedStringSlice::fromLiteral("name"), SourceLoc());
+            writer.addStringValue(UnownedStringSlice(pass.name), SourceLoc());
+
+            writer.addUnquotedKey(UnownedStringSlice::fromLiteral("runs"), SourceLoc());
+            writer.addIntegerValue(int64_t(pass.runCount), SourceLoc());
+
+            writer.addUnquotedKey(UnownedStringSlice::fromLiteral("skips"), SourceLoc());
+            writer.addIntegerValue(int64_t(pass.skipCount), SourceLoc());
+
+            writer.addUnquotedKey(UnownedStringSlice::fromLiteral("timeMs"), SourceLoc());
+            writer.addFloatValue(double(pass.totalTicks) * msPerTick, SourceLoc());
+
+            writer.addUnquotedKey(UnownedStringSlice::fromLiteral("instDelta"), SourceLoc());
+            writer.addIntegerValue(pass.instDelta, SourceLoc());
+
+            writer.endObject(SourceLoc());
+        }
+        writer.endArray(SourceLoc());
+    }
+
+    writer.endObject(SourceLoc());
+
+    out << writer.getBuilder();
+}
+
+} // namespace Slang
@@ -0,0 +1,189 @@
+// slang-performance-report.h
+#ifndef SLANG_PERFORMANCE_REPORT_H
+#define SLANG_PERFORMANCE_REPORT_H
+
+#include "../core/slang-basic.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace Slang
+{
+
+/* Counts of work performed during a compilation */
+enum class PerformanceCounter
+{
+    IRInstsCreated,             ///< IR instructions created
+    IRInstBytesAllocated,       ///< Bytes allocated for IR instructions
+    IRInstsRecycled,            ///< IR instructions created in the memory of removed instructions
+    IRModuleCompactions,        ///< IR modules compacted
+    IRBytesReclaimedByCompaction,   ///< Bytes of IR module memory freed by compaction
+    IRDetachedInstsCompacted,   ///< IR instructions copied by compaction that weren't in the module, but were still referenced
+    LinkedIRInsts,              ///< IR instructions in linked and optimized modules, from which code is emitted
+    LinkedIROperands,           ///< Operands of the instructions in linked and optimized modules
+    LinkedIRInstBytes,          ///< Bytes used by the instructions in linked and optimized modules
+    LinkedIRCompactInstBytes,   ///< Estimate of the bytes the instructions in linked modules would use with a compact encoding
+    IRSpecializations,          ///< Specialized IR functions and types created
+    OverloadCandidatesChecked,  ///< Overload candidates checked during overload resolution
+    MemberLookupCacheHits,      ///< Lookups of the members of a type that were found in the member lookup cache
+    MemberLookupCacheMisses,    ///< Lookups of the members of a type that had to be performed, and could be cached
+    SimplifyIRCodeProcessed,    ///< Functions (and other code) processed by an iteration of simplifyIR
+    SimplifyIRCodeSkipped,      ///< Functions (and other code) skipped by an iteration of simplifyIR, as they were unmodified
+    IRAnalysesComputed,         ///< Analyses of IR code (such as dominator trees) computed
+    IRAnalysesReused,           ///< Analyses of IR code that were cached from an earlier pass, and reused
+    LexedFileCacheHits,         ///< Included files whose tokens were found in the lexed file cache
+    LexedFileCacheMisses,       ///< Included files that had to be lexed
+    IncludesSkippedByGuard,     ///< Includes skipped as the file's include guard was defined
+    CompileCacheHits,           ///< Compilations whose output was found in the compile cache directory
+    CompileCacheMisses,         ///< Compilations whose output could be cached, but wasn't found in the compile cache directory
+    CountOf,
+};
+
+/* Collects the time taken by each phase of a compilation, and counts of work performed.
+
+Phases are hierarchical - a phase timed whilst another phase is active on the same thread
+is recorded as a child of it. Phases with the same name and parent are combined, so the
+report holds the total time and number of times each was entered.
+
+A report only collects anything on threads where it is made current with a `ThreadScope`.
+When no report is current, timing a phase or adding to a counter is just a check of a
+thread local pointer, so instrumentation can be left in place in hot code.
+*/
+class PerformanceReport : public RefObject
+{
+public:
+
+    struct Phase
+    {
+        const char* name;                   ///< The name, typically a string literal
+        Index parentIndex;                  ///< -1 for the root
+        Index firstChildIndex = -1;
+        Index nextSiblingIndex = -1;
+        Index count = 0;                    ///< The amount of times the phase was entered
+        uint64_t totalTicks = 0;            ///< The total time, in Process clock ticks
+    };
+
+        /// The runs of an IR pass (see `IRPassManager`)
+    struct IRPass
+    {
+        const char* name;                   ///< The name, typically a string literal
+        Index runCount = 0;                 ///< The amount of times the pass was run
+        Index skipCount = 0;                ///< The amount of times the pass was skipped
+        uint64_t totalTicks = 0;            ///< The total time taken by runs, in Process clock ticks
+        int64_t instDelta = 0;              ///< The total change in the number of instructions in the modules the pass was run on
+    };
+
+        /// Times the enclosing scope as a phase of the report current on the thread (if any)
+    class PhaseScope
+    {
+    public:
+        PhaseScope(const char* name)
+        {
+            m_report = s_threadReport;
+            if (m_report)
+            {
+                _begin(name);
+            }
+        }
+        ~PhaseScope()
+        {
+            if (m_report)
+            {
+                _end();
+            }
+        }
+
+    protected:
+        void _begin(const char* name);
+        void _end();
+
+        PerformanceReport* m_report;
+        Index m_parentPhaseIndex;
+        Index m_phaseIndex;
+        uint64_t m_startTick;
+    };
+
+        /// Makes `report` current on the thread for the lifetime of the scope. Phases entered on the
+        /// thread are children of `parentPhaseIndex` - this allows work performed on other threads to
+        /// be attributed to the phase that started it.
+    class ThreadScope
+    {
+    public:
+        ThreadScope(PerformanceReport* report, Index parentPhaseIndex = kRootPhaseIndex);
+        ~ThreadScope();
+
+    protected:
+        PerformanceReport* m_previousReport;
+        Index m_previousPhaseIndex;
+    };
+
+        /// Add `value` to the counter on the report current on this thread
+    static void addToCounter(PerformanceCounter counter, int64_t value = 1)
+    {
+        if (PerformanceReport* report = s_threadReport)
+        {
+            report->m_counters[Index(counter)].fetch_add(value, std::memory_order_relaxed);
+        }
+    }
+
+        /// Get the report current on this thread. Returns nullptr if there isn't one.
+    static PerformanceReport* getCurrent() { return s_threadReport; }
+        /// Get the index of the innermost phase active on this thread
+    static Index getCurrentPhaseIndex() { return s_threadPhaseIndex; }
+
+        /// Get the name of a counter for display
+    static const char* getCounterName(PerformanceCounter counter);
+
+        /// Get the current value of a counter
+    int64_t getCounter(PerformanceCounter counter) const { return m_counters[Index(counter)].load(std::memory_order_relaxed); }
+
+        /// Get the value of the counter called `name`, as used as a key in the JSON report. The runs and skips of
+        /// an IR pass are named `irPass.<pass name>.runs` and `irPass.<pass name>.skips`.
+        /// Returns SLANG_E_NOT_FOUND if there is no counter called `name`.
+    SlangResult findCounterValue(const UnownedStringSlice& name, int64_t& outValue) const;
+
+        /// Get the phases. The first phase is the root, which isn't timed.
+    List<Phase> getPhases() const;
+
+        /// Record a run of the IR pass `name`, which took `ticks` and changed the number of instructions by `instDelta`
+    void addIRPassRun(const char* name, uint64_t ticks, int64_t instDelta);
+        /// Record that the IR pass `name` was skipped
+    void addIRPassSkip(const char* name);
+
+        /// Get the IR passes, in the order they were first run or skipped. Only collected when IR pass
+        /// timings are requested.
+    List<IRPass> getIRPasses() const;
+
+        /// Write the IR passes as a table
+    void writeIRPassesText(StringBuilder& out) const;
+
+        /// Write the report as an indented table
+    void writeText(StringBuilder& out) const;
+        /// Write the report as JSON
+    void writeJSON(StringBuilder& out) const;
+
+    PerformanceReport();
+
+    static const Index kRootPhaseIndex = 0;
+
+protected:
+    void _writeTextPhase(const List<Phase>& phases, Index phaseIndex, Index depth, double msPerTick, StringBuilder& out) const;
+        /// Get the pass called `name`, adding it if there isn't one. m_mutex must be locked.
+    IRPass& _getIRPass(const char* name);
+
+    mutable std::mutex m_mutex;                 ///< Guards m_phases and m_irPasses
+    List<Phase> m_phases;
+    List<IRPass> m_irPasses;
+
+    std::atomic<int64_t> m_counters[Index(PerformanceCounter::CountOf)];
+
+    static thread_local PerformanceReport* s_threadReport;
+    static thread_local Index s_threadPhaseIndex;
+};
+
+} // namespace Slang
+
+    /// Time the rest of the enclosing scope as a phase called `name`
+#define SLANG_PERFORMANCE_PHASE(name) ::Slang::PerformanceReport::PhaseScope SLANG_CONCAT(_slangPerformancePhase, __LINE__)(name)
+
+#endif
@@ -0,0 +1,290 @@
+// slang-permutation-compile.cpp
+#include "slang-permutation-compile.h"
+
+#include "../core/slang-string-util.h"
+#include "../core/slang-thread-pool.h"
+#include "../core/slang-writer.h"
+
+namespace Slang {
+
+static SlangResult _processArgs(EndToEndCompileRequest* request, const List<String>& baseArgs, const PermutationCompileUtil::Permutation& permutation, const char* extraArg)
+{
+    List<const char*> args;
+    for (const auto& arg : baseArgs)
+    {
+        args.add(arg.getBuffer());
+    }
+    for (const auto& arg : permutation.args)
+    {
+        args.add(arg.getBuffer());
+    }
+    if (extraArg)
+    {
+        args.add(extraArg);
+    }
+    return request->processCommandLineArguments(args.getBuffer(), int(args.getCount()));
+}
+
+static bool _isDefineArg(const UnownedStringSlice& arg)
+{
+    return arg.startsWith(UnownedStringSlice::fromLiteral("-D"));
+}
+
+/* static */SlangResult PermutationCompileUtil::calcKey(Session* session, const List<String>& baseArgs, const Permutation& permutation, String& outKey, String& outDiagnostics)
+{
+    RefPtr<EndToEndCompileRequest> request = new EndToEndCompileRequest(session);
+
+    // Capture the preprocessed tokens
+    StringBuilder tokens;
+    ComPtr<ISlangWriter> tokenWriter(new StringWriter(&tokens, 0));
+    request->setWriter(WriterChannel::StdOutput, tokenWriter);
+
+    SlangResult res = _processArgs(request, baseArgs, permutation, "-E");
+    if (SLANG_SUCCEEDED(res))
+    {
+        res = request->compile();
+    }
+    outDiagnostics = request->getSink()->outputBuffer;
+    SLANG_RETURN_ON_FAIL(res);
+
+    StringBuilder key;
+    key << "tokens:\n" << tokens << "\n";
+
+    // Imported modules are preprocessed with the defines, but aren't part of the tokens
+    bool hasImport = false;
+    {
+        List<UnownedStringSlice> slices;
+        StringUtil::split(tokens.getUnownedSlice(), ' ', slices);
+        for (const auto& slice : slices)
+        {
+            const auto token = slice.trim();
+            if (token == "import" || token == "__import")
+            {
+                hasImport = true;
+                break;
+            }
+        }
+    }
+
+    // Any arguments that aren't defines may change the output. Defines are only included if there is an import.
+    key << "args:\n";
+    for (Index i = 0; i < permutation.args.getCount(); ++i)
+    {
+        const auto& arg = permutation.args[i];
+        if (!hasImport && _isDefineArg(arg.getUnownedSlice()))
+        {
+            // Skip the value of a define that is a separate arg
+            if (arg.getLength() == 2)
+            {
+                ++i;
+            }
+            continue;
+        }
+        key << arg << "\n";
+    }
+
+    key << "type-args:\n";
+    for (const auto& typeArg : permutation.typeArgs)
+    {
+        key << typeArg << "\n";
+    }
+
+    outKey = key.ProduceString();
+    return SLANG_OK;
+}
+
+/* static */SlangResult PermutationCompileUtil::compilePermutation(Session* session, const List<String>& baseArgs, const Permutation& permutation, ComPtr<ISlangBlob>& outBlob, String& outDiagnostics)
+{
+    RefPtr<EndToEndCompileRequest> request = new EndToEndCompileRequest(session);
+
+    SlangResult res = _processArgs(request, baseArgs, permutation, nullptr);
+    for (Index i = 0; SLANG_SUCCEEDED(res) && i < permutation.typeArgs.getCount(); ++i)
+    {
+        res = request->setTypeNameForGlobalExistentialTypeParam(int(i), permutation.typeArgs[i].getBuffer());
+    }
+
+    auto linkage = request->getLinkage();
+    if (SLANG_SUCCEEDED(res) && linkage->targets.getCount() != 1)
+    {
+        request->getSink()->diagnose(SourceLoc(), Diagnostics::permutationRequiresSingleOutput);
+        res = SLANG_FAIL;
+    }
+
+    if (SLANG_SUCCEEDED(res))
+    {
+        res = request->compile();
+    }
+
+    if (SLANG_SUCCEEDED(res))
+    {
+        if (linkage->targets[0]->isWholeProgramRequest())
+        {
+            res = request->getTargetCodeBlob(0, outBlob.writeRef());
+        }
+        else if (request->m_entryPoints.getCount() == 1)
+        {
+            res = request->getEntryPointCodeBlob(0, 0, outBlob.writeRef());
+        }
+        else
+        {
+            request->getSink()->diagnose(SourceLoc(), Diagnostics::permutationRequiresSingleOutput);
+            res = SLANG_FAIL;
+        }
+    }
+
+    outDiagnostics = request->getSink()->outputBuffer;
+    return res;
+}
+
+static void _appendDiagnostics(Index permutationIndex, const String& diagnostics, StringBuilder& out)
+{
+    if (diagnostics.getLength())
+    {
+        out << "permutation " << permutationIndex << ":\n" << diagnostics;
+    }
+}
+
+/* static */SlangResult PermutationCompileUtil::compile(Session* session, const List<String>& baseArgs, const List<Permutation>& permutations, Result& outResult)
+{
+    const Index permutationCount = permutations.getCount();
+
+    outResult.artifactIndices.setCount(permutationCount);
+    outResult.artifacts.clear();
+    outResult.diagnostics = String();
+
+    if (permutationCount == 0)
+    {
+        return SLANG_OK;
+    }
+
+    RefPtr<ThreadPool> threadPool = new ThreadPool(Math::Min(ThreadPool::getHardwareWorkerCount(), permutationCount) - 1);
+
+    // Preprocess all of the permutations to find their keys
+    List<String> keys;
+    List<String> keyDiagnostics;
+    List<SlangResult> keyResults;
+    keys.setCount(permutationCount);
+    keyDiagnostics.setCount(permutationCount);
+    keyResults.setCount(permutationCount);
+
+    for (Index i = 0; i < permutationCount; ++i)
+    {
+        threadPool->submit([&, i]()
+        {
+            keyResults[i] = calcKey(session, baseArgs, permutations[i], keys[i], keyDiagnostics[i]);
+        });
+    }
+    threadPool->waitAll();
+
+    // Group permutations with the same key. Each group is compiled once, via the first permutation in it.
+    List<Index> groupIndices;
+    List<Index> groupPermutationIndices;
+    groupIndices.setCount(permutationCount);
+    {
+        Dictionary<String, Index> keyToGroup;
+        for (Index i = 0; i < permutationCount; ++i)
+        {
+            groupIndices[i] = -1;
+            if (SLANG_FAILED(keyResults[i]))
+            {
+                continue;
+            }
+            if (auto groupIndex = keyToGroup.TryGetValue(keys[i]))
+            {
+                groupIndices[i] = *groupIndex;
+            }
+            else
+            {
+                groupIndices[i] = groupPermutationIndices.getCount();
+                keyToGroup.Add(keys[i], groupIndices[i]);
+                groupPermutationIndices.add(i);
+            }
+        }
+    }
+
+    const Index groupCount = groupPermutationIndices.getCount();
+
+    List<ComPtr<ISlangBlob>> groupBlobs;
+    List<String> groupDiagnostics;
+    List<SlangResult> groupResults;
+    groupBlobs.setCount(groupCount);
+    groupDiagnostics.setCount(groupCount);
+    groupResults.setCount(groupCount);
+
+    for (Index i = 0; i < groupCount; ++i)
+    {
+        threadPool->submit([&, i]()
+        {
+            groupResults[i] = compilePermutation(session, baseArgs, permutations[groupPermutationIndices[i]], groupBlobs[i], groupDiagnostics[i]);
+        });
+    }
+    threadPool->waitAll();
+
+    // Groups that produced the same output share an artifact
+    List<Index> groupArtifactIndices;
+    groupArtifactIndices.setCount(groupCount);
+    {
+        Dictionary<HashCode64, List<Index>> hashToArtifacts;
+        for (Index i = 0; i < groupCount; ++i)
+        {
+            groupArtifactIndices[i] = -1;
+            if (SLANG_FAILED(groupResults[i]))
+            {
+                continue;
+            }
+
+            ISlangBlob* blob = groupBlobs[i];
+            const auto data = (const char*)blob->getBufferPointer();
+            const size_t size = blob->getBufferSize();
+
+            const HashCode64 hash = getHashCode64(data, size);
+            if (!hashToArtifacts.ContainsKey(hash))
+            {
+                hashToArtifacts.Add(hash, List<Index>());
+            }
+            List<Index>& candidates = *hashToArtifacts.TryGetValue(hash);
+
+            for (auto artifactIndex : candidates)
+            {
+                ISlangBlob* artifact = outResult.artifacts[artifactIndex];
+                if (artifact->getBufferSize() == size && ::memcmp(artifact->getBufferPointer(), data, size) == 0)
+                {
+                    groupArtifactIndices[i] = artifactIndex;
+                    break;
+                }
+            }
+
+            if (groupArtifactIndices[i] < 0)
+            {
+                groupArtifactIndices[i] = outResult.artifacts.getCount();
+                candidates.add(groupArtifactIndices[i]);
+                outResult.artifacts.add(groupBlobs[i]);
+            }
+        }
+    }
+
+    SlangResult res = SLANG_OK;
+    StringBuilder diagnostics;
+    for (Index i = 0; i < permutationCount; ++i)
+    {
+        const Index groupIndex = groupIndices[i];
+        outResult.artifactIndices[i] = (groupIndex >= 0) ? groupArtifactIndices[groupIndex] : -1;
+
+        if (outResult.artifactIndices[i] < 0)
+        {
+            res = SLANG_FAIL;
+        }
+
+        // Compilation diagnostics are reported for the permutation that was compiled
+        _appendDiagnostics(i, keyDiagnostics[i], diagnostics);
+        if (groupIndex >= 0 && groupPermutationIndices[groupIndex] == i)
+        {
+            _appendDiagnostics(i, groupDiagnostics[groupIndex], diagnostics);
+        }
+    }
+    outResult.diagnostics = diagnostics.ProduceString();
+
+    return res;
+}
+
+} // namespace Slang
@@ -0,0 +1,56 @@
+// slang-permutation-compile.h
+#ifndef SLANG_PERMUTATION_COMPILE_H_INCLUDED
+#define SLANG_PERMUTATION_COMPILE_H_INCLUDED
+
+#include "../core/slang-string.h"
+#include "../core/slang-list.h"
+
+#include "slang-compiler.h"
+
+namespace Slang {
+
+/* Facilities to compile many permutations of the same source, that differ in their arguments (typically `-D` defines).
+
+Each permutation is first only preprocessed. Permutations whose translation units preprocess to the same tokens, and that
+are otherwise the same, will produce the same output - so only one of them is compiled, and the output is shared. The
+compilations that remain are run in parallel on a thread pool, each with its own compile request.
+
+Preprocessor definitions are also applied to modules that are `import`ed, which are not seen when preprocessing. So if a
+translation unit imports a module, permutations are only considered the same when their defines are the same. Defines are
+also passed to downstream compilers, so defines that only affect a downstream compiler should be in the base arguments.
+
+Lastly, permutations whose compilations produce identical output share a single artifact. */
+struct PermutationCompileUtil
+{
+    struct Permutation
+    {
+        List<String> args;              ///< Arguments added to the base arguments
+        List<String> typeArgs;          ///< Type names for the global existential type parameters
+    };
+
+    struct Result
+    {
+            /// For each permutation the index of its artifact, or -1 if it failed
+        List<Index> artifactIndices;
+            /// The distinct artifacts
+        List<ComPtr<ISlangBlob>> artifacts;
+            /// The diagnostics of all of the compilations, each prefixed with the permutation it is for
+        String diagnostics;
+    };
+
+        /// Compile all of the permutations.
+        /// Returns SLANG_OK if all permutations compiled.
+    static SlangResult compile(Session* session, const List<String>& baseArgs, const List<Permutation>& permutations, Result& outResult);
+
+        /// Calculate the key that identifies the output of a permutation, by preprocessing it.
+        /// Permutations with the same key produce the same output.
+    static SlangResult calcKey(Session* session, const List<String>& baseArgs, const Permutation& permutation, String& outKey, String& outDiagnostics);
+
+        /// Compile a permutation, and get its output. The compilation must produce a single output - for one
+        /// target, and at most one entry point.
+    static SlangResult compilePermutation(Session* session, const List<String>& baseArgs, const Permutation& permutation, ComPtr<ISlangBlob>& outBlob, String& outDiagnostics);
+};
+
+} // namespace Slang
+
+#endif
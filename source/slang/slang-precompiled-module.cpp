@@ -0,0 +1,342 @@
+// slang-precompiled-module.cpp
+#include "slang-precompiled-module.h"
+
+#include "../core/slang-io.h"
+#include "../core/slang-process.h"
+#include "../core/slang-stream.h"
+#include "../core/slang-string-util.h"
+
+#include "slang-compile-cache.h"
+#include "slang-serialize-ast.h"
+#include "slang-serialize-container.h"
+#include "slang-serialize-factory.h"
+#include "slang-serialize-ir-types.h"
+
+namespace Slang {
+
+static void _appendLines(const List<String>& lines, StringBuilder& out)
+{
+    for (const auto& line : lines)
+    {
+        out << line << "\n";
+    }
+}
+
+static void _getLines(RiffContainer::Data* data, List<String>& outLines)
+{
+    if (!data)
+    {
+        return;
+    }
+
+    List<UnownedStringSlice> slices;
+    StringUtil::split(UnownedStringSlice((const char*)data->getPayload(), data->getSize()), '\n', slices);
+    for (const auto& slice : slices)
+    {
+        if (slice.getLength())
+        {
+            outLines.add(slice);
+        }
+    }
+}
+
+static String _calcFormatIdentity()
+{
+    StringBuilder buf;
+
+    buf << "ast " << ASTSerialBinary::kFormatVersion << " ";
+    RefPtr<SerialClasses> serialClasses;
+    if (SLANG_SUCCEEDED(SerialClassesUtil::create(serialClasses)))
+    {
+        buf << serialClasses->calcLayoutHash();
+    }
+
+    // Instructions are serialized by op code
+    StringBuilder opsText;
+    for (Index i = 0; i < Index(kIROpCount); ++i)
+    {
+        const IROpInfo info = getIROpInfo(IROp(i));
+        opsText << (info.name ? info.name : "") << " " << info.fixedArgCount << "\n";
+    }
+    buf << " ir " << IRSerialBinary::kFormatVersion << " " << getStableHashCode64(opsText.getBuffer(), opsText.getLength());
+
+    return buf.ProduceString();
+}
+
+/* static */UnownedStringSlice PrecompiledModuleUtil::getFormatIdentity()
+{
+    static const String formatIdentity = _calcFormatIdentity();
+    return formatIdentity.getUnownedSlice();
+}
+
+/* static */SlangResult PrecompiledModuleUtil::calcInfo(Linkage* linkage, const List<String>& importNames, const List<String>& filePaths, String& outInfo)
+{
+    // A module written by a different build of the compiler could hold AST or IR that this build reads differently
+    const UnownedStringSlice buildIdentity = CompileCacheUtil::getBuildIdentity();
+    if (buildIdentity.getLength() == 0)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    StringBuilder info;
+
+    info << "slang-module: " << kVersion << "\n";
+    info << "compiler: " << buildIdentity << "\n";
+    info << "format: " << getFormatIdentity() << "\n";
+
+    // Options that can change the result of parsing, checking or IR generation
+    info << "options: " << uint32_t(linkage->m_flag) << " " << int(linkage->m_obfuscateCode) << " " << int(linkage->m_useFalcorCustomSharedKeywordSemantics) << "\n";
+
+    // Search directories change which files are found by `#include` and `import`
+    for (const auto& searchDirectory : linkage->searchDirectories.searchDirectories)
+    {
+        info << "search: " << searchDirectory.path << "\n";
+    }
+    CompileCacheUtil::appendDefines(linkage->preprocessorDefinitions, info);
+
+    for (const auto& importName : importNames)
+    {
+        info << "import: " << importName << "\n";
+    }
+
+    ISlangFileSystemExt* fileSystem = linkage->getFileSystemExt();
+    for (const auto& path : filePaths)
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(fileSystem->loadFile(path.getBuffer(), blob.writeRef()));
+
+        info << "file: " << path << " ";
+        CompileCacheUtil::appendContentHash(blob, info);
+        info << "\n";
+    }
+
+    outInfo = info.ProduceString();
+    return SLANG_OK;
+}
+
+/* static */void PrecompiledModuleUtil::getImportNames(Module* module, List<String>& outImportNames)
+{
+    // The dependency list contains the module itself, and all of the modules it transitively imports
+    for (auto dependency : module->getModuleDependencyList())
+    {
+        if (dependency != module && dependency->getModuleDecl())
+        {
+            outImportNames.add(getText(dependency->getModuleDecl()->getName()));
+        }
+    }
+}
+
+/* static */SlangResult PrecompiledModuleUtil::writeInfo(Linkage* linkage, Module* module, RiffContainer* container)
+{
+    List<String> importNames;
+    getImportNames(module, importNames);
+
+    const auto& filePaths = module->getFilePathDependencyList();
+
+    // A module without files can't be validated, so can't be used
+    if (filePaths.getCount() == 0)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    String info;
+    SLANG_RETURN_ON_FAIL(calcInfo(linkage, importNames, filePaths, info));
+
+    StringBuilder importsText, filesText;
+    _appendLines(importNames, importsText);
+    _appendLines(filePaths, filesText);
+
+    container->addDataChunk(kInfoFourCC, info.getBuffer(), size_t(info.getLength()));
+    container->addDataChunk(kFilesFourCC, filesText.getBuffer(), size_t(filesText.getLength()));
+    if (importsText.getLength())
+    {
+        container->addDataChunk(kImportsFourCC, importsText.getBuffer(), size_t(importsText.getLength()));
+    }
+    return SLANG_OK;
+}
+
+/* static */SlangResult PrecompiledModuleUtil::write(Linkage* linkage, Module* module, const String& path)
+{
+    if (!module->getModuleDecl() || !module->getIRModule())
+    {
+        return SLANG_FAIL;
+    }
+
+    SerialContainerUtil::WriteOptions options;
+    options.compressionType = linkage->serialCompressionType;
+    // Source locations are needed for diagnostics that reference the module
+    options.optionFlags |= SerialOptionFlag::SourceLocation;
+    options.sourceManager = linkage->getSourceManager();
+
+    RiffContainer container;
+    {
+        RiffContainer::ScopeChunk scopeModule(&container, RiffContainer::Chunk::Kind::List, kPrecompiledModuleFourCC);
+
+        SLANG_RETURN_ON_FAIL(writeInfo(linkage, module, &container));
+
+        SerialContainerData data;
+        SLANG_RETURN_ON_FAIL(SerialContainerUtil::addModuleToData(module, options, data));
+        SLANG_RETURN_ON_FAIL(SerialContainerUtil::write(data, options, &container));
+    }
+
+    OwnedMemoryStream stream(FileAccess::Write);
+    SLANG_RETURN_ON_FAIL(RiffUtil::write(&container, &stream));
+
+    // The module may be being read by other compilations, so write to a temporary file and replace
+    StringBuilder tempPath;
+    tempPath << path << "." << uint64_t(Process::getClockTick()) << "." << uint64_t(size_t(module)) << ".tmp";
+
+    auto contents = stream.getContents();
+    SLANG_RETURN_ON_FAIL(File::writeAllBytes(tempPath, contents.getBuffer(), size_t(contents.getCount())));
+
+    if (SLANG_FAILED(File::rename(tempPath, path)))
+    {
+        File::remove(tempPath);
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+static void _addShaderEntryPoints(Linkage* linkage, Module* module)
+{
+    // Find the entry points marked with `[shader(...)]` in the same way as the front end. The entry points
+    // were validated when the module was produced.
+    for (auto globalDecl : module->getModuleDecl()->members)
+    {
+        auto maybeFuncDecl = globalDecl;
+        if (auto genericDecl = as<GenericDecl>(maybeFuncDecl))
+        {
+            maybeFuncDecl = genericDecl->inner;
+        }
+
+        auto funcDecl = as<FuncDecl>(maybeFuncDecl);
+        if (!funcDecl)
+            continue;
+
+        auto entryPointAttr = funcDecl->findModifier<EntryPointAttribute>();
+        if (!entryPointAttr)
+            continue;
+
+        Profile profile;
+        profile.setStage(entryPointAttr->stage);
+
+        module->_addEntryPoint(EntryPoint::create(linkage, makeDeclRef(funcDecl), profile));
+    }
+}
+
+/* static */SlangResult PrecompiledModuleUtil::read(Linkage* linkage, Name* name, ISlangBlob* blob, DiagnosticSink* sink, RefPtr<Module>& outModule)
+{
+    RiffContainer container;
+    {
+        MemoryStreamBase stream(FileAccess::Read, blob->getBufferPointer(), blob->getBufferSize());
+        SLANG_RETURN_ON_FAIL(RiffUtil::read(&stream, container));
+    }
+
+    RiffContainer::ListChunk* moduleChunk = container.getRoot() ? container.getRoot()->findListRec(kPrecompiledModuleFourCC) : nullptr;
+    RiffContainer::Data* infoData = moduleChunk ? moduleChunk->findContainedData(kInfoFourCC) : nullptr;
+    if (!infoData)
+    {
+        // Doesn't have info, so we can't tell if it's valid
+        return SLANG_E_NOT_FOUND;
+    }
+
+    List<String> importNames, filePaths;
+    _getLines(moduleChunk->findContainedData(kImportsFourCC), importNames);
+    _getLines(moduleChunk->findContainedData(kFilesFourCC), filePaths);
+
+    // Check the module was produced from the same files and settings. If a file is no longer available
+    // the module can't be used either.
+    {
+        String info;
+        if (SLANG_FAILED(calcInfo(linkage, importNames, filePaths, info)) ||
+            info.getUnownedSlice() != UnownedStringSlice((const char*)infoData->getPayload(), infoData->getSize()))
+        {
+            return SLANG_E_NOT_FOUND;
+        }
+    }
+
+    // Import the modules this module depends on. This happens in reading the AST too, but only for
+    // modules that are referenced by it, and we need all of them as dependencies.
+    List<Module*> importedModules;
+    for (const auto& importName : importNames)
+    {
+        Module* importedModule = linkage->findOrImportModule(linkage->getNamePool()->getName(importName), SourceLoc(), sink);
+        if (!importedModule)
+        {
+            return SLANG_FAIL;
+        }
+        importedModules.add(importedModule);
+    }
+
+    SerialContainerData containerData;
+    {
+        SerialContainerUtil::ReadOptions options;
+        options.namePool = linkage->getNamePool();
+        options.session = linkage->getSessionImpl();
+        options.sharedASTBuilder = linkage->getASTBuilder()->getSharedASTBuilder();
+        options.sourceManager = linkage->getSourceManager();
+        options.linkage = linkage;
+        options.sink = sink;
+
+        SLANG_RETURN_ON_FAIL(SerialContainerUtil::read(&container, options, containerData));
+    }
+
+    if (containerData.modules.getCount() != 1)
+    {
+        return SLANG_FAIL;
+    }
+
+    auto& srcModule = containerData.modules[0];
+    ModuleDecl* moduleDecl = as<ModuleDecl>(srcModule.astRootNode);
+    if (!moduleDecl || !srcModule.irModule)
+    {
+        return SLANG_FAIL;
+    }
+
+    // The module name is part of the mangled names of its symbols, so it must be the name being imported
+    if (moduleDecl->getName() != name)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    RefPtr<Module> module(new Module(linkage, srcModule.astBuilder));
+
+    // Set the module back reference on the decl
+    moduleDecl->module = module;
+
+    module->setModuleDecl(moduleDecl);
+    module->setIRModule(srcModule.irModule);
+    module->setExportSymbols(srcModule.exportMangledNames, srcModule.exportSymbols);
+
+    for (auto importedModule : importedModules)
+    {
+        module->addModuleDependency(importedModule);
+    }
+    for (const auto& filePath : filePaths)
+    {
+        module->addFilePathDependency(filePath);
+    }
+
+    module->_collectShaderParams();
+    _addShaderEntryPoints(linkage, module);
+
+    outModule = module;
+    return SLANG_OK;
+}
+
+/* static */String PrecompiledModuleUtil::getPathForSource(const String& sourcePath)
+{
+    return Path::replaceExt(sourcePath, "slang-module");
+}
+
+/* static */String PrecompiledModuleUtil::getCachePath(const String& directory, Name* moduleName, const String& sourcePath)
+{
+    // Different files can define modules with the same name, so the path is part of the file name
+    StringBuilder fileName;
+    fileName << getText(moduleName) << "-";
+    fileName.append(uint64_t(getStableHashCode64(sourcePath.getBuffer(), size_t(sourcePath.getLength()))), 16);
+    fileName << ".slang-module";
+    return Path::combine(directory, fileName);
+}
+
+} // namespace Slang
@@ -0,0 +1,65 @@
+// slang-precompiled-module.h
+#ifndef SLANG_PRECOMPILED_MODULE_H_INCLUDED
+#define SLANG_PRECOMPILED_MODULE_H_INCLUDED
+
+#include "../core/slang-riff.h"
+#include "../core/slang-string.h"
+
+#include "slang-compiler.h"
+
+namespace Slang {
+
+/* Support for `import` of a module from a serialized `.slang-module` (the checked AST and the IR), instead of
+parsing and checking the module source.
+
+A precompiled module holds 'info' that describes what the module was produced from - the compiler build (see
+`CompileCacheUtil::getBuildIdentity`), the AST and IR serialization formats, the linkage options that can change
+the result of the front end, the modules it imports, and the size and hash of every file it depends on (its
+source, `#include`d files, and the files of imported modules). A precompiled module is only used if the info
+calculated for the current linkage and current file contents is identical. If the build of the compiler cannot be
+identified, precompiled modules are not written or used.
+
+When importing, a precompiled module is looked for next to the module source (`foo-bar.slang-module` for
+`foo-bar.slang`), and in the linkage cache directory if one is set. Modules that are loaded from source
+are written to the cache directory. */
+struct PrecompiledModuleUtil
+{
+    static const FourCC kPrecompiledModuleFourCC = SLANG_FOUR_CC('S', 'p', 'm', 'd');   ///< The list holding the module and info
+    static const FourCC kInfoFourCC = SLANG_FOUR_CC('S', 'p', 'm', 'i');                 ///< The info text
+    static const FourCC kFilesFourCC = SLANG_FOUR_CC('S', 'p', 'm', 'f');                ///< The file dependencies, one path per line
+    static const FourCC kImportsFourCC = SLANG_FOUR_CC('S', 'p', 'm', 'm');              ///< The names of imported modules, one per line
+
+        /// Change if the format of the info changes
+    static const uint32_t kVersion = 1;
+
+        /// Get text that identifies the AST and IR serialization formats. This is the format versions, along with
+        /// hashes of the layout of the serialized AST classes and of the IR op table.
+    static UnownedStringSlice getFormatIdentity();
+
+        /// Calculate the info for a module with the imports and file dependencies, using the current
+        /// file contents and settings of the linkage.
+    static SlangResult calcInfo(Linkage* linkage, const List<String>& importNames, const List<String>& filePaths, String& outInfo);
+
+        /// Get the names of the modules imported by module
+    static void getImportNames(Module* module, List<String>& outImportNames);
+
+        /// Write the info for module into the current chunk of container
+    static SlangResult writeInfo(Linkage* linkage, Module* module, RiffContainer* container);
+
+        /// Write module as a precompiled module at path
+    static SlangResult write(Linkage* linkage, Module* module, const String& path);
+
+        /// Read a precompiled module called name from blob. If the module is not valid for the current state of
+        /// the linkage returns SLANG_E_NOT_FOUND. The module is not registered with the linkage.
+    static SlangResult read(Linkage* linkage, Name* name, ISlangBlob* blob, DiagnosticSink* sink, RefPtr<Module>& outModule);
+
+        /// Get the path of a precompiled module next to the source at sourcePath
+    static String getPathForSource(const String& sourcePath);
+
+        /// Get the path of a precompiled module in the cache directory for the module source at sourcePath
+    static String getCachePath(const String& directory, Name* moduleName, const String& sourcePath);
+};
+
+} // namespace Slang
+
+#endif
@@ -13,6 +13,8 @@
 
 #include "slang-compiler.h"
 #include "slang-diagnostics.h"
+#include "slang-lexed-file-cache.h"
+#include "slang-performance-report.h"
 #include "../compiler-core/slang-lexer.h"
 
 #include <assert.h>
@@ -548,6 +550,55 @@ private:
     Token m_lookaheadToken;
 };
 
+// When a file is `#include`d its tokens can instead be played back from a
+// `LexedFileCache`, which holds the tokens lexed from files with the same
+// content. Such a file never produces any diagnostics from the lexer, so
+// there is nothing to suppress inside of disabled conditional branches.
+
+    /// An input stream that plays back the tokens lexed from a file, held in a `LexedFileCache`
+struct LexedFileInputStream : InputStream
+{
+    typedef InputStream Super;
+
+    LexedFileInputStream(
+        Preprocessor*           preprocessor,
+        SourceView*             sourceView,
+        LexedFileCache::Entry*  lexedFile);
+
+    Token readToken() SLANG_OVERRIDE
+    {
+        auto result = m_lookaheadToken;
+        m_lookaheadToken = _readTokenImpl();
+        return result;
+    }
+
+    Token peekToken() SLANG_OVERRIDE
+    {
+        return m_lookaheadToken;
+    }
+
+private:
+        /// Read the next token, bypassing lookahead
+    Token _readTokenImpl();
+
+        /// The next token to play back
+    const Token* m_cursor = nullptr;
+        /// The end of file token, which is played back repeatedly at the end
+    const Token* m_endOfFile = nullptr;
+
+        /// The start location of the source view the tokens are for
+    SourceLoc m_startLoc;
+        /// The start of the content that the cached tokens refer to, and the content of the source view
+    char const* m_cachedContentBegin = nullptr;
+    char const* m_contentBegin = nullptr;
+
+        /// Holds the characters of tokens that need scrubbing, as for the lexer
+    MemoryArena* m_memoryArena = nullptr;
+
+        /// One token of lookahead
+    Token m_lookaheadToken;
+};
+
 // The remaining input stream cases deal with macro expansion, so it is
 // probalby a good idea to discuss how macros are represented by the
 // preprocessor as a first step.
@@ -910,8 +961,9 @@ private:
 struct InputFile
 {
     InputFile(
-        Preprocessor*   preprocessor,
-        SourceView*     sourceView);
+        Preprocessor*           preprocessor,
+        SourceView*             sourceView,
+        LexedFileCache::Entry*  lexedFile = nullptr);
 
     ~InputFile();
 
@@ -943,7 +995,10 @@ struct InputFile
         return m_expansionStream->readToken();
     }
 
-    Lexer* getLexer() { return m_lexerStream->getLexer(); }
+        /// Get the lexer, or nullptr if the tokens of the file are played back from a `LexedFileCache`
+    Lexer* getLexer() { return m_lexerStream ? m_lexerStream->getLexer() : nullptr; }
+
+    SourceView* getSourceView() { return m_sourceView; }
 
     ExpansionInputStream* getExpansionStream() { return m_expansionStream; }
 
@@ -965,10 +1020,13 @@ private:
         /// The inner-most preprocessor conditional active for this file.
     Conditional*        m_conditional = nullptr;
 
-        /// The lexer input stream that unexpanded tokens will be read from
-    LexerInputStream* m_lexerStream;
+        /// The source view of the file
+    SourceView* m_sourceView = nullptr;
+
+        /// The lexer input stream that unexpanded tokens will be read from, unless they are played back
+    LexerInputStream* m_lexerStream = nullptr;
 
-        /// An input stream that applies macro expansion to `m_lexerStream`
+        /// An input stream that applies macro expansion to the unexpanded tokens
     ExpansionInputStream* m_expansionStream;
 };
 
@@ -1003,6 +1061,13 @@ struct Preprocessor
         /// stop them from being included again.
     HashSet<String>                         pragmaOnceUniqueIdentities;
 
+        /// The include guard macro of files that have been included, by unique identity, so
+        /// they can be skipped if included again whilst the macro is defined.
+    Dictionary<String, Name*>               includeGuards;
+
+        /// Cache of the tokens lexed from included files
+    LexedFileCache*                         lexedFileCache = nullptr;
+
         /// Name pool to use when creating `Name`s from strings
     NamePool*                               namePool = nullptr;
 
@@ -1101,14 +1166,72 @@ LexerInputStream::LexerInputStream(
     m_lookaheadToken = _readTokenImpl();
 }
 
+LexedFileInputStream::LexedFileInputStream(
+    Preprocessor*           preprocessor,
+    SourceView*             sourceView,
+    LexedFileCache::Entry*  lexedFile)
+    : Super(preprocessor)
+{
+    const auto& tokens = lexedFile->getTokens();
+    m_cursor = tokens.begin();
+    m_endOfFile = tokens.end() - 1;
+
+    m_startLoc = sourceView->getRange().begin;
+    m_cachedContentBegin = lexedFile->getContent().begin();
+    m_contentBegin = sourceView->getContent().begin();
+    m_memoryArena = sourceView->getSourceManager()->getMemoryArena();
+
+    m_lookaheadToken = _readTokenImpl();
+}
+
+Token LexedFileInputStream::_readTokenImpl()
+{
+    Token token = *m_cursor;
+    if (m_cursor != m_endOfFile)
+    {
+        m_cursor++;
+    }
+
+    // The cached token is relative to the start of the content it was lexed from, so
+    // it is moved to the equivalent location and characters in this source view.
+    token.loc = m_startLoc + Int(token.loc.getRaw());
+
+    if (token.hasContent() && (token.flags & TokenFlag::Name) == 0)
+    {
+        const UnownedStringSlice content = token.getContent();
+        if (token.flags & TokenFlag::ScrubbingNeeded)
+        {
+            char* chars = (char*)m_memoryArena->allocateUnaligned(content.getLength());
+            ::memcpy(chars, content.begin(), content.getLength());
+            token.setContent(UnownedStringSlice(chars, content.getLength()));
+        }
+        else
+        {
+            token.setContent(UnownedStringSlice(m_contentBegin + (content.begin() - m_cachedContentBegin), content.getLength()));
+        }
+    }
+    return token;
+}
+
 InputFile::InputFile(
-    Preprocessor*   preprocessor,
-    SourceView*     sourceView)
+    Preprocessor*           preprocessor,
+    SourceView*             sourceView,
+    LexedFileCache::Entry*  lexedFile)
 {
     m_preprocessor = preprocessor;
+    m_sourceView = sourceView;
 
-    m_lexerStream = new LexerInputStream(preprocessor, sourceView);
-    m_expansionStream = new ExpansionInputStream(preprocessor, m_lexerStream);
+    InputStream* baseStream = nullptr;
+    if (lexedFile)
+    {
+        baseStream = new LexedFileInputStream(preprocessor, sourceView, lexedFile);
+    }
+    else
+    {
+        m_lexerStream = new LexerInputStream(preprocessor, sourceView);
+        baseStream = m_lexerStream;
+    }
+    m_expansionStream = new ExpansionInputStream(preprocessor, baseStream);
 }
 
 InputFile::~InputFile()
@@ -1126,7 +1249,7 @@ InputFile::~InputFile()
     }
 
     // Note: We only delete the expansion strema here because the lexer
-    // stream is being used as the "base" stream of the expansion stream,
+    // (or lexed file) stream is being used as the "base" stream of the expansion stream,
     // and the expansion stream takes responsibility for deleting it.
     //
     delete m_expansionStream;
@@ -2437,13 +2560,20 @@ static void _setLexerDiagnosticSuppression(
     InputFile*  inputFile,
     bool        shouldSuppressDiagnostics)
 {
+    // A file played back from the lexed file cache has no diagnostics to suppress
+    auto lexer = inputFile->getLexer();
+    if (!lexer)
+    {
+        return;
+    }
+
     if(shouldSuppressDiagnostics)
     {
-        inputFile->getLexer()->m_lexerFlags |= kLexerFlag_SuppressDiagnostics;
+        lexer->m_lexerFlags |= kLexerFlag_SuppressDiagnostics;
     }
     else
     {
-        inputFile->getLexer()->m_lexerFlags &= ~kLexerFlag_SuppressDiagnostics;
+        lexer->m_lexerFlags &= ~kLexerFlag_SuppressDiagnostics;
     }
 }
 
@@ -3036,6 +3166,16 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    // Check whether we've previously included this file and found it has an include guard that is now defined,
+    // in which case including it again would have no effect
+    Name* includeGuard = nullptr;
+    if (context->m_preprocessor->includeGuards.TryGetValue(filePathInfo.uniqueIdentity, includeGuard) &&
+        LookupMacro(context, includeGuard))
+    {
+        PerformanceReport::addToCounter(PerformanceCounter::IncludesSkippedByGuard, 1);
+        return;
+    }
+
     // Simplify the path
     filePathInfo.foundPath = includeSystem->simplifyPath(filePathInfo.foundPath);
 
@@ -3063,7 +3203,14 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
     // This is a new parse (even if it's a pre-existing source file), so create a new SourceView
     SourceView* sourceView = sourceManager->createSourceView(sourceFile, &filePathInfo, directiveLoc);
 
-    InputFile* inputFile = new InputFile(context->m_preprocessor, sourceView);
+    // Play back the tokens lexed from the file (or another file with the same content) if possible
+    LexedFileCache::Entry* lexedFile = context->m_preprocessor->lexedFileCache->findOrLex(sourceView, context->m_preprocessor->getNamePool());
+    if (lexedFile && lexedFile->getIncludeGuard())
+    {
+        context->m_preprocessor->includeGuards[filePathInfo.uniqueIdentity] = lexedFile->getIncludeGuard();
+    }
+
+    InputFile* inputFile = new InputFile(context->m_preprocessor, sourceView, lexedFile);
 
     context->m_preprocessor->pushInputFile(inputFile);
 }
@@ -3460,7 +3607,7 @@ static void _handleDefaultLineDirective(PreprocessorDirectiveContext* context)
 {
     SourceLoc directiveLoc = GetDirectiveLoc(context);
     auto inputStream = getInputFile(context);
-    auto sourceView = inputStream->getLexer()->m_sourceView;
+    auto sourceView = inputStream->getSourceView();
     sourceView->addDefaultLineDirective(directiveLoc);
 }
 
@@ -3532,7 +3679,7 @@ static void HandleLineDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
-    auto sourceView = inputStream->getLexer()->m_sourceView;
+    auto sourceView = inputStream->getSourceView();
     sourceView->addLineDirective(directiveLoc, file, line);
 }
 
@@ -4003,6 +4150,7 @@ TokenList preprocessSource(
     desc.fileSystem     = linkage->getFileSystemExt();
     desc.namePool       = linkage->getNamePool();
     desc.sourceManager  = linkage->getSourceManager();
+    desc.lexedFileCache = &linkage->m_lexedFileCache;
 
     if (linkage->isInLanguageServer())
     {
@@ -4024,6 +4172,10 @@ TokenList preprocessSource(
     preprocessor.fileSystem = desc.fileSystem;
     preprocessor.namePool = desc.namePool;
 
+    // If there is no cache that outlives preprocessing, included files are just cached whilst preprocessing
+    LexedFileCache localLexedFileCache;
+    preprocessor.lexedFileCache = desc.lexedFileCache ? desc.lexedFileCache : &localLexedFileCache;
+
     preprocessor.endOfFileToken.type = TokenType::EndOfFile;
     preprocessor.endOfFileToken.flags = TokenFlag::AtStartOfLine;
     preprocessor.contentAssistInfo = desc.contentAssistInfo;
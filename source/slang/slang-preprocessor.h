@@ -10,6 +10,7 @@
 namespace Slang {
 
 class DiagnosticSink;
+class LexedFileCache;
 class Linkage;
 struct PreprocessorContentAssistInfo;
 
@@ -57,6 +58,9 @@ struct PreprocessorDesc
 
         /// Optional: additional information for code assist.
     PreprocessorContentAssistInfo* contentAssistInfo = nullptr;
+
+        /// Optional: cache of the tokens lexed from `#include`d files, which must use the same `namePool`
+    LexedFileCache* lexedFileCache = nullptr;
 };
 
     /// Take a source `file` and preprocess it into a list of tokens.
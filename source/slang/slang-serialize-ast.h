@@ -17,12 +17,20 @@ namespace Slang
 /* Holds RIFF FourCC codes for AST types */
 struct ASTSerialBinary
 {
+        /// Change if the way the AST is serialized changes. Changes to the fields of serialized AST classes
+        /// are detected from the layout of the SerialClasses (see `SerialClasses::calcLayoutHash`).
+    static const uint32_t kFormatVersion = 1;
+
     static const FourCC kRiffFourCC = RiffFourCC::kRiff;
 
         /// AST module LIST container
     static const FourCC kSlangASTModuleFourCC = SLANG_FOUR_CC('S', 'A', 'm', 'l');
         /// AST module data 
     static const FourCC kSlangASTModuleDataFourCC = SLANG_FOUR_CC('S', 'A', 'm', 'd');
+        /// Mangled names of the symbols exported from the AST module (a string table)
+    static const FourCC kSlangASTModuleExportNamesFourCC = SLANG_FOUR_CC('S', 'A', 'm', 'x');
+        /// Serial indices of the symbols exported from the AST module (uint32_t for each mangled name)
+    static const FourCC kSlangASTModuleExportIndicesFourCC = SLANG_FOUR_CC('S', 'A', 'm', 'i');
 };
 
 class ModuleSerialFilter : public SerialFilter
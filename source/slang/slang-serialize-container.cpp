@@ -73,6 +73,14 @@ namespace Slang {
             SLANG_ASSERT(moduleDecl);
 
             dstModule.astRootNode = moduleDecl;
+
+            // Save the exported symbols, so they don't have to be found again when the module is read
+            List<UnownedStringSlice> exportMangledNames;
+            module->getExportSymbols(exportMangledNames, dstModule.exportSymbols);
+            for (const auto& mangledName : exportMangledNames)
+            {
+                dstModule.exportMangledNames.add(mangledName);
+            }
         }
         if (options.optionFlags & SerialOptionFlag::IRModule)
         {
@@ -220,9 +228,29 @@ namespace Slang {
                     // Add the module and everything that isn't filtered out in the filter.
                     writer.addPointer(moduleDecl);
 
+                    // Get the indices of the exported symbols. They are all in the module, so are already added.
+                    List<uint32_t> exportIndices;
+                    for (auto exportSymbol : module.exportSymbols)
+                    {
+                        exportIndices.add(uint32_t(writer.addPointer(exportSymbol)));
+                    }
 
                     // We can now serialize it into the riff container.
                     SLANG_RETURN_ON_FAIL(writer.writeIntoContainer(ASTSerialBinary::kSlangASTModuleDataFourCC, container));
+
+                    if (exportIndices.getCount())
+                    {
+                        List<UnownedStringSlice> exportMangledNames;
+                        for (const auto& mangledName : module.exportMangledNames)
+                        {
+                            exportMangledNames.add(mangledName.getUnownedSlice());
+                        }
+                        List<char> encodedNames;
+                        SerialStringTableUtil::encodeStringTable(exportMangledNames.getArrayView(), encodedNames);
+
+                        container->addDataChunk(ASTSerialBinary::kSlangASTModuleExportNamesFourCC, encodedNames.getBuffer(), size_t(encodedNames.getCount()));
+                        container->addDataChunk(ASTSerialBinary::kSlangASTModuleExportIndicesFourCC, exportIndices.getBuffer(), size_t(exportIndices.getCount() * sizeof(uint32_t)));
+                    }
                 }
             }
         }
@@ -354,15 +382,31 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
             NodeBase* astRootNode = nullptr;
             RefPtr<IRModule> irModule;
 
+            RefPtr<IRSerialDeferredModule> deferredIRModule;
+            List<String> exportMangledNames;
+            List<NodeBase*> exportSymbols;
+
             if (auto irChunk = as<RiffContainer::ListChunk>(chunk, IRSerialBinary::kIRModuleFourCc))
             {
-                IRSerialData serialData;
+                if (options.deferIRModules)
+                {
+                    // Just read the serial data, the IR is read from it when it's first needed
+                    deferredIRModule = new IRSerialDeferredModule;
+                    deferredIRModule->m_session = options.session;
+                    deferredIRModule->m_sourceLocReader = sourceLocReader;
 
-                SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(irChunk, containerCompressionType, &serialData));
+                    SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(irChunk, containerCompressionType, &deferredIRModule->m_serialData));
+                }
+                else
+                {
+                    IRSerialData serialData;
 
-                // Read IR back from serialData
-                IRSerialReader reader;
-                SLANG_RETURN_ON_FAIL(reader.read(serialData, options.session, sourceLocReader, irModule));
+                    SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(irChunk, containerCompressionType, &serialData));
+
+                    // Read IR back from serialData
+                    IRSerialReader reader;
+                    SLANG_RETURN_ON_FAIL(reader.read(serialData, options.session, sourceLocReader, irModule));
+                }
 
                 // Onto next chunk
                 chunk = chunk->m_next;
@@ -496,6 +540,31 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
                     // Get the root node. It's at index 1 (0 is the null value).
                     astRootNode = reader.getPointer(SerialIndex(1)).dynamicCast<NodeBase>();
 
+                    // Read the exported symbols if they were written, so they don't need to be found (and mangled)
+                    // when another module refers to them
+                    RiffContainer::Data* exportNamesData = astChunk->findContainedData(ASTSerialBinary::kSlangASTModuleExportNamesFourCC);
+                    RiffContainer::Data* exportIndicesData = astChunk->findContainedData(ASTSerialBinary::kSlangASTModuleExportIndicesFourCC);
+                    if (exportNamesData && exportIndicesData)
+                    {
+                        List<UnownedStringSlice> names;
+                        SerialStringTableUtil::appendDecodedStringTable((const char*)exportNamesData->getPayload(), exportNamesData->getSize(), names);
+
+                        const uint32_t* indices = (const uint32_t*)exportIndicesData->getPayload();
+                        const Index indicesCount = Index(exportIndicesData->getSize() / sizeof(uint32_t));
+                        if (indicesCount != names.getCount())
+                        {
+                            return SLANG_FAIL;
+                        }
+
+                        exportMangledNames.setCount(indicesCount);
+                        exportSymbols.setCount(indicesCount);
+                        for (Index i = 0; i < indicesCount; ++i)
+                        {
+                            exportMangledNames[i] = names[i];
+                            exportSymbols[i] = reader.getPointer(SerialIndex(indices[i])).dynamicCast<NodeBase>();
+                        }
+                    }
+
                     // 2) Add the extensions to the module mapTypeToCandidateExtensions cache
                     // 3) We need to fix the callback pointers for parsing
 
@@ -576,13 +645,16 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
                 chunk = chunk->m_next;
             }
 
-            if (astBuilder || irModule)
+            if (astBuilder || irModule || deferredIRModule)
             {
                 SerialContainerData::Module module;
 
                 module.astBuilder = astBuilder;
                 module.astRootNode = astRootNode;
                 module.irModule = irModule;
+                module.deferredIRModule = deferredIRModule;
+                module.exportMangledNames = exportMangledNames;
+                module.exportSymbols = exportSymbols;
 
                 out.modules.add(module);
             }
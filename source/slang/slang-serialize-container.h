@@ -4,6 +4,7 @@
 
 #include "../core/slang-riff.h"
 #include "slang-serialize-types.h"
+#include "slang-serialize-ir.h"
 #include "slang-ir-insts.h"
 #include "slang-profile.h"
 
@@ -51,8 +52,11 @@ struct SerialContainerData
     struct Module
     {
         RefPtr<IRModule> irModule;              ///< The IR for the module
+        RefPtr<IRSerialDeferredModule> deferredIRModule;   ///< Set instead of irModule if reading the IR is deferred
         RefPtr<ASTBuilder> astBuilder;          ///< The astBuilder that owns the astRootNode
         NodeBase* astRootNode = nullptr;        ///< The module decl
+        List<String> exportMangledNames;        ///< The mangled names of the symbols exported by the module (if were serialized)
+        List<NodeBase*> exportSymbols;          ///< The exported symbols, in the same order as exportMangledNames
     };
 
     struct EntryPoint
@@ -92,6 +96,7 @@ struct SerialContainerUtil
         ASTBuilder* astBuilder = nullptr; // Optional. If not provided will create one in SerialContainerData.
         Linkage* linkage = nullptr;
         DiagnosticSink* sink = nullptr;
+        bool deferIRModules = false;            ///< If set, the IR of modules is only read when first needed
     };
 
         /// Add module to outData
@@ -21,6 +21,10 @@ class Name;
 
 struct IRSerialBinary
 {
+        /// Change if the way IR is serialized changes. Instructions are serialized by op code, so adding or
+        /// removing ops also changes the format, which is detected from the op table.
+    static const uint32_t kFormatVersion = 1;
+
         /// IR module list
     static const FourCC kIRModuleFourCc = SLANG_FOUR_CC('S', 'i', 'm', 'd');             
 
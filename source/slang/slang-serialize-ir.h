@@ -89,6 +89,23 @@ struct IRSerialReader
     IRModule* m_module;
 };
 
+/* The serialized IR of a module, that is only read into an IRModule when it's first needed.
+Holds everything needed to read the IR after the container it was read from is released. */
+class IRSerialDeferredModule : public RefObject
+{
+public:
+        /// Read the IR module
+    Result read(RefPtr<IRModule>& outModule)
+    {
+        IRSerialReader reader;
+        return reader.read(m_serialData, m_session, m_sourceLocReader, outModule);
+    }
+
+    IRSerialData m_serialData;
+    Session* m_session = nullptr;
+    RefPtr<SerialSourceLocReader> m_sourceLocReader;
+};
+
 } // namespace Slang
 
 #endif
@@ -203,6 +203,36 @@ bool SerialClasses::isOk() const
 }
 
 
+HashCode64 SerialClasses::calcLayoutHash() const
+{
+    StringBuilder buf;
+    for (const auto& classes : m_classesByTypeKind)
+    {
+        for (const SerialClass* cls : classes)
+        {
+            if (cls == nullptr)
+            {
+                buf << "-\n";
+                continue;
+            }
+
+            buf << Index(cls->typeKind) << " " << Index(cls->subType) << " " << cls->size << " " << Index(cls->alignment) << " " << Index(cls->flags);
+            if (cls->super)
+            {
+                buf << " : " << Index(cls->super->subType);
+            }
+            buf << "\n";
+
+            for (Index i = 0; i < cls->fieldsCount; ++i)
+            {
+                const SerialField& field = cls->fields[i];
+                buf << "  " << field.name << " " << field.type->serialSizeInBytes << " " << field.serialOffset << "\n";
+            }
+        }
+    }
+    return getStableHashCode64(buf.getBuffer(), buf.getLength());
+}
+
 SerialClasses::SerialClasses():
     m_arena(2048)
 {
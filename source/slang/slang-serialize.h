@@ -506,6 +506,10 @@ public:
         /// Returns true if the SerialClasses structure appears ok
     bool isOk() const;
 
+        /// Calculate a hash of the layout of all of the classes (their sizes and fields), which changes if
+        /// the serialized format of any of them does.
+    HashCode64 calcLayoutHash() const;
+
         /// Get a serial class based on its type/subType
     const SerialClass* getSerialClass(SerialTypeKind typeKind, SerialSubType subType) const
     {
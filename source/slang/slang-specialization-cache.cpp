@@ -0,0 +1,198 @@
+// slang-specialization-cache.cpp
+#include "slang-specialization-cache.h"
+
+#include "slang-compiler.h"
+
+namespace Slang {
+
+bool SpecializationCache::Key::operator==(const Key& rhs) const
+{
+    if (m_hashCode != rhs.m_hashCode ||
+        m_kind != rhs.m_kind ||
+        m_component != rhs.m_component ||
+        m_args.getCount() != rhs.m_args.getCount())
+    {
+        return false;
+    }
+
+    for (Index i = 0; i < m_args.getCount(); ++i)
+    {
+        Val* arg = m_args[i];
+        Val* rhsArg = rhs.m_args[i];
+        if (arg != rhsArg && !(arg && rhsArg && arg->equalsVal(rhsArg)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SpecializationCache::_initKey(Kind kind, ComponentType* component, Val*const* args, Index argCount, Key& outKey)
+{
+    outKey.m_kind = kind;
+    outKey.m_component = component;
+    outKey.m_args.setCount(argCount);
+
+    HashCode hashCode = combineHash(Slang::getHashCode(int(kind)), Slang::getHashCode(component));
+    for (Index i = 0; i < argCount; ++i)
+    {
+        Val* arg = args[i];
+        if (auto type = as<Type>(arg))
+        {
+            arg = type->getCanonicalType();
+        }
+        outKey.m_args[i] = arg;
+        hashCode = combineHash(hashCode, arg ? arg->getHashCode() : 0);
+    }
+    outKey.m_hashCode = hashCode;
+}
+
+void SpecializationCache::_unlink(Entry* entry)
+{
+    if (entry->m_prev)
+    {
+        entry->m_prev->m_next = entry->m_next;
+    }
+    else
+    {
+        m_mostRecent = entry->m_next;
+    }
+
+    if (entry->m_next)
+    {
+        entry->m_next->m_prev = entry->m_prev;
+    }
+    else
+    {
+        m_leastRecent = entry->m_prev;
+    }
+
+    entry->m_prev = nullptr;
+    entry->m_next = nullptr;
+}
+
+void SpecializationCache::_moveToFront(Entry* entry)
+{
+    if (entry == m_mostRecent)
+    {
+        return;
+    }
+    // If the entry is in the list, it has a more recently used entry
+    if (entry->m_prev)
+    {
+        _unlink(entry);
+    }
+
+    entry->m_next = m_mostRecent;
+    if (m_mostRecent)
+    {
+        m_mostRecent->m_prev = entry;
+    }
+    else
+    {
+        m_leastRecent = entry;
+    }
+    m_mostRecent = entry;
+}
+
+void SpecializationCache::_updateMostRecentMemoryUsage()
+{
+    if (Entry* entry = m_mostRecent)
+    {
+        const size_t memoryUsage = entry->m_result->calcApproximateMemoryUsage();
+        m_memoryUsage = m_memoryUsage - entry->m_memoryUsage + memoryUsage;
+        entry->m_memoryUsage = memoryUsage;
+    }
+}
+
+ComponentType* SpecializationCache::find(Kind kind, ComponentType* component, Val*const* args, Index argCount)
+{
+    if (!isEnabled())
+    {
+        return nullptr;
+    }
+
+    Key key;
+    _initKey(kind, component, args, argCount, key);
+
+    if (RefPtr<Entry>* entryPtr = m_entries.TryGetValue(key))
+    {
+        Entry* entry = *entryPtr;
+        m_hitCount++;
+
+        _updateMostRecentMemoryUsage();
+        _moveToFront(entry);
+        return entry->m_result;
+    }
+
+    m_missCount++;
+    return nullptr;
+}
+
+void SpecializationCache::add(Kind kind, ComponentType* component, Val*const* args, Index argCount, ComponentType* result)
+{
+    if (!isEnabled() || !result)
+    {
+        return;
+    }
+
+    RefPtr<Entry> entry = new Entry;
+    _initKey(kind, component, args, argCount, entry->m_key);
+    entry->m_result = result;
+    entry->m_memoryUsage = result->calcApproximateMemoryUsage();
+
+    // Replace any entry with the same key
+    if (RefPtr<Entry>* existing = m_entries.TryGetValue(entry->m_key))
+    {
+        _unlink(*existing);
+        m_memoryUsage -= (*existing)->m_memoryUsage;
+    }
+
+    _updateMostRecentMemoryUsage();
+    _moveToFront(entry);
+    m_memoryUsage += entry->m_memoryUsage;
+    m_entries.Set(entry->m_key, entry);
+
+    _enforceBudget();
+}
+
+void SpecializationCache::setBudget(size_t budget)
+{
+    m_budget = budget;
+    _enforceBudget();
+}
+
+void SpecializationCache::clear()
+{
+    m_entries.Clear();
+    m_mostRecent = nullptr;
+    m_leastRecent = nullptr;
+    m_memoryUsage = 0;
+}
+
+void SpecializationCache::_enforceBudget()
+{
+    while (m_memoryUsage > m_budget && m_leastRecent)
+    {
+        RefPtr<Entry> entry = m_leastRecent;
+        _unlink(entry);
+        m_memoryUsage -= entry->m_memoryUsage;
+        m_entries.Remove(entry->m_key);
+
+        m_evictionCount++;
+    }
+}
+
+void SpecializationCache::getStats(slang::SpecializationCacheStats& outStats)
+{
+    _updateMostRecentMemoryUsage();
+
+    outStats.hitCount = m_hitCount;
+    outStats.missCount = m_missCount;
+    outStats.evictionCount = m_evictionCount;
+    outStats.entryCount = m_entries.getCount();
+    outStats.approximateMemoryUsage = m_memoryUsage;
+    outStats.budget = m_budget;
+}
+
+} // namespace Slang
@@ -0,0 +1,109 @@
+// slang-specialization-cache.h
+#ifndef SLANG_SPECIALIZATION_CACHE_H_INCLUDED
+#define SLANG_SPECIALIZATION_CACHE_H_INCLUDED
+
+#include "../core/slang-basic.h"
+#include "../core/slang-flat-dictionary.h"
+
+#include "../../slang.h"
+
+namespace Slang {
+
+class ComponentType;
+class Val;
+
+/* A cache of the component types produced by specializing and linking component types, held by a linkage.
+
+Applications typically specialize the same component (such as an entry point) with the same arguments many
+times. Without the cache each call produces a new component type, with its own IR, layout and generated code.
+With the cache a repeated request returns the component type produced the first time, so anything already
+generated for it (by its `TargetProgram`s) is reused.
+
+An entry is looked up by the identity of the component that was specialized or linked, and the specialization
+arguments. Arguments that are types are compared by their canonical type. The cached component type holds a
+reference to the component it was produced from, so the identity can't be reused by another component whilst
+the entry exists.
+
+The cache is limited by an approximate memory budget. A running total of the memory used by the entries is kept,
+and the budget is enforced whenever an entry is added, by removing the least recently used entries. Entries are
+held in a list ordered by use, so finding the least recently used is O(1). The memory used by an entry grows as
+code is generated for it, which typically happens just after it is returned, so the memory of the most recently
+used entry is measured again when another entry is used or added. A budget of 0 disables the cache. */
+class SpecializationCache
+{
+public:
+    enum class Kind : uint8_t
+    {
+        Specialize,
+        Link,
+    };
+
+        /// Set the budget in bytes. Entries are removed if the cache is now over budget.
+    void setBudget(size_t budget);
+        /// Get the budget in bytes
+    size_t getBudget() const { return m_budget; }
+
+        /// True if the cache is enabled
+    bool isEnabled() const { return m_budget > 0; }
+
+        /// Find the result of specializing (or linking, if argCount is 0 and kind is Link) `component`.
+        /// Returns nullptr if it isn't in the cache.
+    ComponentType* find(Kind kind, ComponentType* component, Val*const* args, Index argCount);
+
+        /// Add the result of specializing or linking `component`
+    void add(Kind kind, ComponentType* component, Val*const* args, Index argCount, ComponentType* result);
+
+        /// Remove all entries
+    void clear();
+
+        /// Get the current statistics
+    void getStats(slang::SpecializationCacheStats& outStats);
+
+protected:
+    struct Key
+    {
+        HashCode getHashCode() const { return m_hashCode; }
+        bool operator==(const Key& rhs) const;
+
+        Kind m_kind;
+        ComponentType* m_component;
+        List<Val*> m_args;                  ///< Canonicalized arguments
+        HashCode m_hashCode;
+    };
+
+    // Entries are held in a list from the most to the least recently used
+    struct Entry : RefObject
+    {
+        Key m_key;
+        RefPtr<ComponentType> m_result;
+        size_t m_memoryUsage = 0;           ///< The memory used by the result when last measured
+        Entry* m_prev = nullptr;            ///< The next more recently used entry
+        Entry* m_next = nullptr;            ///< The next less recently used entry
+    };
+
+    void _initKey(Kind kind, ComponentType* component, Val*const* args, Index argCount, Key& outKey);
+
+        /// Measure the memory used by the most recently used entry again, as code may have been generated for it
+    void _updateMostRecentMemoryUsage();
+        /// Make entry the most recently used
+    void _moveToFront(Entry* entry);
+    void _unlink(Entry* entry);
+        /// Remove least recently used entries until the cache is within budget
+    void _enforceBudget();
+
+    FlatDictionary<Key, RefPtr<Entry>> m_entries;
+
+    Entry* m_mostRecent = nullptr;
+    Entry* m_leastRecent = nullptr;
+    size_t m_memoryUsage = 0;               ///< The total of the memory used by the entries
+
+    size_t m_budget = 0;
+
+    uint64_t m_hitCount = 0;
+    uint64_t m_missCount = 0;
+    uint64_t m_evictionCount = 0;
+};
+
+} // namespace Slang
+
+#endif
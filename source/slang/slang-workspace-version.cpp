@@ -1,5 +1,6 @@
 #include "slang-workspace-version.h"
 #include "../core/slang-io.h"
+#include "../core/slang-com-object.h"
 #include "../core/slang-file-system.h"
 #include "../compiler-core/slang-lexer.h"
 #include "slang-serialize-container.h"
@@ -28,6 +29,181 @@ struct DirEnumerationContext
         }
     }
 };
+void* DocumentSnapshotFileSystem::getInterface(const Guid& uuid)
+{
+    if (uuid == ISlangUnknown::getTypeGuid() || uuid == ISlangFileSystem::getTypeGuid())
+    {
+        return static_cast<ISlangFileSystem*>(this);
+    }
+    return nullptr;
+}
+
+SlangResult DocumentSnapshotFileSystem::loadFile(const char* path, ISlangBlob** outBlob)
+{
+    String canonnicalPath;
+    SLANG_RETURN_ON_FAIL(Path::getCanonical(path, canonnicalPath));
+    RefPtr<DocumentVersion> doc;
+    if (documents.TryGetValue(canonnicalPath, doc))
+    {
+        *outBlob = StringBlob::create(doc->getText()).detach();
+        return SLANG_OK;
+    }
+    return Slang::OSFileSystem::getExtSingleton()->loadFile(path, outBlob);
+}
+
+// After this many modules have been removed from a linkage, a new linkage is used for the next version,
+// so the memory held by the removed modules can be freed.
+static const Index kMaxRemovedModuleCount = 256;
+
+String WorkspaceLinkage::_getCanonicalPath(const String& path)
+{
+    if (auto canonicalPath = m_canonicalPaths.TryGetValue(path))
+        return *canonicalPath;
+    String canonicalPath;
+    if (SLANG_FAILED(Path::getCanonical(path, canonicalPath)))
+        canonicalPath = path;
+    m_canonicalPaths[path] = canonicalPath;
+    return canonicalPath;
+}
+
+bool WorkspaceLinkage::isReusable(const List<String>& inSearchPaths)
+{
+    if (m_removedModules.getCount() >= kMaxRemovedModuleCount)
+        return false;
+    if (searchPaths.getCount() != inSearchPaths.getCount())
+        return false;
+    for (Index i = 0; i < searchPaths.getCount(); i++)
+    {
+        if (searchPaths[i] != inSearchPaths[i])
+            return false;
+    }
+    return true;
+}
+
+void WorkspaceLinkage::calcDependencies(Module* module, List<String>& outPaths)
+{
+    for (auto& path : module->getFilePathDependencyList())
+        outPaths.add(_getCanonicalPath(path));
+}
+
+static uint32_t _getFileVersion(const Dictionary<String, uint32_t>& fileVersions, const String& path)
+{
+    auto version = fileVersions.TryGetValue(path);
+    return version ? *version : 0;
+}
+
+void WorkspaceLinkage::recordLoadedFiles(const Dictionary<String, uint32_t>& fileVersions)
+{
+    const auto& sourceFiles = linkage->getSourceManager()->getSourceFiles();
+    for (Index i = m_recordedSourceFileCount; i < sourceFiles.getCount(); i++)
+    {
+        SourceFile* sourceFile = sourceFiles[i];
+        const PathInfo& pathInfo = sourceFile->getPathInfo();
+        if (!pathInfo.hasFoundPath() || !sourceFile->hasContent())
+            continue;
+
+        const String path = _getCanonicalPath(pathInfo.foundPath);
+        auto& loadedFile = m_loadedFiles.GetOrAddValue(path, LoadedFile());
+        loadedFile.version = _getFileVersion(fileVersions, path);
+        if (pathInfo.hasUniqueIdentity())
+            loadedFile.uniqueIdentity = pathInfo.uniqueIdentity;
+    }
+    m_recordedSourceFileCount = sourceFiles.getCount();
+}
+
+void WorkspaceLinkage::update(
+    const Dictionary<String, RefPtr<DocumentVersion>>& documents,
+    const Dictionary<String, uint32_t>& fileVersions)
+{
+    fileSystem->documents = documents;
+
+    // Find the files that have changed since the modules were loaded from them.
+    HashSet<String> changedPaths;
+    for (auto& pair : m_loadedFiles)
+    {
+        if (_getFileVersion(fileVersions, pair.Key) != pair.Value.version)
+            changedPaths.Add(pair.Key);
+    }
+    if (changedPaths.Count() == 0)
+        return;
+
+    // Make sure a changed file is loaded again the next time it is included or imported. The linkage
+    // wraps the file system in a cache, which holds the previous contents too.
+    for (auto& path : changedPaths)
+    {
+        auto& uniqueIdentity = m_loadedFiles[path].GetValue().uniqueIdentity;
+        if (uniqueIdentity.getLength())
+            linkage->getSourceManager()->removeSourceFile(uniqueIdentity);
+        m_loadedFiles.Remove(path);
+    }
+    linkage->getFileSystemExt()->clearCache();
+
+    // A document is loaded from a string, so it isn't a file path dependency of its own module.
+    HashSet<Module*> modulesToRemove;
+    for (auto& pair : primaryModules)
+    {
+        if (pair.Value.module && changedPaths.Contains(pair.Key))
+            modulesToRemove.Add(pair.Value.module);
+    }
+
+    // The file path dependencies of a module include the files of the modules it imports, so this finds
+    // the modules that transitively import a changed module too.
+    for (auto& pair : linkage->mapNameToLoadedModules)
+    {
+        for (auto& dependencyPath : pair.Value->getFilePathDependencyList())
+        {
+            if (changedPaths.Contains(_getCanonicalPath(dependencyPath)))
+            {
+                modulesToRemove.Add(pair.Value);
+                break;
+            }
+        }
+    }
+    List<String> documentsToRemove;
+    for (auto& pair : primaryModules)
+    {
+        if (!pair.Value.module || modulesToRemove.Contains(pair.Value.module) || changedPaths.Contains(pair.Key))
+            documentsToRemove.add(pair.Key);
+    }
+    for (auto& path : documentsToRemove)
+        primaryModules.Remove(path);
+
+    if (modulesToRemove.Count() == 0)
+        return;
+
+    for (auto module : modulesToRemove)
+        m_removedModules.add(module);
+
+    List<Name*> namesToRemove;
+    for (auto& pair : linkage->mapNameToLoadedModules)
+    {
+        if (modulesToRemove.Contains(pair.Value))
+            namesToRemove.add(pair.Key);
+    }
+    for (auto name : namesToRemove)
+        linkage->mapNameToLoadedModules.Remove(name);
+
+    List<String> pathsToRemove;
+    for (auto& pair : linkage->mapPathToLoadedModule)
+    {
+        if (modulesToRemove.Contains(pair.Value))
+            pathsToRemove.add(pair.Key);
+    }
+    for (auto& path : pathsToRemove)
+        linkage->mapPathToLoadedModule.Remove(path);
+
+    List<RefPtr<LoadedModule>> loadedModules;
+    for (auto& module : linkage->loadedModulesList)
+    {
+        if (!modulesToRemove.Contains(module))
+            loadedModules.add(module);
+    }
+    linkage->loadedModulesList = _Move(loadedModules);
+
+    // The results cached by type checking may depend on the removed modules
+    linkage->destroyTypeCheckingCache();
+}
+
 DocumentVersion* Workspace::openDoc(String path, String text)
 {
     RefPtr<DocumentVersion> doc = new DocumentVersion();
@@ -35,6 +211,7 @@ DocumentVersion* Workspace::openDoc(String path, String text)
     doc->setPath(path);
     openedDocuments[path] = doc;
     workspaceSearchPaths.Add(Path::getParentDirectory(path));
+    advanceFileVersion(path);
     invalidate();
     return doc.Ptr();
 }
@@ -59,15 +236,39 @@ void Workspace::changeDoc(const String& path, LanguageServerProtocol::Range rang
 void Workspace::changeDoc(DocumentVersion* doc, const String& newText)
 {
     doc->setText(newText);
+    advanceFileVersion(doc->getPath());
     invalidate();
 }
 
 void Workspace::closeDoc(const String& path)
 {
     openedDocuments.Remove(path);
+    // The file is loaded from disk again
+    advanceFileVersion(path);
     invalidate();
 }
 
+void Workspace::changeFile(const String& path)
+{
+    // An opened document is loaded from its text, rather than the file
+    if (openedDocuments.ContainsKey(path))
+        return;
+    advanceFileVersion(path);
+    invalidate();
+}
+
+void Workspace::addFile(const String& path)
+{
+    advanceFileVersion(path);
+    reusableLinkage = nullptr;
+    invalidate();
+}
+
+void Workspace::advanceFileVersion(const String& path)
+{
+    fileVersions[path] = _getFileVersion(fileVersions, path) + 1;
+}
+
 bool Workspace::updatePredefinedMacros(List<String> macros)
 {
     List<OwnedPreprocessorMacroDefinition> newDefs;
@@ -105,7 +306,7 @@ bool Workspace::updatePredefinedMacros(List<String> macros)
     if (changed)
     {
         predefinedMacros = _Move(newDefs);
-        invalidate();
+        invalidateAll();
     }
     return changed;
 }
@@ -129,7 +330,7 @@ bool Workspace::updateSearchPaths(List<String> paths)
     if (changed)
     {
         additionalSearchPaths = _Move(paths);
-        invalidate();
+        invalidateAll();
     }
     return changed;
 }
@@ -140,7 +341,7 @@ bool Workspace::updateSearchInWorkspace(bool value)
     searchInWorkspace = value;
     if (changed)
     {
-        invalidate();
+        invalidateAll();
     }
     return changed;
 }
@@ -184,113 +385,175 @@ void Workspace::init(List<URI> rootDirURI, slang::IGlobalSession* globalSession)
     slangGlobalSession = globalSession;
 }
 
-void Workspace::invalidate() { currentVersion = nullptr; }
+void Workspace::invalidate() { isVersionOutOfDate = true; }
 
-void WorkspaceVersion::parseDiagnostics(String compilerOutput)
+void Workspace::invalidateAll()
 {
-    List<UnownedStringSlice> lines;
-    StringUtil::calcLines(compilerOutput.getUnownedSlice(), lines);
-    for (Index lineIndex = 0; lineIndex < lines.getCount(); lineIndex++)
+    // The settings that affect every document have changed, so neither the current or pending version
+    // (or their linkage) can be used for any of them.
+    currentVersion = nullptr;
+    if (pendingVersion)
     {
-        auto line = lines[lineIndex];
-        Index colonIndex = line.indexOf(UnownedStringSlice("):"));
-        if (colonIndex == -1)
-            continue;
-        Index lparentIndex = line.indexOf('(');
-        if (lparentIndex > colonIndex)
-            continue;
-        String fileName = line.subString(0, lparentIndex);
-        Path::getCanonical(fileName, fileName);
-        auto& diagnosticList = diagnostics.GetOrAddValue(fileName, DocumentDiagnostics());
-
-        LanguageServerProtocol::Diagnostic diagnostic;
-        Index pos = lparentIndex + 1;
-        int lineLoc = StringUtil::parseIntAndAdvancePos(line, pos);
-        if (lineLoc == 0)
-            lineLoc = 1;
-        diagnostic.range.end.line = diagnostic.range.start.line = lineLoc;
-        pos++;
-        int colLoc = StringUtil::parseIntAndAdvancePos(line, pos);
-        if (colLoc == 0)
-            colLoc = 1;
-        diagnostic.range.end.character = diagnostic.range.start.character = colLoc;
-        if (pos >= line.getLength())
-            continue;
-        line = line.tail(colonIndex + 3);
-        colonIndex = line.indexOf(':');
-        if (colonIndex == -1)
-            continue;
-        if (line.startsWith("error"))
-        {
-            diagnostic.severity = LanguageServerProtocol::kDiagnosticsSeverityError;
-        }
-        else if (line.startsWith("warning"))
-        {
-            diagnostic.severity = LanguageServerProtocol::kDiagnosticsSeverityWarning;
-        }
-        else if (line.startsWith("note"))
-        {
-            diagnostic.severity = LanguageServerProtocol::kDiagnosticsSeverityInformation;
-        }
-        else
+        pendingVersion->isSuperseded = true;
+        pendingVersion = nullptr;
+    }
+    reusableLinkage = nullptr;
+    invalidate();
+}
+
+Workspace::~Workspace()
+{
+    // Don't wait for a pending version to be checked if it hasn't been started
+    if (pendingVersion)
+        pendingVersion->isSuperseded = true;
+    versionThreadPool = nullptr;
+}
+
+void Workspace::adoptCheckedVersion()
+{
+    if (pendingVersion && pendingVersion->isChecked)
+    {
+        currentVersion = pendingVersion;
+        pendingVersion = nullptr;
+    }
+}
+
+void Workspace::checkVersionInBackground()
+{
+    if (!isVersionOutOfDate)
+        return;
+    isVersionOutOfDate = false;
+
+    // There is no point checking an older version that hasn't been started yet
+    if (pendingVersion)
+        pendingVersion->isSuperseded = true;
+
+    pendingVersion = createVersionForChecking();
+    if (!versionThreadPool)
+        versionThreadPool = new ThreadPool(1);
+
+    RefPtr<WorkspaceVersion> version = pendingVersion;
+    versionThreadPool->submit(
+        [version]()
         {
-            continue;
-        }
-        pos = line.indexOf(' ');
-        diagnostic.code = StringUtil::parseIntAndAdvancePos(line, pos);
-        diagnostic.message = line.tail(colonIndex + 2);
-        if (lineIndex + 1 < lines.getCount() && lines[lineIndex].startsWith("^+"))
+            if (!version->isSuperseded)
+                version->checkAllDocuments();
+        });
+}
+
+// Collects the diagnostics reported when loading a module as LSP diagnostics, keyed by the canonical
+// path of the file they are in.
+class DocumentDiagnosticListener : public DiagnosticListener
+{
+public:
+    static const Index kMaxDiagnosticCountPerDocument = 1000;
+
+    DocumentDiagnosticListener(
+        SourceManager* sourceManager,
+        const Dictionary<String, RefPtr<DocumentVersion>>& documents)
+        : m_sourceManager(sourceManager)
+        , m_documents(documents)
+    {}
+
+    virtual void handleDiagnostic(Diagnostic const& diagnostic) override
+    {
+        LanguageServerProtocol::Diagnostic lspDiagnostic;
+        switch (diagnostic.severity)
         {
-            lineIndex++;
-            pos = 2;
-            auto tokenLength = StringUtil::parseIntAndAdvancePos(line, pos);
-            diagnostic.range.end.character += tokenLength;
+        case Severity::Note:
+            lspDiagnostic.severity = LanguageServerProtocol::kDiagnosticsSeverityInformation;
+            break;
+        case Severity::Warning:
+            lspDiagnostic.severity = LanguageServerProtocol::kDiagnosticsSeverityWarning;
+            break;
+        case Severity::Error:
+        case Severity::Fatal:
+        case Severity::Internal:
+            lspDiagnostic.severity = LanguageServerProtocol::kDiagnosticsSeverityError;
+            break;
+        default:
+            return;
         }
 
-        if (auto doc = workspace->openedDocuments.TryGetValue(fileName))
+        SourceView* sourceView = m_sourceManager->findSourceViewRecursively(diagnostic.loc);
+        if (!sourceView)
+            return;
+        HumaneSourceLoc humaneLoc = sourceView->getHumaneLoc(diagnostic.loc);
+        String path = _getCanonicalPath(humaneLoc.pathInfo.foundPath);
+
+        auto& docDiagnostics = diagnostics.GetOrAddValue(path, DocumentDiagnostics());
+        if (docDiagnostics.messages.Count() >= kMaxDiagnosticCountPerDocument)
+            return;
+
+        // Notes don't have an id
+        lspDiagnostic.code = diagnostic.ErrorID >= 0 ? diagnostic.ErrorID : 0;
+        lspDiagnostic.message = diagnostic.Message;
+
+        const Index line = Math::Max(humaneLoc.line, Index(1));
+        const Index column = Math::Max(humaneLoc.column, Index(1));
+        // The end is on the same line, as it is the end of the token at the location.
+        Index endColumn = column;
+        if (diagnostic.endLoc.isValid())
+            endColumn += diagnostic.endLoc.getRaw() - diagnostic.loc.getRaw();
+
+        if (auto doc = m_documents.TryGetValue(path))
         {
             // If the file is open, translate to UTF16 positions using the document.
             Index lineUTF16, colUTF16;
-            doc->Ptr()->oneBasedUTF8LocToZeroBasedUTF16Loc(
-                diagnostic.range.start.line, diagnostic.range.start.character, lineUTF16, colUTF16);
-            diagnostic.range.start.line = (int)lineUTF16;
-            diagnostic.range.start.character = (int)colUTF16;
-            doc->Ptr()->oneBasedUTF8LocToZeroBasedUTF16Loc(
-                diagnostic.range.end.line, diagnostic.range.end.character, lineUTF16, colUTF16);
-            diagnostic.range.end.line = (int)lineUTF16;
-            diagnostic.range.end.character = (int)colUTF16;
+            (*doc)->oneBasedUTF8LocToZeroBasedUTF16Loc(line, column, lineUTF16, colUTF16);
+            lspDiagnostic.range.start.line = (int)lineUTF16;
+            lspDiagnostic.range.start.character = (int)colUTF16;
+            (*doc)->oneBasedUTF8LocToZeroBasedUTF16Loc(line, endColumn, lineUTF16, colUTF16);
+            lspDiagnostic.range.end.line = (int)lineUTF16;
+            lspDiagnostic.range.end.character = (int)colUTF16;
         }
         else
         {
             // Otherwise, just return an 0-based position.
-            diagnostic.range.start.line--;
-            diagnostic.range.start.character--;
-            diagnostic.range.end.line--;
-            diagnostic.range.end.character--;
+            lspDiagnostic.range.start.line = lspDiagnostic.range.end.line = (int)(line - 1);
+            lspDiagnostic.range.start.character = (int)(column - 1);
+            lspDiagnostic.range.end.character = (int)(endColumn - 1);
         }
-        diagnosticList.messages.Add(diagnostic);
-        if (diagnosticList.messages.Count() >= 1000)
-            break;
+        docDiagnostics.messages.Add(lspDiagnostic);
+    }
+
+    Dictionary<String, DocumentDiagnostics> diagnostics;
+
+private:
+    String _getCanonicalPath(const String& path)
+    {
+        if (auto canonicalPath = m_canonicalPaths.TryGetValue(path))
+            return *canonicalPath;
+        String canonicalPath;
+        if (SLANG_FAILED(Path::getCanonical(path, canonicalPath)))
+            canonicalPath = path;
+        m_canonicalPaths[path] = canonicalPath;
+        return canonicalPath;
+    }
+
+    SourceManager* m_sourceManager;
+    const Dictionary<String, RefPtr<DocumentVersion>>& m_documents;
+    Dictionary<String, String> m_canonicalPaths;
+};
+
+void WorkspaceVersion::addDiagnostics(const Dictionary<String, DocumentDiagnostics>& diagnosticsToAdd)
+{
+    for (auto& pair : diagnosticsToAdd)
+    {
+        auto& docDiagnostics = diagnostics.GetOrAddValue(pair.Key, DocumentDiagnostics());
+        for (auto& message : pair.Value.messages)
+            docDiagnostics.messages.Add(message);
     }
 }
 
-RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion()
+List<String> Workspace::getSearchPaths()
 {
-    RefPtr<WorkspaceVersion> version = new WorkspaceVersion();
-    version->workspace = this;
-    slang::SessionDesc desc = {};
-    desc.fileSystem = this;
-    desc.targetCount = 1;
-    slang::TargetDesc targetDesc = {};
-    targetDesc.profile = slangGlobalSession->findProfile("sm_6_6");
-    desc.targets = &targetDesc;
-    List<const char*> searchPathsRaw;
-    for (auto& path : additionalSearchPaths)
-        searchPathsRaw.add(path.getBuffer());
+    List<String> searchPaths;
+    searchPaths.addRange(additionalSearchPaths);
     if (searchInWorkspace)
     {
         for (auto& path : workspaceSearchPaths)
-            searchPathsRaw.add(path.getBuffer());
+            searchPaths.add(path);
     }
     else
     {
@@ -299,9 +562,48 @@ RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion()
         {
             auto dir = Path::getParentDirectory(p.Key.getBuffer());
             if (set.Add(dir))
-                searchPathsRaw.add(dir.getBuffer());
+                searchPaths.add(dir);
         }
     }
+    return searchPaths;
+}
+
+// Take a copy of the opened documents, so a version is unaffected by later changes, and the
+// documents aren't shared with another thread.
+static void _copyDocuments(
+    const Dictionary<String, RefPtr<DocumentVersion>>& openedDocuments,
+    Dictionary<String, RefPtr<DocumentVersion>>& outDocuments)
+{
+    for (auto& pair : openedDocuments)
+    {
+        RefPtr<DocumentVersion> doc = new DocumentVersion();
+        doc->setPath(pair.Value->getPath());
+        doc->setText(pair.Value->getText());
+        outDocuments[pair.Key] = doc;
+    }
+}
+
+RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion()
+{
+    RefPtr<WorkspaceVersion> version = new WorkspaceVersion();
+    version->workspace = this;
+    _copyDocuments(openedDocuments, version->documents);
+    version->fileVersions = fileVersions;
+
+    RefPtr<WorkspaceLinkage> sharedLinkage = new WorkspaceLinkage();
+    sharedLinkage->fileSystem = new DocumentSnapshotFileSystem();
+    sharedLinkage->fileSystem->documents = version->documents;
+    sharedLinkage->searchPaths = getSearchPaths();
+
+    slang::SessionDesc desc = {};
+    desc.fileSystem = sharedLinkage->fileSystem;
+    desc.targetCount = 1;
+    slang::TargetDesc targetDesc = {};
+    targetDesc.profile = slangGlobalSession->findProfile("sm_6_6");
+    desc.targets = &targetDesc;
+    List<const char*> searchPathsRaw;
+    for (auto& path : sharedLinkage->searchPaths)
+        searchPathsRaw.add(path.getBuffer());
     desc.searchPaths = searchPathsRaw.getBuffer();
     desc.searchPathCount = searchPathsRaw.getCount();
 
@@ -318,27 +620,62 @@ RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion()
 
     ComPtr<slang::ISession> session;
     slangGlobalSession->createSession(desc, session.writeRef());
-    version->linkage = static_cast<Linkage*>(session.get());
-    version->linkage->contentAssistInfo.checkingMode = ContentAssistCheckingMode::General;
+    sharedLinkage->linkage = static_cast<Linkage*>(session.get());
+    sharedLinkage->linkage->contentAssistInfo.checkingMode = ContentAssistCheckingMode::General;
+
+    version->sharedLinkage = sharedLinkage;
+    version->linkage = sharedLinkage->linkage;
     return version;
 }
 
-SlangResult Workspace::loadFile(const char* path, ISlangBlob** outBlob)
+RefPtr<WorkspaceVersion> Workspace::createVersionForChecking()
 {
-    String canonnicalPath;
-    SLANG_RETURN_ON_FAIL(Path::getCanonical(path, canonnicalPath));
-    RefPtr<DocumentVersion> doc;
-    if (openedDocuments.TryGetValue(canonnicalPath, doc))
+    // Reuse the linkage of the previous version if it was created with the same settings. It is
+    // brought up to date with the documents when the version is checked.
+    if (reusableLinkage && reusableLinkage->isReusable(getSearchPaths()))
     {
-        *outBlob = StringBlob::create(doc->getText()).detach();
-        return SLANG_OK;
+        RefPtr<WorkspaceVersion> version = new WorkspaceVersion();
+        version->workspace = this;
+        _copyDocuments(openedDocuments, version->documents);
+        version->fileVersions = fileVersions;
+        version->sharedLinkage = reusableLinkage;
+        version->linkage = reusableLinkage->linkage;
+        return version;
     }
-    return Slang::OSFileSystem::getExtSingleton()->loadFile(path, outBlob);
+
+    RefPtr<WorkspaceVersion> version = createWorkspaceVersion();
+    reusableLinkage = version->sharedLinkage;
+    return version;
 }
+
 WorkspaceVersion* Workspace::getCurrentVersion()
 {
-    if (!currentVersion)
-        currentVersion = createWorkspaceVersion();
+    checkVersionInBackground();
+    if (pendingVersion)
+    {
+        // Help with checking the pending version, and wait for it to complete
+        versionThreadPool->waitAll();
+        adoptCheckedVersion();
+    }
+    return currentVersion.Ptr();
+}
+WorkspaceVersion* Workspace::getVersionForDocument(const String& path)
+{
+    adoptCheckedVersion();
+    // The current version can't be used whilst a version that shares its linkage is being checked.
+    // Nor can it be used once its linkage can't be reused, as that means something other than the
+    // files it depends on has changed (such as a file being created).
+    if (currentVersion && currentVersion->sharedLinkage == reusableLinkage &&
+        !(pendingVersion && pendingVersion->sharedLinkage == currentVersion->sharedLinkage))
+    {
+        if (currentVersion->isDocumentUpToDate(path, fileVersions))
+            return currentVersion.Ptr();
+    }
+    return getCurrentVersion();
+}
+WorkspaceVersion* Workspace::getLastCheckedVersion()
+{
+    adoptCheckedVersion();
     return currentVersion.Ptr();
 }
 WorkspaceVersion* Workspace::createVersionForCompletion()
@@ -348,15 +685,6 @@ WorkspaceVersion* Workspace::createVersionForCompletion()
         ContentAssistCheckingMode::Completion;
     return currentCompletionVersion.Ptr();
 }
-void* Workspace::getInterface(const Guid& uuid)
-{
-    if (uuid == ISlangUnknown::getTypeGuid() || uuid == ISlangFileSystem::getTypeGuid())
-    {
-        return static_cast<ISlangFileSystem*>(this);
-    }
-    return nullptr;
-}
-
 void DocumentVersion::setText(const String& newText)
 {
     text = newText;
@@ -474,15 +802,30 @@ Module* WorkspaceVersion::getOrLoadModule(String path)
     {
         return module;
     }
-    auto doc = workspace->openedDocuments.TryGetValue(path);
+    auto doc = documents.TryGetValue(path);
     if (!doc)
         return nullptr;
-    ComPtr<ISlangBlob> diagnosticBlob;
+
+    // A document that is unchanged since it was checked with the shared linkage doesn't need
+    // to be checked again.
+    if (auto primaryModule = sharedLinkage->primaryModules.TryGetValue(path))
+    {
+        if (primaryModule->module)
+        {
+            modules[path] = primaryModule->module;
+            documentDependencies[path] = primaryModule->dependencies;
+        }
+        addDiagnostics(primaryModule->diagnostics);
+        return primaryModule->module;
+    }
+
     auto sourceBlob = StringBlob::create((*doc)->getText());
 
     auto moduleName = getMangledNameFromNameString(path.getUnownedSlice());
     linkage->contentAssistInfo.primaryModuleName = linkage->getNamePool()->getName(moduleName);
     linkage->contentAssistInfo.primaryModulePath = path;
+    DocumentDiagnosticListener diagnosticListener(linkage->getSourceManager(), documents);
+    linkage->contentAssistInfo.diagnosticListener = &diagnosticListener;
     // Note: 
     // The module at `path` may have already been loaded into the linkage previously
     // due to an `import`. However that module won't get fully checked in when the checker
@@ -495,22 +838,64 @@ Module* WorkspaceVersion::getOrLoadModule(String path)
         moduleName.getBuffer(),
         path.getBuffer(),
         sourceBlob,
-        diagnosticBlob.writeRef());
+        nullptr);
+    linkage->contentAssistInfo.diagnosticListener = nullptr;
     if (parsedModule)
     {
         modules[path] = static_cast<Module*>(parsedModule);
     }
-    if (diagnosticBlob)
+    WorkspaceLinkage::PrimaryModule primaryModule;
+    primaryModule.module = static_cast<Module*>(parsedModule);
+    if (!primaryModule.module)
+    {
+        // A module that failed to check is still held by the linkage, and is what a later
+        // load returns, so that is the module recorded.
+        RefPtr<LoadedModule> loadedModule;
+        if (linkage->mapNameToLoadedModules.TryGetValue(
+                linkage->getNamePool()->getName(moduleName), loadedModule))
+            primaryModule.module = loadedModule;
+    }
+    if (primaryModule.module)
     {
-        auto diagnosticString = String((const char*)diagnosticBlob->getBufferPointer());
-        parseDiagnostics(diagnosticString);
-        auto docDiagnostic = diagnostics.TryGetValue(path);
-        if (docDiagnostic)
-            docDiagnostic->originalOutput = diagnosticString;
+        // A document is loaded from a string, so it isn't a file path dependency of its own module.
+        primaryModule.dependencies.add(path);
+        sharedLinkage->calcDependencies(primaryModule.module, primaryModule.dependencies);
+        documentDependencies[path] = primaryModule.dependencies;
     }
+    addDiagnostics(diagnosticListener.diagnostics);
+    primaryModule.diagnostics = _Move(diagnosticListener.diagnostics);
+    sharedLinkage->primaryModules[path] = primaryModule;
     return static_cast<Module*>(parsedModule);
 }
 
+void WorkspaceVersion::checkAllDocuments()
+{
+    std::lock_guard<std::mutex> lock(sharedLinkage->mutex);
+
+    sharedLinkage->update(documents, fileVersions);
+    for (auto& pair : documents)
+        getOrLoadModule(pair.Key);
+    sharedLinkage->recordLoadedFiles(fileVersions);
+
+    isChecked = true;
+}
+
+bool WorkspaceVersion::isDocumentUpToDate(
+    const String& path,
+    const Dictionary<String, uint32_t>& workspaceFileVersions)
+{
+    // The dependencies are only known if the document's module was loaded
+    auto dependencies = documentDependencies.TryGetValue(path);
+    if (!dependencies)
+        return false;
+    for (auto& dependencyPath : *dependencies)
+    {
+        if (_getFileVersion(workspaceFileVersions, dependencyPath) != _getFileVersion(fileVersions, dependencyPath))
+            return false;
+    }
+    return true;
+}
+
 MacroDefinitionContentAssistInfo* WorkspaceVersion::tryGetMacroDefinition(UnownedStringSlice name)
 {
     if (macroDefinitions.Count() == 0)
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
 #include "../../slang-com-helper.h"
 #include "../../slang-com-ptr.h"
 #include "../../slang.h"
 #include "../core/slang-basic.h"
 #include "../core/slang-com-object.h"
+#include "../core/slang-thread-pool.h"
 #include "../compiler-core/slang-language-server-protocol.h"
 #include "slang-compiler.h"
 #include "slang-doc-ast.h"
@@ -103,23 +107,131 @@ namespace Slang
     struct DocumentDiagnostics
     {
         OrderedHashSet<LanguageServerProtocol::Diagnostic> messages;
-        String originalOutput;
     };
 
+    // The file system used by the linkage of a workspace version. Opened documents are loaded from a
+    // snapshot, and anything else from the OS file system.
+    class DocumentSnapshotFileSystem
+        : public ISlangFileSystem
+        , public ComObject
+    {
+    public:
+        SLANG_COM_OBJECT_IUNKNOWN_ALL
+        void* getInterface(const Guid& uuid);
+
+        // ISlangFileSystem
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+            loadFile(const char* path, ISlangBlob** outBlob) override;
+
+        Dictionary<String, RefPtr<DocumentVersion>> documents;
+    };
+
+    // A linkage that is shared by successive versions of a workspace, so that the modules that are
+    // unaffected by a change can be reused, rather than parsed and checked again.
+    //
+    // The versions that share a linkage are checked in turn, holding `mutex`. Before a version is
+    // checked, `update` removes the modules that depend on a file that has changed since it was
+    // loaded. Files aren't read to find the changes - the version of each file that was loaded is
+    // compared with the version in the workspace version's snapshot of file versions. Removed
+    // modules are kept alive, as the AST nodes of the linkage may still reference them, so the
+    // workspace starts again with a new linkage once enough modules have been removed.
+    class WorkspaceLinkage : public RefObject
+    {
+    public:
+        // A module loaded for an opened document, and the diagnostics reported by loading it, keyed
+        // by the path of the document they are in.
+        struct PrimaryModule
+        {
+            Module* module = nullptr;
+            Dictionary<String, DocumentDiagnostics> diagnostics;
+            // The canonical paths of the files the module depends on, including the document.
+            List<String> dependencies;
+        };
+
+        RefPtr<Linkage> linkage;
+        ComPtr<DocumentSnapshotFileSystem> fileSystem;
+        List<String> searchPaths;
+        // Keyed by the path of the document.
+        Dictionary<String, PrimaryModule> primaryModules;
+        std::mutex mutex;
+
+        // Make the linkage consistent with `documents`, and the files whose version in `fileVersions`
+        // isn't the version they were loaded at.
+        void update(
+            const Dictionary<String, RefPtr<DocumentVersion>>& documents,
+            const Dictionary<String, uint32_t>& fileVersions);
+        // Record the version in `fileVersions` of the files loaded since the last call.
+        void recordLoadedFiles(const Dictionary<String, uint32_t>& fileVersions);
+
+        // Returns true if the linkage can be reused for a version that uses `inSearchPaths`.
+        bool isReusable(const List<String>& inSearchPaths);
+
+        // Get the canonical paths of the files `module` depends on.
+        void calcDependencies(Module* module, List<String>& outPaths);
+
+    private:
+        struct LoadedFile
+        {
+            uint32_t version = 0;
+            String uniqueIdentity;
+        };
+        String _getCanonicalPath(const String& path);
+
+        // The version of each file the modules in the linkage were loaded from, keyed by canonical path.
+        Dictionary<String, LoadedFile> m_loadedFiles;
+        Index m_recordedSourceFileCount = 0;
+        Dictionary<String, String> m_canonicalPaths;
+        List<RefPtr<Module>> m_removedModules;
+    };
+
+    // A version of the workspace, holding a linkage that is used to check the opened documents.
+    //
+    // A version is created on the server thread, holding a snapshot of the opened documents. It may
+    // then be checked (with `checkAllDocuments`) on a background thread. Only one thread uses a version
+    // at a time - the server thread doesn't access it again until `isChecked` is set, or after a later
+    // version that shares its linkage has been created.
     class WorkspaceVersion : public RefObject
     {
     private:
         Dictionary<String, Module*> modules;
         Dictionary<ModuleDecl*, RefPtr<ASTMarkup>> markupASTs;
         Dictionary<Name*, MacroDefinitionContentAssistInfo*> macroDefinitions;
-        void parseDiagnostics(String compilerOutput);
+        // The canonical paths of the files each checked document depends on, keyed by the document path.
+        Dictionary<String, List<String>> documentDependencies;
+        void addDiagnostics(const Dictionary<String, DocumentDiagnostics>& diagnosticsToAdd);
     public:
+        // Only accessed on the server thread.
         Workspace* workspace;
+        RefPtr<WorkspaceLinkage> sharedLinkage;
         RefPtr<Linkage> linkage;
+        // The opened documents at the time the version was created.
+        Dictionary<String, RefPtr<DocumentVersion>> documents;
+        // The file versions of the workspace at the time the version was created.
+        Dictionary<String, uint32_t> fileVersions;
         Dictionary<String, DocumentDiagnostics> diagnostics;
+
+        // Set when a newer version replaces this one before it has been checked.
+        std::atomic<bool> isSuperseded;
+        // Set when `checkAllDocuments` has completed.
+        std::atomic<bool> isChecked;
+
         ASTMarkup* getOrCreateMarkupAST(ModuleDecl* module);
         Module* getOrLoadModule(String path);
         MacroDefinitionContentAssistInfo* tryGetMacroDefinition(UnownedStringSlice name);
+
+        // Load and check all of the documents, producing their diagnostics.
+        void checkAllDocuments();
+
+        // Returns true if the document at `path`, and each file it depends on, has the same version in
+        // `workspaceFileVersions` as it had when this version was created.
+        bool isDocumentUpToDate(
+            const String& path,
+            const Dictionary<String, uint32_t>& workspaceFileVersions);
+
+        WorkspaceVersion()
+            : isSuperseded(false)
+            , isChecked(false)
+        {}
     };
 
     struct OwnedPreprocessorMacroDefinition
@@ -127,14 +239,29 @@ namespace Slang
         String name;
         String value;
     };
-    class Workspace
-        : public ISlangFileSystem
-        , public ComObject
+    class Workspace : public RefObject
     {
     private:
+        // The latest version that has been checked.
         RefPtr<WorkspaceVersion> currentVersion;
+        // A version of the latest state of the workspace that is being checked in the background.
+        RefPtr<WorkspaceVersion> pendingVersion;
+        // True if the workspace has changed since the latest version was created.
+        bool isVersionOutOfDate = true;
         RefPtr<WorkspaceVersion> currentCompletionVersion;
+        // Has a single worker, that checks pending versions.
+        RefPtr<ThreadPool> versionThreadPool;
+        // The linkage of the latest version, that the next version can reuse.
+        RefPtr<WorkspaceLinkage> reusableLinkage;
+        // The number of times each file has changed, by being opened, edited or closed as a document,
+        // or on disk, keyed by canonical path. A file that hasn't changed isn't held.
+        Dictionary<String, uint32_t> fileVersions;
+        void advanceFileVersion(const String& path);
+        List<String> getSearchPaths();
         RefPtr<WorkspaceVersion> createWorkspaceVersion();
+        RefPtr<WorkspaceVersion> createVersionForChecking();
+        void invalidateAll();
+        void adoptCheckedVersion();
     public:
         List<String> rootDirectories;
         List<String> additionalSearchPaths;
@@ -150,6 +277,13 @@ namespace Slang
 
         void closeDoc(const String& path);
 
+        // Record that the file at `path` has changed on disk. Changes to a file that is opened as a
+        // document are ignored until it is closed.
+        void changeFile(const String& path);
+        // Record that a file has been created at `path`. Any module may have failed to find it before,
+        // so a new linkage is used for the next version.
+        void addFile(const String& path);
+
         // Update predefined macro settings. Returns true if the new settings are different from existing ones.
         bool updatePredefinedMacros(List<String> predefinedMacros);
         bool updateSearchPaths(List<String> searchPaths);
@@ -157,14 +291,23 @@ namespace Slang
 
         void init(List<URI> rootDirURI, slang::IGlobalSession* globalSession);
         void invalidate();
+
+        // Start checking a version of the latest state of the workspace in the background, if there
+        // isn't one already.
+        void checkVersionInBackground();
+        bool hasPendingVersion() { return pendingVersion != nullptr; }
+
+        // Get a checked version of the latest state of the workspace, waiting for it if necessary.
         WorkspaceVersion* getCurrentVersion();
+        // Get a version that is good enough to answer a request about the document at `path`. That is
+        // the latest checked version if neither the document or an opened document it depends on has
+        // changed since, otherwise the current version.
+        WorkspaceVersion* getVersionForDocument(const String& path);
+        // Get the latest checked version without waiting. Can return nullptr.
+        WorkspaceVersion* getLastCheckedVersion();
+
         WorkspaceVersion* getCurrentCompletionVersion() { return currentCompletionVersion.Ptr(); }
         WorkspaceVersion* createVersionForCompletion();
-    public:
-        // Inherited via ISlangFileSystem
-        SLANG_COM_OBJECT_IUNKNOWN_ALL
-        void* getInterface(const Guid& uuid);
-        virtual SLANG_NO_THROW SlangResult SLANG_MCALL
-            loadFile(const char* path, ISlangBlob** outBlob) override;
+        ~Workspace();
     };
 } // namespace LanguageServerProtocol
@@ -14,6 +14,7 @@
 #include "slang-module-library.h"
 
 #include "slang-check.h"
+#include "slang-lookup.h"
 #include "slang-parameter-binding.h"
 #include "slang-lower-to-ir.h"
 #include "slang-mangle.h"
@@ -36,6 +37,8 @@
 #include "slang-serialize-ast.h"
 #include "slang-serialize-ir.h"
 #include "slang-serialize-container.h"
+#include "slang-precompiled-module.h"
+#include "slang-compile-cache.h"
 
 #include "slang-doc-ast.h"
 #include "slang-doc-markdown-writer.h"
@@ -249,11 +252,64 @@ void Session::addBuiltins(
     char const*     sourcePath,
     char const*     sourceString)
 {
+    // The builtin state may already be frozen, in which case nodes can only be created in builtin ASTBuilders
+    // with the frozen mutex held
+    std::lock_guard<OwnedRecursiveMutex> lock(m_sharedASTBuilder->getFrozenMutex());
+
     // TODO(tfoley): Add ability to directly new builtins to the appropriate scope
     addBuiltinSource(
         coreLanguageScope,
         sourcePath,
         sourceString);
+
+    _freezeBuiltinState();
+}
+
+static void _freezeMemberDictionariesRec(ContainerDecl* containerDecl)
+{
+    buildMemberDictionary(containerDecl);
+    containerDecl->isMemberDictionaryFrozen = true;
+
+    for (auto member : containerDecl->members)
+    {
+        if (auto childContainerDecl = as<ContainerDecl>(member))
+        {
+            _freezeMemberDictionariesRec(childContainerDecl);
+        }
+    }
+}
+
+void Session::_freezeBuiltinState()
+{
+    // After this point the builtin state is only read by sessions, which may be on different threads.
+    // Any state that is otherwise lazily created on first use must therefore be created here.
+
+    List<ASTBuilder*> builtinASTBuilders;
+    builtinASTBuilders.add(m_builtinLinkage->getASTBuilder());
+    builtinASTBuilders.add(globalAstBuilder);
+
+    // Lookup builds the member dictionary of a container on demand
+    _freezeMemberDictionariesRec(baseModuleDecl);
+    for (auto module : stdlibModules)
+    {
+        if (auto moduleDecl = module->getModuleDecl())
+        {
+            _freezeMemberDictionariesRec(moduleDecl);
+        }
+        if (builtinASTBuilders.indexOf(module->getASTBuilder()) < 0)
+        {
+            builtinASTBuilders.add(module->getASTBuilder());
+        }
+    }
+
+    // Getting the line for a location in builtin code calculates the line breaks of the file on demand
+    for (auto sourceFile : builtinSourceManager.getSourceFiles())
+    {
+        sourceFile->getLineBreakOffsets();
+    }
+
+    // New nodes can only be created in the builtin ASTBuilders with the frozen mutex held
+    m_sharedASTBuilder->freeze(builtinASTBuilders);
 }
 
 void Session::setSharedLibraryLoader(ISlangSharedLibraryLoader* loader)
@@ -297,6 +353,8 @@ SlangResult Session::compileStdLib(slang::CompileStdLibFlags compileFlags)
     addBuiltinSource(hlslLanguageScope, "hlsl", getHLSLLibraryCode());
     addBuiltinSource(autodiffLanguageScope, "diff", getAutodiffLibraryCode());
 
+    _freezeBuiltinState();
+
     if (compileFlags & slang::CompileStdLibFlag::WriteDocumentation)
     {
         // Not 100% clear where best to get the ASTBuilder from, but from the linkage shouldn't
@@ -305,6 +363,9 @@ SlangResult Session::compileStdLib(slang::CompileStdLibFlags compileFlags)
         ASTBuilder* astBuilder = getBuiltinLinkage()->getASTBuilder();
         SourceManager* sourceManager = getBuiltinSourceManager();
 
+        // Writing may create nodes in the (now frozen) builtin ASTBuilder
+        std::lock_guard<OwnedRecursiveMutex> lock(m_sharedASTBuilder->getFrozenMutex());
+
         DiagnosticSink sink(sourceManager, Lexer::sourceLocationLexer);
 
         List<String> docStrings;
@@ -355,6 +416,8 @@ SlangResult Session::loadStdLib(const void* stdLib, size_t stdLibSizeInBytes)
     SLANG_RETURN_ON_FAIL(_readBuiltinModule(fileSystem, coreLanguageScope, "core"));
     SLANG_RETURN_ON_FAIL(_readBuiltinModule(fileSystem, hlslLanguageScope, "hlsl"));
     SLANG_RETURN_ON_FAIL(_readBuiltinModule(fileSystem, autodiffLanguageScope, "diff"));
+
+    _freezeBuiltinState();
     return SLANG_OK;
 }
 
@@ -442,6 +505,10 @@ SlangResult Session::_readBuiltinModule(ISlangFileSystem* fileSystem, Scope* sco
     // Hmm - don't have a suitable sink yet, so attempt to just not have one
     options.sink = nullptr;
 
+    // Most compilations only use a small part of the builtin modules, so only read the IR
+    // when it's first needed
+    options.deferIRModules = true;
+
     SLANG_RETURN_ON_FAIL(SerialContainerUtil::read(&riffContainer, options, containerData));
 
     for (auto& srcModule : containerData.modules)
@@ -460,9 +527,17 @@ SlangResult Session::_readBuiltinModule(ISlangFileSystem* fileSystem, Scope* sco
             }
             
             module->setModuleDecl(moduleDecl);
+            module->setExportSymbols(srcModule.exportMangledNames, srcModule.exportSymbols);
         }
 
-        module->setIRModule(srcModule.irModule);
+        if (srcModule.deferredIRModule)
+        {
+            module->setDeferredIRModule(srcModule.deferredIRModule);
+        }
+        else
+        {
+            module->setIRModule(srcModule.irModule);
+        }
 
         // Put in the loaded module map
         linkage->mapNameToLoadedModules.Add(sessionNamePool->getName(moduleName), module);
@@ -590,6 +665,19 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Session::createSession(
     {
         linkage->setFileSystem(desc.fileSystem);
     }
+
+    // The cache directory was added after the other fields, so check it is in the structure that was passed in
+    if (desc.structureSize >= SLANG_OFFSET_OF(slang::SessionDesc, cacheDirectory) + sizeof(desc.cacheDirectory) &&
+        desc.cacheDirectory)
+    {
+        linkage->m_cacheDirectory = desc.cacheDirectory;
+    }
+
+    if (desc.structureSize >= SLANG_OFFSET_OF(slang::SessionDesc, specializationCacheBudget) + sizeof(desc.specializationCacheBudget))
+    {
+        linkage->m_specializationCache.setBudget(desc.specializationCacheBudget);
+    }
+
     *outSession = asExternal(linkage.detach());
     return SLANG_OK;
 }
@@ -932,6 +1020,9 @@ ISlangUnknown* Linkage::getInterface(const Guid& guid)
 
 Linkage::~Linkage()
 {
+    // Cached component types can depend on other state of the linkage, so release them first
+    m_specializationCache.clear();
+
     destroyTypeCheckingCache();
 }
 
@@ -991,6 +1082,7 @@ SLANG_NO_THROW slang::IModule* SLANG_MCALL Linkage::loadModule(
     if (isInLanguageServer())
     {
         sink.setFlags(DiagnosticSink::Flag::HumaneLoc | DiagnosticSink::Flag::LanguageServer);
+        sink.setListener(contentAssistInfo.diagnosticListener);
     }
 
     try
@@ -1020,6 +1112,7 @@ SLANG_NO_THROW slang::IModule* SLANG_MCALL Linkage::loadModuleFromSource(
     if (isInLanguageServer())
     {
         sink.setFlags(DiagnosticSink::Flag::HumaneLoc | DiagnosticSink::Flag::LanguageServer);
+        sink.setListener(contentAssistInfo.diagnosticListener);
     }
 
     try
@@ -1301,6 +1394,15 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::createCompileRequest(
     return SLANG_OK;
 }
 
+SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::getSpecializationCacheStats(
+    slang::SpecializationCacheStats* outStats)
+{
+    if (!outStats)
+        return SLANG_E_INVALID_ARG;
+    m_specializationCache.getStats(*outStats);
+    return SLANG_OK;
+}
+
 SlangResult Linkage::addSearchPath(
     char const* path)
 {
@@ -1492,6 +1594,15 @@ void TranslationUnitRequest::addSourceFile(SourceFile* sourceFile)
     {
         getModule()->addFilePathDependency(pathInfo.foundPath);
     }
+
+    // The content is recorded too, such that a module can be identified in a cache key
+    // even when its source wasn't from a file.
+    {
+        StringBuilder digest;
+        digest << pathInfo.foundPath << " ";
+        CompileCacheUtil::appendContentHash(sourceFile->getContent(), digest);
+        getModule()->addSourceContentDigest(digest);
+    }
 }
 
 EndToEndCompileRequest::~EndToEndCompileRequest()
@@ -2009,13 +2120,17 @@ void FrontEndCompileRequest::parseTranslationUnit(
 
     for (auto sourceFile : translationUnit->getSourceFiles())
     {
-        auto tokens = preprocessSource(
-            sourceFile,
-            getSink(),
-            &includeSystem,
-            combinedPreprocessorDefinitions,
-            getLinkage(),
-            &preprocessorHandler);
+        TokenList tokens;
+        {
+            SLANG_PERFORMANCE_PHASE("preprocess");
+            tokens = preprocessSource(
+                sourceFile,
+                getSink(),
+                &includeSystem,
+                combinedPreprocessorDefinitions,
+                getLinkage(),
+                &preprocessorHandler);
+        }
 
         if (outputIncludes)
         {
@@ -2032,12 +2147,15 @@ void FrontEndCompileRequest::parseTranslationUnit(
             return;
         }
 
-        parseSourceFile(
-            astBuilder,
-            translationUnit,
-            tokens,
-            getSink(),
-            languageScope);
+        {
+            SLANG_PERFORMANCE_PHASE("parse");
+            parseSourceFile(
+                astBuilder,
+                translationUnit,
+                tokens,
+                getSink(),
+                languageScope);
+        }
 
         // Let's try dumping
 
@@ -2478,7 +2596,11 @@ SlangResult EndToEndCompileRequest::executeActionsInner()
 // Act as expected of the API-based compiler
 SlangResult EndToEndCompileRequest::executeActions()
 {
-    SlangResult res = executeActionsInner();
+    SlangResult res;
+    {
+        SLANG_PERFORMANCE_PHASE("compile");
+        res = executeActionsInner();
+    }
 
     m_diagnosticOutput = getSink()->outputBuffer.ProduceString();
     return res;
@@ -2855,6 +2977,12 @@ RefPtr<Module> Linkage::findOrImportModule(
     if (mapPathToLoadedModule.TryGetValue(filePathInfo.getMostUniqueIdentity(), loadedModule))
         return loadedModule;
 
+    // If there is a valid precompiled module we can skip parsing and checking
+    if (RefPtr<Module> precompiledModule = _findPrecompiledModule(name, filePathInfo, sink))
+    {
+        return precompiledModule;
+    }
+
     // Try to load it
     ComPtr<ISlangBlob> fileContents;
     if(SLANG_FAILED(includeSystem.loadFile(filePathInfo, fileContents)))
@@ -2866,13 +2994,68 @@ RefPtr<Module> Linkage::findOrImportModule(
 
     // We've found a file that we can load for the given module, so
     // go ahead and perform the module-load action
-    return loadModule(
+    RefPtr<Module> module = loadModule(
         name,
         filePathInfo,
         fileContents,
         loc,
         sink,
         loadedModules);
+
+    // Store the module in the cache, so later imports can use it. Failing to write doesn't
+    // fail the import.
+    if (module && m_cacheDirectory.getLength() && !isInLanguageServer())
+    {
+        Path::createDirectory(m_cacheDirectory);
+        PrecompiledModuleUtil::write(this, module, PrecompiledModuleUtil::getCachePath(m_cacheDirectory, name, filePathInfo.getMostUniqueIdentity()));
+    }
+
+    return module;
+}
+
+RefPtr<Module> Linkage::_findPrecompiledModule(
+    Name*               name,
+    const PathInfo&     filePathInfo,
+    DiagnosticSink*     sink)
+{
+    // The language server needs the source to be parsed
+    if (isInLanguageServer() || !filePathInfo.hasFoundPath())
+    {
+        return nullptr;
+    }
+
+    // A module next to the source is loaded through the linkage file system, whereas
+    // the cache is always on the OS file system.
+    struct Candidate
+    {
+        ISlangFileSystem* fileSystem;
+        String path;
+    };
+    List<Candidate> candidates;
+    candidates.add(Candidate{ getFileSystemExt(), PrecompiledModuleUtil::getPathForSource(filePathInfo.foundPath) });
+    if (m_cacheDirectory.getLength())
+    {
+        candidates.add(Candidate{ OSFileSystem::getExtSingleton(), PrecompiledModuleUtil::getCachePath(m_cacheDirectory, name, filePathInfo.getMostUniqueIdentity()) });
+    }
+
+    for (const auto& candidate : candidates)
+    {
+        ComPtr<ISlangBlob> blob;
+        if (SLANG_FAILED(candidate.fileSystem->loadFile(candidate.path.getBuffer(), blob.writeRef())))
+        {
+            continue;
+        }
+
+        RefPtr<Module> module;
+        if (SLANG_SUCCEEDED(PrecompiledModuleUtil::read(this, name, blob, sink, module)))
+        {
+            mapPathToLoadedModule.Add(filePathInfo.getMostUniqueIdentity(), module);
+            mapNameToLoadedModules.Add(name, module);
+            loadedModulesList.add(module);
+            return module;
+        }
+    }
+    return nullptr;
 }
 
 //
@@ -2974,11 +3157,45 @@ void Module::addFilePathDependency(String const& path)
     m_filePathDependencyList.addDependency(path);
 }
 
+Module::~Module()
+{
+}
+
 void Module::setModuleDecl(ModuleDecl* moduleDecl)
 {
     m_moduleDecl = moduleDecl;
 }
 
+void Module::setDeferredIRModule(IRSerialDeferredModule* deferredIRModule)
+{
+    m_deferredIRModule = deferredIRModule;
+    m_hasDeferredIRModule.store(deferredIRModule != nullptr, std::memory_order_release);
+}
+
+void Module::_readDeferredIRModule()
+{
+    // A builtin module can be shared between threads, so the IR is read with the lock held
+    std::lock_guard<OwnedRecursiveMutex> lock(getASTBuilder()->getSharedASTBuilder()->getFrozenMutex());
+
+    // Another thread may have read it whilst we were waiting
+    if (!m_hasDeferredIRModule.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    RefPtr<IRModule> irModule;
+    if (SLANG_FAILED(m_deferredIRModule->read(irModule)))
+    {
+        // The serialized data was validated when it was loaded, so this shouldn't happen
+        SLANG_UNEXPECTED("Unable to read deferred IR module");
+    }
+
+    m_irModule = irModule;
+    m_deferredIRModule.setNull();
+
+    m_hasDeferredIRModule.store(false, std::memory_order_release);
+}
+
 RefPtr<EntryPoint> Module::findEntryPointByName(UnownedStringSlice const& name)
 {
     // TODO: We should consider having this function be expanded to be able
@@ -3065,25 +3282,70 @@ void Module::_processFindDeclsExportSymbolsRec(Decl* decl)
     }
 }
 
-NodeBase* Module::findExportFromMangledName(const UnownedStringSlice& slice)
+void Module::_ensureExportSymbols()
 {
-    // Will be non zero if has been previously attempted
-    if (m_mangledExportSymbols.getCount() == 0)
+    if (!m_hasExportSymbols)
     {
         // Build up the exported mangled name list
         _processFindDeclsExportSymbolsRec(getModuleDecl());
+        m_hasExportSymbols = true;
+    }
+}
 
-        // If nothing found, mark that we have tried looking by making m_mangledExportSymbols.getCount() != 0
-        if (m_mangledExportSymbols.getCount() == 0)
-        {
-            m_mangledExportSymbols.add(nullptr);
-        }        
+NodeBase* Module::findExportFromMangledName(const UnownedStringSlice& slice)
+{
+    // A builtin module can be shared between threads, so its symbols must be found with the lock held
+    std::unique_lock<OwnedRecursiveMutex> lock;
+    if (getASTBuilder()->isFrozen())
+    {
+        lock = std::unique_lock<OwnedRecursiveMutex>(getASTBuilder()->getSharedASTBuilder()->getFrozenMutex());
     }
 
+    _ensureExportSymbols();
+
     const Index index = m_mangledExportPool.findIndex(slice);
     return (index >= 0) ? m_mangledExportSymbols[index] : nullptr;
 }
 
+void Module::getExportSymbols(List<UnownedStringSlice>& outMangledNames, List<NodeBase*>& outSymbols)
+{
+    std::unique_lock<OwnedRecursiveMutex> lock;
+    if (getASTBuilder()->isFrozen())
+    {
+        lock = std::unique_lock<OwnedRecursiveMutex>(getASTBuilder()->getSharedASTBuilder()->getFrozenMutex());
+    }
+
+    _ensureExportSymbols();
+
+    // The pool is Style::Empty, so the pool index is the same as the symbol index
+    SLANG_ASSERT(m_mangledExportPool.getSlicesCount() == m_mangledExportSymbols.getCount());
+
+    outMangledNames.addRange(m_mangledExportPool.getSlices());
+    outSymbols.addRange(m_mangledExportSymbols);
+}
+
+void Module::setExportSymbols(const List<String>& mangledNames, const List<NodeBase*>& symbols)
+{
+    SLANG_ASSERT(mangledNames.getCount() == symbols.getCount());
+
+    // If there are no symbols they weren't serialized, so they will be found when first needed
+    if (symbols.getCount() == 0)
+    {
+        return;
+    }
+
+    for (Index i = 0; i < mangledNames.getCount(); ++i)
+    {
+        Index index = Index(m_mangledExportPool.add(mangledNames[i]));
+        // As in _processFindDeclsExportSymbolsRec the first symbol with a name is used
+        if (index == m_mangledExportSymbols.getCount())
+        {
+            m_mangledExportSymbols.add(symbols[i]);
+        }
+    }
+    m_hasExportSymbols = true;
+}
+
 // ComponentType
 
 ComponentType::ComponentType(Linkage* linkage)
@@ -3200,6 +3462,23 @@ RefPtr<ComponentType> ComponentType::specialize(
         return this;
     }
 
+    // If the same specialization has been performed before, the result can be reused
+    auto& cache = getLinkage()->m_specializationCache;
+    List<Val*> cacheArgs;
+    if (cache.isEnabled())
+    {
+        for (Index i = 0; i < specializationArgCount; ++i)
+        {
+            cacheArgs.add(inSpecializationArgs[i].val);
+        }
+        if (auto cached = cache.find(SpecializationCache::Kind::Specialize, this, cacheArgs.getBuffer(), cacheArgs.getCount()))
+        {
+            return cached;
+        }
+    }
+
+    const int startErrorCount = sink->getErrorCount();
+
     List<SpecializationArg> specializationArgs;
     specializationArgs.addRange(
         inSpecializationArgs,
@@ -3215,11 +3494,19 @@ RefPtr<ComponentType> ComponentType::specialize(
         specializationArgCount,
         sink);
 
-    return new SpecializedComponentType(
+    RefPtr<ComponentType> specialized = new SpecializedComponentType(
         this,
         specializationInfo,
         specializationArgs,
         sink);
+
+    // Only successful specializations are cached, so that errors are reported each time
+    if (cache.isEnabled() && sink->getErrorCount() == startErrorCount)
+    {
+        cache.add(SpecializationCache::Kind::Specialize, this, cacheArgs.getBuffer(), cacheArgs.getCount(), specialized);
+    }
+
+    return specialized;
 }
 
 SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::specialize(
@@ -3274,6 +3561,23 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::specialize(
     return SLANG_OK;
 }
 
+SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointCacheKey(
+    SlangInt        entryPointIndex,
+    SlangInt        targetIndex,
+    slang::IBlob**  outKey)
+{
+    auto linkage = getLinkage();
+    if(targetIndex < 0 || targetIndex >= linkage->targets.getCount())
+        return SLANG_E_INVALID_ARG;
+    auto target = linkage->targets[targetIndex];
+
+    String key;
+    SLANG_RETURN_ON_FAIL(CompileCacheUtil::calcEntryPointKey(this, entryPointIndex, target, key));
+
+    *outKey = StringUtil::createStringBlob(key).detach();
+    return SLANG_OK;
+}
+
 SLANG_NO_THROW SlangResult SLANG_MCALL
     ComponentType::renameEntryPoint(const char* newName, IComponentType** outEntryPoint)
 {
@@ -3296,9 +3600,16 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::link(
     //
     SLANG_UNUSED(outDiagnostics);
 
-    auto linked = fillRequirements(this);
-    if(!linked)
-        return SLANG_FAIL;
+    auto& cache = getLinkage()->m_specializationCache;
+    RefPtr<ComponentType> linked = cache.find(SpecializationCache::Kind::Link, this, nullptr, 0);
+    if (!linked)
+    {
+        linked = fillRequirements(this);
+        if(!linked)
+            return SLANG_FAIL;
+
+        cache.add(SpecializationCache::Kind::Link, this, nullptr, 0, linked);
+    }
 
     *outLinkedComponentType = ComPtr<slang::IComponentType>(linked).detach();
     return SLANG_OK;
@@ -3985,6 +4296,16 @@ void SpecializedComponentType::acceptVisitor(ComponentTypeVisitor* visitor, Spec
     visitor->visitSpecialized(this);
 }
 
+size_t SpecializedComponentType::calcApproximateMemoryUsage()
+{
+    size_t size = sizeof(*this) + ComponentType::calcApproximateMemoryUsage();
+    if (m_irModule)
+    {
+        size += m_irModule->getMemoryArena().calcTotalMemoryUsed();
+    }
+    return size;
+}
+
 Index SpecializedComponentType::getRequirementCount()
 {
     return m_requirements.getCount();
@@ -4041,6 +4362,16 @@ void ComponentTypeVisitor::visitChildren(SpecializedComponentType* specialized)
     specialized->getBaseComponentType()->acceptVisitor(this, specialized->getSpecializationInfo());
 }
 
+size_t ComponentType::calcApproximateMemoryUsage()
+{
+    size_t size = 0;
+    for (const auto& pair : m_targetPrograms)
+    {
+        size += pair.Value->calcApproximateMemoryUsage();
+    }
+    return size;
+}
+
 TargetProgram* ComponentType::getTargetProgram(TargetRequest* target)
 {
     RefPtr<TargetProgram> targetProgram;
@@ -4065,6 +4396,31 @@ TargetProgram::TargetProgram(
     m_entryPointResults.setCount(componentType->getEntryPointCount());
 }
 
+static size_t _calcApproximateMemoryUsage(const CompileResult& result)
+{
+    size_t size = size_t(result.outputString.getLength());
+    if (result.blob)
+    {
+        size += result.blob->getBufferSize();
+    }
+    return size;
+}
+
+size_t TargetProgram::calcApproximateMemoryUsage()
+{
+    size_t size = sizeof(*this);
+    if (m_irModuleForLayout)
+    {
+        size += m_irModuleForLayout->getMemoryArena().calcTotalMemoryUsed();
+    }
+    size += _calcApproximateMemoryUsage(m_wholeProgramResult);
+    for (const auto& result : m_entryPointResults)
+    {
+        size += _calcApproximateMemoryUsage(result);
+    }
+    return size;
+}
+
 //
 
 
@@ -4386,6 +4742,44 @@ void EndToEndCompileRequest::setDiagnosticFlags(SlangDiagnosticFlags flags)
     getSink()->setFlags(sinkFlags);
 }
 
+void EndToEndCompileRequest::setReportPerformance(bool enable)
+{
+    m_reportPerformance = enable;
+}
+
+static SlangResult _writePerformanceReport(PerformanceReport* report, SlangPerformanceReportFormat format, StringBuilder& out)
+{
+    switch (format)
+    {
+        case SLANG_PERFORMANCE_REPORT_FORMAT_TEXT:  report->writeText(out); return SLANG_OK;
+        case SLANG_PERFORMANCE_REPORT_FORMAT_JSON:  report->writeJSON(out); return SLANG_OK;
+        default: return SLANG_E_INVALID_ARG;
+    }
+}
+
+SlangResult EndToEndCompileRequest::getPerformanceReport(SlangPerformanceReportFormat format, ISlangBlob** outBlob)
+{
+    if (!m_performanceReport)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    StringBuilder buf;
+    SLANG_RETURN_ON_FAIL(_writePerformanceReport(m_performanceReport, format, buf));
+
+    *outBlob = StringUtil::createStringBlob(buf).detach();
+    return SLANG_OK;
+}
+
+SlangResult EndToEndCompileRequest::getPerformanceCounter(const char* name, int64_t* outValue)
+{
+    if (!m_performanceReport)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+    return m_performanceReport->findCounterValue(UnownedStringSlice(name), *outValue);
+}
+
 SlangResult EndToEndCompileRequest::addTargetCapability(SlangInt targetIndex, SlangCapabilityID capability)
 {
     auto& targets = getLinkage()->targets;
@@ -4633,6 +5027,11 @@ SlangResult EndToEndCompileRequest::EndToEndCompileRequest::compile()
 {
     SlangResult res = SLANG_FAIL;
 
+    // Collect the performance report whilst the request is executed. Any report from a previous
+    // compile is replaced. IR pass timings are collected in the report too.
+    m_performanceReport = (m_reportPerformance || m_reportIRPassTimings) ? new PerformanceReport : nullptr;
+    PerformanceReport::ThreadScope performanceReportScope(m_performanceReport);
+
 #if !defined(SLANG_DEBUG_INTERNAL_ERROR)
     // By default we'd like to catch as many internal errors as possible,
     // and report them to the user nicely (rather than just crash their
@@ -4680,6 +5079,22 @@ SlangResult EndToEndCompileRequest::EndToEndCompileRequest::compile()
     }
 #endif
 
+    // When compiling from the command line, the report is output after the compilation
+    if (m_isCommandLineCompile && m_performanceReport)
+    {
+        StringBuilder buf;
+        if (!m_reportPerformance)
+        {
+            // Only the IR pass timings were requested
+            m_performanceReport->writeIRPassesText(buf);
+            getWriter(WriterChannel::StdError)->write(buf.getBuffer(), buf.getLength());
+        }
+        else if (SLANG_SUCCEEDED(_writePerformanceReport(m_performanceReport, m_performanceReportFormat, buf)))
+        {
+            getWriter(WriterChannel::StdError)->write(buf.getBuffer(), buf.getLength());
+        }
+    }
+
     // Repro dump handling
     {
         if (m_dumpRepro.getLength())
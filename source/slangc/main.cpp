@@ -5,6 +5,7 @@
 SLANG_API void spSetCommandLineCompilerMode(SlangCompileRequest* request);
 
 #include "../core/slang-io.h"
+#include "../core/slang-string-util.h"
 #include "../core/slang-test-tool-util.h"
 
 using namespace Slang;
@@ -66,6 +67,156 @@ static SlangResult _compile(SlangCompileRequest* compileRequest, int argc, const
     return res;
 }
 
+struct PermutationLine
+{
+    String outputPath;
+    List<String> args;
+    List<String> typeArgs;
+};
+
+static void _splitOnWhitespace(const UnownedStringSlice& line, List<String>& outTokens)
+{
+    const char* cur = line.begin();
+    const char* end = line.end();
+    while (cur < end)
+    {
+        while (cur < end && (*cur == ' ' || *cur == '\t'))
+        {
+            cur++;
+        }
+        const char* start = cur;
+        while (cur < end && !(*cur == ' ' || *cur == '\t'))
+        {
+            cur++;
+        }
+        if (cur > start)
+        {
+            outTokens.add(UnownedStringSlice(start, cur));
+        }
+    }
+}
+
+// Each line of a permutations file is an output path, followed by the arguments for the permutation.
+// A `-specialize <type>` argument sets the type for the next global existential type parameter.
+static SlangResult _readPermutations(const String& path, List<PermutationLine>& outLines)
+{
+    String contents;
+    if (SLANG_FAILED(File::readAllText(path, contents)))
+    {
+        StdWriters::getError().print("error: unable to read permutations file '%s'\n", path.getBuffer());
+        return SLANG_FAIL;
+    }
+
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(contents.getUnownedSlice(), lines);
+
+    for (const auto& line : lines)
+    {
+        List<String> tokens;
+        _splitOnWhitespace(line, tokens);
+        if (tokens.getCount() == 0 || tokens[0].startsWith("#"))
+        {
+            continue;
+        }
+
+        PermutationLine permutationLine;
+        permutationLine.outputPath = tokens[0];
+        for (Index i = 1; i < tokens.getCount(); ++i)
+        {
+            if (tokens[i] == "-specialize" && i + 1 < tokens.getCount())
+            {
+                permutationLine.typeArgs.add(tokens[++i]);
+            }
+            else
+            {
+                permutationLine.args.add(tokens[i]);
+            }
+        }
+        outLines.add(permutationLine);
+    }
+    return SLANG_OK;
+}
+
+static SlangResult _compilePermutations(SlangSession* session, const List<const char*>& baseArgs, const String& permutationsPath, const String& mapPath)
+{
+    List<PermutationLine> lines;
+    SLANG_RETURN_ON_FAIL(_readPermutations(permutationsPath, lines));
+
+    const Index count = lines.getCount();
+
+    List<List<const char*>> argBuffers;
+    List<List<const char*>> typeArgBuffers;
+    argBuffers.setCount(count);
+    typeArgBuffers.setCount(count);
+
+    List<SlangPermutationDesc> descs;
+    for (Index i = 0; i < count; ++i)
+    {
+        for (const auto& arg : lines[i].args)
+        {
+            argBuffers[i].add(arg.getBuffer());
+        }
+        for (const auto& typeArg : lines[i].typeArgs)
+        {
+            typeArgBuffers[i].add(typeArg.getBuffer());
+        }
+
+        SlangPermutationDesc desc;
+        desc.args = argBuffers[i].getBuffer();
+        desc.argCount = int(argBuffers[i].getCount());
+        desc.typeArgs = typeArgBuffers[i].getBuffer();
+        desc.typeArgCount = int(typeArgBuffers[i].getCount());
+        descs.add(desc);
+    }
+
+    List<int> artifactIndices;
+    List<ComPtr<ISlangBlob>> artifacts;
+    artifactIndices.setCount(count);
+    artifacts.setCount(count);
+
+    int artifactCount = 0;
+    ComPtr<ISlangBlob> diagnostics;
+    const SlangResult compileRes = spCompilePermutations(session,
+        baseArgs.getBuffer(), int(baseArgs.getCount()),
+        descs.getBuffer(), int(count),
+        artifactIndices.getBuffer(), (ISlangBlob**)artifacts.getBuffer(), &artifactCount,
+        diagnostics.writeRef());
+
+    if (diagnostics)
+    {
+        _diagnosticCallback((const char*)diagnostics->getBufferPointer(), nullptr);
+    }
+
+    SlangResult res = SLANG_FAILED(compileRes) ? SLANG_E_INTERNAL_FAIL : SLANG_OK;
+
+    StringBuilder map;
+    for (Index i = 0; i < count; ++i)
+    {
+        const int artifactIndex = artifactIndices[i];
+        map << i << " " << lines[i].outputPath << " " << artifactIndex << "\n";
+
+        if (artifactIndex < 0)
+        {
+            continue;
+        }
+
+        ISlangBlob* artifact = artifacts[artifactIndex];
+        if (SLANG_FAILED(File::writeAllBytes(lines[i].outputPath, artifact->getBufferPointer(), artifact->getBufferSize())))
+        {
+            StdWriters::getError().print("error: unable to write '%s'\n", lines[i].outputPath.getBuffer());
+            res = SLANG_FAIL;
+        }
+    }
+
+    if (mapPath.getLength() && SLANG_FAILED(File::writeAllText(mapPath, map)))
+    {
+        StdWriters::getError().print("error: unable to write '%s'\n", mapPath.getBuffer());
+        res = SLANG_FAIL;
+    }
+
+    return res;
+}
+
 SLANG_TEST_TOOL_API SlangResult innerMain(StdWriters* stdWriters, slang::IGlobalSession* sharedSession, int argc, const char*const* argv)
 {
     StdWriters::setSingleton(stdWriters);
@@ -88,6 +239,34 @@ SLANG_TEST_TOOL_API SlangResult innerMain(StdWriters* stdWriters, slang::IGlobal
         TestToolUtil::setSessionDefaultPreludeFromExePath(argv[0], session);
     }
 
+    // If a permutations file is given, the other arguments are the base arguments for each permutation
+    {
+        String permutationsPath;
+        String mapPath;
+        List<const char*> baseArgs;
+        for (int i = 1; i < argc; ++i)
+        {
+            const UnownedStringSlice arg(argv[i]);
+            if (arg == "-permutations" && i + 1 < argc)
+            {
+                permutationsPath = argv[++i];
+            }
+            else if (arg == "-permutation-map" && i + 1 < argc)
+            {
+                mapPath = argv[++i];
+            }
+            else
+            {
+                baseArgs.add(argv[i]);
+            }
+        }
+
+        if (permutationsPath.getLength())
+        {
+            return _compilePermutations(session, baseArgs, permutationsPath, mapPath);
+        }
+    }
+
     SlangCompileRequest* compileRequest = spCreateCompileRequest(session);
     SlangResult res = _compile(compileRequest, argc, argv);
     // Now that we are done, clean up after ourselves
@@ -0,0 +1,234 @@
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "slang-gfx.h"
+#include "gfx-test-util.h"
+#include "tools/gfx-util/shader-cursor.h"
+#include "source/core/slang-basic.h"
+#include "source/core/slang-riff-file-system.h"
+
+#include <condition_variable>
+#include <mutex>
+
+using namespace gfx;
+
+namespace gfx_test
+{
+    // An in memory file system for the persistent shader cache, where saving a kernel blocks until it's unblocked.
+    // Used to hold a pipeline build on a background thread at a known point.
+    class BlockingShaderCacheFileSystem : public Slang::RiffFileSystem
+    {
+    public:
+        typedef Slang::RiffFileSystem Super;
+
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL saveFile(const char* path, const void* data, size_t size) SLANG_OVERRIDE
+        {
+            if (Slang::UnownedStringSlice(path).endsWith(".gfx-kernel"))
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_isBlocked = true;
+                m_condition.notify_all();
+                m_condition.wait(lock, [this]() { return m_isUnblocked; });
+                m_isBlocked = false;
+            }
+            return Super::saveFile(path, data, size);
+        }
+
+            /// Wait until a kernel is being saved
+        void waitUntilBlocked()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_isBlocked; });
+        }
+            /// Let kernels be saved
+        void unblock()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isUnblocked = true;
+            m_condition.notify_all();
+        }
+
+        BlockingShaderCacheFileSystem() : Super(nullptr) {}
+
+    protected:
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        bool m_isBlocked = false;
+        bool m_isUnblocked = false;
+    };
+
+    static Slang::ComPtr<IDevice> _createBackgroundSpecializationDevice(
+        UnitTestContext* context,
+        ISlangFileSystem* shaderCacheFileSystem = nullptr)
+    {
+        Slang::ComPtr<IDevice> device;
+        IDevice::Desc deviceDesc = {};
+        deviceDesc.deviceType = DeviceType::CPU;
+        deviceDesc.slang.slangGlobalSession = context->slangGlobalSession;
+        const char* searchPaths[] = { "", "../../tools/gfx-unit-test", "tools/gfx-unit-test" };
+        deviceDesc.slang.searchPathCount = (SlangInt)SLANG_COUNT_OF(searchPaths);
+        deviceDesc.slang.searchPaths = searchPaths;
+        deviceDesc.pipelineSpecializationMode = PipelineSpecializationMode::Background;
+        deviceDesc.pipelineSpecializationThreadCount = 2;
+        deviceDesc.shaderCacheFileSystem = shaderCacheFileSystem;
+
+        if (SLANG_FAILED(gfxCreateDevice(&deviceDesc, device.writeRef())))
+        {
+            return nullptr;
+        }
+        return device;
+    }
+
+    SLANG_UNIT_TEST(asyncPipelineSpecializationCPU)
+    {
+        if ((Slang::RenderApiFlag::CPU & unitTestContext->enabledApis) == 0)
+        {
+            SLANG_IGNORE_TEST
+        }
+
+        auto device = _createBackgroundSpecializationDevice(unitTestContext);
+        if (!device)
+        {
+            SLANG_IGNORE_TEST
+        }
+
+        Slang::ComPtr<ITransientResourceHeap> transientHeap;
+        ITransientResourceHeap::Desc transientHeapDesc = {};
+        transientHeapDesc.constantBufferSize = 4096;
+        GFX_CHECK_CALL_ABORT(
+            device->createTransientResourceHeap(transientHeapDesc, transientHeap.writeRef()));
+
+        ComPtr<IShaderProgram> shaderProgram;
+        slang::ProgramLayout* slangReflection;
+        GFX_CHECK_CALL_ABORT(loadComputeProgram(device, shaderProgram, "compute-smoke", "computeMain", slangReflection));
+
+        ComputePipelineStateDesc pipelineDesc = {};
+        pipelineDesc.program = shaderProgram.get();
+        ComPtr<gfx::IPipelineState> pipelineState;
+        GFX_CHECK_CALL_ABORT(
+            device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+
+        slang::TypeReflection* addTransformerType = slangReflection->findTypeByName("AddTransformer");
+
+        // Build the specialization for `AddTransformer` ahead of the dispatch that uses it
+        {
+            auto arg = slang::SpecializationArg::fromType(addTransformerType);
+            ComPtr<IPipelineSpecializationTask> task;
+            GFX_CHECK_CALL_ABORT(device->prewarmSpecializedPipeline(pipelineState, &arg, 1, task.writeRef()));
+            SLANG_CHECK_ABORT(task);
+            GFX_CHECK_CALL_ABORT(task->wait());
+            SLANG_CHECK(task->isComplete());
+
+            // Asking again finds the pipeline that has been built
+            ComPtr<IPipelineSpecializationTask> secondTask;
+            GFX_CHECK_CALL_ABORT(device->prewarmSpecializedPipeline(pipelineState, &arg, 1, secondTask.writeRef()));
+            SLANG_CHECK(secondTask->isComplete());
+        }
+
+        const int numberCount = 4;
+        float initialData[] = { 0.0f, 1.0f, 2.0f, 3.0f };
+        IBufferResource::Desc bufferDesc = {};
+        bufferDesc.sizeInBytes = numberCount * sizeof(float);
+        bufferDesc.format = gfx::Format::Unknown;
+        bufferDesc.elementSize = sizeof(float);
+        bufferDesc.allowedStates = ResourceStateSet(
+            ResourceState::ShaderResource,
+            ResourceState::UnorderedAccess,
+            ResourceState::CopyDestination,
+            ResourceState::CopySource);
+        bufferDesc.defaultState = ResourceState::UnorderedAccess;
+        bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+        ComPtr<IBufferResource> numbersBuffer;
+        GFX_CHECK_CALL_ABORT(device->createBufferResource(
+            bufferDesc,
+            (void*)initialData,
+            numbersBuffer.writeRef()));
+
+        ComPtr<IResourceView> bufferView;
+        IResourceView::Desc viewDesc = {};
+        viewDesc.type = IResourceView::Type::UnorderedAccess;
+        viewDesc.format = Format::Unknown;
+        GFX_CHECK_CALL_ABORT(
+            device->createBufferView(numbersBuffer, nullptr, viewDesc, bufferView.writeRef()));
+
+        // The dispatch uses the prewarmed pipeline, so it is not skipped
+        {
+            ICommandQueue::Desc queueDesc = { ICommandQueue::QueueType::Graphics };
+            auto queue = device->createCommandQueue(queueDesc);
+
+            auto commandBuffer = transientHeap->createCommandBuffer();
+            auto encoder = commandBuffer->encodeComputeCommands();
+
+            auto rootObject = encoder->bindPipeline(pipelineState);
+
+            ComPtr<IShaderObject> transformer;
+            GFX_CHECK_CALL_ABORT(device->createShaderObject(
+                addTransformerType, ShaderObjectContainerType::None, transformer.writeRef()));
+            float c = 1.0f;
+            ShaderCursor(transformer).getPath("c").setData(&c, sizeof(float));
+
+            ShaderCursor entryPointCursor(rootObject->getEntryPoint(0));
+            entryPointCursor.getPath("buffer").setResource(bufferView);
+            entryPointCursor.getPath("transformer").setObject(transformer);
+
+            encoder->dispatchCompute(1, 1, 1);
+            encoder->endEncoding();
+            commandBuffer->close();
+            queue->executeCommandBuffer(commandBuffer);
+            queue->waitOnHost();
+        }
+
+        compareComputeResult(
+            device,
+            numbersBuffer,
+            Slang::makeArray<float>(11.0f, 12.0f, 13.0f, 14.0f));
+    }
+
+    // The device can be used while a pipeline is built in the background, such as to create shader objects,
+    // rather than waiting for the build to finish.
+    SLANG_UNIT_TEST(asyncPipelineSpecializationPendingBuildCPU)
+    {
+        if ((Slang::RenderApiFlag::CPU & unitTestContext->enabledApis) == 0)
+        {
+            SLANG_IGNORE_TEST
+        }
+
+        Slang::RefPtr<BlockingShaderCacheFileSystem> fileSystem = new BlockingShaderCacheFileSystem();
+        auto device = _createBackgroundSpecializationDevice(unitTestContext, fileSystem);
+        if (!device)
+        {
+            SLANG_IGNORE_TEST
+        }
+
+        ComPtr<IShaderProgram> shaderProgram;
+        slang::ProgramLayout* slangReflection;
+        GFX_CHECK_CALL_ABORT(loadComputeProgram(device, shaderProgram, "compute-smoke", "computeMain", slangReflection));
+
+        ComputePipelineStateDesc pipelineDesc = {};
+        pipelineDesc.program = shaderProgram.get();
+        ComPtr<gfx::IPipelineState> pipelineState;
+        GFX_CHECK_CALL_ABORT(
+            device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+
+        slang::TypeReflection* addTransformerType = slangReflection->findTypeByName("AddTransformer");
+
+        auto arg = slang::SpecializationArg::fromType(addTransformerType);
+        ComPtr<IPipelineSpecializationTask> task;
+        GFX_CHECK_CALL_ABORT(device->prewarmSpecializedPipeline(pipelineState, &arg, 1, task.writeRef()));
+        SLANG_CHECK_ABORT(task);
+
+        // The build is held once its kernel has been compiled
+        fileSystem->waitUntilBlocked();
+        SLANG_CHECK(!task->isComplete());
+
+        ComPtr<IShaderObject> transformer;
+        SlangResult createResult = device->createShaderObject(
+            addTransformerType, ShaderObjectContainerType::None, transformer.writeRef());
+        SLANG_CHECK(SLANG_SUCCEEDED(createResult) && transformer);
+        SLANG_CHECK(!task->isComplete());
+
+        fileSystem->unblock();
+        GFX_CHECK_CALL_ABORT(task->wait());
+        SLANG_CHECK(task->isComplete());
+    }
+}
@@ -0,0 +1,171 @@
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "slang-gfx.h"
+#include "gfx-test-util.h"
+#include "tools/gfx-util/shader-cursor.h"
+#include "source/core/slang-basic.h"
+#include "source/core/slang-process.h"
+#include "source/core/slang-thread-pool.h"
+
+using namespace gfx;
+
+namespace gfx_test
+{
+    // Runs the same dispatch on CPU devices configured with different worker thread counts, checks
+    // that the results are identical to what is computed on the host, and reports the time taken
+    // for each configuration.
+
+    static const int kGroupSize = 64;
+    static const int kGroupCount = 1024;
+
+    static Slang::ComPtr<IDevice> _createCPUDevice(UnitTestContext* context, GfxCount workerThreadCount)
+    {
+        Slang::ComPtr<IDevice> device;
+        IDevice::Desc deviceDesc = {};
+        deviceDesc.deviceType = DeviceType::CPU;
+        deviceDesc.slang.slangGlobalSession = context->slangGlobalSession;
+        const char* searchPaths[] = { "", "../../tools/gfx-unit-test", "tools/gfx-unit-test" };
+        deviceDesc.slang.searchPathCount = (SlangInt)SLANG_COUNT_OF(searchPaths);
+        deviceDesc.slang.searchPaths = searchPaths;
+
+        CPUDeviceExtendedDesc extDesc = {};
+        extDesc.workerThreadCount = workerThreadCount;
+
+        deviceDesc.extendedDescCount = 1;
+        void* extDescPtr = &extDesc;
+        deviceDesc.extendedDescs = &extDescPtr;
+
+        if (SLANG_FAILED(gfxCreateDevice(&deviceDesc, device.writeRef())))
+        {
+            return nullptr;
+        }
+        return device;
+    }
+
+    static double _runDispatch(IDevice* device, UnitTestContext* context)
+    {
+        SLANG_UNUSED(context);
+
+        Slang::ComPtr<ITransientResourceHeap> transientHeap;
+        ITransientResourceHeap::Desc transientHeapDesc = {};
+        transientHeapDesc.constantBufferSize = 4096;
+        GFX_CHECK_CALL_ABORT(
+            device->createTransientResourceHeap(transientHeapDesc, transientHeap.writeRef()));
+
+        ComPtr<IShaderProgram> shaderProgram;
+        slang::ProgramLayout* slangReflection;
+        GFX_CHECK_CALL_ABORT(loadComputeProgram(device, shaderProgram, "cpu-dispatch-scaling", "computeMain", slangReflection));
+
+        ComputePipelineStateDesc pipelineDesc = {};
+        pipelineDesc.program = shaderProgram.get();
+        ComPtr<gfx::IPipelineState> pipelineState;
+        GFX_CHECK_CALL_ABORT(
+            device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+
+        const int numberCount = kGroupSize * kGroupCount;
+        IBufferResource::Desc bufferDesc = {};
+        bufferDesc.sizeInBytes = numberCount * sizeof(uint32_t);
+        bufferDesc.format = gfx::Format::Unknown;
+        bufferDesc.elementSize = sizeof(uint32_t);
+        bufferDesc.allowedStates = ResourceStateSet(
+            ResourceState::ShaderResource,
+            ResourceState::UnorderedAccess,
+            ResourceState::CopyDestination,
+            ResourceState::CopySource);
+        bufferDesc.defaultState = ResourceState::UnorderedAccess;
+        bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+        ComPtr<IBufferResource> numbersBuffer;
+        GFX_CHECK_CALL_ABORT(device->createBufferResource(
+            bufferDesc,
+            nullptr,
+            numbersBuffer.writeRef()));
+
+        ComPtr<IResourceView> bufferView;
+        IResourceView::Desc viewDesc = {};
+        viewDesc.type = IResourceView::Type::UnorderedAccess;
+        viewDesc.format = Format::Unknown;
+        GFX_CHECK_CALL_ABORT(
+            device->createBufferView(numbersBuffer, nullptr, viewDesc, bufferView.writeRef()));
+
+        ICommandQueue::Desc queueDesc = { ICommandQueue::QueueType::Graphics };
+        auto queue = device->createCommandQueue(queueDesc);
+
+        // Do a dispatch first such that the kernel compilation is not included in the timing
+        double elapsedTime = 0.0;
+        for (Slang::Index i = 0; i < 2; ++i)
+        {
+            auto commandBuffer = transientHeap->createCommandBuffer();
+            auto encoder = commandBuffer->encodeComputeCommands();
+
+            auto rootObject = encoder->bindPipeline(pipelineState);
+            ShaderCursor entryPointCursor(rootObject->getEntryPoint(0));
+            entryPointCursor.getPath("buffer").setResource(bufferView);
+
+            const auto startTick = Slang::Process::getClockTick();
+
+            encoder->dispatchCompute(kGroupCount, 1, 1);
+            encoder->endEncoding();
+            commandBuffer->close();
+            queue->executeCommandBuffer(commandBuffer);
+            queue->waitOnHost();
+
+            elapsedTime = double(Slang::Process::getClockTick() - startTick) / Slang::Process::getClockFrequency();
+        }
+
+        Slang::List<uint32_t> expectedResult;
+        expectedResult.setCount(numberCount);
+        for (int i = 0; i < numberCount; ++i)
+        {
+            uint32_t value = uint32_t(i);
+            for (int j = 0; j < 4096; ++j)
+            {
+                value = value * 1664525u + 1013904223u;
+            }
+            expectedResult[i] = value;
+        }
+        compareComputeResult(device, numbersBuffer, 0, expectedResult.getBuffer(), numberCount * sizeof(uint32_t));
+
+        return elapsedTime;
+    }
+
+    SLANG_UNIT_TEST(cpuDispatchScaling)
+    {
+        if ((Slang::RenderApiFlag::CPU & unitTestContext->enabledApis) == 0)
+        {
+            SLANG_IGNORE_TEST
+        }
+
+        Slang::List<GfxCount> workerThreadCounts;
+        workerThreadCounts.add(0);
+        for (GfxCount count = 1; count <= GfxCount(Slang::ThreadPool::getHardwareWorkerCount()); count *= 2)
+        {
+            workerThreadCounts.add(count);
+        }
+
+        double singleThreadTime = 0.0;
+        for (auto workerThreadCount : workerThreadCounts)
+        {
+            auto device = _createCPUDevice(unitTestContext, workerThreadCount);
+            if (!device)
+            {
+                SLANG_IGNORE_TEST
+            }
+
+            const double time = _runDispatch(device, unitTestContext);
+            if (workerThreadCount == 0)
+            {
+                singleThreadTime = time;
+            }
+
+            Slang::StringBuilder buf;
+            buf << "cpuDispatchScaling: workers " << workerThreadCount << " time " << time * 1000.0 << "ms";
+            if (time > 0.0)
+            {
+                buf << " speedup " << singleThreadTime / time;
+            }
+            buf << "\n";
+            getTestReporter()->message(TestMessageType::Info, buf.getBuffer());
+        }
+    }
+}
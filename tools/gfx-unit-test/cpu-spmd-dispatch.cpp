@@ -0,0 +1,173 @@
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "slang-gfx.h"
+#include "gfx-test-util.h"
+#include "tools/gfx-util/shader-cursor.h"
+#include "source/core/slang-basic.h"
+#include "source/core/slang-process.h"
+
+using namespace gfx;
+
+namespace gfx_test
+{
+    // Runs the same dispatch on CPU devices with and without SPMD code generation (-emit-cpp-spmd),
+    // checks that the results are identical to what is computed on the host, and reports the time
+    // taken for each. The dispatches are run on a single thread, so the speedup is that of executing
+    // the threads of a group as SIMD lanes.
+
+    static const int kGroupSize = 64;
+    static const int kGroupCount = 16384;
+
+    static Slang::ComPtr<IDevice> _createCPUDevice(UnitTestContext* context, SlangTargetFlags targetFlags)
+    {
+        Slang::ComPtr<IDevice> device;
+        IDevice::Desc deviceDesc = {};
+        deviceDesc.deviceType = DeviceType::CPU;
+        deviceDesc.slang.slangGlobalSession = context->slangGlobalSession;
+        const char* searchPaths[] = { "", "../../tools/gfx-unit-test", "tools/gfx-unit-test" };
+        deviceDesc.slang.searchPathCount = (SlangInt)SLANG_COUNT_OF(searchPaths);
+        deviceDesc.slang.searchPaths = searchPaths;
+        // With SPMD code generation the kernel is also compiled for the host CPU at -O2 (see docs/cpu-target.md)
+        deviceDesc.slang.targetFlags = targetFlags;
+
+        CPUDeviceExtendedDesc extDesc = {};
+        extDesc.workerThreadCount = 0;
+
+        deviceDesc.extendedDescCount = 1;
+        void* extDescPtr = &extDesc;
+        deviceDesc.extendedDescs = &extDescPtr;
+
+        if (SLANG_FAILED(gfxCreateDevice(&deviceDesc, device.writeRef())))
+        {
+            return nullptr;
+        }
+        return device;
+    }
+
+    static uint32_t _calcExpectedValue(uint32_t value)
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            value = (value ^ 61u) ^ (value >> 16);
+            value = value * 9u;
+            value = value ^ (value >> 4);
+            value = value * 0x27d4eb2du;
+            value = value ^ (value >> 15);
+            value = (value & 1u) ? (value * 3u + 1u) : (value >> 1);
+        }
+        return value;
+    }
+
+    static double _runDispatch(IDevice* device, UnitTestContext* context)
+    {
+        SLANG_UNUSED(context);
+
+        Slang::ComPtr<ITransientResourceHeap> transientHeap;
+        ITransientResourceHeap::Desc transientHeapDesc = {};
+        transientHeapDesc.constantBufferSize = 4096;
+        GFX_CHECK_CALL_ABORT(
+            device->createTransientResourceHeap(transientHeapDesc, transientHeap.writeRef()));
+
+        ComPtr<IShaderProgram> shaderProgram;
+        slang::ProgramLayout* slangReflection;
+        GFX_CHECK_CALL_ABORT(loadComputeProgram(device, shaderProgram, "cpu-spmd-dispatch", "computeMain", slangReflection));
+
+        ComputePipelineStateDesc pipelineDesc = {};
+        pipelineDesc.program = shaderProgram.get();
+        ComPtr<gfx::IPipelineState> pipelineState;
+        GFX_CHECK_CALL_ABORT(
+            device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+
+        const int numberCount = kGroupSize * kGroupCount;
+        IBufferResource::Desc bufferDesc = {};
+        bufferDesc.sizeInBytes = numberCount * sizeof(uint32_t);
+        bufferDesc.format = gfx::Format::Unknown;
+        bufferDesc.elementSize = sizeof(uint32_t);
+        bufferDesc.allowedStates = ResourceStateSet(
+            ResourceState::ShaderResource,
+            ResourceState::UnorderedAccess,
+            ResourceState::CopyDestination,
+            ResourceState::CopySource);
+        bufferDesc.defaultState = ResourceState::UnorderedAccess;
+        bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+        ComPtr<IBufferResource> numbersBuffer;
+        GFX_CHECK_CALL_ABORT(device->createBufferResource(
+            bufferDesc,
+            nullptr,
+            numbersBuffer.writeRef()));
+
+        ComPtr<IResourceView> bufferView;
+        IResourceView::Desc viewDesc = {};
+        viewDesc.type = IResourceView::Type::UnorderedAccess;
+        viewDesc.format = Format::Unknown;
+        GFX_CHECK_CALL_ABORT(
+            device->createBufferView(numbersBuffer, nullptr, viewDesc, bufferView.writeRef()));
+
+        ICommandQueue::Desc queueDesc = { ICommandQueue::QueueType::Graphics };
+        auto queue = device->createCommandQueue(queueDesc);
+
+        // The first dispatch compiles the kernel, so the fastest of the later dispatches is reported
+        double elapsedTime = 0.0;
+        for (Slang::Index i = 0; i < 4; ++i)
+        {
+            auto commandBuffer = transientHeap->createCommandBuffer();
+            auto encoder = commandBuffer->encodeComputeCommands();
+
+            auto rootObject = encoder->bindPipeline(pipelineState);
+            ShaderCursor entryPointCursor(rootObject->getEntryPoint(0));
+            entryPointCursor.getPath("buffer").setResource(bufferView);
+
+            const auto startTick = Slang::Process::getClockTick();
+
+            encoder->dispatchCompute(kGroupCount, 1, 1);
+            encoder->endEncoding();
+            commandBuffer->close();
+            queue->executeCommandBuffer(commandBuffer);
+            queue->waitOnHost();
+
+            const double time = double(Slang::Process::getClockTick() - startTick) / Slang::Process::getClockFrequency();
+            if (i == 1 || (i > 1 && time < elapsedTime))
+            {
+                elapsedTime = time;
+            }
+        }
+
+        Slang::List<uint32_t> expectedResult;
+        expectedResult.setCount(numberCount);
+        for (int i = 0; i < numberCount; ++i)
+        {
+            expectedResult[i] = _calcExpectedValue(uint32_t(i));
+        }
+        compareComputeResult(device, numbersBuffer, 0, expectedResult.getBuffer(), numberCount * sizeof(uint32_t));
+
+        return elapsedTime;
+    }
+
+    SLANG_UNIT_TEST(cpuSPMDDispatch)
+    {
+        if ((Slang::RenderApiFlag::CPU & unitTestContext->enabledApis) == 0)
+        {
+            SLANG_IGNORE_TEST
+        }
+
+        auto scalarDevice = _createCPUDevice(unitTestContext, 0);
+        auto spmdDevice = _createCPUDevice(unitTestContext, SLANG_TARGET_FLAG_GENERATE_SPMD);
+        if (!scalarDevice || !spmdDevice)
+        {
+            SLANG_IGNORE_TEST
+        }
+
+        const double scalarTime = _runDispatch(scalarDevice, unitTestContext);
+        const double spmdTime = _runDispatch(spmdDevice, unitTestContext);
+
+        Slang::StringBuilder buf;
+        buf << "cpuSPMDDispatch: scalar " << scalarTime * 1000.0 << "ms spmd " << spmdTime * 1000.0 << "ms";
+        if (spmdTime > 0.0)
+        {
+            buf << " speedup " << scalarTime / spmdTime;
+        }
+        buf << "\n";
+        getTestReporter()->message(TestMessageType::Info, buf.getBuffer());
+    }
+}
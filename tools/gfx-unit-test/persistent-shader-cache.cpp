@@ -0,0 +1,209 @@
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "slang-gfx.h"
+#include "gfx-test-util.h"
+#include "tools/gfx-util/shader-cursor.h"
+#include "source/core/slang-basic.h"
+#include "source/core/slang-riff-file-system.h"
+
+using namespace gfx;
+
+namespace gfx_test
+{
+    // An in memory file system for the persistent shader cache, that records the kernel entries saved to it.
+    class ShaderCacheFileSystem : public Slang::RiffFileSystem
+    {
+    public:
+        typedef Slang::RiffFileSystem Super;
+
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL saveFile(const char* path, const void* data, size_t size) SLANG_OVERRIDE
+        {
+            if (Slang::UnownedStringSlice(path).endsWith(".gfx-kernel"))
+            {
+                savedEntryPaths.add(path);
+            }
+            return Super::saveFile(path, data, size);
+        }
+
+        bool hasFile(const Slang::String& path)
+        {
+            ComPtr<ISlangBlob> blob;
+            return SLANG_SUCCEEDED(loadFile(path.getBuffer(), blob.writeRef()));
+        }
+
+        size_t getFileSize(const Slang::String& path)
+        {
+            ComPtr<ISlangBlob> blob;
+            return SLANG_SUCCEEDED(loadFile(path.getBuffer(), blob.writeRef())) ? blob->getBufferSize() : 0;
+        }
+
+        // Change the last byte of a file, without recording it as saved
+        void corruptFile(const Slang::String& path)
+        {
+            ComPtr<ISlangBlob> blob;
+            if (SLANG_SUCCEEDED(loadFile(path.getBuffer(), blob.writeRef())) && blob->getBufferSize() > 0)
+            {
+                Slang::List<uint8_t> contents;
+                contents.addRange((const uint8_t*)blob->getBufferPointer(), Slang::Index(blob->getBufferSize()));
+                contents.getLast() ^= 0xff;
+                Super::saveFile(path.getBuffer(), contents.getBuffer(), size_t(contents.getCount()));
+            }
+        }
+
+        ShaderCacheFileSystem() : Super(nullptr) {}
+
+        Slang::List<Slang::String> savedEntryPaths;
+    };
+
+    static Slang::ComPtr<IDevice> _createCPUDevice(UnitTestContext* context, ISlangFileSystem* shaderCacheFileSystem, Size maxShaderCacheSize)
+    {
+        Slang::ComPtr<IDevice> device;
+        IDevice::Desc deviceDesc = {};
+        deviceDesc.deviceType = DeviceType::CPU;
+        deviceDesc.slang.slangGlobalSession = context->slangGlobalSession;
+        const char* searchPaths[] = { "", "../../tools/gfx-unit-test", "tools/gfx-unit-test" };
+        deviceDesc.slang.searchPathCount = (SlangInt)SLANG_COUNT_OF(searchPaths);
+        deviceDesc.slang.searchPaths = searchPaths;
+        deviceDesc.shaderCacheFileSystem = shaderCacheFileSystem;
+        deviceDesc.maxShaderCacheSize = maxShaderCacheSize;
+
+        if (SLANG_FAILED(gfxCreateDevice(&deviceDesc, device.writeRef())))
+        {
+            return nullptr;
+        }
+        return device;
+    }
+
+    // Runs the compute smoke test shader, specialized with the transformer type
+    static void _runTransformer(IDevice* device, const char* transformerTypeName, float c, const float expectedResult[4])
+    {
+        Slang::ComPtr<ITransientResourceHeap> transientHeap;
+        ITransientResourceHeap::Desc transientHeapDesc = {};
+        transientHeapDesc.constantBufferSize = 4096;
+        GFX_CHECK_CALL_ABORT(
+            device->createTransientResourceHeap(transientHeapDesc, transientHeap.writeRef()));
+
+        ComPtr<IShaderProgram> shaderProgram;
+        slang::ProgramLayout* slangReflection;
+        GFX_CHECK_CALL_ABORT(loadComputeProgram(device, shaderProgram, "compute-smoke", "computeMain", slangReflection));
+
+        ComputePipelineStateDesc pipelineDesc = {};
+        pipelineDesc.program = shaderProgram.get();
+        ComPtr<gfx::IPipelineState> pipelineState;
+        GFX_CHECK_CALL_ABORT(
+            device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+
+        const int numberCount = 4;
+        float initialData[] = { 0.0f, 1.0f, 2.0f, 3.0f };
+        IBufferResource::Desc bufferDesc = {};
+        bufferDesc.sizeInBytes = numberCount * sizeof(float);
+        bufferDesc.format = gfx::Format::Unknown;
+        bufferDesc.elementSize = sizeof(float);
+        bufferDesc.allowedStates = ResourceStateSet(
+            ResourceState::ShaderResource,
+            ResourceState::UnorderedAccess,
+            ResourceState::CopyDestination,
+            ResourceState::CopySource);
+        bufferDesc.defaultState = ResourceState::UnorderedAccess;
+        bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+        ComPtr<IBufferResource> numbersBuffer;
+        GFX_CHECK_CALL_ABORT(device->createBufferResource(
+            bufferDesc,
+            (void*)initialData,
+            numbersBuffer.writeRef()));
+
+        ComPtr<IResourceView> bufferView;
+        IResourceView::Desc viewDesc = {};
+        viewDesc.type = IResourceView::Type::UnorderedAccess;
+        viewDesc.format = Format::Unknown;
+        GFX_CHECK_CALL_ABORT(
+            device->createBufferView(numbersBuffer, nullptr, viewDesc, bufferView.writeRef()));
+
+        {
+            ICommandQueue::Desc queueDesc = { ICommandQueue::QueueType::Graphics };
+            auto queue = device->createCommandQueue(queueDesc);
+
+            auto commandBuffer = transientHeap->createCommandBuffer();
+            auto encoder = commandBuffer->encodeComputeCommands();
+
+            auto rootObject = encoder->bindPipeline(pipelineState);
+
+            ComPtr<IShaderObject> transformer;
+            GFX_CHECK_CALL_ABORT(device->createShaderObject(
+                slangReflection->findTypeByName(transformerTypeName), ShaderObjectContainerType::None, transformer.writeRef()));
+            ShaderCursor(transformer).getPath("c").setData(&c, sizeof(float));
+
+            ShaderCursor entryPointCursor(rootObject->getEntryPoint(0));
+            entryPointCursor.getPath("buffer").setResource(bufferView);
+            entryPointCursor.getPath("transformer").setObject(transformer);
+
+            encoder->dispatchCompute(1, 1, 1);
+            encoder->endEncoding();
+            commandBuffer->close();
+            queue->executeCommandBuffer(commandBuffer);
+            queue->waitOnHost();
+        }
+
+        compareComputeResult(
+            device,
+            numbersBuffer,
+            Slang::makeArray<float>(expectedResult[0], expectedResult[1], expectedResult[2], expectedResult[3]));
+    }
+
+    SLANG_UNIT_TEST(persistentShaderCacheCPU)
+    {
+        if ((Slang::RenderApiFlag::CPU & unitTestContext->enabledApis) == 0)
+        {
+            SLANG_IGNORE_TEST
+        }
+
+        Slang::RefPtr<ShaderCacheFileSystem> fileSystem = new ShaderCacheFileSystem;
+
+        const float addResult[] = { 11.0f, 12.0f, 13.0f, 14.0f };
+        const float mulResult[] = { 0.0f, 2.0f, 4.0f, 6.0f };
+
+        // The kernel specialized for `AddTransformer` is compiled, and saved to the cache
+        {
+            auto device = _createCPUDevice(unitTestContext, fileSystem, 0);
+            if (!device)
+            {
+                SLANG_IGNORE_TEST
+            }
+            _runTransformer(device, "AddTransformer", 1.0f, addResult);
+            SLANG_CHECK_ABORT(fileSystem->savedEntryPaths.getCount() == 1);
+        }
+
+        const Slang::String addEntryPath = fileSystem->savedEntryPaths[0];
+        const size_t addEntrySize = fileSystem->getFileSize(addEntryPath);
+        SLANG_CHECK_ABORT(addEntrySize > 0);
+
+        // Another device with the same cache loads the kernel rather than compiling it
+        {
+            auto device = _createCPUDevice(unitTestContext, fileSystem, 0);
+            _runTransformer(device, "AddTransformer", 1.0f, addResult);
+            SLANG_CHECK(fileSystem->savedEntryPaths.getCount() == 1);
+        }
+
+        // A corrupted kernel isn't loaded, but compiled and saved again
+        {
+            fileSystem->corruptFile(addEntryPath);
+            auto device = _createCPUDevice(unitTestContext, fileSystem, 0);
+            _runTransformer(device, "AddTransformer", 1.0f, addResult);
+            SLANG_CHECK_ABORT(fileSystem->savedEntryPaths.getCount() == 2);
+            SLANG_CHECK(fileSystem->savedEntryPaths[1] == addEntryPath);
+            SLANG_CHECK(fileSystem->getFileSize(addEntryPath) == addEntrySize);
+        }
+
+        // A different specialization is another entry. The cache can only hold one entry of this size,
+        // so the least recently used entry is removed.
+        {
+            auto device = _createCPUDevice(unitTestContext, fileSystem, addEntrySize + addEntrySize / 2);
+            _runTransformer(device, "MulTransformer", 2.0f, mulResult);
+            SLANG_CHECK_ABORT(fileSystem->savedEntryPaths.getCount() == 3);
+            SLANG_CHECK(fileSystem->savedEntryPaths[2] != addEntryPath);
+            SLANG_CHECK(fileSystem->hasFile(fileSystem->savedEntryPaths[2]));
+            SLANG_CHECK(!fileSystem->hasFile(addEntryPath));
+        }
+    }
+}
@@ -11,6 +11,9 @@
 #include "cpu-shader-program.h"
 #include "cpu-texture.h"
 
+#include "core/slang-io.h"
+#include "core/slang-shared-library.h"
+
 namespace gfx
 {
 using namespace Slang;
@@ -19,8 +22,10 @@ namespace cpu
 {
     DeviceImpl::~DeviceImpl()
     {
+        finishPipelineSpecialization();
         m_currentPipeline = nullptr;
         m_currentRootObject = nullptr;
+        m_threadPool = nullptr;
     }
 
     SLANG_NO_THROW Result SLANG_MCALL DeviceImpl::initialize(const Desc& desc)
@@ -33,6 +38,31 @@ namespace cpu
 
         SLANG_RETURN_ON_FAIL(RendererBase::initialize(desc));
 
+        // Find extended desc.
+        for (GfxIndex i = 0; i < desc.extendedDescCount; i++)
+        {
+            StructType stype;
+            memcpy(&stype, desc.extendedDescs[i], sizeof(stype));
+            if (stype == StructType::CPUExtendedDesc)
+            {
+                memcpy(&m_extendedDesc, desc.extendedDescs[i], sizeof(m_extendedDesc));
+            }
+        }
+
+        // A worker count of 0 means everything is executed on the calling thread,
+        // so there is no need for a pool.
+        {
+            Index workerThreadCount = m_extendedDesc.workerThreadCount;
+            if (workerThreadCount < 0)
+            {
+                workerThreadCount = ThreadPool::getHardwareWorkerCount();
+            }
+            if (workerThreadCount > 0)
+            {
+                m_threadPool = new ThreadPool(workerThreadCount);
+            }
+        }
+
         // Initialize DeviceInfo
         {
             m_info.deviceType = DeviceType::CPU;
@@ -152,6 +182,8 @@ namespace cpu
         IShaderProgram** outProgram,
         ISlangBlob** outDiagnosticBlob)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_slangMutex);
+
         RefPtr<ShaderProgramImpl> cpuProgram = new ShaderProgramImpl();
         cpuProgram->init(desc);
         auto slangGlobalScope = cpuProgram->linkedProgram;
@@ -231,6 +263,95 @@ namespace cpu
         m_currentRootObject = static_cast<RootShaderObjectImpl*>(object);
     }
 
+    static Result _loadSharedLibrary(ISlangBlob* binary, ISlangSharedLibrary** outSharedLibrary)
+    {
+        // A shared library can only be loaded from a file, so the binary is written to a
+        // temporary file that is removed when the library is released.
+        RefPtr<TemporaryFileSet> temporaryFiles = new TemporaryFileSet;
+
+        String path;
+        SLANG_RETURN_ON_FAIL(File::generateTemporary(UnownedStringSlice::fromLiteral("gfx-cpu-kernel"), path));
+        temporaryFiles->add(path);
+
+        SLANG_RETURN_ON_FAIL(File::writeAllBytes(path, binary->getBufferPointer(), binary->getBufferSize()));
+
+        SharedLibrary::Handle handle;
+        SLANG_RETURN_ON_FAIL(SharedLibrary::loadWithPlatformPath(path.getBuffer(), handle));
+
+        auto temporarySharedLibrary = new TemporarySharedLibrary(handle, path);
+        ComPtr<ISlangSharedLibrary> sharedLibrary(temporarySharedLibrary);
+        temporarySharedLibrary->m_temporaryFileSet = temporaryFiles;
+
+        *outSharedLibrary = sharedLibrary.detach();
+        return SLANG_OK;
+    }
+
+    Result DeviceImpl::_getEntryPointHostCallable(
+        ShaderProgramImpl* program,
+        GfxIndex entryPointIndex,
+        GfxIndex targetIndex,
+        ISlangSharedLibrary** outSharedLibrary,
+        ISlangBlob** outDiagnostics)
+    {
+        // The kernel may be loaded on a thread building specialized pipelines in the background
+        std::lock_guard<std::mutex> lock(program->sharedLibrariesMutex);
+
+        ComPtr<ISlangSharedLibrary> sharedLibrary;
+        if (!program->sharedLibraries.TryGetValue(entryPointIndex, sharedLibrary))
+        {
+            ComPtr<ISlangBlob> diagnostics;
+            if (shaderCache.persistentCache)
+            {
+                // The code for a host callable target is the binary of the shared library. Some downstream
+                // compilers (such as LLVM) don't produce a binary, in which case the library comes from Slang.
+                ComPtr<ISlangBlob> binary;
+                if (SLANG_FAILED(getEntryPointCode(
+                        program->slangGlobalScope, entryPointIndex, targetIndex, binary.writeRef(), diagnostics.writeRef())) ||
+                    SLANG_FAILED(_loadSharedLibrary(binary, sharedLibrary.writeRef())))
+                {
+                    sharedLibrary = nullptr;
+                    diagnostics = nullptr;
+                }
+            }
+            if (!sharedLibrary)
+            {
+                std::lock_guard<std::recursive_mutex> slangLock(m_slangMutex);
+                auto result = program->slangGlobalScope->getEntryPointHostCallable(
+                    entryPointIndex, targetIndex, sharedLibrary.writeRef(), diagnostics.writeRef());
+                if (SLANG_FAILED(result))
+                {
+                    if (outDiagnostics)
+                    {
+                        *outDiagnostics = diagnostics.detach();
+                    }
+                    return result;
+                }
+            }
+
+            program->sharedLibraries.Add(entryPointIndex, sharedLibrary);
+            if (diagnostics && outDiagnostics)
+            {
+                *outDiagnostics = diagnostics.detach();
+            }
+        }
+
+        *outSharedLibrary = sharedLibrary.detach();
+        return SLANG_OK;
+    }
+
+    Result DeviceImpl::prepareSpecializedPipeline(PipelineStateBase* pipeline)
+    {
+        // The kernel is otherwise compiled when it's first dispatched
+        ComPtr<ISlangSharedLibrary> sharedLibrary;
+        ComPtr<ISlangBlob> diagnostics;
+        return _getEntryPointHostCallable(
+            static_cast<ShaderProgramImpl*>(pipeline->m_program.Ptr()),
+            0,
+            0,
+            sharedLibrary.writeRef(),
+            diagnostics.writeRef());
+    }
+
     void DeviceImpl::dispatchCompute(int x, int y, int z)
     {
         int entryPointIndex = 0;
@@ -238,7 +359,11 @@ namespace cpu
 
         // Specialize the compute kernel based on the shader object bindings.
         RefPtr<PipelineStateBase> newPipeline;
-        maybeSpecializePipeline(m_currentPipeline, m_currentRootObject, newPipeline);
+        if (SLANG_FAILED(maybeSpecializePipeline(m_currentPipeline, m_currentRootObject, newPipeline)))
+        {
+            // The specialized pipeline is being built, or couldn't be built
+            return;
+        }
         m_currentPipeline = static_cast<PipelineStateImpl*>(newPipeline.Ptr());
 
         auto program = m_currentPipeline->getProgram();
@@ -250,8 +375,8 @@ namespace cpu
 
         ComPtr<ISlangSharedLibrary> sharedLibrary;
         ComPtr<ISlangBlob> diagnostics;
-        auto compileResult = program->slangGlobalScope->getEntryPointHostCallable(
-            entryPointIndex, targetIndex, sharedLibrary.writeRef(), diagnostics.writeRef());
+        auto compileResult = _getEntryPointHostCallable(
+            program, entryPointIndex, targetIndex, sharedLibrary.writeRef(), diagnostics.writeRef());
         if (diagnostics)
         {
             getDebugCallback()->handleMessage(
@@ -263,17 +388,107 @@ namespace cpu
 
         auto func = (slang_prelude::ComputeFunc)sharedLibrary->findSymbolAddressByName(entryPointName);
 
-        slang_prelude::ComputeVaryingInput varyingInput;
-        varyingInput.startGroupID.x = 0;
-        varyingInput.startGroupID.y = 0;
-        varyingInput.startGroupID.z = 0;
-        varyingInput.endGroupID.x = x;
-        varyingInput.endGroupID.y = y;
-        varyingInput.endGroupID.z = z;
-
         auto globalParamsData = m_currentRootObject->getDataBuffer();
         auto entryPointParamsData = entryPointObject->getDataBuffer();
-        func(&varyingInput, entryPointParamsData, globalParamsData);
+
+        const int groupCount[3] = { x, y, z };
+        int tileSize[3];
+        _calcTileSize(groupCount, tileSize);
+
+        if (!m_threadPool || (tileSize[0] >= x && tileSize[1] >= y && tileSize[2] >= z))
+        {
+            slang_prelude::ComputeVaryingInput varyingInput;
+            varyingInput.startGroupID.x = 0;
+            varyingInput.startGroupID.y = 0;
+            varyingInput.startGroupID.z = 0;
+            varyingInput.endGroupID.x = x;
+            varyingInput.endGroupID.y = y;
+            varyingInput.endGroupID.z = z;
+
+            func(&varyingInput, entryPointParamsData, globalParamsData);
+            return;
+        }
+
+        // Split the group grid into tiles, each of which is executed as a separate call
+        // to the kernel with the tile's sub range of groups.
+        for (int tileZ = 0; tileZ < z; tileZ += tileSize[2])
+        {
+            for (int tileY = 0; tileY < y; tileY += tileSize[1])
+            {
+                for (int tileX = 0; tileX < x; tileX += tileSize[0])
+                {
+                    slang_prelude::ComputeVaryingInput varyingInput;
+                    varyingInput.startGroupID.x = tileX;
+                    varyingInput.startGroupID.y = tileY;
+                    varyingInput.startGroupID.z = tileZ;
+                    varyingInput.endGroupID.x = Math::Min(tileX + tileSize[0], x);
+                    varyingInput.endGroupID.y = Math::Min(tileY + tileSize[1], y);
+                    varyingInput.endGroupID.z = Math::Min(tileZ + tileSize[2], z);
+
+                    m_threadPool->submit(
+                        [=]() mutable
+                        {
+                            func(&varyingInput, entryPointParamsData, globalParamsData);
+                        });
+                }
+            }
+        }
+
+        m_threadPool->waitAll();
+    }
+
+    void DeviceImpl::_calcTileSize(const int groupCount[3], int outTileSize[3])
+    {
+        // Start with a single tile that covers everything
+        for (Index i = 0; i < 3; ++i)
+        {
+            outTileSize[i] = Math::Max(groupCount[i], 1);
+        }
+
+        if (!m_threadPool)
+        {
+            return;
+        }
+
+        const GfxCount* requestedTileSize = m_extendedDesc.tileSize;
+        if (requestedTileSize[0] > 0 || requestedTileSize[1] > 0 || requestedTileSize[2] > 0)
+        {
+            // Dimensions that are not specified are not split
+            for (Index i = 0; i < 3; ++i)
+            {
+                if (requestedTileSize[i] > 0)
+                {
+                    outTileSize[i] = Math::Min(int(requestedTileSize[i]), outTileSize[i]);
+                }
+            }
+            return;
+        }
+
+        // Aim for several tiles per thread (including the dispatching thread which helps out),
+        // so that tiles of uneven cost can be balanced by work stealing.
+        const Int64 targetTileCount = Int64(m_threadPool->getWorkerCount() + 1) * 4;
+
+        for (;;)
+        {
+            Int64 tileCount = 1;
+            Index largestIndex = 0;
+            for (Index i = 0; i < 3; ++i)
+            {
+                tileCount *= (groupCount[i] + outTileSize[i] - 1) / outTileSize[i];
+                if (outTileSize[i] > outTileSize[largestIndex])
+                {
+                    largestIndex = i;
+                }
+            }
+
+            if (tileCount >= targetTileCount || outTileSize[largestIndex] <= 1)
+            {
+                break;
+            }
+
+            // Halve the largest dimension of the tile
+            outTileSize[largestIndex] = (outTileSize[largestIndex] + 1) / 2;
+        }
     }
 
     void DeviceImpl::copyBuffer(
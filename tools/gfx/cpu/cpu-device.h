@@ -5,6 +5,8 @@
 #include "cpu-pipeline-state.h"
 #include "cpu-shader-object.h"
 
+#include "core/slang-thread-pool.h"
+
 namespace gfx
 {
 using namespace Slang;
@@ -80,6 +82,25 @@ private:
     RefPtr<RootShaderObjectImpl> m_currentRootObject = nullptr;
     DeviceInfo m_info;
 
+    CPUDeviceExtendedDesc m_extendedDesc;
+        /// Used to execute tiles of a dispatch in parallel. Null if dispatches run on the calling thread.
+    RefPtr<ThreadPool> m_threadPool;
+
+        /// Determine the size (in groups) of the tiles a dispatch of `groupCount` groups is split into
+    void _calcTileSize(const int groupCount[3], int outTileSize[3]);
+
+        /// Get the shared library holding the kernel for an entry point of `program`.
+        /// If the device has a persistent shader cache, the library is loaded from the binary held in the cache,
+        /// and only compiled if it isn't there.
+    Result _getEntryPointHostCallable(
+        ShaderProgramImpl* program,
+        GfxIndex entryPointIndex,
+        GfxIndex targetIndex,
+        ISlangSharedLibrary** outSharedLibrary,
+        ISlangBlob** outDiagnostics);
+
+    virtual Result prepareSpecializedPipeline(PipelineStateBase* pipeline) override;
+
     virtual void setPipelineState(IPipelineState* state) override;
 
     virtual void bindRootShaderObject(IShaderObject* object) override;
@@ -4,6 +4,8 @@
 
 #include "cpu-shader-object-layout.h"
 
+#include <mutex>
+
 namespace gfx
 {
 using namespace Slang;
@@ -16,6 +18,11 @@ class ShaderProgramImpl : public ShaderProgramBase
 public:
     RefPtr<RootShaderObjectLayoutImpl> layout;
 
+        /// Shared libraries holding the kernels for entry points, keyed by entry point index.
+    Dictionary<GfxIndex, ComPtr<ISlangSharedLibrary>> sharedLibraries;
+        /// Guards `sharedLibraries`, as kernels may be loaded on a thread building specialized pipelines.
+    std::mutex sharedLibrariesMutex;
+
     ~ShaderProgramImpl()
     {
     }
@@ -913,8 +913,8 @@ SLANG_NO_THROW Result SLANG_MCALL DeviceImpl::createProgram(
 
     ComPtr<ISlangBlob> kernelCode;
     ComPtr<ISlangBlob> diagnostics;
-    auto compileResult = desc.slangGlobalScope->getEntryPointCode(
-        (SlangInt)0, 0, kernelCode.writeRef(), diagnostics.writeRef());
+    auto compileResult = getEntryPointCode(
+        desc.slangGlobalScope, (SlangInt)0, 0, kernelCode.writeRef(), diagnostics.writeRef());
     if (diagnostics)
     {
         getDebugCallback()->handleMessage(
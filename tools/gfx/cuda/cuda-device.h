@@ -36,6 +36,9 @@ public:
 
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL initialize(const Desc& desc) override;
 
+    // Kernels are loaded into the CUDA context, which is only current on the thread that uses the device.
+    virtual bool supportsBackgroundPipelineSpecialization() override { return false; }
+
     Result getCUDAFormat(Format format, CUarray_format* outFormat);
 
     virtual SLANG_NO_THROW Result SLANG_MCALL createTextureResource(
@@ -19,6 +19,9 @@ public:
 
     // Renderer    implementation
     virtual SLANG_NO_THROW Result SLANG_MCALL initialize(const Desc& desc) override;
+    // Pipelines are bound and used by separate commands when a command buffer is executed, so a call can't be
+    // skipped while its pipeline is being built.
+    virtual bool supportsBackgroundPipelineSpecialization() override { return false; }
     virtual void clearFrame(uint32_t colorBufferMask, bool clearDepth, bool clearStencil) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL createSwapchain(
         const ISwapchain::Desc& desc, WindowHandle window, ISwapchain** outSwapchain) override;
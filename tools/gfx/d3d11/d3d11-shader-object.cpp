@@ -640,6 +640,7 @@ Result RootShaderObjectImpl::_createSpecializedLayout(ShaderObjectLayoutImpl** o
     // require re-computing the layouts (or generated kernel code) for any of the entry points
     // that had already been loaded (in contrast to a compose-then-specialize approach).
     //
+    std::lock_guard<std::recursive_mutex> slangLock(getRenderer()->m_slangMutex);
     ComPtr<slang::IComponentType> specializedComponentType;
     ComPtr<slang::IBlob> diagnosticBlob;
     auto result = getLayout()->getSlangProgram()->specialize(
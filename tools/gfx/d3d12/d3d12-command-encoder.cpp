@@ -974,22 +974,25 @@ void RenderCommandEncoderImpl::setIndexBuffer(
     m_boundIndexOffset = (UINT)offset;
 }
 
-void RenderCommandEncoderImpl::prepareDraw()
+Result RenderCommandEncoderImpl::prepareDraw()
 {
     auto pipelineState = m_currentPipeline.Ptr();
     if (!pipelineState || (pipelineState->desc.type != PipelineType::Graphics))
     {
         assert(!"No graphics pipeline state set");
-        return;
+        return SLANG_FAIL;
     }
 
     // Submit - setting for graphics
     {
         GraphicsSubmitter submitter(m_d3dCmdList);
         RefPtr<PipelineStateBase> newPipeline;
-        if (SLANG_FAILED(_bindRenderState(&submitter, newPipeline)))
+        auto result = _bindRenderState(&submitter, newPipeline);
+        if (SLANG_FAILED(result))
         {
-            assert(!"Failed to bind render state");
+            // The draw is skipped while a specialized pipeline without a fallback is being built.
+            assert(result == SLANG_E_PENDING || !"Failed to bind render state");
+            return result;
         }
     }
 
@@ -1033,18 +1036,21 @@ void RenderCommandEncoderImpl::prepareDraw()
 
         m_d3dCmdList->IASetIndexBuffer(&indexBufferView);
     }
+    return SLANG_OK;
 }
 
 void RenderCommandEncoderImpl::draw(GfxCount vertexCount, GfxIndex startVertex)
 {
-    prepareDraw();
+    if (SLANG_FAILED(prepareDraw()))
+        return;
     m_d3dCmdList->DrawInstanced((uint32_t)vertexCount, 1, (uint32_t)startVertex, 0);
 }
 
 void RenderCommandEncoderImpl::drawIndexed(
     GfxCount indexCount, GfxIndex startIndex, GfxIndex baseVertex)
 {
-    prepareDraw();
+    if (SLANG_FAILED(prepareDraw()))
+        return;
     m_d3dCmdList->DrawIndexedInstanced((uint32_t)indexCount, 1, (uint32_t)startIndex, (uint32_t)baseVertex, 0);
 }
 
@@ -1103,7 +1109,8 @@ void RenderCommandEncoderImpl::drawIndirect(
     IBufferResource* countBuffer,
     Offset countOffset)
 {
-    prepareDraw();
+    if (SLANG_FAILED(prepareDraw()))
+        return;
 
     auto argBufferImpl = static_cast<BufferResourceImpl*>(argBuffer);
     auto countBufferImpl = static_cast<BufferResourceImpl*>(countBuffer);
@@ -1124,7 +1131,8 @@ void RenderCommandEncoderImpl::drawIndexedIndirect(
     IBufferResource* countBuffer,
     Offset countOffset)
 {
-    prepareDraw();
+    if (SLANG_FAILED(prepareDraw()))
+        return;
 
     auto argBufferImpl = static_cast<BufferResourceImpl*>(argBuffer);
     auto countBufferImpl = static_cast<BufferResourceImpl*>(countBuffer);
@@ -1156,7 +1164,8 @@ void RenderCommandEncoderImpl::drawInstanced(
     GfxIndex startVertex,
     GfxIndex startInstanceLocation)
 {
-    prepareDraw();
+    if (SLANG_FAILED(prepareDraw()))
+        return;
     m_d3dCmdList->DrawInstanced(
         (uint32_t)vertexCount,
         (uint32_t)instanceCount,
@@ -1171,7 +1180,8 @@ void RenderCommandEncoderImpl::drawIndexedInstanced(
     GfxIndex baseVertexLocation,
     GfxIndex startInstanceLocation)
 {
-    prepareDraw();
+    if (SLANG_FAILED(prepareDraw()))
+        return;
     m_d3dCmdList->DrawIndexedInstanced(
         (uint32_t)indexCount,
         (uint32_t)instanceCount,
@@ -1208,9 +1218,12 @@ void ComputeCommandEncoderImpl::dispatchCompute(int x, int y, int z)
     {
         ComputeSubmitter submitter(m_d3dCmdList);
         RefPtr<PipelineStateBase> newPipeline;
-        if (SLANG_FAILED(_bindRenderState(&submitter, newPipeline)))
+        auto result = _bindRenderState(&submitter, newPipeline);
+        if (SLANG_FAILED(result))
         {
-            assert(!"Failed to bind render state");
+            // The dispatch is skipped while a specialized pipeline without a fallback is being built.
+            assert(result == SLANG_E_PENDING || !"Failed to bind render state");
+            return;
         }
     }
     m_d3dCmdList->Dispatch(x, y, z);
@@ -1222,9 +1235,12 @@ void ComputeCommandEncoderImpl::dispatchComputeIndirect(IBufferResource* argBuff
     {
         ComputeSubmitter submitter(m_d3dCmdList);
         RefPtr<PipelineStateBase> newPipeline;
-        if (SLANG_FAILED(_bindRenderState(&submitter, newPipeline)))
+        auto result = _bindRenderState(&submitter, newPipeline);
+        if (SLANG_FAILED(result))
         {
-            assert(!"Failed to bind render state");
+            // The dispatch is skipped while a specialized pipeline without a fallback is being built.
+            assert(result == SLANG_E_PENDING || !"Failed to bind render state");
+            return;
         }
     }
     auto argBufferImpl = static_cast<BufferResourceImpl*>(argBuffer);
@@ -1360,9 +1376,11 @@ void RayTracingCommandEncoderImpl::dispatchRays(
             }
         };
         RayTracingSubmitter submitter(m_commandBuffer->m_cmdList4);
-        if (SLANG_FAILED(_bindRenderState(&submitter, newPipeline)))
+        auto result = _bindRenderState(&submitter, newPipeline);
+        if (SLANG_FAILED(result))
         {
-            assert(!"Failed to bind render state");
+            assert(result == SLANG_E_PENDING || !"Failed to bind render state");
+            return;
         }
         if (newPipeline)
             pipeline = newPipeline.Ptr();
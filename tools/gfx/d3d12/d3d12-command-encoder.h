@@ -217,7 +217,7 @@ public:
     virtual SLANG_NO_THROW void SLANG_MCALL
         setIndexBuffer(IBufferResource* buffer, Format indexFormat, Offset offset = 0) override;
 
-    void prepareDraw();
+    Result prepareDraw();
     virtual SLANG_NO_THROW void SLANG_MCALL
         draw(GfxCount vertexCount, GfxIndex startVertex = 0) override;
     virtual SLANG_NO_THROW void SLANG_MCALL
@@ -471,6 +471,7 @@ Result DebugDevice::createGraphicsPipelineState(
         desc.framebufferLayout
             ? static_cast<DebugFramebufferLayout*>(desc.framebufferLayout)->baseObject
             : nullptr;
+    innerDesc.specializationFallback = getInnerObj(desc.specializationFallback);
     RefPtr<DebugPipelineState> outObject = new DebugPipelineState();
     auto result =
         baseObject->createGraphicsPipelineState(innerDesc, outObject->baseObject.writeRef());
@@ -488,6 +489,7 @@ Result DebugDevice::createComputePipelineState(
 
     ComputePipelineStateDesc innerDesc = desc;
     innerDesc.program = static_cast<DebugShaderProgram*>(desc.program)->baseObject;
+    innerDesc.specializationFallback = getInnerObj(desc.specializationFallback);
 
     RefPtr<DebugPipelineState> outObject = new DebugPipelineState();
     auto result =
@@ -585,6 +587,16 @@ Result DebugDevice::getTextureRowAlignment(size_t* outAlignment)
     return baseObject->getTextureRowAlignment(outAlignment);
 }
 
+Result DebugDevice::prewarmSpecializedPipeline(
+    IPipelineState* pipeline,
+    const slang::SpecializationArg* args,
+    GfxCount argCount,
+    IPipelineSpecializationTask** outTask)
+{
+    SLANG_GFX_API_FUNC;
+    return baseObject->prewarmSpecializedPipeline(getInnerObj(pipeline), args, argCount, outTask);
+}
+
 Result DebugDevice::createShaderTable(const IShaderTable::Desc& desc, IShaderTable** outTable)
 {
     SLANG_GFX_API_FUNC;
@@ -141,6 +141,11 @@ public:
     virtual SLANG_NO_THROW Result SLANG_MCALL getTextureRowAlignment(size_t* outAlignment) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL
         createShaderTable(const IShaderTable::Desc& desc, IShaderTable** outTable) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL prewarmSpecializedPipeline(
+        IPipelineState* pipeline,
+        const slang::SpecializationArg* args,
+        GfxCount argCount,
+        IPipelineSpecializationTask** outTask) override;
 };
 
 } // namespace debug
@@ -105,6 +105,8 @@ class GLDevice : public ImmediateRendererBase
 public:
     // Renderer    implementation
     virtual SLANG_NO_THROW Result SLANG_MCALL initialize(const Desc& desc) override;
+    // The GL context is only current on the thread that uses the device.
+    virtual bool supportsBackgroundPipelineSpecialization() override { return false; }
     virtual void clearFrame(uint32_t mask, bool clearDepth, bool clearStencil) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL createSwapchain(
         const ISwapchain::Desc& desc, WindowHandle window, ISwapchain** outSwapchain) override;
@@ -1540,6 +1542,7 @@ public:
             // rquire re-computing the layouts (or generated kernel code) for any of the entry points
             // that had already been loaded (in contrast to a compose-then-specialize approach).
             //
+            std::lock_guard<std::recursive_mutex> slangLock(getRenderer()->m_slangMutex);
             ComPtr<slang::IComponentType> specializedComponentType;
             ComPtr<slang::IBlob> diagnosticBlob;
             auto result = getLayout()->getSlangProgram()->specialize(
@@ -2791,8 +2794,8 @@ Result GLDevice::createProgram(
     {
         ComPtr<ISlangBlob> kernelCode;
         ComPtr<ISlangBlob> diagnostics;
-        auto compileResult = desc.slangGlobalScope->getEntryPointCode(
-            i, 0, kernelCode.writeRef(), diagnostics.writeRef());
+        auto compileResult = getEntryPointCode(
+            desc.slangGlobalScope, i, 0, kernelCode.writeRef(), diagnostics.writeRef());
         if (diagnostics)
         {
             getDebugCallback()->handleMessage(
@@ -0,0 +1,241 @@
+#include "persistent-shader-cache.h"
+
+#include "core/slang-blob.h"
+#include "core/slang-string-util.h"
+
+namespace gfx
+{
+using namespace Slang;
+
+/* static */const char* const PersistentShaderCache::kIndexFileName = "shader-cache-index.txt";
+
+PersistentShaderCache::PersistentShaderCache(ISlangFileSystem* fileSystem, Size maxSize)
+    : m_fileSystem(fileSystem)
+    , m_maxSize(maxSize)
+{
+    fileSystem->queryInterface(ISlangMutableFileSystem::getTypeGuid(), (void**)m_mutableFileSystem.writeRef());
+    _readIndex();
+}
+
+PersistentShaderCache::~PersistentShaderCache()
+{
+    _flush();
+}
+
+/* static */String PersistentShaderCache::calcEntryFileName(ISlangBlob* key)
+{
+    StringBuilder fileName;
+    fileName.append(uint64_t(getStableHashCode64((const char*)key->getBufferPointer(), key->getBufferSize())), 16);
+    fileName << ".gfx-kernel";
+    return fileName;
+}
+
+/* static */uint64_t PersistentShaderCache::calcKernelHash(const void* data, size_t size)
+{
+    return getStableHashCode64((const char*)data, size);
+}
+
+Index PersistentShaderCache::_findEntry(const String& fileName) const
+{
+    return m_entries.findFirstIndex([&](const Entry& entry) -> bool { return entry.fileName == fileName; });
+}
+
+void PersistentShaderCache::_touchEntry(Index index)
+{
+    if (index == m_entries.getCount() - 1)
+    {
+        return;
+    }
+    Entry entry = m_entries[index];
+    m_entries.removeAt(index);
+    m_entries.add(entry);
+    m_isIndexDirty = true;
+}
+
+void PersistentShaderCache::_removeEntry(Index index)
+{
+    m_totalSize -= m_entries[index].size;
+    m_entries.removeAt(index);
+    m_isIndexDirty = true;
+}
+
+void PersistentShaderCache::_readIndex()
+{
+    ComPtr<ISlangBlob> blob;
+    if (SLANG_FAILED(m_fileSystem->loadFile(kIndexFileName, blob.writeRef())))
+    {
+        return;
+    }
+
+    // Each line is the file name of an entry followed by its size, ordered from least to most recently used.
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(StringUtil::getSlice(blob), lines);
+    for (const auto& line : lines)
+    {
+        UnownedStringSlice parts[2];
+        int64_t size = 0;
+        if (StringUtil::split(line.trim(), ' ', 2, parts) != 2 ||
+            SLANG_FAILED(StringUtil::parseInt64(parts[1], size)) ||
+            size < 0)
+        {
+            continue;
+        }
+
+        const String fileName(parts[0]);
+        if (_findEntry(fileName) < 0)
+        {
+            m_entries.add(Entry{ fileName, Size(size) });
+            m_totalSize += Size(size);
+        }
+    }
+}
+
+Result PersistentShaderCache::_writeIndex()
+{
+    if (!m_mutableFileSystem)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    StringBuilder buf;
+    for (const auto& entry : m_entries)
+    {
+        buf << entry.fileName << " " << uint64_t(entry.size) << "\n";
+    }
+    SLANG_RETURN_ON_FAIL(m_mutableFileSystem->saveFile(kIndexFileName, buf.getBuffer(), buf.getLength()));
+
+    m_isIndexDirty = false;
+    return SLANG_OK;
+}
+
+Result PersistentShaderCache::_flush()
+{
+    return m_isIndexDirty ? _writeIndex() : SLANG_OK;
+}
+
+Result PersistentShaderCache::flush()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return _flush();
+}
+
+Result PersistentShaderCache::loadEntry(ISlangBlob* key, ISlangBlob** outKernel)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const String fileName = calcEntryFileName(key);
+    const Index index = _findEntry(fileName);
+
+    ComPtr<ISlangBlob> contents;
+    if (SLANG_FAILED(m_fileSystem->loadFile(fileName.getBuffer(), contents.writeRef())))
+    {
+        // The file has been removed since the index was written
+        if (index >= 0)
+        {
+            _removeEntry(index);
+        }
+        return SLANG_E_NOT_FOUND;
+    }
+
+    // Check the entry is for this key. If not, it will be replaced when the kernel for the key is saved.
+    const auto data = (const uint8_t*)contents->getBufferPointer();
+    const size_t size = contents->getBufferSize();
+    const size_t keySize = key->getBufferSize();
+
+    EntryHeader header;
+    if (size < sizeof(header))
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+    ::memcpy(&header, data, sizeof(header));
+    if (header.magic != kEntryMagic ||
+        header.version != kVersion ||
+        header.keySize != keySize ||
+        size < sizeof(header) + keySize ||
+        ::memcmp(data + sizeof(header), key->getBufferPointer(), keySize) != 0)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    // Check the kernel is the one that was saved
+    const size_t kernelOffset = sizeof(header) + keySize;
+    if (header.kernelHash != calcKernelHash(data + kernelOffset, size - kernelOffset))
+    {
+        if (m_mutableFileSystem)
+        {
+            m_mutableFileSystem->remove(fileName.getBuffer());
+        }
+        if (index >= 0)
+        {
+            _removeEntry(index);
+        }
+        return SLANG_E_NOT_FOUND;
+    }
+
+    if (index >= 0)
+    {
+        _touchEntry(index);
+    }
+    else
+    {
+        // The entry exists, but isn't in the index (for example because the index couldn't be written)
+        m_entries.add(Entry{ fileName, size });
+        m_totalSize += size;
+        m_isIndexDirty = true;
+    }
+
+    *outKernel = RawBlob::create(data + kernelOffset, size - kernelOffset).detach();
+    return SLANG_OK;
+}
+
+Result PersistentShaderCache::saveEntry(ISlangBlob* key, ISlangBlob* kernel)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_mutableFileSystem)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    EntryHeader header;
+    header.keySize = key->getBufferSize();
+    header.kernelHash = calcKernelHash(kernel->getBufferPointer(), kernel->getBufferSize());
+
+    const size_t kernelOffset = sizeof(header) + key->getBufferSize();
+    const size_t size = kernelOffset + kernel->getBufferSize();
+
+    // An entry that can't fit on its own would cause everything to be removed
+    if (m_maxSize && size > m_maxSize)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    List<uint8_t> contents;
+    contents.setCount(size);
+    ::memcpy(contents.getBuffer(), &header, sizeof(header));
+    ::memcpy(contents.getBuffer() + sizeof(header), key->getBufferPointer(), key->getBufferSize());
+    ::memcpy(contents.getBuffer() + kernelOffset, kernel->getBufferPointer(), kernel->getBufferSize());
+
+    const String fileName = calcEntryFileName(key);
+    SLANG_RETURN_ON_FAIL(m_mutableFileSystem->saveFile(fileName.getBuffer(), contents.getBuffer(), size));
+
+    // If an entry with the same name was replaced, it's now the most recently used with a new size
+    const Index index = _findEntry(fileName);
+    if (index >= 0)
+    {
+        _removeEntry(index);
+    }
+    m_entries.add(Entry{ fileName, size });
+    m_totalSize += size;
+
+    // Remove the least recently used entries until the cache is within its limit
+    while (m_maxSize && m_totalSize > m_maxSize && m_entries.getCount() > 1)
+    {
+        m_mutableFileSystem->remove(m_entries[0].fileName.getBuffer());
+        _removeEntry(0);
+    }
+
+    return _writeIndex();
+}
+
+}
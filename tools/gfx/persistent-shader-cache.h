@@ -0,0 +1,102 @@
+#pragma once
+
+#include "slang-gfx.h"
+#include "core/slang-basic.h"
+
+#include <mutex>
+
+namespace gfx
+{
+
+/* A cache of compiled kernels held in a file system, such that they persist between runs of an application.
+
+Kernels are looked up by a key, which is the text produced by `IComponentType::getEntryPointCacheKey`, and so
+identifies the program, its specialization arguments and the target options. Each entry is a file named by a
+stable hash of the key. The file holds the whole key followed by the kernel, and the key must match for the
+entry to be used, so a hash collision can only cause a miss. The header also holds a hash of the kernel, which is
+checked before the kernel is returned, so an entry that was truncated or otherwise corrupted (for example by a
+crash part way through saving it) is removed rather than used. This matters for the CPU target, where the kernel
+is a shared library that is loaded into the process.
+
+The total size of the entries can be bounded. An index file lists the entries in the order they were last used,
+and when an entry is saved and the total is over the limit, the least recently used entries are removed.
+
+Entries are only saved if the file system is an `ISlangMutableFileSystem`.
+
+The cache may be used from multiple threads (such as those building pipelines in the background). */
+class PersistentShaderCache : public Slang::RefObject
+{
+public:
+    static const uint32_t kEntryMagic = 0x6b786667;      ///< 'gfxk'
+    static const uint32_t kVersion = 2;
+
+        /// The name of the file that lists the entries
+    static const char* const kIndexFileName;
+
+    struct EntryHeader
+    {
+        uint32_t magic = kEntryMagic;
+        uint32_t version = kVersion;
+        uint64_t keySize = 0;                   ///< The size of the key, which follows the header. The kernel follows the key.
+        uint64_t kernelHash = 0;                ///< The hash of the kernel (see `calcKernelHash`)
+    };
+
+        /// Load the kernel stored for key. Returns SLANG_E_NOT_FOUND if there isn't one.
+    Slang::Result loadEntry(ISlangBlob* key, ISlangBlob** outKernel);
+
+        /// Save kernel as the entry for key, removing least recently used entries if the cache is over its size limit.
+    Slang::Result saveEntry(ISlangBlob* key, ISlangBlob* kernel);
+
+        /// Write the index if the order entries were used has changed since it was written.
+    Slang::Result flush();
+
+        /// Get the total size of the entries
+    Size getTotalSize() const { std::lock_guard<std::mutex> lock(m_mutex); return m_totalSize; }
+        /// Get the number of entries
+    Slang::Index getEntryCount() const { std::lock_guard<std::mutex> lock(m_mutex); return m_entries.getCount(); }
+
+        /// Get the name of the entry file for key
+    static Slang::String calcEntryFileName(ISlangBlob* key);
+        /// Get the hash of a kernel, as stored in the header of its entry
+    static uint64_t calcKernelHash(const void* data, size_t size);
+
+        /// A maxSize of 0 means the size of the cache isn't limited
+    PersistentShaderCache(ISlangFileSystem* fileSystem, Size maxSize);
+    ~PersistentShaderCache();
+
+protected:
+    struct Entry
+    {
+        Slang::String fileName;
+        Size size;
+    };
+
+    void _readIndex();
+    Slang::Result _writeIndex();
+    Slang::Result _flush();
+
+        /// Find the index of the entry in m_entries, or -1 if not found
+    Slang::Index _findEntry(const Slang::String& fileName) const;
+        /// Make the entry at index the most recently used
+    void _touchEntry(Slang::Index index);
+    void _removeEntry(Slang::Index index);
+
+    // Not a strong reference, as the user holds the file system alive for the lifetime of the device
+    ISlangFileSystem* m_fileSystem;
+    // Set if entries can be saved
+    Slang::ComPtr<ISlangMutableFileSystem> m_mutableFileSystem;
+
+    Size m_maxSize;
+    Size m_totalSize = 0;
+
+    // Ordered from least to most recently used
+    Slang::List<Entry> m_entries;
+
+    // Set if the index needs to be written
+    bool m_isIndexDirty = false;
+
+    // Guards all of the above
+    mutable std::mutex m_mutex;
+};
+
+}
@@ -34,6 +34,7 @@ const Slang::Guid GfxGUID::IID_ICommandQueue = SLANG_UUID_ICommandQueue;
 const Slang::Guid GfxGUID::IID_IQueryPool = SLANG_UUID_IQueryPool;
 const Slang::Guid GfxGUID::IID_IAccelerationStructure = SLANG_UUID_IAccelerationStructure;
 const Slang::Guid GfxGUID::IID_IFence = SLANG_UUID_IFence;
+const Slang::Guid GfxGUID::IID_IPipelineSpecializationTask = SLANG_UUID_IPipelineSpecializationTask;
 const Slang::Guid GfxGUID::IID_IShaderTable = SLANG_UUID_IShaderTable;
 const Slang::Guid GfxGUID::IID_IPipelineCreationAPIDispatcher = SLANG_UUID_IPipelineCreationAPIDispatcher;
 const Slang::Guid GfxGUID::IID_ID3D12TransientResourceHeap = SLANG_UUID_ID3D12TransientResourceHeap;
@@ -77,6 +78,35 @@ IFence* FenceBase::getInterface(const Slang::Guid& guid)
     return nullptr;
 }
 
+IPipelineSpecializationTask* PipelineSpecializationTask::getInterface(const Slang::Guid& guid)
+{
+    if (guid == GfxGUID::IID_ISlangUnknown || guid == GfxGUID::IID_IPipelineSpecializationTask)
+        return static_cast<IPipelineSpecializationTask*>(this);
+    return nullptr;
+}
+
+SLANG_NO_THROW bool SLANG_MCALL PipelineSpecializationTask::isComplete()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_isComplete;
+}
+
+SLANG_NO_THROW Result SLANG_MCALL PipelineSpecializationTask::wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_completed.wait(lock, [&]() { return m_isComplete; });
+    return m_result;
+}
+
+void PipelineSpecializationTask::complete(Result result)
+{
+    // Notify while holding the lock, as a waiter that sees the task is complete may destroy it
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_result = result;
+    m_isComplete = true;
+    m_completed.notify_all();
+}
+
 IResource* BufferResource::getInterface(const Slang::Guid& guid)
 {
     if (guid == GfxGUID::IID_ISlangUnknown || guid == GfxGUID::IID_IResource ||
@@ -318,6 +348,11 @@ void PipelineStateBase::initializeBase(const PipelineStateDesc& inDesc)
     {
         inputLayout = static_cast<InputLayoutBase*>(inDesc.graphics.inputLayout);
         framebufferLayout = static_cast<FramebufferLayoutBase*>(inDesc.graphics.framebufferLayout);
+        specializationFallback = static_cast<PipelineStateBase*>(inDesc.graphics.specializationFallback);
+    }
+    else if (inDesc.type == PipelineType::Compute)
+    {
+        specializationFallback = static_cast<PipelineStateBase*>(inDesc.compute.specializationFallback);
     }
 }
 
@@ -336,9 +371,30 @@ SLANG_NO_THROW Result SLANG_MCALL RendererBase::initialize(const Desc& desc)
             GfxGUID::IID_IPipelineCreationAPIDispatcher,
             (void**)m_pipelineCreationAPIDispatcher.writeRef());
     }
+    if (desc.shaderCacheFileSystem)
+    {
+        shaderCache.persistentCache =
+            new PersistentShaderCache(desc.shaderCacheFileSystem, desc.maxShaderCacheSize);
+    }
+    if (desc.pipelineSpecializationMode == PipelineSpecializationMode::Background &&
+        supportsBackgroundPipelineSpecialization())
+    {
+        Index threadCount = desc.pipelineSpecializationThreadCount;
+        if (threadCount < 0)
+        {
+            threadCount = ThreadPool::getHardwareWorkerCount();
+        }
+        m_specializationThreadPool = new ThreadPool(Math::Max(threadCount, Index(1)));
+    }
     return SLANG_OK;
 }
 
+void RendererBase::finishPipelineSpecialization()
+{
+    // Destroying the pool completes the tasks that were submitted to it
+    m_specializationThreadPool = nullptr;
+}
+
 SLANG_NO_THROW Result SLANG_MCALL RendererBase::getNativeDeviceHandles(InteropHandles* outHandles)
 {
     return SLANG_OK;
@@ -466,7 +522,10 @@ SLANG_NO_THROW Result SLANG_MCALL RendererBase::createShaderObjectFromTypeLayout
     slang::TypeLayoutReflection* typeLayout, IShaderObject** outObject)
 {
     RefPtr<ShaderObjectLayoutBase> shaderObjectLayout;
-    SLANG_RETURN_ON_FAIL(getShaderObjectLayout(typeLayout, shaderObjectLayout.writeRef()));
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_slangMutex);
+        SLANG_RETURN_ON_FAIL(getShaderObjectLayout(typeLayout, shaderObjectLayout.writeRef()));
+    }
     return createShaderObject(shaderObjectLayout, outObject);
 }
 
@@ -474,7 +533,10 @@ SLANG_NO_THROW Result SLANG_MCALL RendererBase::createMutableShaderObjectFromTyp
     slang::TypeLayoutReflection* typeLayout, IShaderObject** outObject)
 {
     RefPtr<ShaderObjectLayoutBase> shaderObjectLayout;
-    SLANG_RETURN_ON_FAIL(getShaderObjectLayout(typeLayout, shaderObjectLayout.writeRef()));
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_slangMutex);
+        SLANG_RETURN_ON_FAIL(getShaderObjectLayout(typeLayout, shaderObjectLayout.writeRef()));
+    }
     return createMutableShaderObject(shaderObjectLayout, outObject);
 }
 
@@ -556,6 +618,20 @@ Result RendererBase::getShaderObjectLayout(
     ShaderObjectContainerType container,
     ShaderObjectLayoutBase** outLayout)
 {
+    const ShaderObjectTypeKey key = { type, container };
+
+    RefPtr<ShaderObjectLayoutBase> shaderObjectLayout;
+    {
+        std::lock_guard<std::mutex> lock(m_shaderObjectLayoutCacheMutex);
+        if (m_shaderObjectLayoutByTypeCache.TryGetValue(key, shaderObjectLayout))
+        {
+            *outLayout = shaderObjectLayout.detach();
+            return SLANG_OK;
+        }
+    }
+
+    std::lock_guard<std::recursive_mutex> slangLock(m_slangMutex);
+
     switch (container)
     {
     case ShaderObjectContainerType::StructuredBuffer:
@@ -569,17 +645,34 @@ Result RendererBase::getShaderObjectLayout(
     }
 
     auto typeLayout = slangContext.session->getTypeLayout(type);
-    return getShaderObjectLayout(typeLayout, outLayout);
+    SLANG_RETURN_ON_FAIL(getShaderObjectLayout(typeLayout, shaderObjectLayout.writeRef()));
+    {
+        std::lock_guard<std::mutex> lock(m_shaderObjectLayoutCacheMutex);
+        m_shaderObjectLayoutByTypeCache[key] = shaderObjectLayout;
+    }
+    *outLayout = shaderObjectLayout.detach();
+    return SLANG_OK;
 }
 
 Result RendererBase::getShaderObjectLayout(
     slang::TypeLayoutReflection* typeLayout, ShaderObjectLayoutBase** outLayout)
 {
     RefPtr<ShaderObjectLayoutBase> shaderObjectLayout;
-    if (!m_shaderObjectLayoutCache.TryGetValue(typeLayout, shaderObjectLayout))
     {
-        SLANG_RETURN_ON_FAIL(createShaderObjectLayout(typeLayout, shaderObjectLayout.writeRef()));
-        m_shaderObjectLayoutCache.Add(typeLayout, shaderObjectLayout);
+        std::lock_guard<std::mutex> lock(m_shaderObjectLayoutCacheMutex);
+        if (m_shaderObjectLayoutCache.TryGetValue(typeLayout, shaderObjectLayout))
+        {
+            *outLayout = shaderObjectLayout.detach();
+            return SLANG_OK;
+        }
+    }
+
+    // Creating the layout can get the layouts of sub-objects, so the cache can't be locked while it's created.
+    // As `m_slangMutex` is held, no other thread can add the layout meanwhile.
+    SLANG_RETURN_ON_FAIL(createShaderObjectLayout(typeLayout, shaderObjectLayout.writeRef()));
+    {
+        std::lock_guard<std::mutex> lock(m_shaderObjectLayoutCacheMutex);
+        m_shaderObjectLayoutCache[typeLayout] = shaderObjectLayout;
     }
     *outLayout = shaderObjectLayout.detach();
     return SLANG_OK;
@@ -637,6 +730,8 @@ ShaderComponentID ShaderCache::getComponentId(UnownedStringSlice name)
 
 ShaderComponentID ShaderCache::getComponentId(ComponentKey key)
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     ShaderComponentID componentId = 0;
     if (componentIds.TryGetValue(key, componentId))
         return componentId;
@@ -651,9 +746,82 @@ ShaderComponentID ShaderCache::getComponentId(ComponentKey key)
 
 void ShaderCache::addSpecializedPipeline(PipelineKey key, Slang::RefPtr<PipelineStateBase> specializedPipeline)
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     specializedPipelines[key] = specializedPipeline;
 }
 
+Slang::RefPtr<PipelineSpecializationTask> ShaderCache::getSpecializationTask(PipelineKey key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Slang::RefPtr<PipelineSpecializationTask> task;
+    specializationTasks.TryGetValue(key, task);
+    return task;
+}
+
+void ShaderCache::addSpecializationTask(PipelineKey key, PipelineSpecializationTask* task)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    specializationTasks[key] = task;
+}
+
+void ShaderCache::removeSpecializationTask(PipelineKey key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    specializationTasks.Remove(key);
+}
+
+Slang::RefPtr<PipelineStateBase> ShaderCache::getFallbackPipeline(PipelineStateBase* unspecializedPipeline)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Slang::RefPtr<PipelineStateBase> fallbackPipeline;
+    fallbackPipelines.TryGetValue(unspecializedPipeline, fallbackPipeline);
+    return fallbackPipeline;
+}
+
+void ShaderCache::addFallbackPipeline(PipelineStateBase* unspecializedPipeline, PipelineStateBase* fallbackPipeline)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    fallbackPipelines[unspecializedPipeline] = fallbackPipeline;
+}
+
+Result RendererBase::getEntryPointCode(
+    slang::IComponentType* program,
+    SlangInt entryPointIndex,
+    SlangInt targetIndex,
+    ISlangBlob** outCode,
+    ISlangBlob** outDiagnostics)
+{
+    auto persistentCache = shaderCache.persistentCache.Ptr();
+
+    ComPtr<ISlangBlob> key;
+    if (persistentCache)
+    {
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_slangMutex);
+            if (SLANG_FAILED(program->getEntryPointCacheKey(entryPointIndex, targetIndex, key.writeRef())))
+            {
+                key = nullptr;
+            }
+        }
+        if (key && SLANG_SUCCEEDED(persistentCache->loadEntry(key, outCode)))
+        {
+            return SLANG_OK;
+        }
+    }
+
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_slangMutex);
+        SLANG_RETURN_ON_FAIL(program->getEntryPointCode(entryPointIndex, targetIndex, outCode, outDiagnostics));
+    }
+
+    if (key)
+    {
+        // Failing to save the kernel doesn't prevent it from being used.
+        persistentCache->saveEntry(key, *outCode);
+    }
+    return SLANG_OK;
+}
+
 void ShaderObjectLayoutBase::initBase(RendererBase* renderer, slang::TypeLayoutReflection* elementTypeLayout)
 {
     m_renderer = renderer;
@@ -681,6 +849,7 @@ Result ShaderObjectBase::_getSpecializedShaderObjectType(ExtendedShaderObjectTyp
     }
     else
     {
+        std::lock_guard<std::recursive_mutex> lock(getRenderer()->m_slangMutex);
         shaderObjectType.slangType = getRenderer()->slangContext.session->specializeType(
             _getElementTypeLayout()->getType(),
             specializationArgs.components.getArrayView().getBuffer(), specializationArgs.getCount());
@@ -829,7 +998,7 @@ void ShaderProgramBase::init(const IShaderProgram::Desc& inDesc)
     }
 }
 
-Result ShaderProgramBase::compileShaders()
+Result ShaderProgramBase::compileShaders(RendererBase* device)
 {
     // For a fully specialized program, read and store its kernel code in `shaderProgram`.
     auto compileShader = [&](slang::EntryPointReflection* entryPointInfo,
@@ -839,8 +1008,8 @@ Result ShaderProgramBase::compileShaders()
         auto stage = entryPointInfo->getStage();
         ComPtr<ISlangBlob> kernelCode;
         ComPtr<ISlangBlob> diagnostics;
-        auto compileResult = entryPointComponent->getEntryPointCode(
-            entryPointIndex, 0, kernelCode.writeRef(), diagnostics.writeRef());
+        auto compileResult = device->getEntryPointCode(
+            entryPointComponent, entryPointIndex, 0, kernelCode.writeRef(), diagnostics.writeRef());
         if (diagnostics)
         {
             getDebugCallback()->handleMessage(
@@ -853,27 +1022,44 @@ Result ShaderProgramBase::compileShaders()
         return SLANG_OK;
     };
 
-    if (linkedEntryPoints.getCount() == 0)
+    // Find the entry points with the Slang mutex held, and then compile them without it, such that it isn't
+    // held while kernels are read from the persistent shader cache.
+    struct EntryPointToCompile
+    {
+        slang::EntryPointReflection* info;
+        slang::IComponentType* component;
+        SlangInt index;
+    };
+    List<EntryPointToCompile> entryPointsToCompile;
     {
-        // If the user does not explicitly specify entry point components, find them from
-        // `linkedEntryPoints`.
-        auto programReflection = linkedProgram->getLayout();
-        for (SlangUInt i = 0; i < programReflection->getEntryPointCount(); i++)
+        std::lock_guard<std::recursive_mutex> lock(device->m_slangMutex);
+        if (linkedEntryPoints.getCount() == 0)
         {
-            SLANG_RETURN_ON_FAIL(compileShader(
-                programReflection->getEntryPointByIndex(i), linkedProgram, (SlangInt)i));
+            // If the user does not explicitly specify entry point components, find them from
+            // `linkedEntryPoints`.
+            auto programReflection = linkedProgram->getLayout();
+            for (SlangUInt i = 0; i < programReflection->getEntryPointCount(); i++)
+            {
+                entryPointsToCompile.add(
+                    EntryPointToCompile{ programReflection->getEntryPointByIndex(i), linkedProgram, (SlangInt)i });
+            }
         }
-    }
-    else
-    {
-        // If the user specifies entry point components via the separated entry point array,
-        // compile code from there.
-        for (auto& entryPoint : linkedEntryPoints)
+        else
         {
-            SLANG_RETURN_ON_FAIL(
-                compileShader(entryPoint->getLayout()->getEntryPointByIndex(0), entryPoint, 0));
+            // If the user specifies entry point components via the separated entry point array,
+            // compile code from there.
+            for (auto& entryPoint : linkedEntryPoints)
+            {
+                entryPointsToCompile.add(
+                    EntryPointToCompile{ entryPoint->getLayout()->getEntryPointByIndex(0), entryPoint, 0 });
+            }
         }
     }
+
+    for (const auto& entryPoint : entryPointsToCompile)
+    {
+        SLANG_RETURN_ON_FAIL(compileShader(entryPoint.info, entryPoint.component, entryPoint.index));
+    }
     return SLANG_OK;
 }
 
@@ -885,14 +1071,166 @@ Result ShaderProgramBase::createShaderModule(
     return SLANG_OK;
 }
 
+Result RendererBase::createSpecializedPipeline(
+    PipelineStateBase* unspecializedPipeline,
+    const ExtendedShaderObjectTypeList& args,
+    RefPtr<PipelineStateBase>& outPipeline)
+{
+    auto pipelineType = unspecializedPipeline->desc.type;
+    auto unspecializedProgram = static_cast<ShaderProgramBase*>(pipelineType == PipelineType::Compute
+        ? unspecializedPipeline->desc.compute.program
+        : unspecializedPipeline->desc.graphics.program);
+
+    ComPtr<slang::IComponentType> specializedComponentType;
+    ComPtr<slang::IBlob> diagnosticBlob;
+    Result compileRs;
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_slangMutex);
+        compileRs = unspecializedProgram->linkedProgram->specialize(
+            args.components.getArrayView().getBuffer(),
+            args.getCount(),
+            specializedComponentType.writeRef(),
+            diagnosticBlob.writeRef());
+    }
+    if (diagnosticBlob)
+    {
+        getDebugCallback()->handleMessage(
+            compileRs == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
+            DebugMessageSource::Slang,
+            (char*)diagnosticBlob->getBufferPointer());
+    }
+    SLANG_RETURN_ON_FAIL(compileRs);
+
+    // Now create the specialized shader program using compiled binaries.
+    ComPtr<IShaderProgram> specializedProgram;
+    IShaderProgram::Desc specializedProgramDesc = unspecializedProgram->desc;
+    specializedProgramDesc.slangGlobalScope = specializedComponentType;
+
+    if (specializedProgramDesc.linkingStyle == IShaderProgram::LinkingStyle::SingleProgram)
+    {
+        // When linking style is GraphicsCompute, the specialized global scope already contains
+        // entry-points, so we do not need to supply them again when creating the specialized
+        // pipeline.
+        specializedProgramDesc.entryPointCount = 0;
+    }
+    SLANG_RETURN_ON_FAIL(createProgram(specializedProgramDesc, specializedProgram.writeRef()));
+
+    // Create specialized pipeline state.
+    ComPtr<IPipelineState> specializedPipelineComPtr;
+    switch (pipelineType)
+    {
+    case PipelineType::Compute:
+    {
+        auto pipelineDesc = unspecializedPipeline->desc.compute;
+        pipelineDesc.program = specializedProgram;
+        pipelineDesc.specializationFallback = nullptr;
+        SLANG_RETURN_ON_FAIL(
+            createComputePipelineState(pipelineDesc, specializedPipelineComPtr.writeRef()));
+        break;
+    }
+    case PipelineType::Graphics:
+    {
+        auto pipelineDesc = unspecializedPipeline->desc.graphics;
+        pipelineDesc.program = static_cast<ShaderProgramBase*>(specializedProgram.get());
+        pipelineDesc.specializationFallback = nullptr;
+        SLANG_RETURN_ON_FAIL(createGraphicsPipelineState(
+            pipelineDesc, specializedPipelineComPtr.writeRef()));
+        break;
+    }
+    case PipelineType::RayTracing:
+    {
+        auto pipelineDesc = unspecializedPipeline->desc.rayTracing;
+        pipelineDesc.program = static_cast<ShaderProgramBase*>(specializedProgram.get());
+        SLANG_RETURN_ON_FAIL(createRayTracingPipelineState(
+            pipelineDesc.get(), specializedPipelineComPtr.writeRef()));
+        break;
+    }
+    default:
+        break;
+    }
+    RefPtr<PipelineStateBase> specializedPipelineState =
+        static_cast<PipelineStateBase*>(specializedPipelineComPtr.get());
+    specializedPipelineState->unspecializedPipelineState = unspecializedPipeline;
+    outPipeline = specializedPipelineState;
+    return SLANG_OK;
+}
+
+Result RendererBase::getSpecializedPipeline(
+    PipelineStateBase* unspecializedPipeline,
+    const ExtendedShaderObjectTypeList& args,
+    RefPtr<PipelineStateBase>& outPipeline,
+    RefPtr<PipelineSpecializationTask>& outTask)
+{
+    // Construct a shader cache key that represents the specialized shader kernels.
+    PipelineKey pipelineKey;
+    pipelineKey.pipeline = unspecializedPipeline;
+    pipelineKey.specializationArgs.addRange(args.componentIDs);
+    pipelineKey.updateHash();
+
+    // Try to find specialized pipeline from shader cache.
+    outPipeline = shaderCache.getSpecializedPipelineState(pipelineKey);
+    if (outPipeline)
+    {
+        return SLANG_OK;
+    }
+
+    if (!m_specializationThreadPool)
+    {
+        SLANG_RETURN_ON_FAIL(createSpecializedPipeline(unspecializedPipeline, args, outPipeline));
+        shaderCache.addSpecializedPipeline(pipelineKey, outPipeline);
+        return SLANG_OK;
+    }
+
+    if (auto task = shaderCache.getSpecializationTask(pipelineKey))
+    {
+        if (!task->isComplete())
+        {
+            outTask = task;
+            return SLANG_E_PENDING;
+        }
+
+        // The task is removed here rather than when it completes, so that the references it holds are
+        // released on this thread. If building failed, the next use of the pipeline will try again.
+        shaderCache.removeSpecializationTask(pipelineKey);
+        SLANG_RETURN_ON_FAIL(task->wait());
+        shaderCache.addSpecializedPipeline(pipelineKey, task->specializedPipeline);
+        outPipeline = task->specializedPipeline;
+        return SLANG_OK;
+    }
+
+    RefPtr<PipelineSpecializationTask> task = new PipelineSpecializationTask();
+    task->unspecializedPipeline = unspecializedPipeline;
+    task->specializationArgs.addRange(args);
+    shaderCache.addSpecializationTask(pipelineKey, task);
+
+    // The shader cache holds the task alive until it's removed on this thread, which can only happen once
+    // it's complete, so a raw pointer can be used here.
+    PipelineSpecializationTask* taskPtr = task;
+    m_specializationThreadPool->submit([this, taskPtr]()
+        {
+            RefPtr<PipelineStateBase> specializedPipeline;
+            Result result = createSpecializedPipeline(
+                taskPtr->unspecializedPipeline, taskPtr->specializationArgs, specializedPipeline);
+            if (SLANG_SUCCEEDED(result))
+            {
+                result = prepareSpecializedPipeline(specializedPipeline);
+            }
+            taskPtr->specializedPipeline = specializedPipeline;
+            specializedPipeline = nullptr;
+            taskPtr->complete(result);
+        });
+
+    outTask = task;
+    return SLANG_E_PENDING;
+}
+
 Result RendererBase::maybeSpecializePipeline(
     PipelineStateBase* currentPipeline,
     ShaderObjectBase* rootObject,
     RefPtr<PipelineStateBase>& outNewPipeline)
 {
     outNewPipeline = static_cast<PipelineStateBase*>(currentPipeline);
-    
-    auto pipelineType = currentPipeline->desc.type;
+
     if (currentPipeline->unspecializedPipelineState)
         currentPipeline = currentPipeline->unspecializedPipelineState;
     // If the currently bound pipeline is specializable, we need to specialize it based on bound shader objects.
@@ -901,89 +1239,95 @@ Result RendererBase::maybeSpecializePipeline(
         specializationArgs.clear();
         SLANG_RETURN_ON_FAIL(rootObject->collectSpecializationArgs(specializationArgs));
 
-        // Construct a shader cache key that represents the specialized shader kernels.
-        PipelineKey pipelineKey;
-        pipelineKey.pipeline = currentPipeline;
-        pipelineKey.specializationArgs.addRange(specializationArgs.componentIDs);
-        pipelineKey.updateHash();
-
-        RefPtr<PipelineStateBase> specializedPipelineState = shaderCache.getSpecializedPipelineState(pipelineKey);
-        // Try to find specialized pipeline from shader cache.
-        if (!specializedPipelineState)
+        RefPtr<PipelineStateBase> specializedPipeline;
+        RefPtr<PipelineSpecializationTask> task;
+        auto result = getSpecializedPipeline(currentPipeline, specializationArgs, specializedPipeline, task);
+        if (result == SLANG_E_PENDING)
         {
-            auto unspecializedProgram = static_cast<ShaderProgramBase*>(pipelineType == PipelineType::Compute
-                ? currentPipeline->desc.compute.program
-                : currentPipeline->desc.graphics.program);
-            auto unspecializedProgramLayout = unspecializedProgram->linkedProgram->getLayout();
-
-            ComPtr<slang::IComponentType> specializedComponentType;
-            ComPtr<slang::IBlob> diagnosticBlob;
-            auto compileRs = unspecializedProgram->linkedProgram->specialize(
-                specializationArgs.components.getArrayView().getBuffer(),
-                specializationArgs.getCount(),
-                specializedComponentType.writeRef(),
-                diagnosticBlob.writeRef());
-            if (diagnosticBlob)
+            // Use the fallback until the specialized pipeline is ready. Without one, the caller skips the call.
+            if (!currentPipeline->specializationFallback)
             {
-                getDebugCallback()->handleMessage(
-                    compileRs == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
-                    DebugMessageSource::Slang,
-                    (char*)diagnosticBlob->getBufferPointer());
+                return SLANG_E_PENDING;
             }
-            SLANG_RETURN_ON_FAIL(compileRs);
+            return getFallbackPipeline(currentPipeline, outNewPipeline);
+        }
+        SLANG_RETURN_ON_FAIL(result);
+        outNewPipeline = specializedPipeline;
+    }
+    return SLANG_OK;
+}
 
-            // Now create the specialized shader program using compiled binaries.
-            ComPtr<IShaderProgram> specializedProgram;
-            IShaderProgram::Desc specializedProgramDesc = unspecializedProgram->desc;
-            specializedProgramDesc.slangGlobalScope = specializedComponentType;
+Result RendererBase::getFallbackPipeline(
+    PipelineStateBase* unspecializedPipeline,
+    RefPtr<PipelineStateBase>& outPipeline)
+{
+    outPipeline = shaderCache.getFallbackPipeline(unspecializedPipeline);
+    if (outPipeline)
+    {
+        return SLANG_OK;
+    }
 
-            if (specializedProgramDesc.linkingStyle == IShaderProgram::LinkingStyle::SingleProgram)
-            {
-                // When linking style is GraphicsCompute, the specialized global scope already contains
-                // entry-points, so we do not need to supply them again when creating the specialized
-                // pipeline.
-                specializedProgramDesc.entryPointCount = 0;
-            }
-            SLANG_RETURN_ON_FAIL(createProgram(specializedProgramDesc, specializedProgram.writeRef()));
+    // The fallback is used through a pipeline of its own, that records the pipeline it stands in for as its
+    // `unspecializedPipelineState`. Devices replace their current pipeline with the one they were given to
+    // use, so that is how the specialized pipeline is found once it's ready.
+    auto fallback = unspecializedPipeline->specializationFallback;
+    ComPtr<IPipelineState> fallbackComPtr;
+    switch (fallback->desc.type)
+    {
+    case PipelineType::Compute:
+        SLANG_RETURN_ON_FAIL(createComputePipelineState(fallback->desc.compute, fallbackComPtr.writeRef()));
+        break;
+    case PipelineType::Graphics:
+        SLANG_RETURN_ON_FAIL(createGraphicsPipelineState(fallback->desc.graphics, fallbackComPtr.writeRef()));
+        break;
+    default:
+        return SLANG_E_INVALID_ARG;
+    }
+    outPipeline = static_cast<PipelineStateBase*>(fallbackComPtr.get());
+    outPipeline->unspecializedPipelineState = unspecializedPipeline;
+    shaderCache.addFallbackPipeline(unspecializedPipeline, outPipeline);
+    return SLANG_OK;
+}
 
-            // Create specialized pipeline state.
-            ComPtr<IPipelineState> specializedPipelineComPtr;
-            switch (pipelineType)
-            {
-            case PipelineType::Compute:
-            {
-                auto pipelineDesc = currentPipeline->desc.compute;
-                pipelineDesc.program = specializedProgram;
-                SLANG_RETURN_ON_FAIL(
-                    createComputePipelineState(pipelineDesc, specializedPipelineComPtr.writeRef()));
-                break;
-            }
-            case PipelineType::Graphics:
-            {
-                auto pipelineDesc = currentPipeline->desc.graphics;
-                pipelineDesc.program = static_cast<ShaderProgramBase*>(specializedProgram.get());
-                SLANG_RETURN_ON_FAIL(createGraphicsPipelineState(
-                    pipelineDesc, specializedPipelineComPtr.writeRef()));
-                break;
-            }
-            case PipelineType::RayTracing:
-            {
-                auto pipelineDesc = currentPipeline->desc.rayTracing;
-                pipelineDesc.program = static_cast<ShaderProgramBase*>(specializedProgram.get());
-                SLANG_RETURN_ON_FAIL(createRayTracingPipelineState(
-                    pipelineDesc.get(), specializedPipelineComPtr.writeRef()));
-                break;
-            }
-            default:
-                break;
-            }
-            specializedPipelineState =
-                static_cast<PipelineStateBase*>(specializedPipelineComPtr.get());
-            specializedPipelineState->unspecializedPipelineState = currentPipeline;
-            shaderCache.addSpecializedPipeline(pipelineKey, specializedPipelineState);
+SLANG_NO_THROW Result SLANG_MCALL RendererBase::prewarmSpecializedPipeline(
+    IPipelineState* pipeline,
+    const slang::SpecializationArg* args,
+    GfxCount argCount,
+    IPipelineSpecializationTask** outTask)
+{
+    auto unspecializedPipeline = static_cast<PipelineStateBase*>(pipeline);
+    if (!unspecializedPipeline->isSpecializable)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    ExtendedShaderObjectTypeList typeArgs;
+    for (GfxIndex i = 0; i < argCount; ++i)
+    {
+        if (args[i].kind != slang::SpecializationArg::Kind::Type || !args[i].type)
+        {
+            return SLANG_E_INVALID_ARG;
         }
-        auto specializedPipelineStateBase = static_cast<PipelineStateBase*>(specializedPipelineState.Ptr());
-        outNewPipeline = specializedPipelineStateBase;
+        ExtendedShaderObjectType typeArg;
+        typeArg.slangType = args[i].type;
+        typeArg.componentID = shaderCache.getComponentId(args[i].type);
+        typeArgs.add(typeArg);
+    }
+
+    RefPtr<PipelineStateBase> specializedPipeline;
+    RefPtr<PipelineSpecializationTask> task;
+    auto result = getSpecializedPipeline(unspecializedPipeline, typeArgs, specializedPipeline, task);
+    if (result != SLANG_E_PENDING)
+    {
+        SLANG_RETURN_ON_FAIL(result);
+
+        // The pipeline is already built
+        task = new PipelineSpecializationTask();
+        task->complete(SLANG_OK);
+    }
+    if (outTask)
+    {
+        returnComPtr(outTask, task);
     }
     return SLANG_OK;
 }
@@ -4,7 +4,9 @@
 #include "slang-context.h"
 #include "core/slang-basic.h"
 #include "core/slang-com-object.h"
+#include "core/slang-thread-pool.h"
 
+#include "persistent-shader-cache.h"
 #include "resource-desc-utils.h"
 
 namespace gfx
@@ -40,6 +42,7 @@ struct GfxGUID
     static const Slang::Guid IID_IQueryPool;
     static const Slang::Guid IID_IAccelerationStructure;
     static const Slang::Guid IID_IFence;
+    static const Slang::Guid IID_IPipelineSpecializationTask;
     static const Slang::Guid IID_IShaderTable;
     static const Slang::Guid IID_IPipelineCreationAPIDispatcher;
     static const Slang::Guid IID_ID3D12TransientResourceHeap;
@@ -855,7 +858,7 @@ public:
         return false;
     }
 
-    Slang::Result compileShaders();
+    Slang::Result compileShaders(RendererBase* device);
     virtual Slang::Result createShaderModule(
         slang::EntryPointReflection* entryPointInfo, Slang::ComPtr<ISlangBlob> kernelCode);
 };
@@ -1015,6 +1018,9 @@ public:
     // Indicates whether this is a specializable pipeline. A specializable
     // pipeline cannot be used directly and must be specialized first.
     bool isSpecializable = false;
+
+    // The pipeline used while a specialization of this pipeline is being built in the background.
+    Slang::RefPtr<PipelineStateBase> specializationFallback;
     Slang::RefPtr<ShaderProgramBase> m_program;
     template <typename TProgram> TProgram* getProgram()
     {
@@ -1100,7 +1106,39 @@ struct OwningComponentKey
     }
 };
 
+// The building of a specialized pipeline, that may take place on a background thread.
+class PipelineSpecializationTask
+    : public IPipelineSpecializationTask
+    , public Slang::ComObject
+{
+public:
+    SLANG_COM_OBJECT_IUNKNOWN_ALL
+    IPipelineSpecializationTask* getInterface(const Slang::Guid& guid);
+
+    virtual SLANG_NO_THROW bool SLANG_MCALL isComplete() override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL wait() override;
+
+    // Called when the pipeline has been built (or failed to build). `specializedPipeline` must be set before
+    // calling, and after the call the task may be destroyed by another thread.
+    void complete(Result result);
+
+    // The inputs of the task
+    Slang::RefPtr<PipelineStateBase> unspecializedPipeline;
+    ExtendedShaderObjectTypeList specializationArgs;
+
+    // Set when the task completes successfully
+    Slang::RefPtr<PipelineStateBase> specializedPipeline;
+
+protected:
+    std::mutex m_mutex;
+    std::condition_variable m_completed;
+    bool m_isComplete = false;
+    Result m_result = SLANG_E_PENDING;
+};
+
 // A cache from specialization keys to a specialized `ShaderKernel`.
+// The cache may be used from the threads that build specialized pipelines in the background, so access to the
+// component ids and pipelines is guarded by a mutex.
 class ShaderCache : public Slang::RefObject
 {
 public:
@@ -1110,6 +1148,7 @@ public:
 
     Slang::RefPtr<PipelineStateBase> getSpecializedPipelineState(PipelineKey programKey)
     {
+        std::lock_guard<std::mutex> lock(m_mutex);
         Slang::RefPtr<PipelineStateBase> result;
         if (specializedPipelines.TryGetValue(programKey, result))
             return result;
@@ -1118,15 +1157,37 @@ public:
     void addSpecializedPipeline(
         PipelineKey key,
         Slang::RefPtr<PipelineStateBase> specializedPipeline);
+
+    // Get the task building the specialized pipeline for key, or nullptr if there isn't one.
+    Slang::RefPtr<PipelineSpecializationTask> getSpecializationTask(PipelineKey key);
+    void addSpecializationTask(PipelineKey key, PipelineSpecializationTask* task);
+    void removeSpecializationTask(PipelineKey key);
+
+    Slang::RefPtr<PipelineStateBase> getFallbackPipeline(PipelineStateBase* unspecializedPipeline);
+    void addFallbackPipeline(PipelineStateBase* unspecializedPipeline, PipelineStateBase* fallbackPipeline);
+
     void free()
     {
         specializedPipelines = decltype(specializedPipelines)();
+        specializationTasks = decltype(specializationTasks)();
+        fallbackPipelines = decltype(fallbackPipelines)();
         componentIds = decltype(componentIds)();
+        persistentCache = nullptr;
     }
 
+    // A cache of compiled kernels held on disk, that persists between runs. Only set if the device was
+    // created with a `shaderCacheFileSystem`.
+    Slang::RefPtr<PersistentShaderCache> persistentCache;
+
 protected:
     Slang::OrderedDictionary<OwningComponentKey, ShaderComponentID> componentIds;
     Slang::OrderedDictionary<PipelineKey, Slang::RefPtr<PipelineStateBase>> specializedPipelines;
+    // Specialized pipelines that are being built in the background. A task is only removed on the thread that
+    // uses the device, such that objects the task references are never released on a background thread.
+    Slang::Dictionary<PipelineKey, Slang::RefPtr<PipelineSpecializationTask>> specializationTasks;
+    // The pipelines used in place of the specializations of a pipeline while they are being built.
+    Slang::Dictionary<PipelineStateBase*, Slang::RefPtr<PipelineStateBase>> fallbackPipelines;
+    std::mutex m_mutex;
 };
 
 class TransientResourceHeapBase : public ITransientResourceHeap, public Slang::ComObject
@@ -1294,25 +1355,79 @@ public:
     // Provides a default implementation that returns SLANG_E_NOT_AVAILABLE.
     virtual SLANG_NO_THROW Result SLANG_MCALL getTextureRowAlignment(size_t* outAlignment) override;
 
+    virtual SLANG_NO_THROW Result SLANG_MCALL prewarmSpecializedPipeline(
+        IPipelineState* pipeline,
+        const slang::SpecializationArg* args,
+        GfxCount argCount,
+        IPipelineSpecializationTask** outTask) override;
+
+    // Get the layout of shader objects of `type`. A layout that has been created before is found without
+    // calling into Slang, and so without waiting for pipelines being built in the background.
     Result getShaderObjectLayout(
         slang::TypeReflection*      type,
         ShaderObjectContainerType   container,
         ShaderObjectLayoutBase**    outLayout);
 
+    // Get the layout of shader objects with `typeLayout`. Must be called holding `m_slangMutex`.
     Result getShaderObjectLayout(
         slang::TypeLayoutReflection* typeLayout,
         ShaderObjectLayoutBase** outLayout);
 
+    // Get the kernel code for an entry point of `program`. The code is read from the persistent shader cache
+    // if it holds it, otherwise it is compiled and then saved to the cache. `m_slangMutex` is only held while
+    // Slang is used, and not while the cache is read or written.
+    Result getEntryPointCode(
+        slang::IComponentType* program,
+        SlangInt entryPointIndex,
+        SlangInt targetIndex,
+        ISlangBlob** outCode,
+        ISlangBlob** outDiagnostics);
+
 public:
     ExtendedShaderObjectTypeList specializationArgs;
     // Given current pipeline and root shader object binding, generate and bind a specialized pipeline if necessary.
     // The newly specialized pipeline is held alive by the pipeline cache so users of `outNewPipeline` do not
     // need to maintain its lifespan.
+    // If the specialized pipeline is being built in the background, `outNewPipeline` is the `specializationFallback`
+    // of the pipeline, or if it has none SLANG_E_PENDING is returned and the call using the pipeline should be skipped.
     Result maybeSpecializePipeline(
         PipelineStateBase* currentPipeline,
         ShaderObjectBase* rootObject,
         Slang::RefPtr<PipelineStateBase>& outNewPipeline);
 
+    // Get the specialization of `unspecializedPipeline` for `args`, building it if it hasn't been built. When
+    // building in the background, returns SLANG_E_PENDING and the building task in `outTask` until it's complete.
+    Result getSpecializedPipeline(
+        PipelineStateBase* unspecializedPipeline,
+        const ExtendedShaderObjectTypeList& args,
+        Slang::RefPtr<PipelineStateBase>& outPipeline,
+        Slang::RefPtr<PipelineSpecializationTask>& outTask);
+
+    // Get the pipeline that stands in for the specializations of `unspecializedPipeline` while they are being built.
+    Result getFallbackPipeline(
+        PipelineStateBase* unspecializedPipeline,
+        Slang::RefPtr<PipelineStateBase>& outPipeline);
+
+    // Build the specialization of `unspecializedPipeline` for `args`.
+    Result createSpecializedPipeline(
+        PipelineStateBase* unspecializedPipeline,
+        const ExtendedShaderObjectTypeList& args,
+        Slang::RefPtr<PipelineStateBase>& outPipeline);
+
+    // Returns true if pipelines can be built on a thread other than the one using the device.
+    virtual bool supportsBackgroundPipelineSpecialization() { return true; }
+
+    // Called on a background thread for a specialized pipeline it has built, to create anything that would
+    // otherwise be created when the pipeline is first used.
+    virtual Result prepareSpecializedPipeline(PipelineStateBase* pipeline)
+    {
+        return pipeline->ensureAPIPipelineStateCreated();
+    }
+
+    // Waits for specialized pipelines being built in the background, and stops the threads building them.
+    // Must be called by the destructor of a device, before any state used to build pipelines is destroyed.
+    void finishPipelineSpecialization();
+
 
     virtual Result createShaderObjectLayout(
         slang::TypeLayoutReflection* typeLayout,
@@ -1335,7 +1450,33 @@ public:
     SlangContext slangContext;
     ShaderCache shaderCache;
 
+    // A Slang session can't be used by more than one thread at a time, and the component types a device uses
+    // can only be used with its session, so the calls into Slang that can be made on the threads building
+    // specialized pipelines hold this mutex. It's recursive because creating the layout of a program calls
+    // back into the device to get the layouts of its parameters. It isn't held while kernels are read from
+    // the persistent shader cache, or while API objects are created.
+    std::recursive_mutex m_slangMutex;
+    // The threads that build specialized pipelines, if they are built in the background.
+    Slang::RefPtr<Slang::ThreadPool> m_specializationThreadPool;
+
+    struct ShaderObjectTypeKey
+    {
+        slang::TypeReflection* type;
+        ShaderObjectContainerType container;
+        bool operator==(const ShaderObjectTypeKey& other) const
+        {
+            return type == other.type && container == other.container;
+        }
+        Slang::HashCode getHashCode() const
+        {
+            return Slang::combineHash(Slang::getHashCode(type), Slang::HashCode(container));
+        }
+    };
+
+    // Guards the layout caches. Only held to look up or add a layout, never while one is created.
+    std::mutex m_shaderObjectLayoutCacheMutex;
     Slang::Dictionary<slang::TypeLayoutReflection*, Slang::RefPtr<ShaderObjectLayoutBase>> m_shaderObjectLayoutCache;
+    Slang::Dictionary<ShaderObjectTypeKey, Slang::RefPtr<ShaderObjectLayoutBase>> m_shaderObjectLayoutByTypeCache;
     Slang::ComPtr<IPipelineCreationAPIDispatcher> m_pipelineCreationAPIDispatcher;
 };
 
@@ -188,15 +188,15 @@ Result PipelineCommandEncoder::setPipelineStateWithRootObjectImpl(
     return SLANG_OK;
 }
 
-void PipelineCommandEncoder::bindRenderState(VkPipelineBindPoint pipelineBindPoint)
+Result PipelineCommandEncoder::bindRenderState(VkPipelineBindPoint pipelineBindPoint)
 {
     auto& api = *m_api;
 
     // Get specialized pipeline state and bind it.
     //
     RefPtr<PipelineStateBase> newPipeline;
-    m_device->maybeSpecializePipeline(
-        m_currentPipeline, &m_commandBuffer->m_rootObject, newPipeline);
+    SLANG_RETURN_ON_FAIL(m_device->maybeSpecializePipeline(
+        m_currentPipeline, &m_commandBuffer->m_rootObject, newPipeline));
     PipelineStateImpl* newPipelineImpl = static_cast<PipelineStateImpl*>(newPipeline.Ptr());
 
     newPipelineImpl->ensureAPIPipelineStateCreated();
@@ -210,6 +210,7 @@ void PipelineCommandEncoder::bindRenderState(VkPipelineBindPoint pipelineBindPoi
         api.vkCmdBindPipeline(m_vkCommandBuffer, pipelineBindPoint, newPipelineImpl->m_pipeline);
         m_boundPipelines[pipelineBindPointId] = newPipelineImpl->m_pipeline;
     }
+    return SLANG_OK;
 }
 
 void ResourceCommandEncoder::copyBuffer(
@@ -1084,20 +1085,21 @@ void RenderCommandEncoder::setIndexBuffer(
         m_vkCommandBuffer, bufferImpl->m_buffer.m_buffer, (VkDeviceSize)offset, indexType);
 }
 
-void RenderCommandEncoder::prepareDraw()
+Result RenderCommandEncoder::prepareDraw()
 {
     auto pipeline = static_cast<PipelineStateImpl*>(m_currentPipeline.Ptr());
     if (!pipeline)
     {
         assert(!"Invalid render pipeline");
-        return;
+        return SLANG_FAIL;
     }
-    bindRenderState(VK_PIPELINE_BIND_POINT_GRAPHICS);
+    return bindRenderState(VK_PIPELINE_BIND_POINT_GRAPHICS);
 }
 
 void RenderCommandEncoder::draw(GfxCount vertexCount, GfxIndex startVertex)
 {
-    prepareDraw();
+    if (SLANG_FAILED(prepareDraw()))
+        return;
     auto& api = *m_api;
     api.vkCmdDraw(m_vkCommandBuffer, vertexCount, 1, 0, 0);
 }
@@ -1105,7 +1107,8 @@ void RenderCommandEncoder::draw(GfxCount vertexCount, GfxIndex startVertex)
 void RenderCommandEncoder::drawIndexed(
     GfxCount indexCount, GfxIndex startIndex, GfxIndex baseVertex)
 {
-    prepareDraw();
+    if (SLANG_FAILED(prepareDraw()))
+        return;
     auto& api = *m_api;
     api.vkCmdDrawIndexed(m_vkCommandBuffer, indexCount, 1, startIndex, baseVertex, 0);
 }
@@ -1126,7 +1129,8 @@ void RenderCommandEncoder::drawIndirect(
     // Vulkan does not support sourcing the count from a buffer.
     assert(!countBuffer);
 
-    prepareDraw();
+    if (SLANG_FAILED(prepareDraw()))
+        return;
     auto& api = *m_api;
     auto argBufferImpl = static_cast<BufferResourceImpl*>(argBuffer);
     api.vkCmdDrawIndirect(
@@ -1147,7 +1151,8 @@ void RenderCommandEncoder::drawIndexedIndirect(
     // Vulkan does not support sourcing the count from a buffer.
     assert(!countBuffer);
 
-    prepareDraw();
+    if (SLANG_FAILED(prepareDraw()))
+        return;
     auto& api = *m_api;
     auto argBufferImpl = static_cast<BufferResourceImpl*>(argBuffer);
     api.vkCmdDrawIndexedIndirect(
@@ -1179,7 +1184,8 @@ void RenderCommandEncoder::drawInstanced(
     GfxIndex startVertex,
     GfxIndex startInstanceLocation)
 {
-    prepareDraw();
+    if (SLANG_FAILED(prepareDraw()))
+        return;
     auto& api = *m_api;
     api.vkCmdDraw(
         m_vkCommandBuffer, vertexCount, instanceCount, startVertex, startInstanceLocation);
@@ -1192,7 +1198,8 @@ void RenderCommandEncoder::drawIndexedInstanced(
     GfxIndex baseVertexLocation,
     GfxIndex startInstanceLocation)
 {
-    prepareDraw();
+    if (SLANG_FAILED(prepareDraw()))
+        return;
     auto& api = *m_api;
     api.vkCmdDrawIndexed(
         m_vkCommandBuffer,
@@ -1227,7 +1234,8 @@ void ComputeCommandEncoder::dispatchCompute(int x, int y, int z)
     }
 
     // Also create descriptor sets based on the given pipeline layout
-    bindRenderState(VK_PIPELINE_BIND_POINT_COMPUTE);
+    if (SLANG_FAILED(bindRenderState(VK_PIPELINE_BIND_POINT_COMPUTE)))
+        return;
     m_api->vkCmdDispatch(m_vkCommandBuffer, x, y, z);
 }
 
@@ -1449,7 +1457,8 @@ void RayTracingCommandEncoder::dispatchRays(
     auto vkApi = m_commandBuffer->m_renderer->m_api;
     auto vkCommandBuffer = m_commandBuffer->m_commandBuffer;
 
-    bindRenderState(VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR);
+    if (SLANG_FAILED(bindRenderState(VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR)))
+        return;
 
     auto rtProps = vkApi.m_rtProperties;
     auto shaderTableImpl = (ShaderTableImpl*)shaderTable;
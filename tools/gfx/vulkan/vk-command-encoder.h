@@ -46,7 +46,9 @@ public:
 
     Result setPipelineStateWithRootObjectImpl(IPipelineState* state, IShaderObject* inObject);
 
-    void bindRenderState(VkPipelineBindPoint pipelineBindPoint);
+    // Returns SLANG_E_PENDING if the call using the render state should be skipped, because a specialized
+    // pipeline without a fallback is being built.
+    Result bindRenderState(VkPipelineBindPoint pipelineBindPoint);
 };
 
 class ResourceCommandEncoder
@@ -185,7 +187,7 @@ public:
     virtual SLANG_NO_THROW void SLANG_MCALL
         setIndexBuffer(IBufferResource* buffer, Format indexFormat, Offset offset = 0) override;
 
-    void prepareDraw();
+    Result prepareDraw();
 
     virtual SLANG_NO_THROW void SLANG_MCALL
         draw(GfxCount vertexCount, GfxIndex startVertex = 0) override;
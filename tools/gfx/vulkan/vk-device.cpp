@@ -28,6 +28,8 @@ namespace vk
 
 DeviceImpl::~DeviceImpl()
 {
+    finishPipelineSpecialization();
+
     // Check the device queue is valid else, we can't wait on it..
     if (m_deviceQueue.isValid())
     {
@@ -1930,10 +1932,12 @@ Result DeviceImpl::createInputLayout(IInputLayout::Desc const& desc, IInputLayou
 Result DeviceImpl::createProgram(
     const IShaderProgram::Desc& desc, IShaderProgram** outProgram, ISlangBlob** outDiagnosticBlob)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_slangMutex);
+
     RefPtr<ShaderProgramImpl> shaderProgram = new ShaderProgramImpl(this);
     shaderProgram->init(desc);
 
-    m_deviceObjectsWithPotentialBackReferences.add(shaderProgram);
+    addDeviceObjectWithPotentialBackReferences(shaderProgram);
 
     RootShaderObjectLayout::create(
         this,
@@ -2000,7 +2004,7 @@ Result DeviceImpl::createGraphicsPipelineState(
     RefPtr<PipelineStateImpl> pipelineStateImpl = new PipelineStateImpl(this);
     pipelineStateImpl->init(desc);
     pipelineStateImpl->establishStrongDeviceReference();
-    m_deviceObjectsWithPotentialBackReferences.add(pipelineStateImpl);
+    addDeviceObjectWithPotentialBackReferences(pipelineStateImpl);
     returnComPtr(outState, pipelineStateImpl);
 
     return SLANG_OK;
@@ -2012,7 +2016,7 @@ Result DeviceImpl::createComputePipelineState(
     ComputePipelineStateDesc desc = inDesc;
     RefPtr<PipelineStateImpl> pipelineStateImpl = new PipelineStateImpl(this);
     pipelineStateImpl->init(desc);
-    m_deviceObjectsWithPotentialBackReferences.add(pipelineStateImpl);
+    addDeviceObjectWithPotentialBackReferences(pipelineStateImpl);
     pipelineStateImpl->establishStrongDeviceReference();
     returnComPtr(outState, pipelineStateImpl);
     return SLANG_OK;
@@ -2023,7 +2027,7 @@ Result DeviceImpl::createRayTracingPipelineState(
 {
     RefPtr<RayTracingPipelineStateImpl> pipelineStateImpl = new RayTracingPipelineStateImpl(this);
     pipelineStateImpl->init(desc);
-    m_deviceObjectsWithPotentialBackReferences.add(pipelineStateImpl);
+    addDeviceObjectWithPotentialBackReferences(pipelineStateImpl);
     pipelineStateImpl->establishStrongDeviceReference();
     returnComPtr(outState, pipelineStateImpl);
     return SLANG_OK;
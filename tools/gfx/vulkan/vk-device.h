@@ -194,6 +194,14 @@ public:
     // worrying the `ShaderProgramImpl` object getting destroyed after the completion of
     // `DeviceImpl::~DeviceImpl()'.
     ChunkedList<RefPtr<RefObject>, 1024> m_deviceObjectsWithPotentialBackReferences;
+    // Guards `m_deviceObjectsWithPotentialBackReferences`, since pipelines may be created by the threads
+    // that build specialized pipelines in the background.
+    std::mutex m_deviceObjectsMutex;
+    void addDeviceObjectWithPotentialBackReferences(RefObject* object)
+    {
+        std::lock_guard<std::mutex> lock(m_deviceObjectsMutex);
+        m_deviceObjectsWithPotentialBackReferences.add(object);
+    }
 
     VkSampler m_defaultSampler;
 
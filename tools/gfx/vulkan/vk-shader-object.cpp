@@ -1217,6 +1217,7 @@ Result RootShaderObjectImpl::_createSpecializedLayout(ShaderObjectLayoutImpl** o
     // points that had already been loaded (in contrast to a compose-then-specialize
     // approach).
     //
+    std::lock_guard<std::recursive_mutex> slangLock(getRenderer()->m_slangMutex);
     ComPtr<slang::IComponentType> specializedComponentType;
     ComPtr<slang::IBlob> diagnosticBlob;
     auto result = getLayout()->getSlangProgram()->specialize(
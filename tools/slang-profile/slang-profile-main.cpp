@@ -3,32 +3,224 @@
 #include "../../source/core/slang-io.h"
 #include "../../source/core/slang-std-writers.h"
 
-#include "../../source/core/slang-process-util.h"
+#include "../../source/core/slang-process.h"
 
 #include "../../slang-com-helper.h"
+#include "../../slang-com-ptr.h"
 
 #include "../../source/core/slang-string-util.h"
+#include "../../source/core/slang-flat-dictionary.h"
 
 using namespace Slang;
 
+namespace { // anonymous
+
+struct Timer
+{
+    Timer() : m_startTick(Process::getClockTick()) {}
+        /// Get the time since construction in milliseconds
+    double getElapsedMs() const { return double(Process::getClockTick() - m_startTick) * 1000.0 / double(Process::getClockFrequency()); }
+
+    uint64_t m_startTick;
+};
+
+} // anonymous
+
+static void _report(const char* name, double timeMs)
+{
+    printf("%-36s %10.3f ms\n", name, timeMs);
+}
+
+static SlangResult _compileShader(slang::IGlobalSession* session)
+{
+    // A minimal shader, so the time is mostly the fixed cost of a compilation
+    const char* source = R"(
+        RWStructuredBuffer<float> buffer;
+        [numthreads(4,1,1)]
+        void computeMain(uint3 id : SV_DispatchThreadID)
+        {
+            buffer[id.x] = buffer[id.x] * 2.0;
+        })";
+
+    auto request = spCreateCompileRequest(session);
+
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "profile.slang", source);
+    spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SlangResult res = spCompile(request);
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+template <typename TDictionary, typename TKey, typename TLookup>
+static void _profileDictionary(const char* name, const List<TKey>& keys, const List<TLookup>& lookups)
+{
+    const Int repeatCount = 16;
+
+    double addMs = 0.0;
+    double findMs = 0.0;
+    Index foundCount = 0;
+
+    for (Int i = 0; i < repeatCount; ++i)
+    {
+        TDictionary dict;
+        {
+            Timer timer;
+            for (Index j = 0; j < keys.getCount(); ++j)
+            {
+                dict.Add(keys[j], j);
+            }
+            addMs += timer.getElapsedMs();
+        }
+        {
+            Timer timer;
+            // Half of the lookups find a key, and half miss
+            for (const auto& lookup : lookups)
+            {
+                foundCount += dict.ContainsKey(lookup) ? 1 : 0;
+            }
+            findMs += timer.getElapsedMs();
+        }
+    }
+
+    SLANG_ASSERT(foundCount == repeatCount * keys.getCount());
+
+    StringBuilder buf;
+    buf << name << " add (average)";
+    _report(buf.getBuffer(), addMs / repeatCount);
+    buf.Clear();
+    buf << name << " find (average)";
+    _report(buf.getBuffer(), findMs / repeatCount);
+}
+
+    /// Compare Dictionary against FlatDictionary with key types typical of the compiler's hot maps
+static void _profileDictionaries()
+{
+    const Index keyCount = 100000;
+
+    // Pointer keys, as used for caches keyed by IR instructions or declarations
+    {
+        List<int> values;
+        values.setCount(keyCount * 2);
+
+        List<int*> keys;
+        List<int*> lookups;
+        for (Index i = 0; i < keyCount; ++i)
+        {
+            keys.add(&values[i * 2]);
+            lookups.add(&values[i * 2]);
+            lookups.add(&values[i * 2 + 1]);
+        }
+
+        _profileDictionary<Dictionary<int*, Index>>("Dictionary<int*>", keys, lookups);
+        _profileDictionary<FlatDictionary<int*, Index>>("FlatDictionary<int*>", keys, lookups);
+    }
+
+    // String slice keys, as used for mangled name lookups
+    {
+        List<String> names;
+        for (Index i = 0; i < keyCount; ++i)
+        {
+            StringBuilder buf;
+            buf << "_S" << i << "_globalValue";
+            names.add(buf.ProduceString());
+            names.add(names.getLast() + "Missing");
+        }
+
+        List<UnownedStringSlice> keys;
+        List<UnownedStringSlice> lookups;
+        for (Index i = 0; i < names.getCount(); ++i)
+        {
+            if ((i & 1) == 0)
+            {
+                keys.add(names[i].getUnownedSlice());
+            }
+            lookups.add(names[i].getUnownedSlice());
+        }
+
+        _profileDictionary<Dictionary<UnownedStringSlice, Index>>("Dictionary<slice>", keys, lookups);
+        _profileDictionary<FlatDictionary<UnownedStringSlice, Index>>("FlatDictionary<slice>", keys, lookups);
+    }
+}
+
 SlangResult innerMain(int argc, char** argv)
 {
+    SLANG_UNUSED(argc);
+    SLANG_UNUSED(argv);
+
     auto stdWriters = StdWriters::initDefaultSingleton();
+    SLANG_UNUSED(stdWriters);
 
-    // Time the creation of the session
-    {
-        const auto startTick = ProcessUtil::getClockTick();
+    _profileDictionaries();
+
+    const Int sessionCount = 32;
 
-        for (Int i = 0; i < 32; ++i)
+    // Time the creation of the session, as an application would typically create it
+    {
+        Timer timer;
+        for (Int i = 0; i < sessionCount; ++i)
         {
             ComPtr<slang::IGlobalSession> slangSession;
             slangSession.attach(spCreateSession(nullptr));
         }
+        _report("spCreateSession (average)", timer.getElapsedMs() / sessionCount);
+    }
+
+    // Time each of the stages of producing a session with the stdlib
+    ComPtr<ISlangBlob> stdLibBlob;
+    {
+        ComPtr<slang::IGlobalSession> slangSession;
+        {
+            Timer timer;
+            SLANG_RETURN_ON_FAIL(slang_createGlobalSessionWithoutStdLib(SLANG_API_VERSION, slangSession.writeRef()));
+            _report("create without stdlib", timer.getElapsedMs());
+        }
+        {
+            Timer timer;
+            SLANG_RETURN_ON_FAIL(slangSession->compileStdLib(0));
+            _report("compileStdLib", timer.getElapsedMs());
+        }
+        {
+            Timer timer;
+            SLANG_RETURN_ON_FAIL(slangSession->saveStdLib(SLANG_ARCHIVE_TYPE_RIFF_LZ4, stdLibBlob.writeRef()));
+            _report("saveStdLib", timer.getElapsedMs());
+        }
+    }
+
+    // Time loading the stdlib, and the compilations that follow, which pay for any parts of
+    // the stdlib that are only read when first used
+    {
+        double loadMs = 0.0;
+        double firstCompileMs = 0.0;
+        double secondCompileMs = 0.0;
 
-        const auto endTick = ProcessUtil::getClockTick();
+        for (Int i = 0; i < sessionCount; ++i)
+        {
+            ComPtr<slang::IGlobalSession> slangSession;
+            SLANG_RETURN_ON_FAIL(slang_createGlobalSessionWithoutStdLib(SLANG_API_VERSION, slangSession.writeRef()));
+            {
+                Timer timer;
+                SLANG_RETURN_ON_FAIL(slangSession->loadStdLib(stdLibBlob->getBufferPointer(), stdLibBlob->getBufferSize()));
+                loadMs += timer.getElapsedMs();
+            }
+            {
+                Timer timer;
+                SLANG_RETURN_ON_FAIL(_compileShader(slangSession));
+                firstCompileMs += timer.getElapsedMs();
+            }
+            {
+                Timer timer;
+                SLANG_RETURN_ON_FAIL(_compileShader(slangSession));
+                secondCompileMs += timer.getElapsedMs();
+            }
+        }
 
-        printf("Ticks %f\n", double(endTick - startTick) / ProcessUtil::getClockFrequency());
-        return SLANG_OK;
+        _report("loadStdLib (average)", loadMs / sessionCount);
+        _report("first compile after load (average)", firstCompileMs / sessionCount);
+        _report("second compile (average)", secondCompileMs / sessionCount);
     }
 
     return SLANG_OK;
@@ -1489,10 +1489,14 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
     {
         return TestResult::Fail;
     }
-    if (SLANG_FAILED(connection->waitForResult(-1)))
+    // Skip any diagnostics still being published for the document of an earlier test
+    do
     {
-        return TestResult::Fail;
-    }
+        if (SLANG_FAILED(connection->waitForResult(-1)))
+        {
+            return TestResult::Fail;
+        }
+    } while (connection->getMessageType() == JSONRPCMessageType::Call);
 
     LanguageServerProtocol::InitializeResult initResult;
     if (SLANG_FAILED(connection->getMessage(&initResult)))
@@ -1529,16 +1533,45 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
             connection->getRPC(&call);
             if (call.method == "textDocument/publishDiagnostics")
             {
-                diagnosticsReceived = true;
                 LanguageServerProtocol::PublishDiagnosticsParams arg;
-                if (SLANG_FAILED(connection->getMessage(&arg)))
+                if (SLANG_FAILED(connection->toNativeArgsOrSendError(call.params, &arg, call.id)))
                     return SLANG_FAIL;
-                diagnostics.add(arg);
+                // The server also publishes diagnostics for documents of earlier tests as they are closed
+                if (arg.uri == openDocParams.textDocument.uri)
+                {
+                    diagnosticsReceived = true;
+                    diagnostics.add(arg);
+                }
                 goto repeat;
             }
         }
         return SLANG_OK;
     };
+    // Diagnostics are published once the document has been checked in the background, without
+    // needing a request.
+    auto waitForDiagnostics = [&]() -> SlangResult
+    {
+        while (!diagnosticsReceived)
+        {
+            if (SLANG_FAILED(connection->waitForResult(-1)))
+                return SLANG_FAIL;
+            if (connection->getMessageType() != JSONRPCMessageType::Call)
+                continue;
+            JSONRPCCall call;
+            connection->getRPC(&call);
+            if (call.method != "textDocument/publishDiagnostics")
+                continue;
+            LanguageServerProtocol::PublishDiagnosticsParams arg;
+            if (SLANG_FAILED(connection->toNativeArgsOrSendError(call.params, &arg, call.id)))
+                return SLANG_FAIL;
+            if (arg.uri == openDocParams.textDocument.uri)
+            {
+                diagnosticsReceived = true;
+                diagnostics.add(arg);
+            }
+        }
+        return SLANG_OK;
+    };
 
     List<UnownedStringSlice> lines;
     StringUtil::calcLines(testFileContent.getUnownedSlice(), lines);
@@ -1552,6 +1585,39 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
         return startPos;
     };
     int callId = 2;
+    int documentVersion = 0;
+    // Make a change that appends a space to the document, so the locations in it are unchanged.
+    auto sendAppendSpace = [&](JSONRPCConnection* to) -> SlangResult
+    {
+        LanguageServerProtocol::TextDocumentContentChangeEvent change;
+        change.range.start.line = change.range.end.line = int(lines.getCount() - 1);
+        change.range.start.character = change.range.end.character = int(lines.getLast().getLength());
+        change.text = " ";
+        LanguageServerProtocol::DidChangeTextDocumentParams changeParams;
+        changeParams.textDocument.uri = openDocParams.textDocument.uri;
+        changeParams.textDocument.version = ++documentVersion;
+        changeParams.contentChanges.add(change);
+        return to->sendCall(LanguageServerProtocol::DidChangeTextDocumentParams::methodName, &changeParams);
+    };
+
+    // Other files in the directory of the test that are opened as documents, or written to disk, by the test.
+    // The arguments of a directive on them are separated by ':'.
+    const String testDirectory = Path::getParentDirectory(fullPath);
+    Dictionary<String, String> openedFileContents;
+    List<String> writtenFiles;
+    auto getFileURI = [&](const String& fileName)
+    {
+        return URI::fromLocalFilePath(Path::combine(testDirectory, fileName).getUnownedSlice()).uri;
+    };
+    auto splitDirectiveArg = [](UnownedStringSlice arg, UnownedStringSlice& outHead, UnownedStringSlice& outTail) -> bool
+    {
+        const Index index = arg.indexOf(':');
+        if (index < 0)
+            return false;
+        outHead = arg.head(index);
+        outTail = arg.tail(index + 1);
+        return true;
+    };
     for (auto line : lines)
     {
         if (line.startsWith("//COMPLETE:"))
@@ -1667,12 +1733,157 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
                 actualOutputSB << "\ncontent:\n" << hover.contents.value << "\n";
             }
         }
-        else if (line.startsWith("//DIAGNOSTICS"))
+        else if (line.startsWith("//CONTENT_MODIFIED:"))
         {
-            if (!diagnosticsReceived)
+            auto arg = line.tail(UnownedStringSlice("//CONTENT_MODIFIED:").getLength());
+            Int linePos, colPos;
+            parseLocation(arg, 0, linePos, colPos);
+
+            LanguageServerProtocol::HoverParams params;
+            params.position.line = int(linePos - 1);
+            params.position.character = int(colPos - 1);
+            params.textDocument.uri = openDocParams.textDocument.uri;
+
+            // A hover followed by a change to the document, which the server reads together, is
+            // answered with ContentModified. The messages are written to a buffer, and sent to the
+            // server in a single write, so it can't read one without the other.
+            RefPtr<OwnedMemoryStream> batchStream = new OwnedMemoryStream(FileAccess::Write);
+            RefPtr<JSONRPCConnection> batchConnection = new JSONRPCConnection();
+            batchConnection->init(
+                new HTTPPacketConnection(new BufferedReadStream(batchStream), batchStream),
+                JSONRPCConnection::CallStyle::Object);
+            const int hoverId = callId++;
+            if (SLANG_FAILED(batchConnection->sendCall(
+                    LanguageServerProtocol::HoverParams::methodName,
+                    &params,
+                    JSONValue::makeInt(hoverId))) ||
+                SLANG_FAILED(sendAppendSpace(batchConnection)))
             {
-                waitForNonDiagnosticResponse();
+                return TestResult::Fail;
+            }
+            auto batch = batchStream->getContents();
+            if (!connection->getProcess() ||
+                SLANG_FAILED(connection->getProcess()->getStream(StdStreamType::In)->write(
+                    batch.getBuffer(), batch.getCount())))
+            {
+                return TestResult::Fail;
             }
+            if (SLANG_FAILED(waitForNonDiagnosticResponse()))
+                return TestResult::Fail;
+            actualOutputSB << "--------\n";
+            JSONRPCErrorResponse errorResponse;
+            if (connection->getMessageType() == JSONRPCMessageType::Error &&
+                SLANG_SUCCEEDED(connection->getRPC(&errorResponse)))
+            {
+                actualOutputSB << "error: " << errorResponse.error.code << "\n";
+            }
+            else
+            {
+                actualOutputSB << "result\n";
+            }
+        }
+        else if (line.startsWith("//OPEN:"))
+        {
+            // Open another file as a document, with its content on disk
+            const String fileName = line.tail(UnownedStringSlice("//OPEN:").getLength()).trim();
+            String content;
+            if (SLANG_FAILED(File::readAllText(Path::combine(testDirectory, fileName), content)))
+                return TestResult::Fail;
+            LanguageServerProtocol::DidOpenTextDocumentParams params;
+            params.textDocument.uri = getFileURI(fileName);
+            params.textDocument.text = content;
+            if (SLANG_FAILED(connection->sendCall(
+                    LanguageServerProtocol::DidOpenTextDocumentParams::methodName, &params)))
+            {
+                return TestResult::Fail;
+            }
+            openedFileContents[fileName] = content;
+        }
+        else if (line.startsWith("//REPLACE:"))
+        {
+            // Replace the first occurrence of some text in a document opened with //OPEN:
+            // For example: //REPLACE:file.slang:old:new
+            UnownedStringSlice fileName, oldText, newText;
+            if (!splitDirectiveArg(line.tail(UnownedStringSlice("//REPLACE:").getLength()), fileName, newText) ||
+                !splitDirectiveArg(newText, oldText, newText))
+            {
+                return TestResult::Fail;
+            }
+            auto content = openedFileContents.TryGetValue(String(fileName));
+            const Index offset = content ? content->getUnownedSlice().indexOf(oldText) : -1;
+            if (offset < 0)
+                return TestResult::Fail;
+
+            LanguageServerProtocol::TextDocumentContentChangeEvent change;
+            const auto before = content->getUnownedSlice().head(offset);
+            change.range.start.line = 0;
+            for (auto c : before)
+                change.range.start.line += (c == '\n');
+            change.range.start.character = int(offset - (before.lastIndexOf('\n') + 1));
+            change.range.end = change.range.start;
+            change.range.end.character += int(oldText.getLength());
+            change.text = newText;
+            LanguageServerProtocol::DidChangeTextDocumentParams params;
+            params.textDocument.uri = getFileURI(String(fileName));
+            params.contentChanges.add(change);
+            if (SLANG_FAILED(connection->sendCall(
+                    LanguageServerProtocol::DidChangeTextDocumentParams::methodName, &params)))
+            {
+                return TestResult::Fail;
+            }
+            StringBuilder newContent;
+            newContent << before << newText << content->getUnownedSlice().tail(offset + oldText.getLength());
+            *content = newContent.ProduceString();
+        }
+        else if (line.startsWith("//WRITE:"))
+        {
+            // Write a line to a file, without the server being notified. It's removed at the end of the test.
+            // For example: //WRITE:file.slang:int value;
+            UnownedStringSlice fileName, text;
+            if (!splitDirectiveArg(line.tail(UnownedStringSlice("//WRITE:").getLength()), fileName, text) ||
+                SLANG_FAILED(File::writeAllText(Path::combine(testDirectory, String(fileName)), String(text) + "\n")))
+            {
+                return TestResult::Fail;
+            }
+            if (!writtenFiles.contains(String(fileName)))
+                writtenFiles.add(fileName);
+        }
+        else if (line.startsWith("//NOTIFY:"))
+        {
+            // Notify the server that a watched file was created, changed or deleted.
+            // For example: //NOTIFY:file.slang:changed
+            UnownedStringSlice fileName, type;
+            if (!splitDirectiveArg(line.tail(UnownedStringSlice("//NOTIFY:").getLength()), fileName, type))
+                return TestResult::Fail;
+            LanguageServerProtocol::FileEvent event;
+            event.uri = getFileURI(String(fileName));
+            type = type.trim();
+            if (type == "created")
+                event.type = LanguageServerProtocol::kFileChangeTypeCreated;
+            else if (type == "changed")
+                event.type = LanguageServerProtocol::kFileChangeTypeChanged;
+            else if (type == "deleted")
+                event.type = LanguageServerProtocol::kFileChangeTypeDeleted;
+            else
+                return TestResult::Fail;
+            LanguageServerProtocol::DidChangeWatchedFilesParams params;
+            params.changes.add(event);
+            if (SLANG_FAILED(connection->sendCall(
+                    LanguageServerProtocol::DidChangeWatchedFilesParams::methodName, &params)))
+            {
+                return TestResult::Fail;
+            }
+        }
+        else if (line.startsWith("//EDIT"))
+        {
+            // Make a change to the document, so it's checked again
+            if (SLANG_FAILED(sendAppendSpace(connection)))
+                return TestResult::Fail;
+        }
+        else if (line.startsWith("//DIAGNOSTICS"))
+        {
+            if (SLANG_FAILED(waitForDiagnostics()))
+                return TestResult::Fail;
             actualOutputSB << "--------\n";
             for (auto item : diagnostics)
             {
@@ -1681,7 +1892,7 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
                 {
                     actualOutputSB << msg.range.start.line << "," << msg.range.start.character
                                    << "-" << msg.range.end.line << "," << msg.range.end.character
-                                   << " " << msg.message;
+                                   << " " << msg.message << "\n";
                 }
             }
         }
@@ -1692,6 +1903,16 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
         LanguageServerProtocol::DidCloseTextDocumentParams::methodName,
         &closeDocParams,
         JSONValue::makeInt(1));
+    for (auto& pair : openedFileContents)
+    {
+        closeDocParams.textDocument.uri = getFileURI(pair.Key);
+        connection->sendCall(
+            LanguageServerProtocol::DidCloseTextDocumentParams::methodName, &closeDocParams);
+    }
+    for (auto& fileName : writtenFiles)
+    {
+        File::remove(Path::combine(testDirectory, fileName));
+    }
 
     auto outputStem = input.outputStem;
     String expectedOutputPath = outputStem + ".expected.txt";
@@ -0,0 +1,146 @@
+// unit-test-compile-cache.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-io.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct EntryVisitor : public Path::Visitor
+{
+    virtual void accept(Path::Type type, const UnownedStringSlice& filename) SLANG_OVERRIDE
+    {
+        if (type == Path::Type::File)
+        {
+            m_entries.add(Path::combine(m_directory, filename));
+        }
+    }
+    EntryVisitor(const String& directory) : m_directory(directory) {}
+
+    String m_directory;
+    List<String> m_entries;
+};
+
+} // anonymous
+
+static List<String> _findEntries(const String& directory)
+{
+    EntryVisitor visitor(directory);
+    Path::find(directory, nullptr, &visitor);
+    return visitor.m_entries;
+}
+
+static void _removeEntries(const String& directory)
+{
+    for (const auto& entry : _findEntries(directory))
+    {
+        File::remove(entry);
+    }
+    Path::remove(directory);
+}
+
+namespace { // anonymous
+
+struct CompileCacheCounts
+{
+    int64_t hits = 0;
+    int64_t misses = 0;
+};
+
+} // anonymous
+
+static SlangResult _compile(SlangSession* session, const char* cacheDirectory, String& outCode, CompileCacheCounts& outCounts)
+{
+    auto request = spCreateCompileRequest(session);
+    spSetReportPerformance(request, true);
+
+    const char* args[] = { "-cache-dir", cacheDirectory };
+    SlangResult res = spProcessCommandLineArguments(request, args, SLANG_COUNT_OF(args));
+
+    if (SLANG_SUCCEEDED(res))
+    {
+        spAddCodeGenTarget(request, SLANG_HLSL);
+        int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+        spAddTranslationUnitSourceFile(request, translationUnitIndex, "compile-cache-main.slang");
+        spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+        res = spCompile(request);
+    }
+
+    if (SLANG_SUCCEEDED(res))
+    {
+        ComPtr<ISlangBlob> blob;
+        res = spGetEntryPointCodeBlob(request, 0, 0, blob.writeRef());
+        if (SLANG_SUCCEEDED(res))
+        {
+            outCode = String((const char*)blob->getBufferPointer(), (const char*)blob->getBufferPointer() + blob->getBufferSize());
+        }
+
+        spGetPerformanceCounter(request, "compileCacheHits", &outCounts.hits);
+        spGetPerformanceCounter(request, "compileCacheMisses", &outCounts.misses);
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+// Test that the output of compilations is stored in, and reused from a cache directory, and that
+// changing a file that is depended on (here via #include) means the cached output is not used.
+SLANG_UNIT_TEST(compileCache)
+{
+    const char* cacheDirectory = "compile-cache-test";
+
+    const char* mainSource = R"(
+        #include "compile-cache-include.h"
+        RWStructuredBuffer<float> buffer;
+        [numthreads(4,1,1)]
+        void computeMain(uint3 dispatchThreadID : SV_DispatchThreadID)
+        {
+            buffer[dispatchThreadID.x] = buffer[dispatchThreadID.x] * SCALE;
+        })";
+
+    _removeEntries(cacheDirectory);
+
+    File::writeAllText("compile-cache-main.slang", mainSource);
+    File::writeAllText("compile-cache-include.h", "#define SCALE 2.0\n");
+
+    auto session = spCreateSession();
+
+    // The first compilation adds an entry
+    String firstCode;
+    CompileCacheCounts firstCounts;
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, cacheDirectory, firstCode, firstCounts)));
+    SLANG_CHECK(firstCounts.hits == 0 && firstCounts.misses == 1);
+    SLANG_CHECK(_findEntries(cacheDirectory).getCount() == 1);
+
+    // The second produces the same output from the entry, without generating code
+    String secondCode;
+    CompileCacheCounts secondCounts;
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, cacheDirectory, secondCode, secondCounts)));
+    SLANG_CHECK(secondCounts.hits == 1 && secondCounts.misses == 0);
+    SLANG_CHECK(secondCode == firstCode);
+    SLANG_CHECK(_findEntries(cacheDirectory).getCount() == 1);
+
+    // Changing the included file produces different output, in a new entry
+    File::writeAllText("compile-cache-include.h", "#define SCALE 3.0\n");
+
+    String thirdCode;
+    CompileCacheCounts thirdCounts;
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, cacheDirectory, thirdCode, thirdCounts)));
+    SLANG_CHECK(thirdCounts.hits == 0 && thirdCounts.misses == 1);
+    SLANG_CHECK(thirdCode != firstCode);
+    SLANG_CHECK(_findEntries(cacheDirectory).getCount() == 2);
+
+    spDestroySession(session);
+
+    _removeEntries(cacheDirectory);
+    File::remove("compile-cache-main.slang");
+    File::remove("compile-cache-include.h");
+}
@@ -0,0 +1,168 @@
+// unit-test-concurrent-sessions.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <thread>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-basic.h"
+
+using namespace Slang;
+
+static const SlangCompileTarget kTargets[] = { SLANG_HLSL, SLANG_GLSL };
+
+static SlangResult _compile(SlangSession* session, Index variant, List<String>& outCode)
+{
+    // Uses a variety of stdlib types and functions, so that lookup, overload resolution and
+    // specialization of builtin declarations all take place.
+    const char* source = R"(
+        interface IShape
+        {
+            float area(float scale);
+        }
+
+        struct Circle : IShape
+        {
+            float radius;
+            float area(float scale) { return 3.14159 * radius * radius * scale; }
+        };
+
+        struct Square : IShape
+        {
+            float side;
+            float area(float scale) { return side * side * scale; }
+        };
+
+        float totalArea<T : IShape>(T shape, int count)
+        {
+            float result = 0;
+            for (int i = 0; i < count; ++i)
+                result += shape.area(float(i));
+            return result;
+        }
+
+        Texture2D<float4> texture;
+        SamplerState sampler;
+        RWStructuredBuffer<float4> buffer;
+
+        [numthreads(4,1,1)]
+        void computeMain(uint3 id : SV_DispatchThreadID)
+        {
+            Circle circle;
+            circle.radius = buffer[id.x].x;
+            Square square;
+            square.side = buffer[id.x].y;
+
+            float2 uv = float2(id.xy) / 16.0;
+            float4 color = texture.SampleLevel(sampler, uv, 0);
+            float3 n = normalize(cross(color.xyz, float3(0, 1, 0)));
+            float4x4 m = float4x4(color, color.yzwx, color.zwxy, color.wxyz);
+
+            buffer[id.x] = mul(m, float4(n, totalArea(circle, VARIANT) + totalArea(square, 2)));
+        })";
+
+    auto request = spCreateCompileRequest(session);
+
+    for (auto target : kTargets)
+    {
+        spAddCodeGenTarget(request, target);
+    }
+
+    // Each variant is a different compilation, so that each thread isn't just repeating the same work
+    StringBuilder variantText;
+    variantText << variant;
+    spAddPreprocessorDefine(request, "VARIANT", variantText.getBuffer());
+
+    int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "concurrent-sessions.slang", source);
+    spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SlangResult res = spCompile(request);
+
+    for (Index targetIndex = 0; SLANG_SUCCEEDED(res) && targetIndex < SLANG_COUNT_OF(kTargets); ++targetIndex)
+    {
+        ComPtr<ISlangBlob> blob;
+        res = spGetEntryPointCodeBlob(request, 0, int(targetIndex), blob.writeRef());
+        if (SLANG_SUCCEEDED(res))
+        {
+            outCode.add(String((const char*)blob->getBufferPointer(), (const char*)blob->getBufferPointer() + blob->getBufferSize()));
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+// Test that compile requests created from one global session can compile on different threads at
+// the same time, and produce the same output as when compiled on a single thread. The threads start
+// compiling as soon as the global session is created, so that any state that is created on first use
+// is created whilst other threads may be using it.
+SLANG_UNIT_TEST(concurrentSessions)
+{
+    const Index threadCount = 4;
+    const Index compileCount = 3;
+
+    List<List<String>> threadCode;
+    threadCode.setCount(threadCount);
+
+    List<SlangResult> threadResults;
+    threadResults.setCount(threadCount);
+
+    {
+        auto session = spCreateSession();
+
+        std::thread threads[threadCount];
+        for (Index i = 0; i < threadCount; ++i)
+        {
+            threads[i] = std::thread([&, i]()
+            {
+                SlangResult res = SLANG_OK;
+                for (Index j = 0; j < compileCount && SLANG_SUCCEEDED(res); ++j)
+                {
+                    List<String> code;
+                    res = _compile(session, i + 1, code);
+                    if (SLANG_SUCCEEDED(res))
+                    {
+                        if (j == 0)
+                        {
+                            threadCode[i] = code;
+                        }
+                        else if (code != threadCode[i])
+                        {
+                            res = SLANG_FAIL;
+                        }
+                    }
+                }
+                threadResults[i] = res;
+            });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        spDestroySession(session);
+    }
+
+    for (auto res : threadResults)
+    {
+        SLANG_CHECK(SLANG_SUCCEEDED(res));
+    }
+
+    // Compile the same on a single thread, with a different global session, so that the output
+    // of the threads didn't depend on state created by this compilation
+    auto session = spCreateSession();
+    for (Index i = 0; i < threadCount; ++i)
+    {
+        List<String> code;
+        SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, i + 1, code)));
+        SLANG_CHECK(code.getCount() == SLANG_COUNT_OF(kTargets));
+        SLANG_CHECK(code == threadCode[i]);
+    }
+    spDestroySession(session);
+}
@@ -0,0 +1,66 @@
+// unit-test-diagnostic-listener.cpp
+
+#include "../../source/compiler-core/slang-diagnostic-sink.h"
+#include "../../source/compiler-core/slang-json-diagnostics.h"
+#include "../../source/compiler-core/slang-lexer.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct RecordingListener : public DiagnosticListener
+{
+    virtual void handleDiagnostic(Diagnostic const& diagnostic) SLANG_OVERRIDE
+    {
+        diagnostics.add(diagnostic);
+    }
+
+    List<Diagnostic> diagnostics;
+};
+
+} // anonymous
+
+SLANG_UNIT_TEST(diagnosticListener)
+{
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+
+    const char text[] = "value = unknownName + 1;";
+    SourceFile* sourceFile = sourceManager.createSourceFileWithString(PathInfo::makePath("listener.slang"), text);
+    SourceView* sourceView = sourceManager.createSourceView(sourceFile, nullptr, SourceLoc());
+
+    const SourceLoc loc = sourceView->getRange().begin + 8;
+    const UnownedStringSlice tokenText = UnownedStringSlice::fromLiteral("unknownName");
+
+    // The listener gets the diagnostic, with the range of the token at its location, and no text is output
+    {
+        RecordingListener listener;
+        DiagnosticSink sink(&sourceManager, Lexer::sourceLocationLexer);
+        sink.setListener(&listener);
+
+        sink.diagnose(loc, JSONDiagnostics::unexpectedToken, tokenText);
+
+        SLANG_CHECK(sink.outputBuffer.getLength() == 0);
+        SLANG_CHECK(sink.getErrorCount() == 1);
+        SLANG_CHECK_ABORT(listener.diagnostics.getCount() == 1);
+
+        const Diagnostic& diagnostic = listener.diagnostics[0];
+        SLANG_CHECK(diagnostic.ErrorID == JSONDiagnostics::unexpectedToken.id);
+        SLANG_CHECK(diagnostic.severity == Severity::Error);
+        SLANG_CHECK(diagnostic.Message == "unexpected 'unknownName'");
+        SLANG_CHECK(diagnostic.loc == loc);
+        SLANG_CHECK(diagnostic.endLoc == loc + tokenText.getLength());
+    }
+
+    // Without a listener the diagnostic is formatted as text
+    {
+        DiagnosticSink sink(&sourceManager, Lexer::sourceLocationLexer);
+
+        sink.diagnose(loc, JSONDiagnostics::unexpectedToken, tokenText);
+
+        SLANG_CHECK(sink.getErrorCount() == 1);
+        SLANG_CHECK(sink.outputBuffer.indexOf(UnownedStringSlice::fromLiteral("unexpected 'unknownName'")) >= 0);
+    }
+}
@@ -0,0 +1,102 @@
+// unit-test-downstream-product-cache.cpp
+
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "../../source/core/slang-io.h"
+#include "../../source/compiler-core/slang-downstream-product-cache.h"
+
+using namespace Slang;
+
+static bool _findProduct(DownstreamProductCache& cache, const String& key, const String& directory, const char* expected)
+{
+    List<uint8_t> product;
+    if (SLANG_FAILED(cache.find(key, directory, product)))
+    {
+        return false;
+    }
+    return UnownedStringSlice((const char*)product.getBuffer(), product.getCount()) == UnownedStringSlice(expected);
+}
+
+// Test products are found in memory, and via a directory from another cache (as would be the case for another process)
+SLANG_UNIT_TEST(downstreamProductCache)
+{
+    const String directory = "downstream-product-cache-test";
+
+    const char product[] = "not really a shared library";
+    const size_t productSize = sizeof(product) - 1;
+
+    // Just in memory
+    {
+        DownstreamProductCache cache;
+
+        SLANG_CHECK(!_findProduct(cache, "key", String(), product));
+        SLANG_CHECK(SLANG_SUCCEEDED(cache.add("key", String(), product, productSize)));
+        SLANG_CHECK(_findProduct(cache, "key", String(), product));
+        SLANG_CHECK(!_findProduct(cache, "other key", String(), product));
+
+        cache.clear();
+        SLANG_CHECK(!_findProduct(cache, "key", String(), product));
+    }
+
+    const String entryPath = DownstreamProductCache::calcEntryPath(directory, "key");
+    File::remove(entryPath);
+
+    {
+        DownstreamProductCache cache;
+        SLANG_CHECK(SLANG_SUCCEEDED(cache.add("key", directory, product, productSize)));
+        SLANG_CHECK(File::exists(entryPath));
+    }
+
+    // Another cache finds the product in the directory, but only for the same key
+    {
+        DownstreamProductCache cache;
+        SLANG_CHECK(_findProduct(cache, "key", directory, product));
+        SLANG_CHECK(!_findProduct(cache, "other key", directory, product));
+
+        // Once found it's held in memory
+        File::remove(entryPath);
+        SLANG_CHECK(_findProduct(cache, "key", directory, product));
+    }
+
+    Path::remove(directory);
+}
+
+static String _calcIncludesKey(const String& source)
+{
+    StringBuilder key;
+    DownstreamProductCache::appendIncludesToKey(source.getUnownedSlice(), key);
+    return key;
+}
+
+// Test the key covers the contents of files included by path (as a prelude is), and the files they include
+SLANG_UNIT_TEST(downstreamProductCacheIncludes)
+{
+    const String directory = "downstream-product-cache-includes-test";
+    Path::createDirectory(directory);
+
+    const String preludePath = Path::combine(directory, "prelude.h");
+    const String typesPath = Path::combine(directory, "types.h");
+
+    String canonicalPreludePath;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(preludePath, "#include \"types.h\"\n")));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(typesPath, "typedef int Int;\n")));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(Path::getCanonical(preludePath, canonicalPreludePath)));
+
+    const String source = "#include \"" + canonicalPreludePath + "\"\n#include <stdint.h>\nint main() { return 0; }\n";
+
+    const String key = _calcIncludesKey(source);
+    SLANG_CHECK(key.indexOf(UnownedStringSlice::fromLiteral("types.h")) >= 0);
+    SLANG_CHECK(key == _calcIncludesKey(source));
+
+    // Changing a file included by the prelude changes the key
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(typesPath, "typedef long Int;\n")));
+    const String changedKey = _calcIncludesKey(source);
+    SLANG_CHECK(changedKey != key);
+
+    // As does removing it
+    File::remove(typesPath);
+    SLANG_CHECK(_calcIncludesKey(source) != changedKey);
+
+    File::remove(preludePath);
+    Path::remove(directory);
+}
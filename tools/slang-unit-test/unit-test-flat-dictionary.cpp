@@ -0,0 +1,184 @@
+// unit-test-flat-dictionary.cpp
+
+#include "../../source/core/slang-flat-dictionary.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "../../source/core/slang-random-generator.h"
+#include "../../source/core/slang-dictionary.h"
+#include "../../source/core/slang-string.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+// Has no default constructor, so can only be constructed in place
+struct Thing
+{
+    Thing(int a, int b) : m_value(a * 1000 + b) {}
+    int m_value;
+};
+
+} // anonymous
+
+static bool _isEqual(const FlatDictionary<int, int>& dict, const Dictionary<int, int>& reference)
+{
+    if (dict.Count() != reference.Count())
+    {
+        return false;
+    }
+
+    for (const auto& pair : reference)
+    {
+        const int* value = dict.TryGetValue(pair.Key);
+        if (!value || *value != pair.Value)
+        {
+            return false;
+        }
+    }
+
+    // Check iteration visits every entry once
+    Index count = 0;
+    for (const auto& entry : dict)
+    {
+        int referenceValue;
+        if (!reference.TryGetValue(entry.Key, referenceValue) || referenceValue != entry.Value)
+        {
+            return false;
+        }
+        count++;
+    }
+    return count == reference.Count();
+}
+
+SLANG_UNIT_TEST(flatDictionary)
+{
+    // Randomly add, set and remove, comparing against Dictionary
+    {
+        DefaultRandomGenerator randGen(0x5123);
+
+        FlatDictionary<int, int> dict;
+        Dictionary<int, int> reference;
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            // Use a small range of keys, so there are lots of collisions and removals
+            const int key = randGen.nextInt32UpTo(1000);
+            switch (randGen.nextInt32UpTo(4))
+            {
+                case 0:
+                {
+                    SLANG_CHECK(dict.AddIfNotExists(key, i) == reference.AddIfNotExists(key, i));
+                    break;
+                }
+                case 1:
+                {
+                    dict.Set(key, i);
+                    reference[key] = i;
+                    break;
+                }
+                case 2:
+                {
+                    dict.Remove(key);
+                    reference.Remove(key);
+                    break;
+                }
+                default:
+                {
+                    SLANG_CHECK(dict.ContainsKey(key) == reference.ContainsKey(key));
+                    break;
+                }
+            }
+        }
+
+        SLANG_CHECK(_isEqual(dict, reference));
+
+        // Copy and move
+        FlatDictionary<int, int> copy(dict);
+        SLANG_CHECK(_isEqual(copy, reference));
+
+        FlatDictionary<int, int> moved(_Move(copy));
+        SLANG_CHECK(copy.Count() == 0 && !copy.ContainsKey(reference.begin()->Key));
+        SLANG_CHECK(_isEqual(moved, reference));
+
+        dict.Clear();
+        SLANG_CHECK(dict.Count() == 0 && dict.begin() == dict.end());
+        for (const auto& pair : reference)
+        {
+            SLANG_CHECK(!dict.ContainsKey(pair.Key));
+        }
+    }
+
+    // Pointer keys, which have hashes with low bits that are the same
+    {
+        List<int> values;
+        values.setCount(4096);
+
+        FlatDictionary<int*, Index> dict;
+        for (Index i = 0; i < values.getCount(); ++i)
+        {
+            dict.Add(&values[i], i);
+        }
+        SLANG_CHECK(dict.Count() == values.getCount());
+
+        bool allFound = true;
+        for (Index i = 0; i < values.getCount(); ++i)
+        {
+            Index* found = dict.TryGetValue(&values[i]);
+            allFound = allFound && found && *found == i;
+        }
+        SLANG_CHECK(allFound);
+    }
+
+    // String keys, found with slices
+    {
+        FlatDictionary<String, int> dict;
+        for (int i = 0; i < 100; ++i)
+        {
+            StringBuilder buf;
+            buf << "name" << i;
+            dict.Add(buf.ProduceString(), i);
+        }
+
+        int* value = dict.TryGetValue(UnownedStringSlice::fromLiteral("name42"));
+        SLANG_CHECK(value && *value == 42);
+        SLANG_CHECK(!dict.ContainsKey(UnownedStringSlice::fromLiteral("name100")));
+
+        // Adding with a slice only constructs a String if the key isn't found
+        SLANG_CHECK(!dict.AddIfNotExists(UnownedStringSlice::fromLiteral("name7"), 0));
+        SLANG_CHECK(dict.AddIfNotExists(UnownedStringSlice::fromLiteral("other"), -1));
+        SLANG_CHECK(dict.Count() == 101);
+    }
+
+    // Construction in place
+    {
+        FlatDictionary<int, Thing> dict;
+        SLANG_CHECK(dict.TryEmplace(1, 2, 3));
+        SLANG_CHECK(!dict.TryEmplace(1, 4, 5));
+        SLANG_CHECK(dict.GetOrEmplace(2, 6, 7).m_value == 6007);
+        SLANG_CHECK(dict.GetOrEmplace(1, 8, 9).m_value == 2003);
+    }
+
+    // Set
+    {
+        FlatHashSet<int> set;
+        for (int i = 0; i < 100; ++i)
+        {
+            SLANG_CHECK(set.Add(i * 3));
+        }
+        SLANG_CHECK(!set.Add(3));
+        SLANG_CHECK(set.Contains(99) && !set.Contains(100));
+        set.Remove(99);
+        SLANG_CHECK(!set.Contains(99) && set.Count() == 99);
+
+        int sum = 0;
+        for (auto value : set)
+        {
+            sum += value;
+        }
+        SLANG_CHECK(sum == 3 * (99 * 100 / 2) - 99);
+    }
+}
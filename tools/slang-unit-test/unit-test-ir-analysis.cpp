@@ -0,0 +1,58 @@
+// unit-test-ir-analysis.cpp
+
+#include "../../slang.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-basic.h"
+
+using namespace Slang;
+
+// Phi elimination computes the dominator tree of the function, and preserves it, so liveness tracking reuses it.
+// The liveness of the variables in the loop is still found.
+SLANG_UNIT_TEST(irAnalysis)
+{
+    const char* source = R"(
+        RWStructuredBuffer<int> buffer;
+
+        [numthreads(4,1,1)]
+        void computeMain(uint3 id : SV_DispatchThreadID)
+        {
+            int sum = 0;
+            for (int i = 0; i < buffer[0]; ++i)
+            {
+                sum += buffer[i + 1];
+            }
+            buffer[id.x] = sum;
+        })";
+
+    auto session = spCreateSession();
+    auto request = spCreateCompileRequest(session);
+
+    const char* args[] = { "-track-liveness" };
+    SLANG_CHECK(SLANG_SUCCEEDED(spProcessCommandLineArguments(request, args, SLANG_COUNT_OF(args))));
+    spSetReportPerformance(request, true);
+
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "ir-analysis.slang", source);
+    spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SLANG_CHECK(SLANG_SUCCEEDED(spCompile(request)));
+
+    ComPtr<ISlangBlob> codeBlob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spGetEntryPointCodeBlob(request, 0, 0, codeBlob.writeRef())));
+    const String code((const char*)codeBlob->getBufferPointer(), (const char*)codeBlob->getBufferPointer() + codeBlob->getBufferSize());
+    SLANG_CHECK(code.indexOf(UnownedStringSlice::fromLiteral("SLANG_LIVE_START(sum")) >= 0);
+    SLANG_CHECK(code.indexOf(UnownedStringSlice::fromLiteral("SLANG_LIVE_END(sum")) >= 0);
+    SLANG_CHECK(code.indexOf(UnownedStringSlice::fromLiteral("SLANG_LIVE_START(i")) >= 0);
+
+    int64_t computed = 0, reused = 0;
+    SLANG_CHECK(SLANG_SUCCEEDED(spGetPerformanceCounter(request, "irAnalysesComputed", &computed)));
+    SLANG_CHECK(SLANG_SUCCEEDED(spGetPerformanceCounter(request, "irAnalysesReused", &reused)));
+    SLANG_CHECK(computed > 0);
+    SLANG_CHECK(reused > 0);
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+}
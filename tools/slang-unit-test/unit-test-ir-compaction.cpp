@@ -0,0 +1,115 @@
+// unit-test-ir-compaction.cpp
+
+#include "../../slang.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-basic.h"
+
+using namespace Slang;
+
+static const char kSource[] = R"(
+    struct Material
+    {
+        float4 color;
+        Texture2D texture;
+        SamplerState sampler;
+    }
+
+    ParameterBlock<Material> material;
+    RWStructuredBuffer<float4> outputBuffer;
+
+    interface IShape
+    {
+        float area(float scale);
+    }
+
+    struct Circle : IShape
+    {
+        float radius;
+        float area(float scale) { return 3.14 * radius * radius * scale; }
+    }
+
+    struct Square : IShape
+    {
+        float side;
+        float area(float scale) { return side * side * scale; }
+    }
+
+    float4 shade<T : IShape>(T shape, Material m, float2 uv)
+    {
+        float4 result = m.color;
+        for (int i = 0; i < 4; i++)
+            result += m.texture.SampleLevel(m.sampler, uv, 0) * shape.area(float(i));
+        return result;
+    }
+
+    [numthreads(4,1,1)]
+    void computeMain(uint3 id : SV_DispatchThreadID)
+    {
+        Circle c;
+        c.radius = outputBuffer[0].x;
+        Square s;
+        s.side = outputBuffer[1].x;
+        float2 uv = float2(id.xy);
+        outputBuffer[id.x] = shade(c, material, uv) + shade(s, material, uv);
+    })";
+
+struct CompactionCounts
+{
+    int64_t compactions = 0;
+    int64_t detachedInsts = 0;
+    int64_t recycledInsts = 0;
+};
+
+static SlangResult _compile(SlangCompileTarget target, bool verify, String& outCode, CompactionCounts& outCounts)
+{
+    auto session = spCreateSession();
+    auto request = spCreateCompileRequest(session);
+
+    const char* args[] = { "-verify-ir-compaction" };
+    SlangResult res = spProcessCommandLineArguments(request, args, verify ? 1 : 0);
+    if (SLANG_SUCCEEDED(res))
+    {
+        spSetReportPerformance(request, true);
+
+        spAddCodeGenTarget(request, target);
+        int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+        spAddTranslationUnitSourceString(request, translationUnitIndex, "ir-compaction.slang", kSource);
+        spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+        res = spCompile(request);
+        if (SLANG_SUCCEEDED(res))
+        {
+            outCode = spGetEntryPointSource(request, 0);
+            spGetPerformanceCounter(request, "irModuleCompactions", &outCounts.compactions);
+            spGetPerformanceCounter(request, "irDetachedInstsCompacted", &outCounts.detachedInsts);
+            spGetPerformanceCounter(request, "irInstsRecycled", &outCounts.recycledInsts);
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+    return res;
+}
+
+// When verifying, the module is compacted during code generation whether or not it is wasteful, and the compile
+// fails if the compacted IR isn't valid. Passes before compaction remove insts that are still used (such as the
+// layouts of legalized parameters) and leave code detached from the module, which compaction must copy, and the
+// memory of removed insts is reused after compaction.
+SLANG_UNIT_TEST(irCompaction)
+{
+    const SlangCompileTarget targets[] = { SLANG_HLSL, SLANG_GLSL };
+    for (auto target : targets)
+    {
+        String code, verifiedCode;
+        CompactionCounts counts, verifiedCounts;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(target, false, code, counts)));
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(target, true, verifiedCode, verifiedCounts)));
+
+        SLANG_CHECK(verifiedCounts.compactions > 0);
+        SLANG_CHECK(verifiedCounts.detachedInsts > 0);
+        SLANG_CHECK(verifiedCounts.recycledInsts > 0);
+        SLANG_CHECK(code.getLength() > 0 && code == verifiedCode);
+    }
+}
@@ -0,0 +1,121 @@
+// unit-test-ir-pass-manager.cpp
+
+#include "../../slang.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-basic.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct IRPassCounts
+{
+    int64_t runs = -1;
+    int64_t skips = -1;
+};
+
+} // anonymous
+
+static IRPassCounts _getIRPassCounts(SlangCompileRequest* request, const char* passName)
+{
+    IRPassCounts counts;
+
+    StringBuilder runsName, skipsName;
+    runsName << "irPass." << passName << ".runs";
+    skipsName << "irPass." << passName << ".skips";
+
+    spGetPerformanceCounter(request, runsName.getBuffer(), &counts.runs);
+    spGetPerformanceCounter(request, skipsName.getBuffer(), &counts.skips);
+    return counts;
+}
+
+static const char kSource[] = R"(
+    RWStructuredBuffer<int> buffer;
+
+    int load(RWStructuredBuffer<int> b, int i) { return b[i]; }
+
+    [numthreads(4,1,1)]
+    void computeMain(uint3 id : SV_DispatchThreadID)
+    {
+        buffer[id.x] = load(buffer, int(id.x) + 1);
+    })";
+
+// The passes that are checked
+static const char* const kPassNames[] = { "specializeFuncsForBufferLoadArgs", "simplifyIR", "lowerGenerics" };
+
+static SlangResult _compile(const char* const* args, int argCount, Dictionary<String, IRPassCounts>& outCounts, String& outDiagnostics)
+{
+    auto session = spCreateSession();
+    auto request = spCreateCompileRequest(session);
+
+    SlangResult res = spProcessCommandLineArguments(request, args, argCount);
+    if (SLANG_SUCCEEDED(res))
+    {
+        spSetReportPerformance(request, true);
+
+        spAddCodeGenTarget(request, SLANG_HLSL);
+        int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+        spAddTranslationUnitSourceString(request, translationUnitIndex, "ir-pass-manager.slang", kSource);
+        spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+        res = spCompile(request);
+        outDiagnostics = spGetDiagnosticOutput(request);
+
+        if (SLANG_SUCCEEDED(res))
+        {
+            for (auto passName : kPassNames)
+            {
+                outCounts[passName] = _getIRPassCounts(request, passName);
+            }
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+    return res;
+}
+
+// Passes are timed, cleanup passes are skipped on unchanged IR, and optimization passes are skipped at -O0
+SLANG_UNIT_TEST(irPassManager)
+{
+    {
+        const char* args[] = { "-ir-pass-timings" };
+        Dictionary<String, IRPassCounts> counts;
+        String diagnostics;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(args, SLANG_COUNT_OF(args), counts, diagnostics)));
+
+        const IRPassCounts specialize = counts["specializeFuncsForBufferLoadArgs"];
+        SLANG_CHECK(specialize.runs == 1 && specialize.skips == 0);
+
+        // simplifyIR is run several times, and there is always a run without changes since the last
+        const IRPassCounts simplify = counts["simplifyIR"];
+        SLANG_CHECK(simplify.runs > 0 && simplify.skips > 0);
+    }
+
+    {
+        const char* args[] = { "-ir-pass-timings", "-O0" };
+        Dictionary<String, IRPassCounts> counts;
+        String diagnostics;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(args, SLANG_COUNT_OF(args), counts, diagnostics)));
+
+        const IRPassCounts specialize = counts["specializeFuncsForBufferLoadArgs"];
+        SLANG_CHECK(specialize.runs == 0 && specialize.skips == 1);
+    }
+
+    {
+        const char* args[] = { "-ir-pass-timings", "-ir-disable-pass", "specializeFuncsForBufferLoadArgs", "-ir-disable-pass", "lowerGenerics" };
+        Dictionary<String, IRPassCounts> counts;
+        String diagnostics;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(args, SLANG_COUNT_OF(args), counts, diagnostics)));
+
+        const IRPassCounts specialize = counts["specializeFuncsForBufferLoadArgs"];
+        SLANG_CHECK(specialize.runs == 0 && specialize.skips == 1);
+
+        // Required passes are still run, with a warning
+        const IRPassCounts lowerGenerics = counts["lowerGenerics"];
+        SLANG_CHECK(lowerGenerics.runs == 1);
+        SLANG_CHECK(diagnostics.indexOf("lowerGenerics") >= 0);
+    }
+}
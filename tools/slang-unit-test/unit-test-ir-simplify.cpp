@@ -0,0 +1,102 @@
+// unit-test-ir-simplify.cpp
+
+#include "../../slang.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-basic.h"
+
+using namespace Slang;
+
+static const char kSource[] = R"(
+    RWStructuredBuffer<float> outputBuffer;
+
+    interface IShape
+    {
+        float area(float scale);
+    }
+
+    struct Circle : IShape
+    {
+        float radius;
+        float area(float scale) { return 3.14 * radius * radius * scale; }
+    }
+
+    struct Square : IShape
+    {
+        float side;
+        float area(float scale)
+        {
+            float result = side * side;
+            if (scale > 0.0)
+                result *= scale;
+            return result;
+        }
+    }
+
+    float twice(float x) { return x + x; }
+
+    float sumAreas<T : IShape>(T shape, int count)
+    {
+        float sum = 0.0;
+        for (int i = 0; i < count; i++)
+            sum += shape.area(twice(float(i)));
+        return sum;
+    }
+
+    [numthreads(4,1,1)]
+    void computeMain(uint3 id : SV_DispatchThreadID)
+    {
+        Circle c;
+        c.radius = outputBuffer[0];
+        Square s;
+        s.side = outputBuffer[1];
+        outputBuffer[id.x] = sumAreas(c, int(id.x)) + sumAreas(s, 3);
+    })";
+
+static SlangResult _compile(SlangCompileTarget target, bool verify, String& outCode, int64_t& outSkipped)
+{
+    auto session = spCreateSession();
+    auto request = spCreateCompileRequest(session);
+
+    const char* args[] = { "-verify-ir-simplify" };
+    SlangResult res = spProcessCommandLineArguments(request, args, verify ? 1 : 0);
+    if (SLANG_SUCCEEDED(res))
+    {
+        spSetReportPerformance(request, true);
+
+        spAddCodeGenTarget(request, target);
+        int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+        spAddTranslationUnitSourceString(request, translationUnitIndex, "ir-simplify.slang", kSource);
+        spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+        res = spCompile(request);
+        if (SLANG_SUCCEEDED(res))
+        {
+            outCode = spGetEntryPointSource(request, 0);
+            outSkipped = -1;
+            spGetPerformanceCounter(request, "simplifyIRCodeSkipped", &outSkipped);
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+    return res;
+}
+
+// simplifyIR skips code that hasn't been modified since it was simplified. When verifying, the skipped code is
+// simplified anyway, and the compile fails if that changes it.
+SLANG_UNIT_TEST(irSimplify)
+{
+    const SlangCompileTarget targets[] = { SLANG_HLSL, SLANG_GLSL };
+    for (auto target : targets)
+    {
+        String code, verifiedCode;
+        int64_t skipped = 0, verifiedSkipped = 0;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(target, false, code, skipped)));
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(target, true, verifiedCode, verifiedSkipped)));
+
+        SLANG_CHECK(skipped > 0);
+        SLANG_CHECK(code.getLength() > 0 && code == verifiedCode);
+    }
+}
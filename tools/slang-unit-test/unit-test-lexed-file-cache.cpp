@@ -0,0 +1,131 @@
+// unit-test-lexed-file-cache.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-riff-file-system.h"
+
+using namespace Slang;
+
+static const char kHeader[] = R"(
+    // A header with an include guard
+    #ifndef GUARD_H
+    #define GUARD_H
+
+    #if 0
+    #else
+    #endif
+
+    #define TWICE(x) \
+        ((x) + (x))
+
+    float twice(float x) { return TWICE(x); }
+
+    #endif
+)";
+
+namespace { // anonymous
+
+struct LexedFileCacheCounts
+{
+    int64_t hits = -1;
+    int64_t misses = -1;
+    int64_t skippedIncludes = -1;
+};
+
+} // anonymous
+
+static SlangResult _compile(slang::ISession* session, const char* source, LexedFileCacheCounts& outCounts)
+{
+    ComPtr<SlangCompileRequest> request;
+    SLANG_RETURN_ON_FAIL(session->createCompileRequest(request.writeRef()));
+
+    spSetReportPerformance(request, true);
+
+    int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "main.slang", source);
+    spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+    SLANG_RETURN_ON_FAIL(spCompile(request));
+
+    SLANG_RETURN_ON_FAIL(spGetPerformanceCounter(request, "lexedFileCacheHits", &outCounts.hits));
+    SLANG_RETURN_ON_FAIL(spGetPerformanceCounter(request, "lexedFileCacheMisses", &outCounts.misses));
+    SLANG_RETURN_ON_FAIL(spGetPerformanceCounter(request, "includesSkippedByGuard", &outCounts.skippedIncludes));
+    return SLANG_OK;
+}
+
+SLANG_UNIT_TEST(lexedFileCache)
+{
+    const char* source = R"(
+        #include "guard.h"
+        #include "guard.h"
+
+        RWStructuredBuffer<float> buffer;
+
+        [numthreads(4,1,1)]
+        void computeMain(uint3 id : SV_DispatchThreadID)
+        {
+            buffer[id.x] = twice(buffer[id.x]);
+        })";
+
+    // The same content at another path, which is found in the cache, but can't be skipped
+    const char* copySource = R"(
+        #include "guard.h"
+        #include "copy.h"
+
+        RWStructuredBuffer<float> buffer;
+
+        [numthreads(4,1,1)]
+        void computeMain(uint3 id : SV_DispatchThreadID)
+        {
+            buffer[id.x] = twice(buffer[id.x]);
+        })";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang::createGlobalSession(globalSession.writeRef())));
+
+    ComPtr<ISlangMutableFileSystem> fileSystem(new RiffFileSystem(nullptr));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(fileSystem->saveFile("guard.h", kHeader, strlen(kHeader))));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(fileSystem->saveFile("copy.h", kHeader, strlen(kHeader))));
+
+    slang::TargetDesc targetDesc;
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("cs_5_0");
+
+    slang::SessionDesc sessionDesc;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.targetCount = 1;
+    sessionDesc.fileSystem = fileSystem;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    // The header is lexed the first time it is included, and the second include is skipped by its guard
+    {
+        LexedFileCacheCounts counts;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(session, source, counts)));
+        SLANG_CHECK(counts.hits == 0);
+        SLANG_CHECK(counts.misses == 1);
+        SLANG_CHECK(counts.skippedIncludes == 1);
+    }
+
+    // Another compile with the session plays back the tokens lexed by the previous one
+    {
+        LexedFileCacheCounts counts;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(session, source, counts)));
+        SLANG_CHECK(counts.hits == 1);
+        SLANG_CHECK(counts.misses == 0);
+        SLANG_CHECK(counts.skippedIncludes == 1);
+    }
+
+    {
+        LexedFileCacheCounts counts;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(session, copySource, counts)));
+        SLANG_CHECK(counts.hits == 2);
+        SLANG_CHECK(counts.misses == 0);
+        SLANG_CHECK(counts.skippedIncludes == 0);
+    }
+}
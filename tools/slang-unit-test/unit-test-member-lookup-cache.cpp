@@ -0,0 +1,90 @@
+// unit-test-member-lookup-cache.cpp
+
+#include "../../slang.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-basic.h"
+
+using namespace Slang;
+
+// Repeated lookups of the same members are found in the cache, without changing what is found. Lookups
+// on different specializations of a generic type find their own members, and an extension declared after
+// a type has been looked up in still adds its members.
+SLANG_UNIT_TEST(memberLookupCache)
+{
+    const char* source = R"(
+        struct Box<T>
+        {
+            T value;
+            T get() { return value; }
+        }
+
+        struct Counter
+        {
+            int count;
+            int next() { return count + 1; }
+        }
+
+        int pick(int x) { return 1; }
+        int pick(float x) { return 2; }
+
+        int getNext(Counter c) { return c.next(); }
+
+        extension Counter
+        {
+            int twice() { return count * 2; }
+        }
+
+        public __extern_cpp int calcResult()
+        {
+            Box<int> i;
+            i.value = 3;
+            Box<float> f;
+            f.value = 0.5;
+            Counter c;
+            c.count = 5;
+
+            // If the lookups of `get` on Box<int> and Box<float> shared a result, both calls to `pick`
+            // would resolve to the same overload
+            return pick(i.get()) * 10000 + pick(f.get()) * 1000 + c.next() * 100 + getNext(c) * 10 + c.twice() + i.get();
+        })";
+
+    auto session = spCreateSession();
+    if (SLANG_FAILED(spSessionCheckCompileTargetSupport(session, SLANG_SHADER_HOST_CALLABLE)))
+    {
+        spDestroySession(session);
+        SLANG_IGNORE_TEST
+    }
+
+    auto request = spCreateCompileRequest(session);
+
+    spSetReportPerformance(request, true);
+
+    const int targetIndex = spAddCodeGenTarget(request, SLANG_SHADER_HOST_CALLABLE);
+    spSetTargetFlags(request, targetIndex, SLANG_TARGET_FLAG_GENERATE_WHOLE_PROGRAM);
+    int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "member-lookup-cache.slang", source);
+
+    SLANG_CHECK(SLANG_SUCCEEDED(spCompile(request)));
+
+    ComPtr<ISlangSharedLibrary> sharedLibrary;
+    SLANG_CHECK(SLANG_SUCCEEDED(spGetTargetHostCallable(request, 0, sharedLibrary.writeRef())));
+    if (sharedLibrary)
+    {
+        typedef int (*Func)();
+        Func func = (Func)sharedLibrary->findFuncByName("calcResult");
+        SLANG_CHECK_ABORT(func);
+
+        SLANG_CHECK(func() == 1 * 10000 + 2 * 1000 + 6 * 100 + 6 * 10 + 10 + 3);
+    }
+
+    int64_t hits = 0, misses = 0;
+    SLANG_CHECK(SLANG_SUCCEEDED(spGetPerformanceCounter(request, "memberLookupCacheHits", &hits)));
+    SLANG_CHECK(SLANG_SUCCEEDED(spGetPerformanceCounter(request, "memberLookupCacheMisses", &misses)));
+    SLANG_CHECK(hits > 0);
+    SLANG_CHECK(misses > 0);
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+}
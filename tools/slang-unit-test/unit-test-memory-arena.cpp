@@ -267,5 +267,31 @@ SLANG_UNIT_TEST(memoryArena)
         
 
 
+    }
+    {
+        // Swapping moves the allocations, which remain valid
+        MemoryArena arena(1024);
+        MemoryArena otherArena(256);
+
+        void* mem = arena.allocate(100);
+        ::memset(mem, 0x5a, 100);
+        void* largeMem = arena.allocate(4096);
+        ::memset(largeMem, 0xa5, 4096);
+
+        arena.swapWith(otherArena);
+
+        SLANG_CHECK(otherArena.isValid(mem, 100) && otherArena.isValid(largeMem, 4096));
+        SLANG_CHECK(!arena.isValid(mem, 100));
+        SLANG_CHECK(arena.getBlockPayloadSize() == 256 && otherArena.getBlockPayloadSize() == 1024);
+
+        SLANG_CHECK(hasValue((uint8_t*)mem, 100, 0x5a));
+        SLANG_CHECK(hasValue((uint8_t*)largeMem, 4096, 0xa5));
+
+        void* newMem = arena.allocate(100);
+        SLANG_CHECK(newMem && arena.isValid(newMem, 100));
+
+        // Freeing the swapped arena frees the original allocations
+        otherArena.reset();
+        SLANG_CHECK(arena.isValid(newMem, 100));
     }
 }
@@ -0,0 +1,101 @@
+// unit-test-parallel-codegen.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-basic.h"
+
+using namespace Slang;
+
+static const char* kEntryPointNames[] = { "computeA", "computeB", "computeC", "computeD" };
+static const SlangCompileTarget kTargets[] = { SLANG_HLSL, SLANG_GLSL, SLANG_CPP_SOURCE };
+
+static SlangResult _compile(SlangSession* session, bool parallel, List<String>& outCode, String& outDiagnostics)
+{
+    const char* source = R"(
+        RWStructuredBuffer<float> buffer;
+
+        float scale(float value, int count)
+        {
+            float result = value;
+            for (int i = 0; i < count; ++i)
+                result = result * 0.5 + 1.0;
+            return result;
+        }
+
+        [numthreads(4,1,1)] void computeA(uint3 id : SV_DispatchThreadID) { buffer[id.x] = scale(buffer[id.x], 1); }
+        [numthreads(4,1,1)] void computeB(uint3 id : SV_DispatchThreadID) { buffer[id.x] = scale(buffer[id.x], 2); }
+        [numthreads(4,1,1)] void computeC(uint3 id : SV_DispatchThreadID) { buffer[id.x] = scale(buffer[id.x], 3); }
+        [numthreads(4,1,1)] void computeD(uint3 id : SV_DispatchThreadID) { buffer[id.x] = scale(buffer[id.x], 4); })";
+
+    auto request = spCreateCompileRequest(session);
+
+    SlangResult res = SLANG_OK;
+    if (parallel)
+    {
+        const char* args[] = { "-parallel-codegen" };
+        res = spProcessCommandLineArguments(request, args, SLANG_COUNT_OF(args));
+    }
+
+    if (SLANG_SUCCEEDED(res))
+    {
+        for (auto target : kTargets)
+        {
+            spAddCodeGenTarget(request, target);
+        }
+
+        int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+        spAddTranslationUnitSourceString(request, translationUnitIndex, "parallel-codegen.slang", source);
+        for (auto entryPointName : kEntryPointNames)
+        {
+            spAddEntryPoint(request, translationUnitIndex, entryPointName, SLANG_STAGE_COMPUTE);
+        }
+
+        res = spCompile(request);
+        outDiagnostics = spGetDiagnosticOutput(request);
+    }
+
+    for (Index targetIndex = 0; SLANG_SUCCEEDED(res) && targetIndex < SLANG_COUNT_OF(kTargets); ++targetIndex)
+    {
+        for (Index entryPointIndex = 0; SLANG_SUCCEEDED(res) && entryPointIndex < SLANG_COUNT_OF(kEntryPointNames); ++entryPointIndex)
+        {
+            ComPtr<ISlangBlob> blob;
+            res = spGetEntryPointCodeBlob(request, int(entryPointIndex), int(targetIndex), blob.writeRef());
+            if (SLANG_SUCCEEDED(res))
+            {
+                outCode.add(String((const char*)blob->getBufferPointer(), (const char*)blob->getBufferPointer() + blob->getBufferSize()));
+            }
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+// Test that generating code for multiple entry points and targets in parallel produces the same output
+// as generating it serially.
+SLANG_UNIT_TEST(parallelCodegen)
+{
+    auto session = spCreateSession();
+
+    List<String> serialCode;
+    String serialDiagnostics;
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, false, serialCode, serialDiagnostics)));
+    SLANG_CHECK(serialCode.getCount() == SLANG_COUNT_OF(kTargets) * SLANG_COUNT_OF(kEntryPointNames));
+
+    // Repeat, to make it more likely differences in scheduling are seen
+    for (Index i = 0; i < 4; ++i)
+    {
+        List<String> parallelCode;
+        String parallelDiagnostics;
+        SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, true, parallelCode, parallelDiagnostics)));
+        SLANG_CHECK(parallelCode == serialCode);
+        SLANG_CHECK(parallelDiagnostics == serialDiagnostics);
+    }
+
+    spDestroySession(session);
+}
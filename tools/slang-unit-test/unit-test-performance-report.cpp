@@ -0,0 +1,96 @@
+// unit-test-performance-report.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-basic.h"
+
+using namespace Slang;
+
+static SlangResult _compile(SlangCompileRequest* request)
+{
+    const char* source = R"(
+        RWStructuredBuffer<float> buffer;
+
+        T twice<T : __BuiltinArithmeticType>(T value) { return value + value; }
+
+        [numthreads(4,1,1)]
+        void computeMain(uint3 id : SV_DispatchThreadID)
+        {
+            buffer[id.x] = twice(buffer[id.x]) + float(twice(int(id.x)));
+        })";
+
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "performance-report.slang", source);
+    spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    return spCompile(request);
+}
+
+static String _getReport(SlangCompileRequest* request, SlangPerformanceReportFormat format)
+{
+    ComPtr<ISlangBlob> blob;
+    if (SLANG_FAILED(spGetPerformanceReport(request, format, blob.writeRef())))
+    {
+        return String();
+    }
+    return String((const char*)blob->getBufferPointer(), (const char*)blob->getBufferPointer() + blob->getBufferSize());
+}
+
+SLANG_UNIT_TEST(performanceReport)
+{
+    auto session = spCreateSession();
+
+    // No report is collected unless it is enabled
+    {
+        auto request = spCreateCompileRequest(session);
+        SLANG_CHECK(SLANG_SUCCEEDED(_compile(request)));
+
+        ComPtr<ISlangBlob> blob;
+        SLANG_CHECK(spGetPerformanceReport(request, SLANG_PERFORMANCE_REPORT_FORMAT_TEXT, blob.writeRef()) == SLANG_E_NOT_AVAILABLE);
+
+        int64_t value = 0;
+        SLANG_CHECK(spGetPerformanceCounter(request, "irInstsCreated", &value) == SLANG_E_NOT_AVAILABLE);
+
+        spDestroyCompileRequest(request);
+    }
+
+    {
+        auto request = spCreateCompileRequest(session);
+        spSetReportPerformance(request, true);
+        SLANG_CHECK(SLANG_SUCCEEDED(_compile(request)));
+
+        const String text = _getReport(request, SLANG_PERFORMANCE_REPORT_FORMAT_TEXT);
+        SLANG_CHECK(text.indexOf("compile") >= 0);
+        SLANG_CHECK(text.indexOf("\n  check") >= 0);
+        SLANG_CHECK(text.indexOf("linkAndOptimizeIR") >= 0);
+        SLANG_CHECK(text.indexOf("IR insts created") >= 0);
+
+        const String json = _getReport(request, SLANG_PERFORMANCE_REPORT_FORMAT_JSON);
+        SLANG_CHECK(json.startsWith("{"));
+        SLANG_CHECK(json.indexOf("\"irInstsCreated\"") >= 0);
+        SLANG_CHECK(json.indexOf("\"name\" : \"simplifyIR\"") >= 0);
+
+        // Counters can be read individually, by their JSON name
+        int64_t instsCreated = 0;
+        SLANG_CHECK(SLANG_SUCCEEDED(spGetPerformanceCounter(request, "irInstsCreated", &instsCreated)));
+        SLANG_CHECK(instsCreated > 0);
+        SLANG_CHECK(spGetPerformanceCounter(request, "IR insts created", &instsCreated) == SLANG_E_NOT_FOUND);
+
+        // IR pass counts are only collected with -ir-pass-timings
+        int64_t simplifyRuns = 0;
+        SLANG_CHECK(spGetPerformanceCounter(request, "irPass.simplifyIR.runs", &simplifyRuns) == SLANG_E_NOT_FOUND);
+
+        ComPtr<ISlangBlob> blob;
+        SLANG_CHECK(spGetPerformanceReport(request, SLANG_PERFORMANCE_REPORT_FORMAT_COUNT_OF, blob.writeRef()) == SLANG_E_INVALID_ARG);
+
+        spDestroyCompileRequest(request);
+    }
+
+    spDestroySession(session);
+}
@@ -0,0 +1,98 @@
+// unit-test-permutation-compile.cpp
+
+#include "../../slang.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-io.h"
+
+using namespace Slang;
+
+static const char kSource[] = R"(
+    RWStructuredBuffer<float> buffer;
+
+    #if defined(DOUBLE)
+    #define SCALE 2.0
+    #elif defined(TRIPLE)
+    #define SCALE 3.0
+    #else
+    #define SCALE 2.0
+    #endif
+
+    [numthreads(4,1,1)]
+    void computeMain(uint3 id : SV_DispatchThreadID)
+    {
+        buffer[id.x] = buffer[id.x] * SCALE;
+    })";
+
+static SlangPermutationDesc _makePermutation(const char* const* args, int argCount)
+{
+    SlangPermutationDesc desc = {};
+    desc.args = args;
+    desc.argCount = argCount;
+    return desc;
+}
+
+// Permutations that preprocess the same share an artifact, and a failing permutation doesn't stop the others
+SLANG_UNIT_TEST(permutationCompile)
+{
+    const String path = "permutation-compile-test.slang";
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(path, kSource)));
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang::createGlobalSession(globalSession.writeRef())));
+
+    const char* baseArgs[] = { path.getBuffer(), "-target", "hlsl", "-profile", "cs_5_0", "-entry", "computeMain", "-stage", "compute" };
+    const int baseArgCount = SLANG_COUNT_OF(baseArgs);
+
+    const char* doubleArgs[] = { "-DDOUBLE" };
+    const char* tripleArgs[] = { "-DTRIPLE" };
+    const char* badArgs[] = { "-DcomputeMain=)" };
+
+    {
+        const SlangPermutationDesc permutations[] =
+        {
+            _makePermutation(doubleArgs, 1),
+            _makePermutation(tripleArgs, 1),
+            _makePermutation(nullptr, 0),
+        };
+        const int permutationCount = SLANG_COUNT_OF(permutations);
+
+        int artifactIndices[permutationCount];
+        ComPtr<ISlangBlob> artifacts[permutationCount];
+        int artifactCount = 0;
+
+        SLANG_CHECK(SLANG_SUCCEEDED(spCompilePermutations(globalSession, baseArgs, baseArgCount, permutations, permutationCount,
+            artifactIndices, (ISlangBlob**)artifacts, &artifactCount, nullptr)));
+
+        SLANG_CHECK(artifactCount == 2);
+        SLANG_CHECK(artifactIndices[0] == artifactIndices[2]);
+        SLANG_CHECK(artifactIndices[0] != artifactIndices[1]);
+        SLANG_CHECK(artifactIndices[1] >= 0 && artifactIndices[1] < artifactCount);
+    }
+
+    {
+        const SlangPermutationDesc permutations[] =
+        {
+            _makePermutation(tripleArgs, 1),
+            _makePermutation(badArgs, 1),
+        };
+        const int permutationCount = SLANG_COUNT_OF(permutations);
+
+        int artifactIndices[permutationCount];
+        ComPtr<ISlangBlob> artifacts[permutationCount];
+        int artifactCount = 0;
+        ComPtr<ISlangBlob> diagnostics;
+
+        SLANG_CHECK(SLANG_FAILED(spCompilePermutations(globalSession, baseArgs, baseArgCount, permutations, permutationCount,
+            artifactIndices, (ISlangBlob**)artifacts, &artifactCount, diagnostics.writeRef())));
+
+        SLANG_CHECK(artifactCount == 1);
+        SLANG_CHECK(artifactIndices[0] == 0);
+        SLANG_CHECK(artifactIndices[1] == -1);
+        SLANG_CHECK(diagnostics && diagnostics->getBufferSize() > 0);
+    }
+
+    File::remove(path);
+}
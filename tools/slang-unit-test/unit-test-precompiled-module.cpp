@@ -0,0 +1,199 @@
+// unit-test-precompiled-module.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-io.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct ModuleVisitor : public Path::Visitor
+{
+    virtual void accept(Path::Type type, const UnownedStringSlice& filename) SLANG_OVERRIDE
+    {
+        if (type == Path::Type::File)
+        {
+            m_paths.add(Path::combine(m_directory, filename));
+            if (Path::getPathExt(filename) == toSlice("slang-module"))
+            {
+                m_moduleCount++;
+            }
+        }
+    }
+    ModuleVisitor(const String& directory) : m_directory(directory) {}
+
+    String m_directory;
+    List<String> m_paths;
+    Index m_moduleCount = 0;
+};
+
+} // anonymous
+
+static Index _countModules(const String& directory)
+{
+    ModuleVisitor visitor(directory);
+    Path::find(directory, nullptr, &visitor);
+    return visitor.m_moduleCount;
+}
+
+static void _removeDirectory(const String& directory)
+{
+    ModuleVisitor visitor(directory);
+    Path::find(directory, nullptr, &visitor);
+    for (const auto& path : visitor.m_paths)
+    {
+        File::remove(path);
+    }
+    Path::remove(directory);
+}
+
+static List<String> _findModules(const String& directory)
+{
+    ModuleVisitor visitor(directory);
+    Path::find(directory, nullptr, &visitor);
+
+    List<String> modulePaths;
+    for (const auto& path : visitor.m_paths)
+    {
+        if (Path::getPathExt(path) == toSlice("slang-module"))
+        {
+            modulePaths.add(path);
+        }
+    }
+    return modulePaths;
+}
+
+// Returns the index of text in the contents, or -1 if not found
+static Index _indexOf(const List<unsigned char>& contents, const UnownedStringSlice& text)
+{
+    for (Index i = 0; i + text.getLength() <= contents.getCount(); ++i)
+    {
+        if (::memcmp(contents.getBuffer() + i, text.begin(), size_t(text.getLength())) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static SlangResult _compile(SlangSession* session, const char* cacheDirectory, String& outCode)
+{
+    auto request = spCreateCompileRequest(session);
+
+    const char* args[] = { "-cache-dir", cacheDirectory };
+    SlangResult res = spProcessCommandLineArguments(request, args, SLANG_COUNT_OF(args));
+
+    if (SLANG_SUCCEEDED(res))
+    {
+        spAddCodeGenTarget(request, SLANG_HLSL);
+        int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+        spAddTranslationUnitSourceFile(request, translationUnitIndex, "precompiled-module-main.slang");
+        spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+        res = spCompile(request);
+    }
+
+    if (SLANG_SUCCEEDED(res))
+    {
+        ComPtr<ISlangBlob> blob;
+        res = spGetEntryPointCodeBlob(request, 0, 0, blob.writeRef());
+        if (SLANG_SUCCEEDED(res))
+        {
+            outCode = String((const char*)blob->getBufferPointer(), (const char*)blob->getBufferPointer() + blob->getBufferSize());
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+// Test that imported modules are stored in the cache directory, that a compilation that imports them
+// produces the same output, and that a change to the source of a module (or a module it imports) is detected.
+SLANG_UNIT_TEST(precompiledModule)
+{
+    const char* cacheDirectory = "precompiled-module-test";
+
+    const char* mainSource = R"(
+        import precompiled_module_lib;
+        RWStructuredBuffer<float> buffer;
+        [numthreads(4,1,1)]
+        void computeMain(uint3 dispatchThreadID : SV_DispatchThreadID)
+        {
+            Thing thing;
+            thing.value = buffer[dispatchThreadID.x];
+            buffer[dispatchThreadID.x] = thing.get();
+        })";
+
+    const char* libSource = R"(
+        import precompiled_module_util;
+        struct Thing
+        {
+            float value;
+            float get() { return scaleValue(value); }
+        };)";
+
+    _removeDirectory(cacheDirectory);
+
+    File::writeAllText("precompiled-module-main.slang", mainSource);
+    File::writeAllText("precompiled-module-lib.slang", libSource);
+    File::writeAllText("precompiled-module-util.slang", "float scaleValue(float v) { return v * 2.0; }\n");
+
+    auto session = spCreateSession();
+
+    // The first compilation imports from source, and stores both of the imported modules
+    String firstCode;
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, cacheDirectory, firstCode)));
+    SLANG_CHECK(_countModules(cacheDirectory) == 2);
+
+    // Change the main source, so the output isn't found in the cache, but the imported modules are
+    File::writeAllText("precompiled-module-main.slang", String(mainSource) + "\n");
+
+    String secondCode;
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, cacheDirectory, secondCode)));
+    SLANG_CHECK(secondCode == firstCode);
+    SLANG_CHECK(_countModules(cacheDirectory) == 2);
+
+    // Changing a module that is imported indirectly must change the output
+    File::writeAllText("precompiled-module-util.slang", "float scaleValue(float v) { return v * 3.0; }\n");
+
+    String thirdCode;
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, cacheDirectory, thirdCode)));
+    SLANG_CHECK(thirdCode != firstCode);
+
+    // A module written with a different serialization format is not used, and is replaced by one written
+    // from source. The format is changed in place, as the info is stored as uncompressed text.
+    const UnownedStringSlice format = toSlice("format: ast ");
+    for (const auto& modulePath : _findModules(cacheDirectory))
+    {
+        List<unsigned char> contents;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::readAllBytes(modulePath, contents)));
+        const Index formatIndex = _indexOf(contents, format);
+        SLANG_CHECK_ABORT(formatIndex >= 0);
+        contents[formatIndex + format.getLength()] = 'X';
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllBytes(modulePath, contents.getBuffer(), size_t(contents.getCount()))));
+    }
+
+    String fourthCode;
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, cacheDirectory, fourthCode)));
+    SLANG_CHECK(fourthCode == thirdCode);
+    for (const auto& modulePath : _findModules(cacheDirectory))
+    {
+        List<unsigned char> contents;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::readAllBytes(modulePath, contents)));
+        const Index formatIndex = _indexOf(contents, format);
+        SLANG_CHECK(formatIndex >= 0 && contents[formatIndex + format.getLength()] != 'X');
+    }
+
+    spDestroySession(session);
+
+    _removeDirectory(cacheDirectory);
+    File::remove("precompiled-module-main.slang");
+    File::remove("precompiled-module-lib.slang");
+    File::remove("precompiled-module-util.slang");
+}
@@ -0,0 +1,203 @@
+// unit-test-specialization-cache.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-blob.h"
+
+using namespace Slang;
+
+static const char kSource[] = R"(
+    interface IShape
+    {
+        float area();
+    }
+
+    struct Circle : IShape
+    {
+        float area() { return 3.14159; }
+    };
+
+    struct Square : IShape
+    {
+        float area() { return 1.0; }
+    };
+
+    struct Triangle : IShape
+    {
+        float area() { return 0.5; }
+    };
+
+    RWStructuredBuffer<float> buffer;
+
+    [shader("compute")]
+    [numthreads(4,1,1)]
+    void computeMain<T : IShape>(uint3 id : SV_DispatchThreadID)
+    {
+        T shape;
+        buffer[id.x] = shape.area();
+    })";
+
+namespace { // anonymous
+
+struct Program
+{
+    SlangResult init(slang::IGlobalSession* globalSession, size_t specializationCacheBudget)
+    {
+        slang::TargetDesc targetDesc;
+        targetDesc.format = SLANG_HLSL;
+        targetDesc.profile = globalSession->findProfile("cs_5_0");
+
+        slang::SessionDesc sessionDesc;
+        sessionDesc.targets = &targetDesc;
+        sessionDesc.targetCount = 1;
+        sessionDesc.specializationCacheBudget = specializationCacheBudget;
+        SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, session.writeRef()));
+
+        auto sourceBlob = StringBlob::create(kSource);
+        slang::IModule* module = session->loadModuleFromSource("specialization-cache", "specialization-cache.slang", sourceBlob);
+        if (!module)
+        {
+            return SLANG_FAIL;
+        }
+
+        ComPtr<slang::IEntryPoint> entryPoint;
+        SLANG_RETURN_ON_FAIL(module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+        slang::IComponentType* components[] = { module, entryPoint };
+        SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(components, SLANG_COUNT_OF(components), program.writeRef()));
+
+        auto layout = program->getLayout();
+        circleType = layout->findTypeByName("Circle");
+        squareType = layout->findTypeByName("Square");
+        triangleType = layout->findTypeByName("Triangle");
+        return (circleType && squareType && triangleType) ? SLANG_OK : SLANG_FAIL;
+    }
+
+    ComPtr<slang::IComponentType> specialize(slang::TypeReflection* type)
+    {
+        slang::SpecializationArg arg = slang::SpecializationArg::fromType(type);
+        ComPtr<slang::IComponentType> specialized;
+        program->specialize(&arg, 1, specialized.writeRef(), nullptr);
+        return specialized;
+    }
+
+    slang::SpecializationCacheStats getStats()
+    {
+        slang::SpecializationCacheStats stats;
+        session->getSpecializationCacheStats(&stats);
+        return stats;
+    }
+
+    ComPtr<slang::ISession> session;
+    ComPtr<slang::IComponentType> program;
+    slang::TypeReflection* circleType = nullptr;
+    slang::TypeReflection* squareType = nullptr;
+    slang::TypeReflection* triangleType = nullptr;
+};
+
+} // anonymous
+
+SLANG_UNIT_TEST(specializationCache)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang::createGlobalSession(globalSession.writeRef())));
+
+    // Repeated requests return the same component type, and the code generated for it
+    {
+        Program program;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(program.init(globalSession, 64 * 1024 * 1024)));
+
+        auto circle = program.specialize(program.circleType);
+        SLANG_CHECK_ABORT(circle);
+
+        ComPtr<slang::IBlob> code;
+        SLANG_CHECK(SLANG_SUCCEEDED(circle->getEntryPointCode(0, 0, code.writeRef(), nullptr)));
+
+        auto circleAgain = program.specialize(program.circleType);
+        SLANG_CHECK(circleAgain == circle);
+
+        ComPtr<slang::IBlob> codeAgain;
+        SLANG_CHECK(SLANG_SUCCEEDED(circleAgain->getEntryPointCode(0, 0, codeAgain.writeRef(), nullptr)));
+        SLANG_CHECK(codeAgain && codeAgain->getBufferPointer() == code->getBufferPointer());
+
+        auto square = program.specialize(program.squareType);
+        SLANG_CHECK(square && square != circle);
+
+        ComPtr<slang::IComponentType> linked, linkedAgain;
+        SLANG_CHECK(SLANG_SUCCEEDED(circle->link(linked.writeRef(), nullptr)));
+        SLANG_CHECK(SLANG_SUCCEEDED(circle->link(linkedAgain.writeRef(), nullptr)));
+        SLANG_CHECK(linked && linked == linkedAgain);
+
+        const auto stats = program.getStats();
+        SLANG_CHECK(stats.hitCount == 2);
+        SLANG_CHECK(stats.missCount == 3);
+        SLANG_CHECK(stats.entryCount == 3);
+        SLANG_CHECK(stats.evictionCount == 0);
+        SLANG_CHECK(stats.approximateMemoryUsage > code->getBufferSize());
+    }
+
+    // A budget too small to hold anything evicts every entry
+    {
+        Program program;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(program.init(globalSession, 1)));
+
+        auto circle = program.specialize(program.circleType);
+        auto circleAgain = program.specialize(program.circleType);
+        SLANG_CHECK(circle && circleAgain && circle != circleAgain);
+
+        const auto stats = program.getStats();
+        SLANG_CHECK(stats.hitCount == 0);
+        SLANG_CHECK(stats.entryCount == 0);
+        SLANG_CHECK(stats.evictionCount == 2);
+    }
+
+    // The least recently used entry is evicted first
+    {
+        // Find the memory used by two entries
+        size_t twoEntryMemoryUsage = 0;
+        {
+            Program program;
+            SLANG_CHECK_ABORT(SLANG_SUCCEEDED(program.init(globalSession, 64 * 1024 * 1024)));
+            program.specialize(program.circleType);
+            program.specialize(program.squareType);
+            twoEntryMemoryUsage = program.getStats().approximateMemoryUsage;
+        }
+
+        // Has room for two entries, but not three
+        Program program;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(program.init(globalSession, twoEntryMemoryUsage + twoEntryMemoryUsage / 4)));
+
+        auto circle = program.specialize(program.circleType);
+        auto square = program.specialize(program.squareType);
+        SLANG_CHECK(program.specialize(program.circleType) == circle);
+
+        // Adding triangle evicts square, which is now the least recently used
+        auto triangle = program.specialize(program.triangleType);
+        SLANG_CHECK(triangle);
+        SLANG_CHECK(program.getStats().evictionCount == 1);
+        SLANG_CHECK(program.getStats().entryCount == 2);
+
+        SLANG_CHECK(program.specialize(program.circleType) == circle);
+        SLANG_CHECK(program.specialize(program.triangleType) == triangle);
+        SLANG_CHECK(program.getStats().approximateMemoryUsage <= program.getStats().budget);
+    }
+
+    // The cache is disabled by default
+    {
+        Program program;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(program.init(globalSession, 0)));
+
+        auto circle = program.specialize(program.circleType);
+        auto circleAgain = program.specialize(program.circleType);
+        SLANG_CHECK(circle && circleAgain && circle != circleAgain);
+
+        const auto stats = program.getStats();
+        SLANG_CHECK(stats.hitCount == 0 && stats.missCount == 0);
+    }
+}
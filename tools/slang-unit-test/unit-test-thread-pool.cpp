@@ -0,0 +1,66 @@
+// unit-test-thread-pool.cpp
+
+#include "../../source/core/slang-thread-pool.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "../../source/core/slang-list.h"
+
+using namespace Slang;
+
+static void _checkAllTasksRun(Index workerCount)
+{
+    RefPtr<ThreadPool> pool = new ThreadPool(workerCount);
+
+    const Index taskCount = 1000;
+
+    List<int> results;
+    results.setCount(taskCount);
+    for (auto& result : results)
+    {
+        result = 0;
+    }
+
+    std::atomic<Index> runCount(0);
+
+    // Run a couple of rounds to check the pool can be reused after waitAll
+    for (Index round = 0; round < 2; ++round)
+    {
+        for (Index i = 0; i < taskCount; ++i)
+        {
+            int* dst = &results[i];
+            pool->submit([dst, &runCount]() { (*dst)++; runCount++; });
+        }
+        pool->waitAll();
+
+        SLANG_CHECK(runCount == taskCount * (round + 1));
+    }
+
+    bool allRunTwice = true;
+    for (auto result : results)
+    {
+        allRunTwice = allRunTwice && result == 2;
+    }
+    SLANG_CHECK(allRunTwice);
+}
+
+SLANG_UNIT_TEST(threadPool)
+{
+    // With no workers all of the work is done by the thread that waits
+    _checkAllTasksRun(0);
+    _checkAllTasksRun(1);
+    _checkAllTasksRun(4);
+
+    // Tasks submitted but never waited on are completed before the pool is destroyed
+    {
+        std::atomic<Index> runCount(0);
+        {
+            RefPtr<ThreadPool> pool = new ThreadPool(2);
+            for (Index i = 0; i < 100; ++i)
+            {
+                pool->submit([&runCount]() { runCount++; });
+            }
+        }
+        SLANG_CHECK(runCount == 100);
+    }
+}